@@ -11,6 +11,14 @@ FIND_LIBRARY(
 	PATH_SUFFIXES lib lib32 lib64
 )
 
+#The threaded library is optional.
+FIND_LIBRARY(
+	FFTW3_THREADS_LIBRARIES
+	NAMES fftw3_threads
+	PATHS ${FFTW3_LIBRARY_PATH}
+	PATH_SUFFIXES lib lib32 lib64
+)
+
 INCLUDE(FindPackageHandleStandardArgs)
 FIND_PACKAGE_HANDLE_STANDARD_ARGS(
 	FFTW3
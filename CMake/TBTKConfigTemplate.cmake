@@ -64,7 +64,12 @@ ENDIF(CURL_FOUND)
 
 IF(FFTW3_FOUND)
 	TBTK_MESSAGE("[X] FFTW3")
+	ADD_DEFINITIONS(-DTBTK_USE_FFTW3)
 #	SET(TBTK_LIBRARIES "${TBTK_LIBRARIES} -lfftw3")
+	IF(FFTW3_THREADS_LIBRARIES)
+		ADD_DEFINITIONS(-DTBTK_USE_FFTW3_THREADS)
+		LIST(APPEND TBTK_LIBRARIES "fftw3_threads")
+	ENDIF(FFTW3_THREADS_LIBRARIES)
 	LIST(APPEND TBTK_LIBRARIES "fftw3")
 ELSE(FFTW3_FOUND)
 	TBTK_MESSAGE("[ ] FFTW3")
@@ -77,6 +82,7 @@ IF(HDF5_FOUND)
 	INCLUDE_DIRECTORIES(${HDF5_INCLUDE_DIRS})
 #	LINK_DIRECTORIES(${HDF5_LIBRARY_DIRS})
 	ADD_DEFINITIONS(${HDF_DEFINITIONS})
+	ADD_DEFINITIONS(-DTBTK_USE_HDF5)
 	LIST(APPEND TBTK_LIBRARIES ${HDF5_LIBRARIES})
 ELSE(HDF5_FOUND)
 	TBTK_MESSAGE("[ ] HDF5")
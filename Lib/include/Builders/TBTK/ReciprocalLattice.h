@@ -28,6 +28,7 @@
 #include "TBTK/StateTreeNode.h"
 #include "TBTK/UnitCell.h"
 
+#include <complex>
 #include <initializer_list>
 #include <vector>
 
@@ -63,6 +64,11 @@ namespace TBTK{
  *  space environment around a reference UnitCell, large enough to ensure that
  *  the sum can run over all relevant \f[\bar{R}\f], and then using this to
  *  calcualte the coefficeints when Models with given k and k' is demanded.
+ *
+ *  The coefficients \f$a_{\bar{R}i0i'}\f$ are tabulated once when the
+ *  ReciprocalLattice is constructed. The Bloch Hamiltonians for many momentums
+ *  can then be calculated at once using calculateHamiltonians(), which is
+ *  much faster than generating one Model per momentum.
  **/
 class ReciprocalLattice{
 public:
@@ -84,6 +90,37 @@ public:
 		const std::vector<Index> &blockIndices
 	) const;
 
+	/** Calculate the Bloch Hamiltonians for several momentums at once.
+	 *  The phase factors for all momentums are calculated in parallel and
+	 *  are then multiplied with the tabulated real space coefficients in a
+	 *  single matrix multiplication.
+	 *
+	 *  @param momentums The momentums.
+	 *
+	 *  @return The Hamiltonians on the layout [momentum][to][from], where
+	 *  to and from are the positions of the states in the UnitCell. */
+	std::vector<std::complex<double>> calculateHamiltonians(
+		const std::vector<std::vector<double>> &momentums
+	) const;
+
+	/** Calculate the Bloch Hamiltonians on a mesh that covers the
+	 *  Brillouin zone. The mesh points are
+	 *  \f$k = \sum_{c}\frac{m_c}{N_c}b_c\f$, where \f$b_c\f$ are the
+	 *  reciprocal lattice vectors and \f$m_c = 0, ..., N_c-1\f$, ordered
+	 *  with the last index varying fastest. The Fourier transform is
+	 *  carried out one direction at a time, which reduces the cost from
+	 *  the number of mesh points times the number of lattice vectors to
+	 *  the number of mesh points times the range of the lattice vectors
+	 *  along each direction.
+	 *
+	 *  @param numMeshPoints The number of mesh points along each
+	 *  reciprocal lattice vector.
+	 *
+	 *  @return The Hamiltonians on the layout [meshPoint][to][from]. */
+	std::vector<std::complex<double>> calculateHamiltonians(
+		const std::vector<unsigned int> &numMeshPoints
+	) const;
+
 	/** Get reciprocal lattice vectors. */
 	const std::vector<std::vector<double>>& getReciprocalLatticeVectors() const;
 
@@ -111,6 +148,17 @@ private:
 	/** Reciprocal lattice vectors. */
 	std::vector<std::vector<double>> reciprocalLatticeVectors;
 
+	/** Indices of the states in the reference cell. */
+	std::vector<Index> stateIndices;
+
+	/** Lattice vectors R, in units of the UnitCell lattice vectors, for
+	 *  which the real space Hamiltonian H(R) is nonzero. Stored on the
+	 *  layout [R][direction]. */
+	std::vector<int> hoppingDisplacements;
+
+	/** The real space Hamiltonian H(R) on the layout [R][to][from]. */
+	std::vector<std::complex<double>> realSpaceHamiltonian;
+
 	/** Constant used to provide a margin that protects from roundoff
 	 *  errors. */
 	static constexpr double ROUNDOFF_MARGIN_MULTIPLIER = 1.01;
@@ -120,6 +168,10 @@ private:
 
 	/** Setup real space environment. */
 	void setupRealSpaceEnvironment(const UnitCell *unitCell);
+
+	/** Tabulate the real space Hamiltonian H(R) using the real space
+	 *  environment. */
+	void setupRealSpaceHamiltonian(const UnitCell *unitCell);
 };
 
 inline const std::vector<std::vector<double>>& ReciprocalLattice::getReciprocalLatticeVectors() const{
@@ -0,0 +1,256 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @package TBTKcalc
+ *  @file BasisIndexLookupTable.h
+ *  @brief Flat lookup table between physical indices and basis indices.
+ *
+ *  @author Kristofer Björnson
+ */
+
+#ifndef COM_DAFER45_TBTK_BASIS_INDEX_LOOKUP_TABLE
+#define COM_DAFER45_TBTK_BASIS_INDEX_LOOKUP_TABLE
+
+#include "TBTK/HoppingAmplitudeTree.h"
+#include "TBTK/Index.h"
+
+#include <vector>
+
+namespace TBTK{
+
+/** @brief Flat lookup table between physical indices and basis indices.
+ *
+ *  The BasisIndexLookupTable provides constant time alternatives to
+ *  HoppingAmplitudeTree::getBasisIndex() and
+ *  HoppingAmplitudeTree::getPhysicalIndex(). The table is generated from a
+ *  HoppingAmplitudeTree for which the basis indices already have been
+ *  generated.
+ *
+ *  The physical to basis index map is only available when all physical
+ *  indices have the same number of subindices. If the indices moreover
+ *  fill a sufficiently large fraction of the box spanned by the subindex
+ *  ranges, a dense strided array is used. Otherwise the subindices are
+ *  packed into a 64-bit key that is looked up in an open addressing hash
+ *  table. If none of these representations is possible, getBasisIndex()
+ *  always returns -1 and the caller is expected to fall back on the
+ *  HoppingAmplitudeTree.
+ *
+ *  The basis to physical index map is always available once the table has
+ *  been generated. */
+class BasisIndexLookupTable{
+public:
+	/** Enum class for the representation used for the physical to basis
+	 *  index map. */
+	enum class Type{None, Dense, Hash};
+
+	/** Constructor. */
+	BasisIndexLookupTable();
+
+	/** Generate the lookup table from a HoppingAmplitudeTree.
+	 *
+	 *  @param hoppingAmplitudeTree HoppingAmplitudeTree for which
+	 *  HoppingAmplitudeTree::generateBasisIndices() has been called. */
+	void generate(const HoppingAmplitudeTree &hoppingAmplitudeTree);
+
+	/** Clear the lookup table. */
+	void clear();
+
+	/** Get the type of representation used for the physical to basis
+	 *  index map.
+	 *
+	 *  @return The representation type. */
+	Type getType() const;
+
+	/** Returns true if the table has been generated.
+	 *
+	 *  @return True if the table has been generated, otherwise false. */
+	bool getIsGenerated() const;
+
+	/** Get the basis index for the given physical index.
+	 *
+	 *  @param index Physical index.
+	 *
+	 *  @return The basis index corresponding to the physical index, or -1
+	 *  if the physical index cannot be resolved by the table. */
+	int getBasisIndex(const Index &index) const;
+
+	/** Get physical index for the given basis index.
+	 *
+	 *  @param basisIndex Basis index. Must be in the range
+	 *  [0, basisSize).
+	 *
+	 *  @return The physical index corresponding to the basis index. */
+	Index getPhysicalIndex(int basisIndex) const;
+
+	/** Get size in bytes.
+	 *
+	 *  @return Memory size required to store the lookup table. */
+	unsigned int getSizeInBytes() const;
+private:
+	/** Type of the physical to basis index map. */
+	Type type;
+
+	/** Flag indicating whether the table has been generated. */
+	bool isGenerated;
+
+	/** Number of subindices of the physical indices. Only valid if type
+	 *  is not Type::None. */
+	unsigned int rank;
+
+	/** Upper bound (exclusive) for each subindex. */
+	std::vector<int> ranges;
+
+	/** Strides used to calculate the position in the dense table. */
+	std::vector<unsigned long long> strides;
+
+	/** Bit offsets used to pack subindices into hash keys. */
+	std::vector<unsigned int> shifts;
+
+	/** Dense table storing the basis index for each position in the box
+	 *  spanned by the subindex ranges. Missing indices are stored as -1.
+	 */
+	std::vector<int> denseTable;
+
+	/** Hash table keys. Empty slots are marked with EMPTY_KEY. */
+	std::vector<unsigned long long> hashKeys;
+
+	/** Hash table values. */
+	std::vector<int> hashValues;
+
+	/** Mask used to map hashes to slots. Equal to the hash table size
+	 *  minus one. */
+	unsigned long long hashMask;
+
+	/** Concatenated subindices for the physical indices, ordered by basis
+	 *  index. */
+	std::vector<int> subindices;
+
+	/** Offsets into subindices where the physical index for a given basis
+	 *  index starts. Contains basisSize+1 entries. */
+	std::vector<unsigned int> offsets;
+
+	/** Key used to mark empty hash table slots. Packed keys use at most
+	 *  63 bits and can therefore never be equal to this value. */
+	static constexpr unsigned long long EMPTY_KEY = ~0ull;
+
+	/** Maximum ratio between the size of the dense table and the basis
+	 *  size for which the dense representation is used. */
+	static constexpr unsigned int MAX_DENSE_FILL_RATIO = 4;
+
+	/** Pack the subindices of an Index into a hash key. Assumes that the
+	 *  Index has already been checked to be inside the ranges. */
+	unsigned long long getKey(const Index &index) const;
+
+	/** Calculate hash table slot for a given key. */
+	unsigned long long getSlot(unsigned long long key) const;
+
+	/** Returns true if the Index has the correct rank and all subindices
+	 *  are within the ranges. */
+	bool isInRange(const Index &index) const;
+
+	/** Setup the dense table. */
+	void generateDenseTable();
+
+	/** Setup the hash table. */
+	void generateHashTable();
+};
+
+inline BasisIndexLookupTable::Type BasisIndexLookupTable::getType() const{
+	return type;
+}
+
+inline bool BasisIndexLookupTable::getIsGenerated() const{
+	return isGenerated;
+}
+
+inline unsigned long long BasisIndexLookupTable::getKey(
+	const Index &index
+) const{
+	unsigned long long key = 0;
+	for(unsigned int n = 0; n < rank; n++)
+		key |= ((unsigned long long)index[n]) << shifts[n];
+
+	return key;
+}
+
+inline unsigned long long BasisIndexLookupTable::getSlot(
+	unsigned long long key
+) const{
+	//Fibonacci hashing.
+	return ((key*0x9E3779B97F4A7C15ull) >> 17) & hashMask;
+}
+
+inline bool BasisIndexLookupTable::isInRange(const Index &index) const{
+	if(index.getSize() != rank)
+		return false;
+
+	for(unsigned int n = 0; n < rank; n++)
+		if(index[n] < 0 || index[n] >= ranges[n])
+			return false;
+
+	return true;
+}
+
+inline int BasisIndexLookupTable::getBasisIndex(const Index &index) const{
+	switch(type){
+	case Type::Dense:
+	{
+		if(!isInRange(index))
+			return -1;
+
+		unsigned long long position = 0;
+		for(unsigned int n = 0; n < rank; n++)
+			position += strides[n]*index[n];
+
+		return denseTable[position];
+	}
+	case Type::Hash:
+	{
+		if(!isInRange(index))
+			return -1;
+
+		unsigned long long key = getKey(index);
+		unsigned long long slot = getSlot(key);
+		while(true){
+			if(hashKeys[slot] == key)
+				return hashValues[slot];
+			if(hashKeys[slot] == EMPTY_KEY)
+				return -1;
+
+			slot = (slot + 1) & hashMask;
+		}
+	}
+	default:
+		return -1;
+	}
+}
+
+inline Index BasisIndexLookupTable::getPhysicalIndex(int basisIndex) const{
+	Index index;
+	index.reserve(offsets[basisIndex+1] - offsets[basisIndex]);
+	for(
+		unsigned int n = offsets[basisIndex];
+		n < offsets[basisIndex+1];
+		n++
+	){
+		index.push_back(subindices[n]);
+	}
+
+	return index;
+}
+
+};	//End of namespace TBTK
+
+#endif
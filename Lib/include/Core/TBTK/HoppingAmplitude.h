@@ -48,6 +48,66 @@ enum HermitianConjugate {HC};
  */
 class HoppingAmplitude{
 public:
+	/** @brief Base class for callbacks that evaluate HoppingAmplitudes at
+	 *  run time.
+	 *
+	 *  In contrast to a plain callback function, an AmplitudeCallback can
+	 *  carry its own state (such as mean-field parameters), which makes it
+	 *  possible to keep several @link Model Models @endlink with different
+	 *  parameters alive in the same process without resorting to global
+	 *  variables. The AmplitudeCallback is not owned by the
+	 *  HoppingAmplitude and has to outlive every HoppingAmplitude that
+	 *  refers to it.
+	 *
+	 *  Classes that can evaluate many amplitudes more efficiently at once
+	 *  (for example by vectorizing or parallelizing the evaluation) can
+	 *  override getHoppingAmplitudes(), which is used by the
+	 *  HoppingAmplitudeSet to evaluate all amplitudes that share the same
+	 *  AmplitudeCallback in a single call. */
+	class AmplitudeCallback{
+	public:
+		/** Destructor. */
+		virtual ~AmplitudeCallback();
+
+		/** Get the amplitude for the given pair of @link Index
+		 *  Indices@endlink.
+		 *
+		 *  @param toIndex The to-Index of the HoppingAmplitude.
+		 *  @param fromIndex The from-Index of the HoppingAmplitude.
+		 *
+		 *  @return The value of the amplitude. */
+		virtual std::complex<double> getHoppingAmplitude(
+			const Index &toIndex,
+			const Index &fromIndex
+		) const = 0;
+
+		/** Get the amplitudes for several pairs of @link Index
+		 *  Indices@endlink at once. The default implementation calls
+		 *  getHoppingAmplitude() once for every pair.
+		 *
+		 *  @param numAmplitudes Number of amplitudes to evaluate.
+		 *  @param toIndices The to-Indices of the HoppingAmplitudes.
+		 *  @param fromIndices The from-Indices of the
+		 *  HoppingAmplitudes.
+		 *
+		 *  @param toBasisIndices The basis indices corresponding to
+		 *  the to-Indices.
+		 *
+		 *  @param fromBasisIndices The basis indices corresponding to
+		 *  the from-Indices.
+		 *
+		 *  @param amplitudes Array with room for numAmplitudes values
+		 *  into which the amplitudes are written. */
+		virtual void getHoppingAmplitudes(
+			unsigned int numAmplitudes,
+			const Index *const *toIndices,
+			const Index *const *fromIndices,
+			const int *toBasisIndices,
+			const int *fromBasisIndices,
+			std::complex<double> *amplitudes
+		) const;
+	};
+
 	/** Constructs a HoppingAmplitude from a value and two @link Index
 	 *  Indices@endlink.
 	 *
@@ -84,11 +144,34 @@ public:
 		Index fromIndex
 	);
 
+	/** Constructor. Takes an AmplitudeCallback rather than a parameter
+	 *  value. The AmplitudeCallback is evaluated each time the amplitude
+	 *  is requested and must outlive the HoppingAmplitude.
+	 *
+	 *  @param amplitudeCallback AmplitudeCallback able to return a value
+	 *  when passed toIndex and fromIndex.
+	 *
+	 *  @param toIndex The left index (i or to-Index) on the
+	 *  HoppingAmplitude.
+	 *
+	 *  @param fromIndex The right index (j or from-Index) on the
+	 *  HoppingAmplitude. */
+	HoppingAmplitude(
+		const AmplitudeCallback &amplitudeCallback,
+		Index toIndex,
+		Index fromIndex
+	);
+
 	/** Copy constructor.
 	 *
 	 *  @param ha HoppingAmplitude to copy. */
 	HoppingAmplitude(const HoppingAmplitude &ha);
 
+	/** Move constructor.
+	 *
+	 *  @param ha HoppingAmplitude to move. */
+	HoppingAmplitude(HoppingAmplitude &&ha) noexcept;
+
 	/** Constructor. Constructs the HoppingAmplitude from a serialization
 	 *  string.
 	 *
@@ -101,6 +184,20 @@ public:
 		Serializeable::Mode mode
 	);
 
+	/** Assignment operator.
+	 *
+	 *  @param rhs HoppingAmplitude to assign to the left hand side.
+	 *
+	 *  @return Reference to the assigned HoppingAmplitude. */
+	HoppingAmplitude& operator=(const HoppingAmplitude &rhs);
+
+	/** Move assignment operator.
+	 *
+	 *  @param rhs HoppingAmplitude to assign to the left hand side.
+	 *
+	 *  @return Reference to the assigned HoppingAmplitude. */
+	HoppingAmplitude& operator=(HoppingAmplitude &&rhs) noexcept;
+
 	/** Get the Hermitian cojugate of the HoppingAmplitude.
 	 *
 	 *  @return The Hermitian conjugate of the HoppingAmplitude. */
@@ -114,6 +211,20 @@ public:
 	 *  @return The value of the amplitude. */
 	std::complex<double> getAmplitude() const;
 
+	/** Get the AmplitudeCallback used to evaluate the amplitude.
+	 *
+	 *  @return Pointer to the AmplitudeCallback, or nullptr if the
+	 *  HoppingAmplitude does not use an AmplitudeCallback. */
+	const AmplitudeCallback* getAmplitudeCallback() const;
+
+	/** Get whether the amplitude is a constant value. The amplitude is
+	 *  not constant if it is evaluated using a callback function or an
+	 *  AmplitudeCallback, in which case it can change between calls to
+	 *  getAmplitude().
+	 *
+	 *  @return True if the amplitude is a constant value. */
+	bool getIsAmplitudeConstant() const;
+
 	/** Addition operator. Creates a tuple containing the HoppingAmplitude
 	 *  and its Hermitian conjugate. Used to allow the syntax<br>
 	 *  model << hoppingAmplitude + HC.
@@ -167,21 +278,43 @@ private:
 		const Index &fromIndex
 	);
 
+	/** AmplitudeCallback for runtime evaluation of amplitudes. Will be
+	 *  used if not NULL. */
+	const AmplitudeCallback *amplitudeCallbackObject;
+
 	/** Index to jump from (annihilate). */
 	Index fromIndex;
 
 	/** Index to jump to (create). */
 	Index toIndex;
 
+	/** HoppingAmplitudeTree serializes the HoppingAmplitudes in bulk on
+	 *  the Serializeable::Mode::Binary format. */
+	friend class HoppingAmplitudeTree;
 };
 
 inline std::complex<double> HoppingAmplitude::getAmplitude() const{
 	if(amplitudeCallback)
 		return amplitudeCallback(toIndex, fromIndex);
+	else if(amplitudeCallbackObject)
+		return amplitudeCallbackObject->getHoppingAmplitude(
+			toIndex,
+			fromIndex
+		);
 	else
 		return amplitude;
 }
 
+inline const HoppingAmplitude::AmplitudeCallback*
+HoppingAmplitude::getAmplitudeCallback() const{
+	return amplitudeCallbackObject;
+}
+
+inline bool HoppingAmplitude::getIsAmplitudeConstant() const{
+	return amplitudeCallback == nullptr
+		&& amplitudeCallbackObject == nullptr;
+}
+
 inline std::tuple<HoppingAmplitude, HoppingAmplitude> HoppingAmplitude::operator+(
 	HermitianConjugate hc
 ){
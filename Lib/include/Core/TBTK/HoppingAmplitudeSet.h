@@ -23,6 +23,7 @@
 #ifndef COM_DAFER45_TBTK_HOPPING_AMPLITUDE_SET
 #define COM_DAFER45_TBTK_HOPPING_AMPLITUDE_SET
 
+#include "TBTK/BasisIndexLookupTable.h"
 #include "TBTK/HoppingAmplitude.h"
 #include "TBTK/HoppingAmplitudeTree.h"
 #include "TBTK/IndexTree.h"
@@ -84,13 +85,31 @@ public:
 	 *  @param HoppingAmplitude to add. */
 	void addHoppingAmplitudeAndHermitianConjugate(HoppingAmplitude ha);
 
+	/** Add several @link HoppingAmplitude HoppingAmplitudes @endlink at
+	 *  once. See HoppingAmplitudeTree::add(std::vector<HoppingAmplitude>
+	 *  &hoppingAmplitudes).
+	 *
+	 *  @param hoppingAmplitudes HoppingAmplitudes to add. The vector is
+	 *  left empty. */
+	void addHoppingAmplitudes(
+		std::vector<HoppingAmplitude> &hoppingAmplitudes
+	);
+
+	/** Preallocate the tree structure. See
+	 *  HoppingAmplitudeTree::reserve().
+	 *
+	 *  @param capacity The 'Index capacity'. */
+	void reserve(const std::vector<unsigned int> &capacity);
+
 	/** Get all @link HoppingAmplitude HoppingAmplitudes @endlink with
 	 * given 'from'-index.
 	 *
 	 *  @param index 'From'-index to get HoppingAmplitudes for. */
 	const std::vector<HoppingAmplitude>* getHAs(Index index) const;
 
-	/** Get Hilbert space index corresponding to given 'from'-index.
+	/** Get Hilbert space index corresponding to given 'from'-index. Uses
+	 *  the BasisIndexLookupTable if possible and otherwise falls back on
+	 *  the HoppingAmplitudeTree.
 	 *
 	 *  @param index 'From'-index to get Hilbert space index for. */
 	int getBasisIndex(const Index &index) const;
@@ -98,6 +117,24 @@ public:
 	/** Get Physical index for given Hilbert space basis index. */
 	Index getPhysicalIndex(int basisIndex) const;
 
+	/** Set whether a BasisIndexLookupTable should be generated when the
+	 *  HoppingAmplitudeSet is constructed. The lookup table makes
+	 *  getBasisIndex() and getPhysicalIndex() constant time operations at
+	 *  the cost of additional memory. Enabled by default. If called after
+	 *  the HoppingAmplitudeSet has been constructed, the lookup table is
+	 *  generated or removed immediately.
+	 *
+	 *  @param useBasisIndexLookupTable Flag indicating whether the lookup
+	 *  table should be used. */
+	void setUseBasisIndexLookupTable(bool useBasisIndexLookupTable);
+
+	/** Get the BasisIndexLookupTable.
+	 *
+	 *  @return The BasisIndexLookupTable. The table is empty unless the
+	 *  HoppingAmplitudeSet has been constructed with the lookup table
+	 *  enabled. */
+	const BasisIndexLookupTable& getBasisIndexLookupTable() const;
+
 	/** Get size of Hilbert space. */
 	int getBasisSize() const;
 
@@ -139,9 +176,38 @@ public:
 	 *  reflect changes in the Hamiltonain due to changes in values
 	 *  returned by HoppingAmplitude-callback functions. The function is
 	 *  intended to be called by the Model whenever it is notified of
-	 *  possible changes in values returned by the callback-functions. */
+	 *  possible changes in values returned by the callback-functions.
+	 *  Since the sparsity pattern is unaffected by the callbacks, only the
+	 *  values are updated. */
 	void reconstructCOO();
 
+	/** Get the values of all @link HoppingAmplitude HoppingAmplitudes
+	 *  @endlink in the order in which they are visited by the Iterator.
+	 *  HoppingAmplitudes that use the same
+	 *  HoppingAmplitude::AmplitudeCallback are evaluated using a single
+	 *  call to HoppingAmplitude::AmplitudeCallback::getHoppingAmplitudes(),
+	 *  while HoppingAmplitudes that use a callback function are evaluated
+	 *  individually. The HoppingAmplitudeSet must be constructed.
+	 *
+	 *  @return The HoppingAmplitude values. */
+	std::vector<std::complex<double>> getAmplitudes() const;
+
+	/** Get the basis indices of the to-Indices of all @link
+	 *  HoppingAmplitude HoppingAmplitudes @endlink in the order in which
+	 *  they are visited by the Iterator. The HoppingAmplitudeSet must be
+	 *  constructed.
+	 *
+	 *  @return The basis indices of the to-Indices. */
+	const std::vector<int>& getToBasisIndices() const;
+
+	/** Get the basis indices of the from-Indices of all @link
+	 *  HoppingAmplitude HoppingAmplitudes @endlink in the order in which
+	 *  they are visited by the Iterator. The HoppingAmplitudeSet must be
+	 *  constructed.
+	 *
+	 *  @return The basis indices of the from-Indices. */
+	const std::vector<int>& getFromBasisIndices() const;
+
 	/** Get number of matrix elements in the Hamiltonian corresponding to
 	 *  the HoppingAmplitudeSet. Only used if COO format has been
 	 *  constructed. */
@@ -268,6 +334,14 @@ private:
 	 */
 	bool isSorted;
 
+	/** Flag indicating whether the basisIndexLookupTable should be
+	 *  generated when the HoppingAmplitudeSet is constructed. */
+	bool useBasisIndexLookupTable;
+
+	/** Flat lookup table used to accelerate conversion between physical
+	 *  and basis indices. */
+	BasisIndexLookupTable basisIndexLookupTable;
+
 	/** Number of matrix elements in HoppingAmplitudeSet. Is only used and
 	 *  if COO format has been constructed and is otherwise -1. */
 	int numMatrixElements;
@@ -280,6 +354,63 @@ private:
 
 	/** COO format values. */
 	std::complex<double> *cooValues;
+
+	/** Basis indices of the to-Indices of the HoppingAmplitudes in the
+	 *  order in which they are visited by the Iterator. */
+	std::vector<int> toBasisIndices;
+
+	/** Basis indices of the from-Indices of the HoppingAmplitudes in the
+	 *  order in which they are visited by the Iterator. */
+	std::vector<int> fromBasisIndices;
+
+	/** Amplitudes of the HoppingAmplitudes with constant amplitudes, in
+	 *  the order in which they are visited by the Iterator. Entries for
+	 *  HoppingAmplitudes that use a callback are zero. */
+	std::vector<std::complex<double>> constantAmplitudes;
+
+	/** HoppingAmplitudes that use a callback function rather than an
+	 *  AmplitudeCallback. These are evaluated individually each time the
+	 *  amplitudes are requested. */
+	std::vector<const HoppingAmplitude*> callbackFunctionAmplitudes;
+
+	/** Positions of the HoppingAmplitudes in callbackFunctionAmplitudes
+	 *  in the order in which they are visited by the Iterator. */
+	std::vector<unsigned int> callbackFunctionPositions;
+
+	/** HoppingAmplitudes that use the same AmplitudeCallback, on the
+	 *  form expected by
+	 *  HoppingAmplitude::AmplitudeCallback::getHoppingAmplitudes(). */
+	class AmplitudeBatch{
+	public:
+		/** The AmplitudeCallback. */
+		const HoppingAmplitude::AmplitudeCallback *callback;
+
+		/** Pointers to the to-Indices. */
+		std::vector<const Index*> toIndices;
+
+		/** Pointers to the from-Indices. */
+		std::vector<const Index*> fromIndices;
+
+		/** Basis indices of the to-Indices. */
+		std::vector<int> toBasisIndices;
+
+		/** Basis indices of the from-Indices. */
+		std::vector<int> fromBasisIndices;
+
+		/** Positions of the HoppingAmplitudes in the order in which
+		 *  they are visited by the Iterator. */
+		std::vector<unsigned int> positions;
+	};
+
+	/** One AmplitudeBatch per AmplitudeCallback. */
+	std::vector<AmplitudeBatch> amplitudeBatches;
+
+	/** Generate toBasisIndices, fromBasisIndices, constantAmplitudes,
+	 *  callbackFunctionAmplitudes, callbackFunctionPositions, and
+	 *  amplitudeBatches. The callback entries contain pointers into the
+	 *  HoppingAmplitudeTree and must be regenerated whenever the
+	 *  HoppingAmplitudes are moved or reordered. */
+	void generateAmplitudeBatches();
 };
 
 inline void HoppingAmplitudeSet::addHoppingAmplitude(HoppingAmplitude ha){
@@ -293,6 +424,18 @@ inline void HoppingAmplitudeSet::addHoppingAmplitudeAndHermitianConjugate(
 	hoppingAmplitudeTree.add(ha.getHermitianConjugate());
 }
 
+inline void HoppingAmplitudeSet::addHoppingAmplitudes(
+	std::vector<HoppingAmplitude> &hoppingAmplitudes
+){
+	hoppingAmplitudeTree.add(hoppingAmplitudes);
+}
+
+inline void HoppingAmplitudeSet::reserve(
+	const std::vector<unsigned int> &capacity
+){
+	hoppingAmplitudeTree.reserve(capacity);
+}
+
 inline const std::vector<HoppingAmplitude>* HoppingAmplitudeSet::getHAs(
 	Index index
 ) const{
@@ -300,13 +443,45 @@ inline const std::vector<HoppingAmplitude>* HoppingAmplitudeSet::getHAs(
 }
 
 inline int HoppingAmplitudeSet::getBasisIndex(const Index &index) const{
+	int basisIndex = basisIndexLookupTable.getBasisIndex(index);
+	if(basisIndex != -1)
+		return basisIndex;
+
 	return hoppingAmplitudeTree.getBasisIndex(index);
 }
 
 inline Index HoppingAmplitudeSet::getPhysicalIndex(int basisIndex) const{
+	if(basisIndexLookupTable.getIsGenerated()){
+		TBTKAssert(
+			basisIndex >= 0 && basisIndex < getBasisSize(),
+			"HoppingAmplitudeSet::getPhysicalIndex()",
+			"Hilbert space index out of bound.",
+			""
+		);
+
+		return basisIndexLookupTable.getPhysicalIndex(basisIndex);
+	}
+
 	return hoppingAmplitudeTree.getPhysicalIndex(basisIndex);
 }
 
+inline void HoppingAmplitudeSet::setUseBasisIndexLookupTable(
+	bool useBasisIndexLookupTable
+){
+	this->useBasisIndexLookupTable = useBasisIndexLookupTable;
+	if(isConstructed){
+		if(useBasisIndexLookupTable)
+			basisIndexLookupTable.generate(hoppingAmplitudeTree);
+		else
+			basisIndexLookupTable.clear();
+	}
+}
+
+inline const BasisIndexLookupTable&
+HoppingAmplitudeSet::getBasisIndexLookupTable() const{
+	return basisIndexLookupTable;
+}
+
 inline int HoppingAmplitudeSet::getBasisSize() const{
 	return hoppingAmplitudeTree.getBasisSize();
 }
@@ -328,7 +503,10 @@ inline void HoppingAmplitudeSet::construct(){
 	);
 
 	hoppingAmplitudeTree.generateBasisIndices();
+	if(useBasisIndexLookupTable)
+		basisIndexLookupTable.generate(hoppingAmplitudeTree);
 	isConstructed = true;
+	generateAmplitudeBatches();
 }
 
 inline bool HoppingAmplitudeSet::getIsConstructed() const{
@@ -364,9 +542,34 @@ inline void HoppingAmplitudeSet::sort(){
 	if(!isSorted){
 		hoppingAmplitudeTree.sort(&hoppingAmplitudeTree);
 		isSorted = true;
+		generateAmplitudeBatches();
 	}
 }
 
+inline const std::vector<int>& HoppingAmplitudeSet::getToBasisIndices(
+) const{
+	TBTKAssert(
+		isConstructed,
+		"HoppingAmplitudeSet::getToBasisIndices()",
+		"HoppingAmplitudeSet not constructed.",
+		"Use Model::construct() to construct the HoppingAmplitudeSet."
+	);
+
+	return toBasisIndices;
+}
+
+inline const std::vector<int>& HoppingAmplitudeSet::getFromBasisIndices(
+) const{
+	TBTKAssert(
+		isConstructed,
+		"HoppingAmplitudeSet::getFromBasisIndices()",
+		"HoppingAmplitudeSet not constructed.",
+		"Use Model::construct() to construct the HoppingAmplitudeSet."
+	);
+
+	return fromBasisIndices;
+}
+
 inline const int* HoppingAmplitudeSet::getCOORowIndices() const{
 	return cooRowIndices;
 }
@@ -382,6 +585,8 @@ inline const std::complex<double>* HoppingAmplitudeSet::getCOOValues() const{
 inline unsigned int HoppingAmplitudeSet::getSizeInBytes() const{
 	unsigned int size = sizeof(*this) - sizeof(hoppingAmplitudeTree);
 	size += hoppingAmplitudeTree.getSizeInBytes();
+	size += basisIndexLookupTable.getSizeInBytes()
+		- sizeof(basisIndexLookupTable);
 	if(numMatrixElements > 0){
 		size += numMatrixElements*(
 			sizeof(*cooRowIndices)
@@ -389,6 +594,20 @@ inline unsigned int HoppingAmplitudeSet::getSizeInBytes() const{
 			+ sizeof(*cooValues)
 		);
 	}
+	size += toBasisIndices.capacity()*sizeof(int);
+	size += fromBasisIndices.capacity()*sizeof(int);
+	size += constantAmplitudes.capacity()*sizeof(std::complex<double>);
+	size += callbackFunctionAmplitudes.capacity()*sizeof(
+		const HoppingAmplitude*
+	);
+	size += callbackFunctionPositions.capacity()*sizeof(unsigned int);
+	for(unsigned int n = 0; n < amplitudeBatches.size(); n++){
+		size += sizeof(AmplitudeBatch);
+		size += amplitudeBatches[n].positions.size()*(
+			2*sizeof(const Index*) + 2*sizeof(int)
+			+ sizeof(unsigned int)
+		);
+	}
 
 	return size;
 }
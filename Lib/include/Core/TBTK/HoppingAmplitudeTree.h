@@ -62,14 +62,70 @@ public:
 	 *  @param mode Mode with which the string has been serialized. */
 	HoppingAmplitudeTree(const std::string &serialization, Mode mode);
 
+	/** Copy constructor.
+	 *
+	 *  @param hoppingAmplitudeTree HoppingAmplitudeTree to copy. */
+	HoppingAmplitudeTree(
+		const HoppingAmplitudeTree &hoppingAmplitudeTree
+	) = default;
+
+	/** Move constructor.
+	 *
+	 *  @param hoppingAmplitudeTree HoppingAmplitudeTree to move. */
+	HoppingAmplitudeTree(
+		HoppingAmplitudeTree &&hoppingAmplitudeTree
+	) noexcept = default;
+
 	/** Destructor. */
 	virtual ~HoppingAmplitudeTree();
 
+	/** Assignment operator.
+	 *
+	 *  @param rhs HoppingAmplitudeTree to assign to the left hand side.
+	 *
+	 *  @return Reference to the assigned HoppingAmplitudeTree. */
+	HoppingAmplitudeTree& operator=(
+		const HoppingAmplitudeTree &rhs
+	) = default;
+
+	/** Move assignment operator.
+	 *
+	 *  @param rhs HoppingAmplitudeTree to assign to the left hand side.
+	 *
+	 *  @return Reference to the assigned HoppingAmplitudeTree. */
+	HoppingAmplitudeTree& operator=(
+		HoppingAmplitudeTree &&rhs
+	) noexcept = default;
+
 	/** Add a HoppingAmplitude.
 	 *
 	 *  @param ha HoppingAmplitude to add. */
 	void add(HoppingAmplitude ha);
 
+	/** Add several @link HoppingAmplitude HoppingAmplitudes @endlink at
+	 *  once. The HoppingAmplitudes are first sorted into buckets by the
+	 *  first subindex of their from-Index, after which the subtrees
+	 *  corresponding to different buckets are built in parallel. The
+	 *  result is identical to adding the HoppingAmplitudes one by one
+	 *  using HoppingAmplitudeTree::add().
+	 *
+	 *  @param hoppingAmplitudes The HoppingAmplitudes to add. The content
+	 *  of the vector is moved into the tree and the vector is left empty.
+	 */
+	void add(std::vector<HoppingAmplitude> &hoppingAmplitudes);
+
+	/** Preallocate the tree structure such that the addition of
+	 *  HoppingAmplitudes with indices that have the same subindex
+	 *  structure as 'capacity', but with smaller subindices, does not
+	 *  cause reallocation of the main tree structure. Has the same effect
+	 *  as constructing the tree using
+	 *  HoppingAmplitudeTree(const std::vector<unsigned int> &capacity),
+	 *  but can also be applied to a tree to which HoppingAmplitudes
+	 *  already have been added.
+	 *
+	 *  @param capacity The 'Index capacity'. */
+	void reserve(const std::vector<unsigned int> &capacity);
+
 	/** Get basis size.
 	 *
 	 *  @return The basis size if the basis has been generated using the
@@ -301,10 +357,31 @@ private:
 	 *  when a non-existing subspace is requested. */
 	static const HoppingAmplitudeTree emptyTree;
 
+	/** Flattened representation of the tree used for serialization on
+	 *  the Serializeable::Mode::Binary format. */
+	struct BinaryData;
+
+	/** Append the node and its children to the BinaryData in pre-order. Is
+	 *  called by HoppingAmplitudeTree::serialize() and is called
+	 *  recursively. */
+	void appendBinaryData(BinaryData &binaryData) const;
+
+	/** Read the node and its children from the BinaryData. Is called by
+	 *  the serialization constructor and is called recursively. */
+	void readBinaryData(BinaryData &binaryData);
+
 	/** Add HoppingAmplitude. Is called by the public
-	 *  HoppingAmplitudeTree::add and is called recursively. */
+	 *  HoppingAmplitudeTree::add and is called recursively. The
+	 *  HoppingAmplitude is moved into the tree. */
 	void add(HoppingAmplitude &ha, unsigned int subindex);
 
+	/** Reserve tree structure. Is called by the public
+	 *  HoppingAmplitudeTree::reserve() and is called recursively. */
+	void reserve(
+		const std::vector<unsigned int> &capacity,
+		unsigned int subindex
+	);
+
 	/** Get sub tree. Is called by HoppingAmplitudeTree::getSubTree and is
 	 *  called recursively. */
 	const HoppingAmplitudeTree* getSubTree(
@@ -26,6 +26,7 @@
 #include "TBTK/Serializeable.h"
 #include "TBTK/Streams.h"
 
+#include <stdexcept>
 #include <vector>
 
 namespace TBTK{
@@ -70,22 +71,30 @@ enum {
 class Index{
 public:
 	/** Constructs an empty Index. */
-	Index(){};
+	Index();
 
 	/** Constructs an Index from an initializer list.
 	 *
 	 * @param i Initializer list from which the Index is constructed. */
-	Index(std::initializer_list<int> i) : indices(i){};
+	Index(std::initializer_list<int> i);
 
 	/** Constructs an Index from an std::vector<int>.
 	 *
 	 *  @param i Vector from which the Index is constructed. */
-	Index(std::vector<int> i) : indices(i){};
+	Index(const std::vector<int> &i);
 
 	/** Copy constructor.
 	 *
 	 *  @param index Index to copy. */
-	Index(const Index &index) : indices(index.indices){};
+	Index(const Index &index);
+
+	/** Move constructor.
+	 *
+	 *  @param index Index to move. */
+	Index(Index &&index) noexcept;
+
+	/** Destructor. */
+	~Index();
 
 	/** Constructs a new Index by concatenating two indices into one total
 	 *  index of the form {head, tail}.
@@ -126,6 +135,20 @@ public:
 	 *  @param mode Mode with which the string has been serialized. */
 	Index(const std::string &serialization, Serializeable::Mode mode);
 
+	/** Assignment operator.
+	 *
+	 *  @param rhs Index to assign to the left hand side.
+	 *
+	 *  @return Reference to the assigned Index. */
+	Index& operator=(const Index &rhs);
+
+	/** Move assignment operator.
+	 *
+	 *  @param rhs Index to assign to the left hand side.
+	 *
+	 *  @return Reference to the assigned Index. */
+	Index& operator=(Index &&rhs) noexcept;
+
 	/** Compare this index with another index. Returns true if the indices
 	 *  have the same number of subindices and all subindices are equal.
 	 *
@@ -248,16 +271,173 @@ public:
 	 *  @return Memory size required to store the Index. */
 	unsigned int getSizeInBytes() const;
 private:
-	/** Subindex container. */
-	std::vector<int> indices;
+	/** Number of subindices that can be stored without allocating memory
+	 *  on the heap. Indices with more subindices than this falls back on
+	 *  heap allocated storage. */
+	static constexpr unsigned int STACK_CAPACITY = 8;
+
+	/** Pointer to the subindices. Points either to stackIndices or to a
+	 *  heap allocated array. */
+	int *indices;
+
+	/** Number of subindices. */
+	unsigned int size;
+
+	/** Number of subindices that fits in the storage pointed to by
+	 *  indices. */
+	unsigned int capacity;
+
+	/** Inline storage used for indices with at most STACK_CAPACITY
+	 *  subindices. */
+	int stackIndices[STACK_CAPACITY];
+
+	/** Returns true if the subindices are stored on the heap. */
+	bool isOnHeap() const;
+
+	/** Ensures that there is room for at least the given number of
+	 *  subindices, preserving the current subindices.
+	 *
+	 *  @param newCapacity Minimum number of subindices to make room for. */
+	void grow(unsigned int newCapacity);
+
+	/** Copies subindices into the Index, replacing the current content.
+	 *
+	 *  @param subindices Pointer to the subindices to copy.
+	 *  @param numSubindices Number of subindices to copy. */
+	void assign(const int *subindices, unsigned int numSubindices);
+
+	/** Takes over the storage of another Index, leaving the other Index
+	 *  empty. Assumes that this Index does not own any heap memory.
+	 *
+	 *  @param index Index to steal the storage from. */
+	void steal(Index &index) noexcept;
+
+	/** Throws std::out_of_range if n is not a valid subindex position. */
+	void checkRange(unsigned int n) const;
 };
 
+inline Index::Index() :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
+}
+
+inline Index::Index(std::initializer_list<int> i) :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
+	assign(i.begin(), i.size());
+}
+
+inline Index::Index(const std::vector<int> &i) :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
+	assign(i.data(), i.size());
+}
+
+inline Index::Index(const Index &index) :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
+	assign(index.indices, index.size);
+}
+
+inline Index::Index(Index &&index) noexcept :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
+	steal(index);
+}
+
+inline Index::~Index(){
+	if(isOnHeap())
+		delete [] indices;
+}
+
+inline Index& Index::operator=(const Index &rhs){
+	if(this != &rhs)
+		assign(rhs.indices, rhs.size);
+
+	return *this;
+}
+
+inline Index& Index::operator=(Index &&rhs) noexcept{
+	if(this != &rhs){
+		if(isOnHeap())
+			delete [] indices;
+		indices = stackIndices;
+		size = 0;
+		capacity = STACK_CAPACITY;
+		steal(rhs);
+	}
+
+	return *this;
+}
+
+inline bool Index::isOnHeap() const{
+	return indices != stackIndices;
+}
+
+inline void Index::grow(unsigned int newCapacity){
+	if(newCapacity <= capacity)
+		return;
+
+	if(newCapacity < 2*capacity)
+		newCapacity = 2*capacity;
+
+	int *newIndices = new int[newCapacity];
+	for(unsigned int n = 0; n < size; n++)
+		newIndices[n] = indices[n];
+
+	if(isOnHeap())
+		delete [] indices;
+
+	indices = newIndices;
+	capacity = newCapacity;
+}
+
+inline void Index::assign(const int *subindices, unsigned int numSubindices){
+	size = 0;
+	grow(numSubindices);
+	for(unsigned int n = 0; n < numSubindices; n++)
+		indices[n] = subindices[n];
+	size = numSubindices;
+}
+
+inline void Index::steal(Index &index) noexcept{
+	if(index.isOnHeap()){
+		indices = index.indices;
+		size = index.size;
+		capacity = index.capacity;
+
+		index.indices = index.stackIndices;
+		index.capacity = STACK_CAPACITY;
+	}
+	else{
+		for(unsigned int n = 0; n < index.size; n++)
+			indices[n] = index.indices[n];
+		size = index.size;
+	}
+	index.size = 0;
+}
+
+inline void Index::checkRange(unsigned int n) const{
+	if(n >= size)
+		throw std::out_of_range("Index::at()");
+}
+
 inline void Index::print() const{
 	Streams::out << "{";
-	for(unsigned int n = 0; n < indices.size(); n++){
+	for(unsigned int n = 0; n < size; n++){
 		if(n != 0)
 			Streams::out << ", ";
-		Streams::out << indices.at(n);
+		Streams::out << indices[n];
 	}
 	Streams::out << "}\n";
 }
@@ -265,10 +445,10 @@ inline void Index::print() const{
 inline std::string Index::toString() const{
 	std::string str = "{";
 	bool isFirstIndex = true;
-	for(unsigned int n = 0; n < indices.size(); n++){
+	for(unsigned int n = 0; n < size; n++){
 /*		if(n != 0)
 			str += ", ";*/
-		int subindex = indices.at(n);
+		int subindex = indices[n];
 		if(!isFirstIndex && subindex != IDX_SEPARATOR)
 			str += ", ";
 		else
@@ -307,15 +487,15 @@ inline std::string Index::toString() const{
 }
 
 inline bool Index::equals(const Index &index, bool allowWildcard) const{
-	if(indices.size() == index.indices.size()){
-		for(unsigned int n = 0; n < indices.size(); n++){
-			if(indices.at(n) != index.indices.at(n)){
+	if(size == index.size){
+		for(unsigned int n = 0; n < size; n++){
+			if(indices[n] != index.indices[n]){
 				if(!allowWildcard)
 					return false;
 				else{
 					if(
-						indices.at(n) == IDX_ALL ||
-						index.indices.at(n) == IDX_ALL
+						indices[n] == IDX_ALL ||
+						index.indices[n] == IDX_ALL
 					)
 						continue;
 					else
@@ -332,42 +512,50 @@ inline bool Index::equals(const Index &index, bool allowWildcard) const{
 }
 
 inline int& Index::at(unsigned int n){
-	return indices.at(n);
+	checkRange(n);
+
+	return indices[n];
 }
 
 inline const int& Index::at(unsigned int n) const{
-	return indices.at(n);
+	checkRange(n);
+
+	return indices[n];
 }
 
 inline unsigned int Index::getSize() const{
-	return indices.size();
+	return size;
 }
 
 inline void Index::reserve(unsigned int size){
-	indices.reserve(size);
+	grow(size);
 }
 
 inline void Index::push_back(int subindex){
-	indices.push_back(subindex);
+	if(size == capacity)
+		grow(size + 1);
+	indices[size++] = subindex;
 }
 
 inline int Index::popFront(){
-	int first = indices.at(0);
-	indices.erase(indices.begin());
+	int first = at(0);
+	for(unsigned int n = 1; n < size; n++)
+		indices[n-1] = indices[n];
+	size--;
 
 	return first;
 }
 
 inline int Index::popBack(){
-	int last = indices.back();
-	indices.pop_back();
+	int last = indices[size-1];
+	size--;
 
 	return last;
 }
 
 inline bool Index::isPatternIndex() const{
-	for(unsigned int n = 0; n < indices.size(); n++)
-		if(indices.at(n) < 0)
+	for(unsigned int n = 0; n < size; n++)
+		if(indices[n] < 0)
 			return true;
 
 	return false;
@@ -382,7 +570,10 @@ inline const int& Index::operator[](unsigned int subindex) const{
 }
 
 inline unsigned int Index::getSizeInBytes() const{
-	return sizeof(*this) + sizeof(int)*indices.capacity();
+	if(isOnHeap())
+		return sizeof(*this) + sizeof(int)*capacity;
+	else
+		return sizeof(*this);
 }
 
 };	//End of namespace TBTK
@@ -76,6 +76,15 @@ public:
 	/** Generate a list of indices satisfying the specified pattern. */
 	std::vector<Index> getIndexList(const Index &pattern) const;
 
+	/** Compare the IndexTree with another IndexTree. Two IndexTrees are
+	 *  equal if they contain the same Indices and map them to the same
+	 *  linear indices.
+	 *
+	 *  @param indexTree The IndexTree to compare with.
+	 *
+	 *  @return True if the IndexTrees are equal. */
+	bool equals(const IndexTree &indexTree) const;
+
 	/** Iterator for iterating through @link Index Indices @link stored in
 	 *  the tree structure. */
 	class Iterator{
@@ -185,6 +194,18 @@ private:
 
 	/** Get maximum linear index of IndexTree. */
 	int getMaxIndex() const;
+
+	/** Flattened representation of the tree used for serialization on
+	 *  the Serializeable::Mode::Binary format. */
+	struct BinaryData;
+
+	/** Append the node and its children to the BinaryData in pre-order. Is
+	 *  called by IndexTree::serialize() and is called recursively. */
+	void appendBinaryData(BinaryData &binaryData) const;
+
+	/** Read the node and its children from the BinaryData. Is called by
+	 *  the serialization constructor and is called recursively. */
+	void readBinaryData(BinaryData &binaryData);
 };
 
 inline int IndexTree::getSize() const{
@@ -31,11 +31,13 @@
 #include "TBTK/IndexBasedHoppingAmplitudeFilter.h"
 #include "TBTK/SingleParticleContext.h"
 #include "TBTK/ManyBodyContext.h"
+#include "TBTK/ParameterizedHamiltonian.h"
 #include "TBTK/Serializeable.h"
 #include "TBTK/Statistics.h"
 
 #include <complex>
 #include <fstream>
+#include <functional>
 #include <string>
 #include <tuple>
 
@@ -56,7 +58,10 @@ public:
 	/** Constructor. */
 	Model(const std::vector<unsigned int> &capacity);
 
-	/** Copy constructor. */
+	/** Copy constructor. Models that contain @link
+	 *  ParameterizedHamiltonian ParameterizedHamiltonians @endlink can
+	 *  not be copied, since the ParameterizedHamiltonian is shared with
+	 *  the original Model but keeps a lookup table for a single Model. */
 	Model(const Model &model);
 
 	/** Move constructor. */
@@ -69,7 +74,9 @@ public:
 	/** Destructor. */
 	virtual ~Model();
 
-	/** Assignment operator. */
+	/** Assignment operator. Models that contain @link
+	 *  ParameterizedHamiltonian ParameterizedHamiltonians @endlink can
+	 *  not be assigned. See the copy constructor. */
 	Model& operator=(const Model &model);
 
 	/** Move assignment operator. */
@@ -81,6 +88,47 @@ public:
 	/** Add a HoppingAmplitude and its Hermitian conjugate. */
 	void addHoppingAmplitudeAndHermitianConjugate(HoppingAmplitude ha);
 
+	/** Add several HoppingAmplitudes at once. The HoppingAmplitudes are
+	 *  passed through the filter (if any) and are then inserted into the
+	 *  HoppingAmplitudeSet using a parallel sort followed by a parallel
+	 *  construction of the tree structure. This is considerably faster
+	 *  than adding the HoppingAmplitudes one by one for large models.
+	 *
+	 *  @param hoppingAmplitudes HoppingAmplitudes to add. The vector is
+	 *  left empty. */
+	void addHoppingAmplitudes(
+		std::vector<HoppingAmplitude> &hoppingAmplitudes
+	);
+
+	/** Add HoppingAmplitudes produced by a generator. The generator is
+	 *  called once for each partition in [0, numPartitions), possibly in
+	 *  parallel, and is expected to append the HoppingAmplitudes of the
+	 *  given partition to the vector that is passed to it. The generator
+	 *  therefore has to be thread safe. A natural choice of partitions is
+	 *  the range of the first subindex, for example the x-coordinate.
+	 *
+	 *  @param numPartitions Number of partitions.
+	 *  @param generator Function that generates the HoppingAmplitudes for
+	 *  a given partition. */
+	void addHoppingAmplitudes(
+		unsigned int numPartitions,
+		std::function<void(
+			unsigned int partition,
+			std::vector<HoppingAmplitude> &hoppingAmplitudes
+		)> generator
+	);
+
+	/** Preallocate the tree structure used to store the HoppingAmplitudes
+	 *  such that the addition of HoppingAmplitudes with indices that have
+	 *  the same subindex structure as 'capacity', but with smaller
+	 *  subindices, does not cause reallocation of the tree structure.
+	 *  Equivalent to using the constructor Model(const
+	 *  std::vector<unsigned int> &capacity), but can be called at any
+	 *  time before Model::construct().
+	 *
+	 *  @param capacity The 'Index capacity'. */
+	void reserve(const std::vector<unsigned int> &capacity);
+
 	/** Add a Model as a subsystem. */
 	void addModel(const Model &model, const Index &subsytemIndex);
 
@@ -170,6 +218,13 @@ public:
 		const std::tuple<HoppingAmplitude, HoppingAmplitude> &hoppingAmplitudes
 	);
 
+	/** Operator<<. Adds one HoppingAmplitude for each matrix element in
+	 *  the ParameterizedHamiltonian, using the ParameterizedHamiltonian as
+	 *  HoppingAmplitude::AmplitudeCallback. The ParameterizedHamiltonian
+	 *  can not be extended afterwards and must outlive the Model, which
+	 *  can no longer be copied. */
+	Model& operator<<(ParameterizedHamiltonian &parameterizedHamiltonian);
+
 	/** Implements Serializeable::serialize(). Note that the
 	 *  ManyBodyContext is not yet serialized. */
 	std::string serialize(Mode mode) const;
@@ -189,6 +244,11 @@ private:
 	/** Hopping amplitude filter. */
 	AbstractHoppingAmplitudeFilter *hoppingAmplitudeFilter;
 
+	/** @link ParameterizedHamiltonian ParameterizedHamiltonians @endlink
+	 *  that have been added to the Model. Their lookup tables are
+	 *  generated when the Model is constructed. */
+	std::vector<ParameterizedHamiltonian*> parameterizedHamiltonians;
+
 	/** FileReader is a friend class to allow it to write Model data. */
 	friend class FileReader;
 };
@@ -203,6 +263,10 @@ inline void Model::addHoppingAmplitudeAndHermitianConjugate(
 	singleParticleContext->addHoppingAmplitudeAndHermitianConjugate(ha);
 }
 
+inline void Model::reserve(const std::vector<unsigned int> &capacity){
+	singleParticleContext->reserve(capacity);
+}
+
 inline int Model::getBasisSize() const{
 	return singleParticleContext->getBasisSize();
 }
@@ -0,0 +1,343 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @package TBTKcalc
+ *  @file ParameterizedHamiltonian.h
+ *  @brief Hamiltonian on the form H = H_0 + sum_i lambda_i H_i.
+ *
+ *  @author Kristofer Björnson
+ */
+
+#ifndef COM_DAFER45_TBTK_PARAMETERIZED_HAMILTONIAN
+#define COM_DAFER45_TBTK_PARAMETERIZED_HAMILTONIAN
+
+#include "TBTK/HoppingAmplitude.h"
+#include "TBTK/Index.h"
+
+#include <complex>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace TBTK{
+
+class HoppingAmplitudeSet;
+
+/** @brief Hamiltonian on the form
+ *  \f$H = H_0 + \sum_{i}\lambda_{i}H_{i}\f$.
+ *
+ *  The ParameterizedHamiltonian stores a constant base term \f$H_0\f$ and a
+ *  number of named terms \f$H_i\f$ that are scaled by parameters
+ *  \f$\lambda_i\f$. All terms share a common set of matrix elements, and
+ *  the matrix element values are stored in flat arrays. Changing the
+ *  parameters therefore only requires the current values to be recalculated
+ *  as a sequence of AXPY operations, which makes it suitable for parameter
+ *  sweeps.
+ *
+ *  The ParameterizedHamiltonian is added to a Model using
+ *  Model::operator<<(), which adds one HoppingAmplitude per matrix element
+ *  that uses the ParameterizedHamiltonian as its
+ *  HoppingAmplitude::AmplitudeCallback. After the parameters have been
+ *  updated, solvers pick up the new values the next time they evaluate the
+ *  HoppingAmplitudes, without the Model having to be reconstructed. The
+ *  ParameterizedHamiltonian must therefore outlive the Model.
+ *
+ *  The values are calculated using the amplitudes of the HoppingAmplitudes
+ *  at the time they are added. The ParameterizedHamiltonian can not be
+ *  extended after it has been added to a Model. */
+class ParameterizedHamiltonian : public HoppingAmplitude::AmplitudeCallback{
+public:
+	/** Constructor. */
+	ParameterizedHamiltonian();
+
+	/** Add a parameter.
+	 *
+	 *  @param name The name of the parameter.
+	 *  @param value The initial value of the parameter. */
+	void addParameter(
+		const std::string &name,
+		std::complex<double> value = 0
+	);
+
+	/** Add a HoppingAmplitude to the base term \f$H_0\f$.
+	 *
+	 *  @param hoppingAmplitude The HoppingAmplitude to add. */
+	void add(const HoppingAmplitude &hoppingAmplitude);
+
+	/** Add a HoppingAmplitude and its Hermitian conjugate to the base
+	 *  term \f$H_0\f$.
+	 *
+	 *  @param hoppingAmplitudes Tuple containing the HoppingAmplitude and
+	 *  its Hermitian conjugate. */
+	void add(
+		const std::tuple<HoppingAmplitude, HoppingAmplitude>
+			&hoppingAmplitudes
+	);
+
+	/** Add a HoppingAmplitude to the term \f$H_i\f$ that is scaled by the
+	 *  given parameter.
+	 *
+	 *  @param parameterName The name of the parameter that scales the
+	 *  term.
+	 *
+	 *  @param hoppingAmplitude The HoppingAmplitude to add. */
+	void add(
+		const std::string &parameterName,
+		const HoppingAmplitude &hoppingAmplitude
+	);
+
+	/** Add a HoppingAmplitude and its Hermitian conjugate to the term
+	 *  \f$H_i\f$ that is scaled by the given parameter. The Hermitian
+	 *  conjugate is scaled by the complex conjugate of the parameter,
+	 *  such that the Hamiltonian remains Hermitian also for complex
+	 *  parameter values.
+	 *
+	 *  @param parameterName The name of the parameter that scales the
+	 *  term.
+	 *
+	 *  @param hoppingAmplitudes Tuple containing the HoppingAmplitude and
+	 *  its Hermitian conjugate. */
+	void add(
+		const std::string &parameterName,
+		const std::tuple<HoppingAmplitude, HoppingAmplitude>
+			&hoppingAmplitudes
+	);
+
+	/** Set the value of a parameter.
+	 *
+	 *  @param name The name of the parameter.
+	 *  @param value The new value of the parameter. */
+	void setParameter(const std::string &name, std::complex<double> value);
+
+	/** Set the value of all parameters at once. Avoids recalculating the
+	 *  matrix element values more than once when several parameters
+	 *  change.
+	 *
+	 *  @param values The new parameter values, in the order in which the
+	 *  parameters were added. */
+	void setParameters(const std::vector<std::complex<double>> &values);
+
+	/** Get the value of a parameter.
+	 *
+	 *  @param name The name of the parameter.
+	 *
+	 *  @return The value of the parameter. */
+	std::complex<double> getParameter(const std::string &name) const;
+
+	/** Get the number of matrix elements.
+	 *
+	 *  @return The number of matrix elements. */
+	unsigned int getNumMatrixElements() const;
+
+	/** Get the to-Index of a matrix element.
+	 *
+	 *  @param matrixElement The matrix element.
+	 *
+	 *  @return The to-Index of the matrix element. */
+	const Index& getToIndex(unsigned int matrixElement) const;
+
+	/** Get the from-Index of a matrix element.
+	 *
+	 *  @param matrixElement The matrix element.
+	 *
+	 *  @return The from-Index of the matrix element. */
+	const Index& getFromIndex(unsigned int matrixElement) const;
+
+	/** Get the current value of a matrix element.
+	 *
+	 *  @param matrixElement The matrix element.
+	 *
+	 *  @return The value of the matrix element for the current parameter
+	 *  values. */
+	std::complex<double> getValue(unsigned int matrixElement) const;
+
+	/** Mark the ParameterizedHamiltonian as added to a Model. Called by
+	 *  Model::operator<<(). */
+	void lock();
+
+	/** Generate a lookup table from the basis indices of the matrix
+	 *  elements in the given HoppingAmplitudeSet to the matrix elements.
+	 *  Called by Model::construct(). The lookup table is only read by
+	 *  getHoppingAmplitudes(), which therefore can be called from
+	 *  several threads at once.
+	 *
+	 *  @param hoppingAmplitudeSet A constructed HoppingAmplitudeSet that
+	 *  contains the matrix elements of the ParameterizedHamiltonian. */
+	void generateLookupTable(
+		const HoppingAmplitudeSet &hoppingAmplitudeSet
+	);
+
+	/** Implements HoppingAmplitude::AmplitudeCallback::getHoppingAmplitude().
+	 *  Requires a lookup of the matrix element and is mainly intended for
+	 *  occasional access. */
+	virtual std::complex<double> getHoppingAmplitude(
+		const Index &toIndex,
+		const Index &fromIndex
+	) const;
+
+	/** Implements
+	 *  HoppingAmplitude::AmplitudeCallback::getHoppingAmplitudes(). The
+	 *  matrix elements are found through the lookup table generated by
+	 *  generateLookupTable(), falling back on a search by Index for
+	 *  amplitudes that are not covered by the lookup table. */
+	virtual void getHoppingAmplitudes(
+		unsigned int numAmplitudes,
+		const Index *const *toIndices,
+		const Index *const *fromIndices,
+		const int *toBasisIndices,
+		const int *fromBasisIndices,
+		std::complex<double> *amplitudes
+	) const;
+private:
+	/** Parameter names. */
+	std::vector<std::string> parameterNames;
+
+	/** Parameter values. */
+	std::vector<std::complex<double>> parameterValues;
+
+	/** Map from matrix element key to matrix element. */
+	std::map<std::vector<int>, unsigned int> matrixElementMap;
+
+	/** To-Indices of the matrix elements. */
+	std::vector<Index> toIndices;
+
+	/** From-Indices of the matrix elements. */
+	std::vector<Index> fromIndices;
+
+	/** Values of the base term \f$H_0\f$ for each matrix element. */
+	std::vector<std::complex<double>> baseValues;
+
+	/** Matrix elements of the terms \f$H_i\f$. One entry for each
+	 *  parameter. */
+	std::vector<std::vector<unsigned int>> termMatrixElements;
+
+	/** Values of the terms \f$H_i\f$. One entry for each parameter. */
+	std::vector<std::vector<std::complex<double>>> termValues;
+
+	/** Matrix elements of the Hermitian conjugate parts of the terms
+	 *  \f$H_i\f$, which are scaled by \f$\lambda_i^{*}\f$. One entry for
+	 *  each parameter. */
+	std::vector<std::vector<unsigned int>> conjugateTermMatrixElements;
+
+	/** Values of the Hermitian conjugate parts of the terms \f$H_i\f$.
+	 *  One entry for each parameter. */
+	std::vector<std::vector<std::complex<double>>> conjugateTermValues;
+
+	/** Current values of the matrix elements. */
+	std::vector<std::complex<double>> values;
+
+	/** Flag indicating whether the ParameterizedHamiltonian has been added
+	 *  to a Model. */
+	bool isLocked;
+
+	/** Offsets into lookupTableToBasisIndices and
+	 *  lookupTableMatrixElements for each from-basis index. Empty until
+	 *  generateLookupTable() has been called. */
+	std::vector<unsigned int> lookupTableOffsets;
+
+	/** To-basis indices of the matrix elements, sorted for each
+	 *  from-basis index. */
+	std::vector<int> lookupTableToBasisIndices;
+
+	/** Matrix elements corresponding to the entries in
+	 *  lookupTableToBasisIndices. */
+	std::vector<unsigned int> lookupTableMatrixElements;
+
+	/** Get the key used to identify a matrix element. */
+	static std::vector<int> getKey(
+		const Index &toIndex,
+		const Index &fromIndex
+	);
+
+	/** Get the matrix element for the given Indices, creating it if it
+	 *  does not exist. */
+	unsigned int getOrCreateMatrixElement(
+		const Index &toIndex,
+		const Index &fromIndex
+	);
+
+	/** Add a HoppingAmplitude to the Hermitian conjugate part of the
+	 *  term \f$H_i\f$ that is scaled by the given parameter. */
+	void addConjugate(
+		const std::string &parameterName,
+		const HoppingAmplitude &hoppingAmplitude
+	);
+
+	/** Find the matrix element for the given Indices using
+	 *  matrixElementMap. */
+	unsigned int findMatrixElement(
+		const Index &toIndex,
+		const Index &fromIndex
+	) const;
+
+	/** Get the parameter number for the given parameter name. */
+	unsigned int getParameterID(const std::string &name) const;
+
+	/** Recalculate the matrix element values from the current parameter
+	 *  values. */
+	void update();
+};
+
+inline void ParameterizedHamiltonian::add(
+	const std::tuple<HoppingAmplitude, HoppingAmplitude> &hoppingAmplitudes
+){
+	add(std::get<0>(hoppingAmplitudes));
+	add(std::get<1>(hoppingAmplitudes));
+}
+
+inline void ParameterizedHamiltonian::add(
+	const std::string &parameterName,
+	const std::tuple<HoppingAmplitude, HoppingAmplitude> &hoppingAmplitudes
+){
+	add(parameterName, std::get<0>(hoppingAmplitudes));
+	addConjugate(parameterName, std::get<1>(hoppingAmplitudes));
+}
+
+inline std::complex<double> ParameterizedHamiltonian::getParameter(
+	const std::string &name
+) const{
+	return parameterValues[getParameterID(name)];
+}
+
+inline unsigned int ParameterizedHamiltonian::getNumMatrixElements() const{
+	return values.size();
+}
+
+inline const Index& ParameterizedHamiltonian::getToIndex(
+	unsigned int matrixElement
+) const{
+	return toIndices[matrixElement];
+}
+
+inline const Index& ParameterizedHamiltonian::getFromIndex(
+	unsigned int matrixElement
+) const{
+	return fromIndices[matrixElement];
+}
+
+inline std::complex<double> ParameterizedHamiltonian::getValue(
+	unsigned int matrixElement
+) const{
+	return values[matrixElement];
+}
+
+inline void ParameterizedHamiltonian::lock(){
+	isLocked = true;
+}
+
+};	//End of namespace TBTK
+
+#endif
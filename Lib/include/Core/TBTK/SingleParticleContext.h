@@ -76,6 +76,16 @@ public:
 	/** Add a HoppingAmplitude and its Hermitian conjugate. */
 	void addHoppingAmplitudeAndHermitianConjugate(HoppingAmplitude ha);
 
+	/** Add several HoppingAmplitudes at once. The vector is left empty.
+	 */
+	void addHoppingAmplitudes(
+		std::vector<HoppingAmplitude> &hoppingAmplitudes
+	);
+
+	/** Preallocate the tree structure used to store the
+	 *  HoppingAmplitudes. */
+	void reserve(const std::vector<unsigned int> &capacity);
+
 	/** Get Hilbert space index corresponding to given 'from'-index.
 	 *  @param index 'from'-index to get Hilbert space index for. */
 	int getBasisIndex(const Index &index) const;
@@ -150,6 +160,18 @@ inline void SingleParticleContext::addHoppingAmplitudeAndHermitianConjugate(
 	hoppingAmplitudeSet->addHoppingAmplitudeAndHermitianConjugate(ha);
 }
 
+inline void SingleParticleContext::addHoppingAmplitudes(
+	std::vector<HoppingAmplitude> &hoppingAmplitudes
+){
+	hoppingAmplitudeSet->addHoppingAmplitudes(hoppingAmplitudes);
+}
+
+inline void SingleParticleContext::reserve(
+	const std::vector<unsigned int> &capacity
+){
+	hoppingAmplitudeSet->reserve(capacity);
+}
+
 inline int SingleParticleContext::getBasisIndex(const Index &index) const{
 	return hoppingAmplitudeSet->getBasisIndex(index);
 }
@@ -25,7 +25,11 @@
 
 #include "TBTK/Serializeable.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace TBTK{
@@ -48,7 +52,8 @@ public:
 	 *  string. */
 	DataManager(const std::string &serialization, Mode mode);
 
-	/** Destructor. */
+	/** Destructor. Waits for pending writes to finish. Write errors that
+	 *  have not been reported by flush() are printed to Streams::err. */
 	virtual ~DataManager();
 
 	/** Assignment operator. */
@@ -78,7 +83,8 @@ public:
 	enum class FileType {
 		Custom,
 		SerializeableJSON,
-		PNG
+		PNG,
+		SerializeableBinary
 	};
 
 	/** Add a data type to manage. */
@@ -99,6 +105,45 @@ public:
 	/** Reserve a data point. */
 	int reserveDataPoint(const std::string &dataTypes = "");
 
+	/** Set whether reservations should be shared between processes
+	 *  through lock files. When enabled, a data point is reserved by
+	 *  exclusively creating a lock file next to the output file, and a
+	 *  completion marker is created when the data point is completed. This
+	 *  allows independent processes, possibly on different nodes that
+	 *  share the output path, to work on the same parameter sweep. The
+	 *  lock files of a process that crashes expire after the lease time,
+	 *  after which the data point can be reserved by another process.
+	 *
+	 *  @param useFileReservations True to share reservations through the
+	 *  file system. */
+	void setUseFileReservations(bool useFileReservations);
+
+	/** Get whether reservations are shared through the file system.
+	 *
+	 *  @return True if lock files are used. */
+	bool getUseFileReservations() const;
+
+	/** Set the lease time for file reservations. A reservation that has
+	 *  not been renewed for longer than the lease time is considered to
+	 *  belong to a crashed process. The clocks of the participating nodes
+	 *  are assumed to be synchronized to well within the lease time.
+	 *
+	 *  @param leaseTime The lease time in seconds. */
+	void setLeaseTime(unsigned int leaseTime);
+
+	/** Get the lease time for file reservations.
+	 *
+	 *  @return The lease time in seconds. */
+	unsigned int getLeaseTime() const;
+
+	/** Renew the lease of a file reservation. Calculations that can take
+	 *  longer than the lease time should call this function periodically.
+	 *
+	 *  @param dataType The data type of the reservation. An empty string
+	 *  renews the reservations for all data types.
+	 *  @param id The ID of the reserved data point. */
+	void renewReservation(const std::string &dataType, int id);
+
 	/** Get parameter for a given ID. */
 	std::vector<double> getParameters(int id) const;
 
@@ -118,13 +163,55 @@ public:
 		int id
 	);
 
-	/** Complete save a Serializeable result and mark it as completed. */
+	/** Complete save a Serializeable result and mark it as completed.
+	 *
+	 *  The Serializeable is serialized on the calling thread, while the
+	 *  file is written by a background writer thread. The result is first
+	 *  written to a temporary file which is renamed once the write has
+	 *  finished, which means that a file with the final filename always
+	 *  is complete. The data point is marked completed when the file has
+	 *  been renamed. If the number of pending writes reaches the maximum
+	 *  queue size, the call blocks until a write has finished. If a
+	 *  previous write has failed, the error is reported here instead of
+	 *  on the writer thread. */
 	void complete(
 		const Serializeable &serializeable,
 		const std::string &dataType,
 		int id
 	);
 
+	/** Set the maximum number of results that can wait to be written by
+	 *  the background writer thread before DataManager::complete()
+	 *  blocks.
+	 *
+	 *  @param maxQueueSize The maximum number of pending writes. */
+	void setMaxQueueSize(unsigned int maxQueueSize);
+
+	/** Block until all results passed to DataManager::complete() have
+	 *  been written and marked completed. Reports the first error that
+	 *  occured on the writer thread. */
+	void flush();
+
+	/** Set whether completed data points should be recorded in an append
+	 *  only journal. When the journal is used, each completion appends a
+	 *  single line to the journal file instead of the completion table
+	 *  being stored in the serialization of the DataManager. The journal
+	 *  is replayed when the DataManager is reconstructed from its
+	 *  serialization.
+	 *
+	 *  @param useJournal True to record completions in the journal. */
+	void setUseJournal(bool useJournal);
+
+	/** Get whether completed data points are recorded in the journal.
+	 *
+	 *  @return True if the journal is used. */
+	bool getUseJournal() const;
+
+	/** Get the name of the journal file.
+	 *
+	 *  @return The path to the file that completions are appended to. */
+	std::string getJournalFilename() const;
+
 	/** Implements Serializeable::serialize(). */
 	virtual std::string serialize(Mode mode) const;
 private:
@@ -161,6 +248,130 @@ private:
 	/** Table of data points that have been completed. */
 	std::vector<bool*> completedDataPoints;
 
+	/** Flag indicating whether completions are recorded in the journal.
+	 */
+	bool useJournal;
+
+	/** Flag indicating whether reservations are shared through lock
+	 *  files. */
+	bool useFileReservations;
+
+	/** Lease time in seconds for file reservations. */
+	unsigned int leaseTime;
+
+	/** A result waiting to be written by the writer thread. */
+	class WriteRequest{
+	public:
+		/** Name of the file to write to. */
+		std::string filename;
+
+		/** The data to write. */
+		std::string data;
+
+		/** Data type of the data point. Stored by name, since the
+		 *  writer thread does not hold the lock that protects
+		 *  DataManager::dataTypes. */
+		std::string dataType;
+
+		/** File name prefix of the reservation files of the data
+		 *  point. */
+		std::string reservationFilename;
+
+		/** Data type index of the data point. */
+		unsigned int dataTypeIndex;
+
+		/** ID of the data point. */
+		unsigned int id;
+	};
+
+	/** Results waiting to be written. */
+	std::deque<WriteRequest> writeQueue;
+
+	/** Number of results that are queued or currently being written. */
+	unsigned int numPendingWrites;
+
+	/** Maximum number of pending writes. */
+	unsigned int maxQueueSize;
+
+	/** Flag telling the writer thread to terminate. */
+	bool stopWriter;
+
+	/** The first error that occured on the writer thread. Empty if no
+	 *  error has occured. */
+	std::string writeError;
+
+	/** Background thread that writes results. */
+	std::thread writerThread;
+
+	/** Protects the data tables and the write queue. */
+	mutable std::mutex mutex;
+
+	/** Serializes appends to the journal, which are performed without
+	 *  holding DataManager::mutex. */
+	std::mutex journalMutex;
+
+	/** Signaled when a write request is added to the queue, or when the
+	 *  writer thread should terminate. */
+	std::condition_variable writeRequested;
+
+	/** Signaled when a write has finished. */
+	std::condition_variable writeFinished;
+
+	/** Main loop of the writer thread. */
+	void runWriter();
+
+	/** Write data to a file by first writing to a temporary file and then
+	 *  renaming it. Returns an error message, or an empty string on
+	 *  success. */
+	static std::string writeAtomically(
+		const std::string &filename,
+		const std::string &data
+	);
+
+	/** Record the completion of a data point in the journal and through
+	 *  the completion marker. Performs file I/O only and is called
+	 *  without holding DataManager::mutex. Returns an error message, or
+	 *  an empty string on success. */
+	std::string recordCompletion(
+		const std::string &dataType,
+		const std::string &reservationFilename,
+		unsigned int id,
+		bool useJournal,
+		bool useFileReservations
+	);
+
+	/** Append a completed data point to the journal. Returns an error
+	 *  message, or an empty string on success. */
+	std::string appendToJournal(const std::string &dataType, unsigned int id);
+
+	/** Read the journal and mark the recorded data points completed. */
+	void replayJournal();
+
+	/** Try to reserve a data point by creating its lock file. Returns
+	 *  false if the data point is reserved or completed by another
+	 *  process. */
+	bool acquireFileReservation(unsigned int dataTypeIndex, unsigned int id);
+
+	/** Remove the lock file of a data point.
+	 *
+	 *  @param reservationFilename The file name prefix returned by
+	 *  getReservationFilename(). */
+	void releaseFileReservation(const std::string &reservationFilename);
+
+	/** Remove a lock file if its lease has expired. Returns true if the
+	 *  lock file no longer exists. */
+	bool breakExpiredLock(const std::string &lockFilename) const;
+
+	/** Get the file name prefix used for lock files and completion markers
+	 *  of a data point. */
+	std::string getReservationFilename(
+		unsigned int dataTypeIndex,
+		unsigned int id
+	) const;
+
+	/** Get a string that identifies this process across nodes. */
+	static std::string getProcessIdentifier();
+
 	/** Add data tables. */
 	void addDataTables();
 
@@ -216,6 +427,18 @@ inline const std::string& DataManager::getPath() const{
 	return path;
 }
 
+inline bool DataManager::getUseJournal() const{
+	return useJournal;
+}
+
+inline bool DataManager::getUseFileReservations() const{
+	return useFileReservations;
+}
+
+inline unsigned int DataManager::getLeaseTime() const{
+	return leaseTime;
+}
+
 };	//End namespace TBTK
 
 #endif
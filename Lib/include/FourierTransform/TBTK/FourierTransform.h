@@ -28,27 +28,56 @@
 #include <fftw3.h>
 
 #include <complex>
+#include <string>
+#include <vector>
 
 namespace TBTK{
 
 class FourierTransform{
 public:
-	/** Plan for executing the Fourier-transform. */
-	template<typename DataType>
+	/** Enum class for specifying how much time FFTW3 spends on finding a
+	 *  fast algorithm when a Plan is created. Estimate creates the Plan
+	 *  immediately, while Measure, Patient, and Exhaustive time actual
+	 *  transforms to find increasingly fast algorithms. The later three
+	 *  overwrite the input and output arrays while the Plan is created,
+	 *  so the Plan should be created before the input is filled. The
+	 *  result of the timing is stored as wisdom, which can be saved to
+	 *  and loaded from disk using exportWisdom() and importWisdom(). */
+	enum class PlanningRigor{Estimate, Measure, Patient, Exhaustive};
+
+	/** Enum class for specifying how the data for multiple transforms
+	 *  executed by a single Plan is laid out in memory. For Consecutive,
+	 *  the data for one transform is stored contiguously, followed by the
+	 *  data for the next transform. For Interleaved, the nth element of
+	 *  every transform is stored contiguously. For example, for data
+	 *  stored as data[numTransforms*k + orbital], the transforms over k
+	 *  for every orbital are Interleaved. */
+	enum class Layout{Consecutive, Interleaved};
+
+	/** Plan for executing the Fourier-transform. The InputType and
+	 *  OutputType are both std::complex<double> for complex transforms.
+	 *  InputType double and OutputType std::complex<double> gives a real
+	 *  to complex transform, and InputType std::complex<double> and
+	 *  OutputType double gives a complex to real transform. For these,
+	 *  only the first ranges.back()/2 + 1 elements along the last
+	 *  dimension of the complex data are stored, since the remaining
+	 *  elements follow from Hermitian symmetry. Complex to real
+	 *  transforms overwrite the input. */
+	template<typename InputType, typename OutputType = InputType>
 	class Plan{
 	public:
 		/** Constructor. */
 		Plan(
-			DataType *in,
-			DataType *out,
+			InputType *in,
+			OutputType *out,
 			int sizeX,
 			int sign
 		);
 
 		/** Constructor. */
 		Plan(
-			DataType *in,
-			DataType *out,
+			InputType *in,
+			OutputType *out,
 			int sizeX,
 			int sizeY,
 			int sign
@@ -56,14 +85,34 @@ public:
 
 		/** Constructor. */
 		Plan(
-			DataType *in,
-			DataType *out,
+			InputType *in,
+			OutputType *out,
 			int sizeX,
 			int sizeY,
 			int sizeZ,
 			int sign
 		);
 
+		/** Constructor. Creates a Plan that executes several
+		 *  transforms of arbitrary dimension at once.
+		 *
+		 *  @param in The input data.
+		 *  @param out The output data.
+		 *  @param ranges The ranges of a single transform.
+		 *  @param numTransforms The number of transforms.
+		 *  @param layout The memory layout of the transforms.
+		 *  @param sign The sign of the exponent. Must be -1 for real
+		 *  to complex transforms and 1 for complex to real
+		 *  transforms. */
+		Plan(
+			InputType *in,
+			OutputType *out,
+			const std::vector<unsigned int> &ranges,
+			unsigned int numTransforms,
+			Layout layout,
+			int sign
+		);
+
 		/** Copy constructor. */
 		Plan(const Plan &plan) = delete;
 
@@ -91,41 +140,41 @@ public:
 		/** Normalization factor. */
 		double normalizationFactor;
 
-		/** Data size. */
+		/** Output data size. */
 		unsigned int size;
 
 		/** Input data. */
-		DataType *input;
+		InputType *input;
 
 		/** Output data. */
-		DataType *output;
+		OutputType *output;
 
 		/** Get FFTW3 plan. */
 		fftw_plan& getFFTWPlan();
 
-		/** Get data size. */
+		/** Get output data size. */
 		unsigned int getSize() const;
 
 		/** Get input data. */
-		DataType* getInput();
+		InputType* getInput();
 
 		/** Get output data. */
-		DataType* getOutput();
+		OutputType* getOutput();
 
 		/** Make FourierTransform a friend class. */
 		friend class FourierTransform;
 	};
 
 	/** Plan for executing forward Fourier-transform. */
-	template<typename DataType>
-	class ForwardPlan : public Plan<DataType>{
+	template<typename InputType, typename OutputType = InputType>
+	class ForwardPlan : public Plan<InputType, OutputType>{
 	public:
 		/** Constructor. */
 		ForwardPlan(
-			DataType *in,
-			DataType *out,
+			InputType *in,
+			OutputType *out,
 			int sizeX
-		) : Plan<DataType>(
+		) : Plan<InputType, OutputType>(
 			in,
 			out,
 			sizeX,
@@ -134,11 +183,11 @@ public:
 
 		/** Constructor. */
 		ForwardPlan(
-			DataType *in,
-			DataType *out,
+			InputType *in,
+			OutputType *out,
 			int sizeX,
 			int sizeY
-		) : Plan<DataType>(
+		) : Plan<InputType, OutputType>(
 			in,
 			out,
 			sizeX,
@@ -148,12 +197,12 @@ public:
 
 		/** Constructor. */
 		ForwardPlan(
-			DataType *in,
-			DataType *out,
+			InputType *in,
+			OutputType *out,
 			int sizeX,
 			int sizeY,
 			int sizeZ
-		) : Plan<DataType>(
+		) : Plan<InputType, OutputType>(
 			in,
 			out,
 			sizeX,
@@ -161,18 +210,34 @@ public:
 			sizeZ,
 			-1
 		){}
+
+		/** Constructor. See the corresponding Plan constructor. */
+		ForwardPlan(
+			InputType *in,
+			OutputType *out,
+			const std::vector<unsigned int> &ranges,
+			unsigned int numTransforms = 1,
+			Layout layout = Layout::Consecutive
+		) : Plan<InputType, OutputType>(
+			in,
+			out,
+			ranges,
+			numTransforms,
+			layout,
+			-1
+		){}
 	};
 
 	/** Plan for executing inverse Fourier-transform. */
-	template<typename DataType>
-	class InversePlan : public Plan<DataType>{
+	template<typename InputType, typename OutputType = InputType>
+	class InversePlan : public Plan<InputType, OutputType>{
 	public:
 		/** Constructor. */
 		InversePlan(
-			DataType *in,
-			DataType *out,
+			InputType *in,
+			OutputType *out,
 			int sizeX
-		) : Plan<DataType>(
+		) : Plan<InputType, OutputType>(
 			in,
 			out,
 			sizeX,
@@ -181,11 +246,11 @@ public:
 
 		/** Constructor. */
 		InversePlan(
-			DataType *in,
-			DataType *out,
+			InputType *in,
+			OutputType *out,
 			int sizeX,
 			int sizeY
-		) : Plan<DataType>(
+		) : Plan<InputType, OutputType>(
 			in,
 			out,
 			sizeX,
@@ -195,12 +260,12 @@ public:
 
 		/** Constructor. */
 		InversePlan(
-			DataType *in,
-			DataType *out,
+			InputType *in,
+			OutputType *out,
 			int sizeX,
 			int sizeY,
 			int sizeZ
-		) : Plan<DataType>(
+		) : Plan<InputType, OutputType>(
 			in,
 			out,
 			sizeX,
@@ -208,6 +273,22 @@ public:
 			sizeZ,
 			1
 		){}
+
+		/** Constructor. See the corresponding Plan constructor. */
+		InversePlan(
+			InputType *in,
+			OutputType *out,
+			const std::vector<unsigned int> &ranges,
+			unsigned int numTransforms = 1,
+			Layout layout = Layout::Consecutive
+		) : Plan<InputType, OutputType>(
+			in,
+			out,
+			ranges,
+			numTransforms,
+			layout,
+			1
+		){}
 	};
 
 	/** One-dimensional complex Fourier transform. */
@@ -237,9 +318,9 @@ public:
 		int sign
 	);
 
-	/** One-dimensional complex Fourier transform. */
-	template<typename DataType>
-	static void transform(Plan<DataType> &plan);
+	/** Execute a Plan. */
+	template<typename InputType, typename OutputType>
+	static void transform(Plan<InputType, OutputType> &plan);
 
 	/** One-dimensional complex forward Fourier transform. */
 	static void forward(
@@ -288,17 +369,55 @@ public:
 		int sizeY,
 		int sizeZ
 	);
+
+	/** Set the planning rigor used when Plans are created. The one-shot
+	 *  transforms always use PlanningRigor::Estimate, since the other
+	 *  rigors overwrite the data. The default is PlanningRigor::Estimate.
+	 *
+	 *  @param planningRigor The planning rigor. */
+	static void setPlanningRigor(PlanningRigor planningRigor);
+
+	/** Get the planning rigor used when Plans are created.
+	 *
+	 *  @return The planning rigor. */
+	static PlanningRigor getPlanningRigor();
+
+	/** Set the number of threads used by Plans that are created after the
+	 *  call. Requires that TBTK is built with the threaded version of
+	 *  FFTW3.
+	 *
+	 *  @param numThreads The number of threads. */
+	static void setNumThreads(unsigned int numThreads);
+
+	/** Load wisdom from file. Loaded wisdom allows Plans for previously
+	 *  measured transform sizes to be created without measuring again.
+	 *
+	 *  @param filename The file to load the wisdom from.
+	 *
+	 *  @return True if the wisdom was loaded, false if the file does not
+	 *  exist or does not contain valid wisdom. */
+	static bool importWisdom(const std::string &filename);
+
+	/** Save the accumulated wisdom to file.
+	 *
+	 *  @param filename The file to save the wisdom to. */
+	static void exportWisdom(const std::string &filename);
 private:
+	/** Planning rigor used when Plans are created. */
+	static PlanningRigor planningRigor;
+
+	/** Get the FFTW3 planner flags corresponding to the planning
+	 *  rigor. */
+	static unsigned int getPlannerFlags();
 };
 
-template<typename DataType>
-inline void FourierTransform::transform(Plan<DataType> &plan){
+template<typename InputType, typename OutputType>
+inline void FourierTransform::transform(Plan<InputType, OutputType> &plan){
 	fftw_execute(plan.getFFTWPlan());
 
 	double normalizationFactor = plan.getNormalizationFactor();
 	if(normalizationFactor != 1.){
-		Streams::out << "Normalizing\n";
-		DataType *output = plan.getOutput();
+		OutputType *output = plan.getOutput();
 		for(unsigned int n = 0; n < plan.getSize(); n++)
 			output[n] /= normalizationFactor;
 	}
@@ -358,8 +477,16 @@ inline void FourierTransform::inverse(
 	transform(in, out, sizeX, sizeY, sizeZ, 1);
 }
 
-template<typename DataType>
-inline FourierTransform::Plan<DataType>::Plan(Plan &&plan){
+inline void FourierTransform::setPlanningRigor(PlanningRigor planningRigor){
+	FourierTransform::planningRigor = planningRigor;
+}
+
+inline FourierTransform::PlanningRigor FourierTransform::getPlanningRigor(){
+	return planningRigor;
+}
+
+template<typename InputType, typename OutputType>
+inline FourierTransform::Plan<InputType, OutputType>::Plan(Plan &&plan){
 	this->plan = plan.plan;
 	plan.plan = nullptr;
 
@@ -369,8 +496,8 @@ inline FourierTransform::Plan<DataType>::Plan(Plan &&plan){
 	output = plan.output;
 }
 
-template<typename DataType>
-inline FourierTransform::Plan<DataType>::~Plan(){
+template<typename InputType, typename OutputType>
+inline FourierTransform::Plan<InputType, OutputType>::~Plan(){
 	if(plan != nullptr){
 		#pragma omp critical (TBTK_FOURIER_TRANSFORM)
 		fftw_destroy_plan(*plan);
@@ -380,58 +507,73 @@ inline FourierTransform::Plan<DataType>::~Plan(){
 
 }
 
-template<typename DataType>
-inline FourierTransform::Plan<DataType>& FourierTransform::Plan<
-	DataType
->::operator=(Plan &&rhs){
+template<typename InputType, typename OutputType>
+inline FourierTransform::Plan<InputType, OutputType>&
+FourierTransform::Plan<InputType, OutputType>::operator=(Plan &&rhs){
 	if(this != &rhs){
 		if(this->plan != nullptr){
 			#pragma omp critical (TBTK_FOURIER_TRANSFORM)
 			fftw_destroy_plan(*this->plan);
 
 			delete this->plan;
+		}
 
-			this->plan = rhs.plan;
+		this->plan = rhs.plan;
+		rhs.plan = nullptr;
 
-			normalizationFactor = rhs.normalizationFactor;
-			size = rhs.size;
-			input = rhs.input;
-			output = rhs.output;
-		}
+		normalizationFactor = rhs.normalizationFactor;
+		size = rhs.size;
+		input = rhs.input;
+		output = rhs.output;
 	}
 
 	return *this;
 }
 
-template<typename DataType>
-inline void FourierTransform::Plan<DataType>::setNormalizationFactor(
+template<typename InputType, typename OutputType>
+inline void FourierTransform::Plan<
+	InputType,
+	OutputType
+>::setNormalizationFactor(
 	double normalizationFactor
 ){
 	this->normalizationFactor = normalizationFactor;
 }
 
-template<typename DataType>
-inline double FourierTransform::Plan<DataType>::getNormalizationFactor() const{
+template<typename InputType, typename OutputType>
+inline double FourierTransform::Plan<
+	InputType,
+	OutputType
+>::getNormalizationFactor() const{
 	return normalizationFactor;
 }
 
-template<typename DataType>
-inline fftw_plan& FourierTransform::Plan<DataType>::getFFTWPlan(){
+template<typename InputType, typename OutputType>
+inline fftw_plan& FourierTransform::Plan<
+	InputType,
+	OutputType
+>::getFFTWPlan(){
 	return *plan;
 }
 
-template<typename DataType>
-inline unsigned int FourierTransform::Plan<DataType>::getSize() const{
+template<typename InputType, typename OutputType>
+inline unsigned int FourierTransform::Plan<
+	InputType,
+	OutputType
+>::getSize() const{
 	return size;
 }
 
-template<typename DataType>
-inline DataType* FourierTransform::Plan<DataType>::getInput(){
+template<typename InputType, typename OutputType>
+inline InputType* FourierTransform::Plan<InputType, OutputType>::getInput(){
 	return input;
 }
 
-template<typename DataType>
-inline DataType* FourierTransform::Plan<DataType>::getOutput(){
+template<typename InputType, typename OutputType>
+inline OutputType* FourierTransform::Plan<
+	InputType,
+	OutputType
+>::getOutput(){
 	return output;
 }
 
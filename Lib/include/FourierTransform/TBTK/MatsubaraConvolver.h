@@ -0,0 +1,201 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @package TBTKcalc
+ *  @file MatsubaraConvolver.h
+ *  @brief Correlates functions of momentum and Matsubara frequency using FFT.
+ *
+ *  @author Kristofer Björnson
+ */
+
+#ifndef COM_DAFER45_TBTK_MATSUBARA_CONVOLVER
+#define COM_DAFER45_TBTK_MATSUBARA_CONVOLVER
+
+#include "TBTK/FourierTransform.h"
+
+#include <complex>
+#include <vector>
+
+namespace TBTK{
+
+/** @brief Correlates functions of momentum and Matsubara frequency using FFT.
+ *
+ *  The MatsubaraConvolver calculates
+ *  \f[
+ *	C_{ab}(q, s) = \sum_{k}\sum_{n}f_a(k, n)f_b(k+q, n+s)
+ *  \f]
+ *  for all q and s at once, where k and q lie on a regular momentum mesh
+ *  and n and s are indices of equally spaced Matsubara frequencies. This
+ *  is the structure of for example the bare susceptibility
+ *  \f$\sum_{k}\sum_{n}G(k, i\omega_n)G(k+q, i\omega_n + i\nu_s)\f$.
+ *
+ *  The functions are periodic in momentum and assumed to be zero outside of
+ *  the given frequency range. The functions are zero padded along the
+ *  frequency axis and Fourier transformed to real space and imaginary time,
+ *  where the correlation becomes a pointwise product. This reduces the cost
+ *  from \f$O(N_k^2)\f$ to \f$O(N_k\log N_k)\f$ per pair of functions.
+ *
+ *  The functions are given on the layout [meshPoint][function][energy],
+ *  where meshPoint is the row major linear index of the integer mesh
+ *  coordinates. The functions are not copied, but are transformed one at a
+ *  time when they are needed, and the transforms of the two most recently
+ *  used functions are kept. The memory required in addition to the
+ *  functions is therefore three padded transforms, independently of the
+ *  number of functions. A call to correlate() that shares a function with
+ *  the previous call requires one forward and one inverse transform.
+ *
+ *  The MatsubaraConvolver reuses internal buffers and is therefore not
+ *  thread safe. The pointwise products are parallelized with OpenMP, and
+ *  the transforms can be parallelized using
+ *  FourierTransform::setNumThreads(). */
+class MatsubaraConvolver{
+public:
+	/** Constructor.
+	 *
+	 *  @param numMeshPoints The number of mesh points along each
+	 *  dimension of the momentum mesh.
+	 *  @param numFunctions The number of functions.
+	 *  @param numInputEnergies The number of frequencies of the
+	 *  functions.
+	 *  @param numOutputEnergies The number of frequencies of the
+	 *  correlation. The output index e corresponds to the frequency shift
+	 *  s = e - numOutputEnergies/2. */
+	MatsubaraConvolver(
+		const std::vector<unsigned int> &numMeshPoints,
+		unsigned int numFunctions,
+		unsigned int numInputEnergies,
+		unsigned int numOutputEnergies
+	);
+
+	/** Copy constructor. */
+	MatsubaraConvolver(const MatsubaraConvolver &matsubaraConvolver) = delete;
+
+	/** Destructor. */
+	~MatsubaraConvolver();
+
+	/** Assignment operator. */
+	MatsubaraConvolver& operator=(
+		const MatsubaraConvolver &matsubaraConvolver
+	) = delete;
+
+	/** Set the functions. The functions are not copied and must remain
+	 *  valid until the functions are set again or the MatsubaraConvolver
+	 *  is destroyed.
+	 *
+	 *  @param functions The functions on the layout
+	 *  [meshPoint][function][energy]. */
+	void setFunctions(const std::complex<double> *functions);
+
+	/** Calculate the correlation between two functions.
+	 *
+	 *  @param a The first function.
+	 *  @param b The second function.
+	 *  @param result Array with room for
+	 *  numMeshPoints*numOutputEnergies elements that the correlation is
+	 *  written to on the layout [q][e]. */
+	void correlate(
+		unsigned int a,
+		unsigned int b,
+		std::complex<double> *result
+	);
+
+	/** Get the number of mesh points along each dimension. */
+	const std::vector<unsigned int>& getNumMeshPoints() const;
+
+	/** Get the number of functions. */
+	unsigned int getNumFunctions() const;
+
+	/** Get the number of input energies. */
+	unsigned int getNumInputEnergies() const;
+
+	/** Get the number of output energies. */
+	unsigned int getNumOutputEnergies() const;
+private:
+	/** Number of mesh points along each dimension. */
+	std::vector<unsigned int> numMeshPoints;
+
+	/** Total number of mesh points. */
+	unsigned int meshSize;
+
+	/** Number of functions. */
+	unsigned int numFunctions;
+
+	/** Number of input energies. */
+	unsigned int numInputEnergies;
+
+	/** Number of output energies. */
+	unsigned int numOutputEnergies;
+
+	/** Length of the zero padded frequency axis. */
+	unsigned int paddedSize;
+
+	/** Number of elements in a single transform. */
+	unsigned int transformSize;
+
+	/** The functions on the layout [meshPoint][function][energy]. */
+	const std::complex<double> *functions;
+
+	/** Buffers for the transforms of the two most recently used
+	 *  functions on the layout [meshPoint][paddedEnergy]. */
+	std::vector<std::complex<double>> transformBuffers[2];
+
+	/** The function stored in each transform buffer, or -1 if the buffer
+	 *  is empty. */
+	int bufferedFunctions[2];
+
+	/** Work buffer for the inverse transform. */
+	std::vector<std::complex<double>> workBuffer;
+
+	/** Plans for the forward transform of the transform buffers. */
+	FourierTransform::ForwardPlan<std::complex<double>> *forwardPlans[2];
+
+	/** Plan for the inverse transform of the work buffer. */
+	FourierTransform::InversePlan<std::complex<double>> *inversePlan;
+
+	/** Linear index of -p for every element p of a transform. */
+	std::vector<unsigned int> negatedIndices;
+
+	/** Returns the transform buffer that contains the transform of the
+	 *  given function. If the function is not already transformed, it is
+	 *  transformed into a buffer other than the reserved buffer.
+	 *
+	 *  @param function The function to transform.
+	 *  @param reservedBuffer Buffer that must not be overwritten, or -1
+	 *  if any buffer can be overwritten.
+	 *
+	 *  @return The index of the buffer that contains the transform. */
+	unsigned int transformFunction(unsigned int function, int reservedBuffer);
+};
+
+inline const std::vector<unsigned int>& MatsubaraConvolver::getNumMeshPoints(
+) const{
+	return numMeshPoints;
+}
+
+inline unsigned int MatsubaraConvolver::getNumFunctions() const{
+	return numFunctions;
+}
+
+inline unsigned int MatsubaraConvolver::getNumInputEnergies() const{
+	return numInputEnergies;
+}
+
+inline unsigned int MatsubaraConvolver::getNumOutputEnergies() const{
+	return numOutputEnergies;
+}
+
+};	//End of namespace TBTK
+
+#endif
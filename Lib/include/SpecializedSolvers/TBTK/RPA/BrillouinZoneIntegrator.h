@@ -0,0 +1,138 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @package TBTKcalc
+ *  @file BrillouinZoneIntegrator.h
+ *  @brief Integrates band quantities over the Brillouin zone.
+ *
+ *  @author Kristofer Björnson
+ */
+
+#ifndef COM_DAFER45_TBTK_BRILLOUIN_ZONE_INTEGRATOR
+#define COM_DAFER45_TBTK_BRILLOUIN_ZONE_INTEGRATOR
+
+#include "TBTK/Property/DOS.h"
+#include "TBTK/RPA/MomentumSpaceContext.h"
+
+#include <vector>
+
+namespace TBTK{
+
+/** @brief Integrates band quantities over the Brillouin zone.
+ *
+ *  The BrillouinZoneIntegrator uses the energies of an initialized
+ *  MomentumSpaceContext to perform Brillouin zone integrals that converge
+ *  much faster with the number of mesh points than plain sums over the mesh
+ *  with a fixed broadening.
+ *
+ *  The linear tetrahedron method divides every cell of the mesh into
+ *  simplices (line segments, triangles, or tetrahedra in one, two, and
+ *  three dimensions) and interpolates the bands linearly inside each
+ *  simplex. Adaptive smearing instead broadens every state with a Gaussian
+ *  whose width is proportional to the change of the band energy between
+ *  neighboring mesh points, so that flat bands are resolved sharply while
+ *  steep bands are smoothed over the mesh spacing.
+ *
+ *  The simplices are formed from the integer mesh coordinates, and the
+ *  bands are identified by their energy ordering at each mesh point. */
+class BrillouinZoneIntegrator{
+public:
+	/** Constructor.
+	 *
+	 *  @param momentumSpaceContext An initialized MomentumSpaceContext.
+	 *  The MomentumSpaceContext must outlive the BrillouinZoneIntegrator.
+	 */
+	BrillouinZoneIntegrator(
+		const MomentumSpaceContext &momentumSpaceContext
+	);
+
+	/** Calculate the density of states using the linear tetrahedron
+	 *  method. Each energy interval contains the exact integral of the
+	 *  linearly interpolated density of states over the interval, which
+	 *  means that no states are lost however narrow the features are.
+	 *  The normalization is the same as for
+	 *  PropertyExtractor::BlockDiagonalizer::calculateDOS().
+	 *
+	 *  @param lowerBound The lower bound of the energy interval.
+	 *  @param upperBound The upper bound of the energy interval.
+	 *  @param resolution The number of energy intervals.
+	 *
+	 *  @return The density of states. */
+	Property::DOS calculateDOSTetrahedron(
+		double lowerBound,
+		double upperBound,
+		int resolution
+	) const;
+
+	/** Calculate the density of states using adaptive Gaussian smearing.
+	 *  The broadening of each state is given by getAdaptiveBroadenings(),
+	 *  but is never smaller than the width of an energy interval.
+	 *
+	 *  @param lowerBound The lower bound of the energy interval.
+	 *  @param upperBound The upper bound of the energy interval.
+	 *  @param resolution The number of energy intervals.
+	 *  @param smearingFactor The proportionality constant between the
+	 *  broadening and the change in energy between neighboring mesh
+	 *  points.
+	 *
+	 *  @return The density of states. */
+	Property::DOS calculateDOSAdaptiveSmearing(
+		double lowerBound,
+		double upperBound,
+		int resolution,
+		double smearingFactor = 0.5
+	) const;
+
+	/** Get the adaptive broadening of every state. The broadening is
+	 *  smearingFactor*|dE|, where dE is the change in the band energy per
+	 *  mesh step calculated using central differences along each
+	 *  direction of the mesh.
+	 *
+	 *  @param smearingFactor The proportionality constant.
+	 *
+	 *  @return The broadenings on the layout [meshPoint][state]. */
+	std::vector<double> getAdaptiveBroadenings(double smearingFactor) const;
+
+	/** Calculate the zero temperature occupation of every state using
+	 *  the linear tetrahedron method with Blöchl's correction. The
+	 *  occupations replace the step function in sums over the mesh, such
+	 *  that \f$\frac{1}{N}\sum_{kn}w_{kn}A_{kn}\f$ approximates the
+	 *  integral of A over the occupied states. Only three-dimensional
+	 *  meshes are supported.
+	 *
+	 *  @param fermiEnergy The Fermi energy.
+	 *
+	 *  @return The occupations on the layout [meshPoint][state]. */
+	std::vector<double> calculateOccupationsTetrahedron(
+		double fermiEnergy
+	) const;
+private:
+	/** The MomentumSpaceContext. */
+	const MomentumSpaceContext &momentumSpaceContext;
+
+	/** Get the simplices that the mesh is divided into, given as the
+	 *  mesh points at their corners on the layout [simplex][corner]. */
+	std::vector<unsigned int> getSimplices() const;
+
+	/** Get the mesh point at the given offset from a mesh point. */
+	unsigned int getNeighbor(
+		const Index &kIndex,
+		const std::vector<int> &offset
+	) const;
+};
+
+};	//End of namespace TBTK
+
+#endif
@@ -60,11 +60,6 @@ public:
 		const std::vector<int> &orbitalIndices
 	);
 
-	/** Precompute susceptibilities. Will calculate the susceptibility for
-	 *  all values using a parallel algorithm. Can speed up calculations if
-	 *  most of the susceptibilities are needed. */
-	void precompute(unsigned int numWorkers = 129);
-
 	/** Set to true if the susceptibility is known to only be
 	 *  evaluated at points away from poles. */
 	void setSusceptibilityIsSafeFromPoles(
@@ -82,10 +77,14 @@ private:
 	/** Fermi-Dirac distribution lookup table. */
 	double *fermiDiracLookupTable;
 
+	/** Flag indicating whether the LindhardSusceptibilityCalculator is a
+	 *  master. Masters owns resources shared between masters and slaves
+	 *  and is responsible for cleaning up. */
+	bool isMaster;
+
 	/** Slave constructor. */
 	LindhardSusceptibilityCalculator(
 		const MomentumSpaceContext &momentumSpaceContext,
-		int *kPlusQLookupTable,
 		double *fermiDiracLookupTable
 	);
 
@@ -97,12 +96,27 @@ private:
 	);
 
 	/** Calculate the susceptibility using the Lindhard function. */
-	template<bool useKPlusQLookupTable, bool isSafeFromPoles>
+	template<bool isSafeFromPoles>
 	std::vector<std::complex<double>> calculateSusceptibilityLindhard(
 		const DualIndex &kDual,
 		const std::vector<int> &orbitalIndices
 	);
 
+	/** Calculate the susceptibility using the Lindhard function for all
+	 *  orbital indices and energies at once. The band-pair weights are
+	 *  combined with the Lindhard factors using matrix multiplications,
+	 *  and the Lindhard factors are vectorized over the energies. The
+	 *  results are added to the cache.
+	 *
+	 *  @param kDual The momentum.
+	 *
+	 *  @return The susceptibility on the layout [o0][o1][o2][o3][energy].
+	 */
+	template<bool isSafeFromPoles>
+	std::vector<std::complex<double>> calculateSusceptibilityLindhardBatched(
+		const DualIndex &kDual
+	);
+
 	/** Get polt times two Fermi functions for use in the Linhard
 	 *  function. */
 	std::complex<double> getPoleTimesTwoFermi(
@@ -111,7 +125,7 @@ private:
 		double e1,
 		double chemicalPotential,
 		double temperature,
-		int kPlusQLinearIndex,
+		unsigned int kPlusQMeshPoint,
 		unsigned int meshPoint,
 		unsigned int state2,
 		unsigned int state1,
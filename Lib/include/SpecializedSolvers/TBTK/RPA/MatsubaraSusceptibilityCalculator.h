@@ -31,6 +31,9 @@
 
 namespace TBTK{
 
+class DiscreteLehmannRepresentation;
+class MatsubaraConvolver;
+
 class MatsubaraSusceptibilityCalculator : public SusceptibilityCalculator{
 public:
 	/** Constructor. */
@@ -59,21 +62,84 @@ public:
 		const std::vector<int> &orbitalIndices
 	);
 
-	/** Set the number of summation energies. */
+	/** Set the number of summation energies. The summation energies are
+	 *  the fermionic Matsubara energies \f$i\pi(2n+1)kT\f$ for
+	 *  \f$-N/2 \leq n \leq N/2\f$, where N is the number of summation
+	 *  energies. The susceptibility for the energy with index e is the
+	 *  sum over these energies of \f$G(k, i\omega_n)G(k+q,
+	 *  i\omega_{n+s})\f$, where \f$s = e - M/2\f$ and M is the number
+	 *  of energies.
+	 *
+	 *  @param numSummationEnergies The number of summation energies. Must
+	 *  be odd. */
 	void setNumSummationEnergies(unsigned int numSummationEnergies);
+
+	/** Set whether the susceptibility should be calculated using FFT
+	 *  convolution. If enabled, the susceptibility is calculated for every
+	 *  k on the mesh at once when it is requested for a given set of
+	 *  orbital indices, which reduces the cost from O(N_k^2) to
+	 *  O(N_k log N_k). All results are cached. Requires that TBTK is built
+	 *  with FFTW3.
+	 *
+	 *  @param useFFTConvolution Flag indicating whether to use FFT
+	 *  convolution. */
+	void setUseFFTConvolution(bool useFFTConvolution);
+
+	/** Get whether the susceptibility is calculated using FFT
+	 *  convolution. */
+	bool getUseFFTConvolution() const;
+
+	/** Set whether the susceptibility should be calculated using the
+	 *  DiscreteLehmannRepresentation of the Green's function. If enabled,
+	 *  the Green's function is stored as a few tens of coefficients per
+	 *  mesh point and pair of orbitals instead of its values at every
+	 *  summation energy, and the Matsubara sum is performed analytically
+	 *  on the coefficients. The number of summation energies is then not
+	 *  used, and the result is the limit of the sum described in
+	 *  setNumSummationEnergies() when the number of summation energies
+	 *  goes to infinity. As for the sum, the energy with index e is the
+	 *  bosonic Matsubara energy \f$i2\pi skT\f$, where
+	 *  \f$s = e - M/2\f$ and M is the number of energies.
+	 *
+	 *  @param useDiscreteLehmannRepresentation Flag indicating whether to
+	 *  use the DiscreteLehmannRepresentation.
+	 *  @param tolerance The relative accuracy of the representation. */
+	void setUseDiscreteLehmannRepresentation(
+		bool useDiscreteLehmannRepresentation,
+		double tolerance = 1e-10
+	);
+
+	/** Get whether the susceptibility is calculated using the
+	 *  DiscreteLehmannRepresentation. */
+	bool getUseDiscreteLehmannRepresentation() const;
 private:
 	/** Green's function for use in Mode::Matsubara. */
 	std::complex<double> *greensFunction;
 
+	/** Flag indicating whether to use FFT convolution. */
+	bool useFFTConvolution;
+
+	/** Transforms of the Green's function used for FFT convolution. */
+	MatsubaraConvolver *convolver;
+
+	/** Flag indicating whether to use the DiscreteLehmannRepresentation.
+	 */
+	bool useDiscreteLehmannRepresentation;
+
+	/** Tolerance of the DiscreteLehmannRepresentation. */
+	double discreteLehmannRepresentationTolerance;
+
+	/** DiscreteLehmannRepresentation of the Green's function. */
+	DiscreteLehmannRepresentation *discreteLehmannRepresentation;
+
+	/** Coefficients of the Green's function in the
+	 *  DiscreteLehmannRepresentation on the layout
+	 *  [meshPoint][orbital0][orbital1][pole]. */
+	std::vector<std::complex<double>> greensFunctionCoefficients;
+
 	/** Summation energies. Used in Mode::Matsubara. */
 	std::vector<std::complex<double>> summationEnergies;
 
-	/** Slave constructor. */
-	MatsubaraSusceptibilityCalculator(
-		const MomentumSpaceContext &momentumSpaceContext,
-		int *kPlusQLookupTable
-	);
-
 	/** Calculate the susceptibility using the Matsubara sum. */
 	std::complex<double> calculateSusceptibilityMatsubara(
 		const std::vector<double> &k,
@@ -82,15 +148,35 @@ private:
 	);
 
 	/** Calculate the susceptibility using the Matsubara sum. */
-	template<bool useKPlusQLookupTable>
 	std::vector<std::complex<double>> calculateSusceptibilityMatsubara(
 		const DualIndex &kDual,
 		const std::vector<int> &orbitalIndices
 	);
 
+	/** Calculate the susceptibility for all k on the mesh using FFT
+	 *  convolution, and cache the results. */
+	std::vector<std::complex<double>> calculateSusceptibilityFFT(
+		const DualIndex &kDual,
+		const std::vector<int> &orbitalIndices
+	);
+
+	/** Calculate the susceptibility using the
+	 *  DiscreteLehmannRepresentation of the Green's function. */
+	std::vector<std::complex<double>> calculateSusceptibilityDLR(
+		const DualIndex &kDual,
+		const std::vector<int> &orbitalIndices
+	);
+
 	/** Calculate Green's function. */
 	void calculateGreensFunction();
 
+	/** Calculate the coefficients of the Green's function in the
+	 *  DiscreteLehmannRepresentation. */
+	void calculateGreensFunctionCoefficients();
+
+	/** Delete the Green's function and the data derived from it. */
+	void clearGreensFunction();
+
 	/** Get greensFunctionValue. */
 	std::complex<double>& getGreensFunctionValue(
 		unsigned int meshPoint,
@@ -116,20 +202,29 @@ inline void MatsubaraSusceptibilityCalculator::setNumSummationEnergies(
 		getMomentumSpaceContext().getModel().getTemperature()
 	);
 	double kT = UnitHandler::getK_BB()*temperature;
-	double hbar = UnitHandler::getHbarB();
 
 	summationEnergies.clear();
-	for(unsigned int n = 0; n < numSummationEnergies; n++){
+	for(
+		int n = -(int)numSummationEnergies/2;
+		n <= (int)numSummationEnergies/2;
+		n++
+	){
 		summationEnergies.push_back(
-			M_PI*(2*(n - numSummationEnergies/2))*kT/hbar
+			std::complex<double>(0, M_PI*(2*n + 1)*kT)
 		);
 	}
 
 	clearCache();
-	if(greensFunction != nullptr){
-		delete [] greensFunction;
-		greensFunction = nullptr;
-	}
+	clearGreensFunction();
+}
+
+inline bool MatsubaraSusceptibilityCalculator::getUseFFTConvolution() const{
+	return useFFTConvolution;
+}
+
+inline bool MatsubaraSusceptibilityCalculator::getUseDiscreteLehmannRepresentation(
+) const{
+	return useDiscreteLehmannRepresentation;
 }
 
 /*inline std::vector<std::complex<double>> SusceptibilityCalculator::calculateSusceptibility(
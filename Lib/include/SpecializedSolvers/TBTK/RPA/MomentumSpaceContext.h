@@ -27,6 +27,10 @@
 #include "TBTK/Solver/BlockDiagonalizer.h"
 #include "TBTK/PropertyExtractor/BlockDiagonalizer.h"
 
+#include <complex>
+#include <utility>
+#include <vector>
+
 namespace TBTK{
 
 class MomentumSpaceContext{
@@ -64,6 +68,37 @@ public:
 	/** Get number of orbitals. */
 	unsigned int getNumOrbitals() const;
 
+	/** Add a symmetry operation. A symmetry operation consists of an
+	 *  integer matrix R acting on the reciprocal lattice coordinates of
+	 *  the momentum, and a unitary matrix U acting on the orbitals, such
+	 *  that \f$H(Rk) = UH(k)U^{\dagger}\f$. It is enough to add the
+	 *  generators of the point group, since the group is completed by
+	 *  init().
+	 *
+	 *  When symmetry operations are added, init() only diagonalizes the
+	 *  Hamiltonian at the irreducible mesh points and obtains the
+	 *  eigenvectors at the remaining mesh points by applying U. The
+	 *  operations are verified against the Model during init().
+	 *
+	 *  @param rotation The matrix R. The element R[i][j] gives the
+	 *  contribution of the jth reciprocal lattice coordinate to the ith
+	 *  reciprocal lattice coordinate.
+	 *  @param orbitalRepresentation The matrix U. If empty, the identity
+	 *  is used. */
+	void addSymmetryOperation(
+		const std::vector<std::vector<int>> &rotation,
+		const std::vector<std::vector<std::complex<double>>>
+			&orbitalRepresentation = {}
+	);
+
+	/** Set whether init() should detect symmetry operations
+	 *  automatically. If set, every unimodular transformation of the mesh
+	 *  coordinates with elements -1, 0, and 1 that leaves the Hamiltonian
+	 *  invariant at every mesh point is added as a symmetry operation with
+	 *  the identity as orbital representation. Operations that also act
+	 *  on the orbitals have to be added using addSymmetryOperation(). */
+	void setDetectSymmetryOperations(bool detectSymmetryOperations);
+
 	/** Initialize the SusceptibilityCalculator. */
 	void init();
 
@@ -83,7 +118,89 @@ public:
 	/** Get Index corresponding to given k-vector. */
 	Index getKIndex(const std::vector<double> &k) const;
 
-	/** Get property extractor. */
+	/** Get the mesh point corresponding to a given k-Index.
+	 *
+	 *  @param kIndex Index with the integer mesh coordinates of the
+	 *  k-point, as returned by getKIndex().
+	 *
+	 *  @return The position of the k-point in the mesh. */
+	unsigned int getMeshPoint(const Index &kIndex) const;
+
+	/** Get the mesh point corresponding to k+q. The result is calculated
+	 *  using modular arithmetic on the integer mesh coordinates and works
+	 *  for one-, two-, and three-dimensional meshes.
+	 *
+	 *  @param kMeshPoint The mesh point of k.
+	 *  @param qMeshPoint The mesh point of q.
+	 *
+	 *  @return The mesh point of k+q. */
+	unsigned int getKPlusQMeshPoint(
+		unsigned int kMeshPoint,
+		unsigned int qMeshPoint
+	) const;
+
+	/** Get the mesh point corresponding to k-q. The result is calculated
+	 *  using modular arithmetic on the integer mesh coordinates and works
+	 *  for one-, two-, and three-dimensional meshes.
+	 *
+	 *  @param kMeshPoint The mesh point of k.
+	 *  @param qMeshPoint The mesh point of q.
+	 *
+	 *  @return The mesh point of k-q. */
+	unsigned int getKMinusQMeshPoint(
+		unsigned int kMeshPoint,
+		unsigned int qMeshPoint
+	) const;
+
+	/** Get the number of symmetry operations in the point group,
+	 *  including the identity. Available after init() has been called. */
+	unsigned int getNumSymmetryOperations() const;
+
+	/** Get the irreducible mesh points. Every mesh point is the image of
+	 *  exactly one irreducible mesh point under some symmetry operation.
+	 */
+	const std::vector<unsigned int>& getIrreducibleMeshPoints() const;
+
+	/** Get the irreducible mesh point that a given mesh point is the
+	 *  image of.
+	 *
+	 *  @param meshPoint The mesh point.
+	 *
+	 *  @return The irreducible mesh point. */
+	unsigned int getRepresentativeMeshPoint(unsigned int meshPoint) const;
+
+	/** Get the symmetry operation that maps the representative mesh
+	 *  point to the given mesh point.
+	 *
+	 *  @param meshPoint The mesh point.
+	 *
+	 *  @return The symmetry operation. */
+	unsigned int getSymmetryOperation(unsigned int meshPoint) const;
+
+	/** Apply a symmetry operation to a mesh point.
+	 *
+	 *  @param symmetryOperation The symmetry operation.
+	 *  @param meshPoint The mesh point.
+	 *
+	 *  @return The mesh point that results from the symmetry operation.
+	 */
+	unsigned int applySymmetryOperation(
+		unsigned int symmetryOperation,
+		unsigned int meshPoint
+	) const;
+
+	/** Get the orbital representation of a symmetry operation.
+	 *
+	 *  @param symmetryOperation The symmetry operation.
+	 *
+	 *  @return Pointer to the row major numOrbitals x numOrbitals matrix U.
+	 */
+	const std::complex<double>* getOrbitalRepresentation(
+		unsigned int symmetryOperation
+	) const;
+
+	/** Get property extractor. Not available if symmetry operations are
+	 *  used. */
 	const PropertyExtractor::BlockDiagonalizer& getPropertyExtractorBlockDiagonalizer() const;
 private:
 	/** Model to work on. */
@@ -113,10 +230,75 @@ private:
 	/** Amplitudes. */
 	std::complex<double> *amplitudes;
 
+	/** Integer coordinates of the mesh points on the layout
+	 *  [meshPoint][dimension]. */
+	std::vector<unsigned int> meshPointCoordinates;
+
+	/** Lookup table from the row major linear index of the integer mesh
+	 *  coordinates to the corresponding mesh point. */
+	std::vector<unsigned int> meshPointLookupTable;
+
+	/** Symmetry operations added using addSymmetryOperation(), stored
+	 *  as pairs of row major rotations and orbital representations. */
+	std::vector<
+		std::pair<std::vector<int>, std::vector<std::complex<double>>>
+	> symmetryOperationGenerators;
+
+	/** Flag indicating whether init() should detect symmetry operations.
+	 */
+	bool detectSymmetryOperations;
+
+	/** Row major rotation matrices of the symmetry operations on the
+	 *  layout [symmetryOperation][row][col]. */
+	std::vector<int> symmetryRotations;
+
+	/** Row major orbital representations of the symmetry operations on
+	 *  the layout [symmetryOperation][row][col]. */
+	std::vector<std::complex<double>> orbitalRepresentations;
+
+	/** The irreducible mesh points. */
+	std::vector<unsigned int> irreducibleMeshPoints;
+
+	/** The irreducible mesh point that each mesh point is an image of. */
+	std::vector<unsigned int> representativeMeshPoints;
+
+	/** The symmetry operation that maps the representative mesh point to
+	 *  each mesh point. */
+	std::vector<unsigned int> meshPointSymmetryOperations;
+
 	/** Flag indicating whether the SusceptibilityCalculator is
 	 *  initialized. */
 	bool isInitialized;
 
+	/** Calculate the energies and amplitudes using a BlockDiagonalizer.
+	 */
+	void diagonalizeAllMeshPoints();
+
+	/** Generate the point group from the symmetry operations and
+	 *  calculate the energies and amplitudes at the irreducible mesh
+	 *  points. */
+	void diagonalizeIrreducibleMeshPoints();
+
+	/** Get every rotation that leaves the Hamiltonian invariant with the
+	 *  identity as orbital representation. */
+	std::vector<std::vector<int>> detectSymmetryRotations() const;
+
+	/** Get the Hamiltonian at a mesh point as a row major matrix in the
+	 *  orbital basis. */
+	std::vector<std::complex<double>> getHamiltonian(
+		unsigned int meshPoint
+	) const;
+
+	/** Apply a rotation given as a row major matrix to a mesh point. The
+	 *  elements R[i][j] must be such that R[i][j]*numMeshPoints[i] is
+	 *  divisible by numMeshPoints[j]. */
+	unsigned int applyRotation(
+		const int *rotation,
+		unsigned int meshPoint
+	) const;
+
+	/** Check whether a rotation maps the mesh onto itself. */
+	bool isCompatibleWithMesh(const int *rotation) const;
 };
 
 inline void MomentumSpaceContext::setModel(Model &model){
@@ -205,8 +387,120 @@ inline Index MomentumSpaceContext::getKIndex(
 	);
 }
 
+inline unsigned int MomentumSpaceContext::getMeshPoint(
+	const Index &kIndex
+) const{
+	unsigned int linearIndex = 0;
+	for(unsigned int n = 0; n < numMeshPoints.size(); n++)
+		linearIndex = numMeshPoints[n]*linearIndex + kIndex[n];
+
+	return meshPointLookupTable[linearIndex];
+}
+
+inline unsigned int MomentumSpaceContext::getKPlusQMeshPoint(
+	unsigned int kMeshPoint,
+	unsigned int qMeshPoint
+) const{
+	const unsigned int *kCoordinates
+		= &meshPointCoordinates[numMeshPoints.size()*kMeshPoint];
+	const unsigned int *qCoordinates
+		= &meshPointCoordinates[numMeshPoints.size()*qMeshPoint];
+
+	unsigned int linearIndex = 0;
+	for(unsigned int n = 0; n < numMeshPoints.size(); n++){
+		unsigned int coordinate = kCoordinates[n] + qCoordinates[n];
+		if(coordinate >= numMeshPoints[n])
+			coordinate -= numMeshPoints[n];
+
+		linearIndex = numMeshPoints[n]*linearIndex + coordinate;
+	}
+
+	return meshPointLookupTable[linearIndex];
+}
+
+inline unsigned int MomentumSpaceContext::getKMinusQMeshPoint(
+	unsigned int kMeshPoint,
+	unsigned int qMeshPoint
+) const{
+	const unsigned int *kCoordinates
+		= &meshPointCoordinates[numMeshPoints.size()*kMeshPoint];
+	const unsigned int *qCoordinates
+		= &meshPointCoordinates[numMeshPoints.size()*qMeshPoint];
+
+	unsigned int linearIndex = 0;
+	for(unsigned int n = 0; n < numMeshPoints.size(); n++){
+		unsigned int coordinate
+			= kCoordinates[n] + numMeshPoints[n] - qCoordinates[n];
+		if(coordinate >= numMeshPoints[n])
+			coordinate -= numMeshPoints[n];
+
+		linearIndex = numMeshPoints[n]*linearIndex + coordinate;
+	}
+
+	return meshPointLookupTable[linearIndex];
+}
+
+inline void MomentumSpaceContext::setDetectSymmetryOperations(
+	bool detectSymmetryOperations
+){
+	this->detectSymmetryOperations = detectSymmetryOperations;
+
+	isInitialized = false;
+}
+
+inline unsigned int MomentumSpaceContext::getNumSymmetryOperations() const{
+	unsigned int dimension = numMeshPoints.size();
+
+	return symmetryRotations.size()/(dimension*dimension);
+}
+
+inline const std::vector<unsigned int>& MomentumSpaceContext::getIrreducibleMeshPoints(
+) const{
+	return irreducibleMeshPoints;
+}
+
+inline unsigned int MomentumSpaceContext::getRepresentativeMeshPoint(
+	unsigned int meshPoint
+) const{
+	return representativeMeshPoints[meshPoint];
+}
+
+inline unsigned int MomentumSpaceContext::getSymmetryOperation(
+	unsigned int meshPoint
+) const{
+	return meshPointSymmetryOperations[meshPoint];
+}
+
+inline unsigned int MomentumSpaceContext::applySymmetryOperation(
+	unsigned int symmetryOperation,
+	unsigned int meshPoint
+) const{
+	unsigned int dimension = numMeshPoints.size();
+
+	return applyRotation(
+		&symmetryRotations[dimension*dimension*symmetryOperation],
+		meshPoint
+	);
+}
+
+inline const std::complex<double>* MomentumSpaceContext::getOrbitalRepresentation(
+	unsigned int symmetryOperation
+) const{
+	return &orbitalRepresentations[
+		numOrbitals*numOrbitals*symmetryOperation
+	];
+}
+
 inline const PropertyExtractor::BlockDiagonalizer& MomentumSpaceContext::getPropertyExtractorBlockDiagonalizer(
 ) const{
+	TBTKAssert(
+		propertyExtractor != nullptr,
+		"MomentumSpaceContext::getPropertyExtractorBlockDiagonalizer()",
+		"The PropertyExtractor is not available.",
+		"The PropertyExtractor is only available after init() has"
+		<< " been called without symmetry operations."
+	);
+
 	return *propertyExtractor;
 }
 
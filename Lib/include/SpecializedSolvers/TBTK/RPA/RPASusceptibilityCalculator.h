@@ -23,6 +23,7 @@
 #ifndef COM_DAFER45_TBTK_RPA_SUSCEPTIBILITY_CALCULATOR
 #define COM_DAFER45_TBTK_RPA_SUSCEPTIBILITY_CALCULATOR
 
+#include "TBTK/IndexedDataTree.h"
 #include "TBTK/InteractionAmplitude.h"
 #include "TBTK/RPA/MomentumSpaceContext.h"
 #include "TBTK/SerializeableVector.h"
@@ -52,10 +53,11 @@ public:
 	 *  used after the generating master have been destructed. */
 	RPASusceptibilityCalculator* createSlave();
 
-	/** Precompute susceptibilities. Will calculate the susceptibility for
-	 *  all values using a parallel algorithm. Can speed up calculations if
-	 *  most of the susceptibilities are needed. */
-	void precompute(unsigned int numWorkers = 129);
+	/** Precompute the bare susceptibilities. Will calculate the bare
+	 *  susceptibility for all values using a parallel algorithm. Can
+	 *  speed up calculations if most of the susceptibilities are needed.
+	 */
+	void precompute();
 
 	const MomentumSpaceContext& getMomentumSpaceContext() const;
 
@@ -137,7 +139,9 @@ private:
 	/** Energies to calculate the susceptibility for. */
 	std::vector<std::complex<double>> energies;
 public:
-	/** Calculate RPA Susceptibility. */
+	/** Calculate RPA Susceptibility. Throws an Exception if the
+	 *  denominator \f$1 + U\chi_0\f$ is singular for any of the
+	 *  energies. */
 	std::vector<std::complex<double>> calculateRPASusceptibility(
 		const DualIndex &kDual,
 		const std::vector<int> &orbitalIndices
@@ -149,7 +153,9 @@ public:
 		const std::vector<int> &orbitalIndices
 	);
 
-	/** Calculate charge RPA Susceptibility. */
+	/** Calculate charge RPA Susceptibility. Throws an Exception if the
+	 *  denominator \f$1 + U\chi_0\f$ is singular for any of the
+	 *  energies. */
 	std::vector<std::complex<double>> calculateChargeRPASusceptibility(
 		const DualIndex &kDual,
 		const std::vector<int> &orbitalIndices
@@ -161,7 +167,9 @@ public:
 		const std::vector<int> &orbitalIndices
 	);
 
-	/** Calculate spin RPA Susceptibility. */
+	/** Calculate spin RPA Susceptibility. Throws an Exception if the
+	 *  denominator \f$1 + U\chi_0\f$ is singular for any of the
+	 *  energies. */
 	std::vector<std::complex<double>> calculateSpinRPASusceptibility(
 		const DualIndex &kDual,
 		const std::vector<int> &orbitalIndices
@@ -212,17 +220,6 @@ private:
 		const std::vector<int> &orbitalIndices
 	) const;
 
-	/** Invert matix. */
-	void invertMatrix(std::complex<double> *matrix, unsigned int dimensions);
-
-	/** Multiply matrices. */
-	void multiplyMatrices(
-		std::complex<double> *matrix1,
-		std::complex<double> *matrix2,
-		std::complex<double> *result,
-		unsigned int dimensions
-	);
-
 	/** RPA-susceptibility main algorithm. */
 	std::vector<std::vector<std::vector<std::complex<double>>>> rpaSusceptibilityMainAlgorithm(
 		const DualIndex &kDual,
@@ -375,6 +372,10 @@ inline bool RPASusceptibilityCalculator::getSusceptibilityIsSafeFromPoles() cons
 	);
 }*/
 
+inline void RPASusceptibilityCalculator::precompute(){
+	susceptibilityCalculator->precompute();
+}
+
 inline void RPASusceptibilityCalculator::saveSusceptibilities(
 	const std::string &filename
 ) const{
@@ -100,21 +100,6 @@ private:
 	/** ElectronFluctuationVertexCalculator. */
 	std::vector<ElectronFluctuationVertexCalculator*> electronFluctuationVertexCalculators;
 
-	/** Lookup table for calculating k+q. */
-	int *kMinusQLookupTable;
-
-	/** Generate lookup table for the k-q linear index. Can be called
-	 *  repeatedly, and the lookup table is only generated once. */
-	void generateKMinusQLookupTable();
-
-	/** Returns the linear index for k+q. */
-	template<bool useKPlusKLookupTable>
-	int getKMinusQLinearIndex(
-		unsigned int meshIndex,
-		const std::vector<double> &k,
-		int kLinearIndex
-	) const;
-
 	/** Number of energies to sum over. */
 	unsigned int numSummationEnergies;
 
@@ -23,22 +23,23 @@
 #ifndef COM_DAFER45_TBTK_SUSCEPTIBILITY_CALCULATOR
 #define COM_DAFER45_TBTK_SUSCEPTIBILITY_CALCULATOR
 
+#include "TBTK/Communicator.h"
 #include "TBTK/RPA/DualIndex.h"
-#include "TBTK/IndexedDataTree.h"
 #include "TBTK/InteractionAmplitude.h"
 #include "TBTK/RPA/MomentumSpaceContext.h"
+#include "TBTK/RPA/SusceptibilityTensor.h"
 #include "TBTK/Resource.h"
-#include "TBTK/SerializeableVector.h"
 #include "TBTK/UnitHandler.h"
 
 #include <complex>
+#include <memory>
 #include <vector>
 
 //#include <omp.h>
 
 namespace TBTK{
 
-class SusceptibilityCalculator{
+class SusceptibilityCalculator : public Communicator{
 public:
 	/** List of algorithm identifiers. Officilly supported algorithms are
 	 *  given unique identifiers. Algorithms not (yet) supported should
@@ -84,18 +85,44 @@ public:
 		const std::vector<int> &orbitalIndices
 	);
 
+	/** Calculate the susceptibility and return a pointer to the cached
+	 *  result instead of a copy.
+	 *
+	 *  @param kDual The momentum.
+	 *  @param orbitalIndices The four orbital indices.
+	 *
+	 *  @return Pointer to the susceptibility for each of the energies
+	 *  returned by getEnergies(). The pointer remains valid until the
+	 *  cache is cleared, for example by setting new energies. */
+	const std::complex<double>* getSusceptibilityData(
+		const DualIndex &kDual,
+		const std::vector<int> &orbitalIndices
+	);
+
 	/** Precompute susceptibilities. Will calculate the susceptibility for
-	 *  all values using a parallel algorithm. Can speed up calculations if
-	 *  most of the susceptibilities are needed. */
-//	void precompute(unsigned int numWorkers = 129);
+	 *  all mesh points and orbital indices in parallel, using one slave
+	 *  per thread that writes directly to the cache of the
+	 *  SusceptibilityCalculator. Can speed up calculations if most of the
+	 *  susceptibilities are needed.
+	 *
+	 *  Every combination of mesh point and orbital indices is a separate
+	 *  task, and the tasks are handed out dynamically to the threads.
+	 *  Tasks that already are in the cache, for example because they were
+	 *  calculated together with another task or loaded using
+	 *  loadSusceptibilities(), are skipped at no cost. If the
+	 *  SusceptibilityCalculator is verbose, progress is printed during
+	 *  the calculation, followed by the number of calculated entries per
+	 *  second.
+	 *
+	 *  If the MomentumSpaceContext has symmetry operations, the
+	 *  susceptibility is only calculated explicitly at the irreducible
+	 *  mesh points, and is obtained at the remaining mesh points by
+	 *  applying the orbital representations of the symmetry operations.
+	 */
+	void precompute();
 
 	const MomentumSpaceContext& getMomentumSpaceContext() const;
 
-	/** Generate lookup table for the k+q linear index. Can be called
-	 *  repeatedly, and the lookup table is only generated the first time.
-	 */
-	void generateKPlusQLookupTable();
-
 	/** Enum class for indicating whether the energy is an arbitrary comlex
 	 *  number, or if it is restricted to the real or imaginary axis. */
 	enum class EnergyType {Real, Imaginary, Complex};
@@ -136,60 +163,52 @@ public:
 	 *  symmetric. */
 	bool getEnergiesAreInversionSymmetric() const;
 
-	/** Save susceptibilities. */
+	/** Save susceptibilities. The susceptibilities are stored as a
+	 *  Serializeable::Mode::Binary serialization of a
+	 *  SusceptibilityTensor. */
 	void saveSusceptibilities(const std::string &filename) const;
 
-	/** Load susceptibilities. */
+	/** Load susceptibilities. The file is memory mapped rather than
+	 *  read, which means that only the parts of the file that are used
+	 *  are loaded into memory. The file must have been saved for the
+	 *  same mesh, number of orbitals, and number of energies. */
 	void loadSusceptibilities(const std::string &filename);
 protected:
-	/** Slave constructor. */
-	SusceptibilityCalculator(
-		Algorithm algorithm,
-		const MomentumSpaceContext &momentumSpaceContext,
-		int *kPlusQLookupTable/*,
-		double *fermiDiracLookupTable*/
-	);
-
-	/** Returns true if the SusceptibilityCalculator is a master. */
-	bool getIsMaster() const;
-
-	/** Returns the k+q lookup table. */
-	int* getKPlusQLookupTable();
-
-	/** Returns the k+q lookup table. */
-	const int* getKPlusQLookupTable() const;
-
-	/** Get Susceptibility result Index. */
-	Index getSusceptibilityResultIndex(
+	/** Get a cached susceptibility.
+	 *
+	 *  @param kIndex The momentum Index.
+	 *  @param orbitalIndices The four orbital indices.
+	 *
+	 *  @return Pointer to the susceptibility for all energies, or nullptr
+	 *  if the susceptibility has not been calculated. */
+	const std::complex<double>* getCachedSusceptibility(
 		const Index &kIndex,
 		const std::vector<int> &orbitalIndices
 	) const;
 
-	/** Get susceptibility tree. */
-	const IndexedDataTree<SerializeableVector<std::complex<double>>>& getSusceptibilityTree() const;
-
-	/** Returns the linear index for k+q. */
-	template<bool useKPlusQLookupTable>
-	int getKPlusQLinearIndex(
-		unsigned int meshIndex,
-		const std::vector<double> &k,
-		int kLinearIndex
-	) const;
-
 	/** Cache susceptibility. */
 	void cacheSusceptibility(
 		const std::vector<std::complex<double>> &result,
 		const std::vector<double> &k,
 		const std::vector<int> &orbitalIndices,
-		const Index &kIndex,
-		const Index &resultIndex
+		const Index &kIndex
 	);
 
 	/** Clear cache. */
 	void clearCache();
 private:
-	/** IndexedDataTree storing the bare susceptibilities. */
-	IndexedDataTree<SerializeableVector<std::complex<double>>> susceptibilityTree;
+	/** Dense storage of the bare susceptibilities. Allocated the first
+	 *  time a susceptibility is cached and shared with the slaves used
+	 *  by precompute(). */
+	std::shared_ptr<SusceptibilityTensor> susceptibilityTensor;
+
+	/** Get the SusceptibilityTensor, allocating it if necessary. */
+	SusceptibilityTensor& getSusceptibilityTensor();
+
+	/** Fill in the susceptibility at every mesh point that is not
+	 *  irreducible by applying the symmetry operations of the
+	 *  MomentumSpaceContext to the irreducible mesh points. */
+	void applySymmetryOperations();
 
 	/** Algorithm. */
 	Algorithm algorithm;
@@ -207,14 +226,6 @@ private:
 
 	/** Momentum space context. */
 	const MomentumSpaceContext *momentumSpaceContext;
-
-	/** Lookup table for calculating k+q. */
-	int *kPlusQLookupTable;
-
-	/** Flag indicating whether the SusceptibilityCalculator is a master.
-	 *  Masters owns resources shared between masters and slaves and is
-	 *  responsible for cleaning up. */
-	bool isMaster;
 };
 
 inline const MomentumSpaceContext& SusceptibilityCalculator::getMomentumSpaceContext(
@@ -226,21 +237,6 @@ inline SusceptibilityCalculator::Algorithm SusceptibilityCalculator::getAlgorith
 	return algorithm;
 }
 
-inline Index SusceptibilityCalculator::getSusceptibilityResultIndex(
-	const Index &kIndex,
-	const std::vector<int> &orbitalIndices
-) const{
-	return Index(
-		kIndex,
-		{
-			orbitalIndices.at(0),
-			orbitalIndices.at(1),
-			orbitalIndices.at(2),
-			orbitalIndices.at(3)
-		}
-	);
-}
-
 inline void SusceptibilityCalculator::setEnergyType(
 	EnergyType energyType
 ){
@@ -256,7 +252,7 @@ inline void SusceptibilityCalculator::setEnergies(
 	const std::vector<std::complex<double>> &energies
 ){
 	this->energies = energies;
-	susceptibilityTree.clear();
+	susceptibilityTensor.reset();
 }
 
 inline const std::vector<std::complex<double>>& SusceptibilityCalculator::getEnergies() const{
@@ -274,26 +270,6 @@ inline bool SusceptibilityCalculator::getEnergiesAreInversionSymmetric(
 	return energiesAreInversionSymmetric;
 }
 
-inline void SusceptibilityCalculator::saveSusceptibilities(
-	const std::string &filename
-) const{
-	Resource resource;
-	resource.setData(
-		susceptibilityTree.serialize(Serializeable::Mode::JSON)
-	);
-	resource.write(filename);
-}
-
-inline void SusceptibilityCalculator::loadSusceptibilities(
-	const std::string &filename
-){
-	Resource resource;
-	resource.read(filename);
-	susceptibilityTree = IndexedDataTree<SerializeableVector<std::complex<double>>>(
-		resource.getData(),
-		Serializeable::Mode::JSON
-	);
-}
 
 inline std::vector<std::complex<double>> SusceptibilityCalculator::calculateSusceptibility(
 		const std::vector<double> &k,
@@ -308,55 +284,21 @@ inline std::vector<std::complex<double>> SusceptibilityCalculator::calculateSusc
 	);
 }
 
-inline void SusceptibilityCalculator::clearCache(){
-	susceptibilityTree.clear();
-}
-
-inline bool SusceptibilityCalculator::getIsMaster() const{
-	return isMaster;
-}
-
-inline int* SusceptibilityCalculator::getKPlusQLookupTable(){
-	return kPlusQLookupTable;
-}
-
-inline const int* SusceptibilityCalculator::getKPlusQLookupTable() const{
-	return kPlusQLookupTable;
-}
-
-template<>
-inline int SusceptibilityCalculator::getKPlusQLinearIndex<false>(
-	unsigned int meshIndex,
-	const std::vector<double> &k,
-	int kLinearIndex
+inline const std::complex<double>* SusceptibilityCalculator::getCachedSusceptibility(
+	const Index &kIndex,
+	const std::vector<int> &orbitalIndices
 ) const{
-	const std::vector<std::vector<double>> &mesh
-		= momentumSpaceContext->getMesh();
-
-	Index kPlusQIndex
-		= momentumSpaceContext->getBrillouinZone().getMinorCellIndex(
-			{mesh[meshIndex][0] + k[0], mesh[meshIndex][1] + k[1]},
-			momentumSpaceContext->getNumMeshPoints()
-		);
-	return momentumSpaceContext->getModel().getHoppingAmplitudeSet()->getFirstIndexInBlock(
-		kPlusQIndex
-	);
-}
+	if(!susceptibilityTensor)
+		return nullptr;
 
-template<>
-inline int SusceptibilityCalculator::getKPlusQLinearIndex<true>(
-	unsigned int meshIndex,
-	const std::vector<double> &k,
-	int kLinearIndex
-) const{
-	return kPlusQLookupTable[
-		meshIndex*momentumSpaceContext->getMesh().size()
-		+ kLinearIndex/momentumSpaceContext->getNumOrbitals()
-	];
+	return susceptibilityTensor->get(
+		momentumSpaceContext->getMeshPoint(kIndex),
+		orbitalIndices
+	);
 }
 
-inline const IndexedDataTree<SerializeableVector<std::complex<double>>>& SusceptibilityCalculator::getSusceptibilityTree() const{
-	return susceptibilityTree;
+inline void SusceptibilityCalculator::clearCache(){
+	susceptibilityTensor.reset();
 }
 
 };	//End of namespace TBTK
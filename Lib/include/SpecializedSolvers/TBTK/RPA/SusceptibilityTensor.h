@@ -0,0 +1,245 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @package TBTKcalc
+ *  @file SusceptibilityTensor.h
+ *  @brief Dense storage of bare susceptibilities.
+ *
+ *  @author Kristofer Björnson
+ */
+
+#ifndef COM_DAFER45_TBTK_SUSCEPTIBILITY_TENSOR
+#define COM_DAFER45_TBTK_SUSCEPTIBILITY_TENSOR
+
+#include "TBTK/MemoryMappedFile.h"
+#include "TBTK/Serializeable.h"
+
+#include <complex>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace TBTK{
+
+/** @brief Dense storage of bare susceptibilities.
+ *
+ *  The SusceptibilityTensor stores the bare susceptibility
+ *  \f$\chi_0(k, o_0, o_1, o_2, o_3, E)\f$ in a single contiguous array on
+ *  the layout [meshPoint][o0][o1][o2][o3][energy]. Each entry, consisting of
+ *  the susceptibility for all energies, has a status flag that indicates
+ *  whether it has been calculated. Entries are accessed in place through
+ *  pointers, without any allocations or copies.
+ *
+ *  Entries can be added and read concurrently from multiple threads. An
+ *  entry is claimed by the first thread that adds it, and it is not visible
+ *  to readers until all of its values have been written.
+ *
+ *  The SusceptibilityTensor can be serialized using Mode::Binary, either to
+ *  a string or directly to a stream, and be constructed directly from a
+ *  memory mapped file. In this case only the status flags are copied into
+ *  memory, while the data is accessed in place and pages are loaded by the
+ *  operating system first when they are accessed. */
+class SusceptibilityTensor : public Serializeable{
+public:
+	/** Constructor.
+	 *
+	 *  @param meshSize The number of mesh points.
+	 *  @param numOrbitals The number of orbitals.
+	 *  @param numEnergies The number of energies. */
+	SusceptibilityTensor(
+		unsigned int meshSize,
+		unsigned int numOrbitals,
+		unsigned int numEnergies
+	);
+
+	/** Constructor. Constructs the SusceptibilityTensor from a memory
+	 *  mapped file containing a Serializeable::Mode::Binary
+	 *  serialization of the SusceptibilityTensor. The data is accessed in
+	 *  place, while the status flags are copied into memory, where
+	 *  entries that were incomplete when the tensor was serialized are
+	 *  marked as empty. Loading therefore does not write to the mapping.
+	 *
+	 *  @param file The memory mapped file. New entries are written to
+	 *  the mapped memory, so entries can only be added if the file is
+	 *  mapped with MemoryMappedFile::Mode::CopyOnWrite or
+	 *  MemoryMappedFile::Mode::ReadWrite. With
+	 *  MemoryMappedFile::Mode::ReadWrite, the status of added entries is
+	 *  written to the file as well. */
+	SusceptibilityTensor(const MemoryMappedFile &file);
+
+	/** Copy constructor. */
+	SusceptibilityTensor(
+		const SusceptibilityTensor &susceptibilityTensor
+	) = delete;
+
+	/** Assignment operator. */
+	SusceptibilityTensor& operator=(
+		const SusceptibilityTensor &susceptibilityTensor
+	) = delete;
+
+	/** Get the number of mesh points. */
+	unsigned int getMeshSize() const;
+
+	/** Get the number of orbitals. */
+	unsigned int getNumOrbitals() const;
+
+	/** Get the number of energies. */
+	unsigned int getNumEnergies() const;
+
+	/** Get a stored entry.
+	 *
+	 *  @param meshPoint The mesh point.
+	 *  @param orbitalIndices The four orbital indices.
+	 *
+	 *  @return Pointer to the susceptibility for all energies, or nullptr
+	 *  if the entry has not been added. */
+	const std::complex<double>* get(
+		unsigned int meshPoint,
+		const std::vector<int> &orbitalIndices
+	) const;
+
+	/** Add an entry. If the entry already has been added, the tensor is
+	 *  left unchanged.
+	 *
+	 *  @param values The susceptibility for all energies.
+	 *  @param meshPoint The mesh point.
+	 *  @param orbitalIndices The four orbital indices.
+	 *
+	 *  @return True if the entry was added, false if it already existed.
+	 *  It is an error to add entries to a SusceptibilityTensor that is
+	 *  mapped with MemoryMappedFile::Mode::ReadOnly. */
+	bool add(
+		const std::complex<double> *values,
+		unsigned int meshPoint,
+		const std::vector<int> &orbitalIndices
+	);
+
+	/** Get the number of entries that have been added. */
+	std::uint64_t getNumAddedEntries() const;
+
+	/** Implements Serializeable::serialize(). Only
+	 *  Serializeable::Mode::Binary is supported. */
+	virtual std::string serialize(Mode mode) const;
+
+	/** Serialize directly to a stream, without building the
+	 *  serialization string in memory. Only Serializeable::Mode::Binary
+	 *  is supported.
+	 *
+	 *  @param mode The serialization mode.
+	 *  @param stream The stream to write to. Must be opened in binary
+	 *  mode. */
+	void serialize(Mode mode, std::ostream &stream) const;
+private:
+	/** Status of an entry that has not been added. */
+	static constexpr unsigned char EMPTY = 0;
+
+	/** Status of an entry that is being written. */
+	static constexpr unsigned char WRITING = 1;
+
+	/** Status of an entry that has been added. */
+	static constexpr unsigned char READY = 2;
+
+	/** Number of mesh points. */
+	unsigned int meshSize;
+
+	/** Number of orbitals. */
+	unsigned int numOrbitals;
+
+	/** Number of energies. */
+	unsigned int numEnergies;
+
+	/** Number of entries. */
+	std::uint64_t numEntries;
+
+	/** Storage for the status flags. */
+	std::vector<unsigned char> statusStorage;
+
+	/** Storage for the data when not memory mapped. */
+	std::vector<std::complex<double>> dataStorage;
+
+	/** Memory mapped file holding the status flags and data. */
+	MemoryMappedFile memoryMappedFile;
+
+	/** Status flag for each entry. */
+	unsigned char *status;
+
+	/** Status flags in the memory mapped file, or nullptr unless the file
+	 *  is mapped with MemoryMappedFile::Mode::ReadWrite. */
+	unsigned char *mappedStatus;
+
+	/** The susceptibilities. */
+	std::complex<double> *data;
+
+	/** Write the fields of the Mode::Binary serialization. */
+	void writeBinary(BinaryWriter &writer) const;
+
+	/** Get the linear index of an entry. */
+	std::uint64_t getEntry(
+		unsigned int meshPoint,
+		const std::vector<int> &orbitalIndices
+	) const;
+};
+
+inline unsigned int SusceptibilityTensor::getMeshSize() const{
+	return meshSize;
+}
+
+inline unsigned int SusceptibilityTensor::getNumOrbitals() const{
+	return numOrbitals;
+}
+
+inline unsigned int SusceptibilityTensor::getNumEnergies() const{
+	return numEnergies;
+}
+
+inline const std::complex<double>* SusceptibilityTensor::get(
+	unsigned int meshPoint,
+	const std::vector<int> &orbitalIndices
+) const{
+	std::uint64_t entry = getEntry(meshPoint, orbitalIndices);
+
+	unsigned char entryStatus;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp atomic read
+#endif
+	entryStatus = status[entry];
+	if(entryStatus != READY)
+		return nullptr;
+
+	//Make sure the values written before the status was set are visible.
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp flush
+#endif
+
+	return data + entry*numEnergies;
+}
+
+inline std::uint64_t SusceptibilityTensor::getEntry(
+	unsigned int meshPoint,
+	const std::vector<int> &orbitalIndices
+) const{
+	return numOrbitals*(
+		numOrbitals*(
+			numOrbitals*(
+				numOrbitals*(std::uint64_t)meshPoint
+				+ orbitalIndices[0]
+			) + orbitalIndices[1]
+		) + orbitalIndices[2]
+	) + orbitalIndices[3];
+}
+
+};	//End of namespace TBTK
+
+#endif
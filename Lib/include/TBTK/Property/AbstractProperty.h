@@ -23,10 +23,16 @@
 #ifndef COM_DAFER45_TBTK_ABSTRACT_PROPERTY
 #define COM_DAFER45_TBTK_ABSTRACT_PROPERTY
 
+#include "TBTK/MemoryMappedFile.h"
 #include "TBTK/Property/IndexDescriptor.h"
 #include "TBTK/SpinMatrix.h"
 #include "TBTK/TBTKMacros.h"
 
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
 #include "TBTK/json.hpp"
 
 namespace TBTK{
@@ -44,19 +50,20 @@ public:
 	unsigned int getBlockSize() const;
 
 	/** Set size. */
-	void setSize(unsigned int size);
+	void setSize(std::uint64_t size);
 
 	/** Get size. */
-	unsigned int getSize() const;
+	std::uint64_t getSize() const;
 
-	/** Get data. */
+	/** Get data. Unless the AbstractProperty is memory mapped, the data
+	 *  is aligned to DATA_ALIGNMENT bytes. */
 	const DataType* getData() const;
 
 	/** Same as getData, but with write access. */
 	DataType* getDataRW();
 
 	/** Get size in bytes. */
-	unsigned int getSizeInBytes() const;
+	std::uint64_t getSizeInBytes() const;
 
 	/** Returns data on raw format. Intended for use in serialization. */
 	char* getRawData();
@@ -69,7 +76,7 @@ public:
 	std::vector<int> getRanges() const;
 
 	/** Get the offset in memory for given Index. */
-	int getOffset(const Index &index) const;
+	std::int64_t getOffset(const Index &index) const;
 
 	/** Get IndexDescriptor. */
 	const IndexDescriptor& getIndexDescriptor() const;
@@ -84,10 +91,10 @@ public:
 	virtual DataType& operator()(const Index &index, unsigned int offset = 0);
 
 	/** Function call operator. */
-	virtual const DataType& operator()(unsigned int offset) const;
+	virtual const DataType& operator()(std::uint64_t offset) const;
 
 	/** Function call operator. */
-	virtual DataType& operator()(unsigned int offset);
+	virtual DataType& operator()(std::uint64_t offset);
 
 	/** Set whether access of index not contained in the Property is
 	 *  allowed or not. If eneabled, remember to also initialize the value
@@ -100,8 +107,68 @@ public:
 	 *  AbstractProperty::setAllowIndexOutOfBoundsAccess(true) is called. */
 	void setDefaultValue(const DataType &defaultValue);
 
+	/** Returns true if the data is accessed in place in a memory mapped
+	 *  file. */
+	bool isMemoryMapped() const;
+
+	/** Addition assignment operator. Adds the data of an AbstractProperty
+	 *  with the same memory layout element by element.
+	 *
+	 *  @param rhs The AbstractProperty to add.
+	 *
+	 *  @return The AbstractProperty after the addition. */
+	AbstractProperty& operator+=(const AbstractProperty &rhs);
+
+	/** Subtraction assignment operator. Subtracts the data of an
+	 *  AbstractProperty with the same memory layout element by element.
+	 *
+	 *  @param rhs The AbstractProperty to subtract.
+	 *
+	 *  @return The AbstractProperty after the subtraction. */
+	AbstractProperty& operator-=(const AbstractProperty &rhs);
+
+	/** Multiplication assignment operator. Multiplies every element by a
+	 *  scalar.
+	 *
+	 *  @param rhs The scalar to multiply by.
+	 *
+	 *  @return The AbstractProperty after the multiplication. */
+	AbstractProperty& operator*=(const DataType &rhs);
+
+	/** Division assignment operator. Divides every element by a scalar.
+	 *
+	 *  @param rhs The scalar to divide by.
+	 *
+	 *  @return The AbstractProperty after the division. */
+	AbstractProperty& operator/=(const DataType &rhs);
+
+	/** Add a scaled AbstractProperty with the same memory layout, that is,
+	 *  perform this = this + a*x in place. Useful for example to
+	 *  accumulate weighted averages over disorder realizations without
+	 *  temporaries.
+	 *
+	 *  @param a The scale factor.
+	 *  @param x The AbstractProperty to scale and add. */
+	void axpy(const DataType &a, const AbstractProperty &x);
+
+	/** Sum the blocks for all Indices that match a pattern. For example,
+	 *  for an LDOS with Indices {x, y, spin}, the pattern
+	 *  {IDX_ALL, IDX_ALL, 0} gives the spin up density of states summed
+	 *  over all sites. Only supported for the IndexDescriptor format
+	 *  Custom.
+	 *
+	 *  @param pattern Index pattern that can contain wildcards.
+	 *
+	 *  @return A vector with blockSize elements containing the sum. */
+	std::vector<DataType> sum(const Index &pattern) const;
+
 	/** Implements Serializeable::serialize(). */
 	virtual std::string serialize(Mode mode) const;
+
+	/** Alignment in bytes of the data allocated by the AbstractProperty.
+	 *  Corresponds to a cache line and is sufficient for any vector
+	 *  instruction set. */
+	static constexpr std::size_t DATA_ALIGNMENT = 64;
 protected:
 	/** Constructor. */
 	AbstractProperty();
@@ -158,6 +225,25 @@ protected:
 		Mode mode
 	);
 
+	/** Constructor. Constructs the AbstractProperty from a memory mapped
+	 *  file containing a Serializeable::Mode::Binary serialization of a
+	 *  Property. The IndexDescriptor is read immediately, while the data
+	 *  is accessed in place and only read from disk once it is accessed.
+	 *
+	 *  @param file The memory mapped file. Modifications are stored in
+	 *  the file if it is mapped with MemoryMappedFile::Mode::ReadWrite.
+	 *  If the file is mapped with MemoryMappedFile::Mode::ReadOnly, the
+	 *  data is copied into memory the first time it is accessed through
+	 *  a function that gives write access, such as the non-const
+	 *  function call operators. This first access is not thread safe.
+	 *  @param reader A BinaryReader for the serialization of the Property
+	 *  in the file. Passed in by the Property, so that the file only is
+	 *  parsed once. */
+	AbstractProperty(
+		const MemoryMappedFile &file,
+		const BinaryReader &reader
+	);
+
 	/** Destructor. */
 	virtual ~AbstractProperty();
 
@@ -166,6 +252,30 @@ protected:
 
 	/** Move assignment operator. */
 	AbstractProperty& operator=(AbstractProperty &&abstractProperty);
+
+	/** Minimum number of elements for which the element-wise operations
+	 *  are parallelized. */
+	static constexpr std::uint64_t PARALLELIZATION_THRESHOLD = 65536;
+
+	/** Assert that an AbstractProperty has the same memory layout and
+	 *  the same Indices. Overridden by Properties that also need to
+	 *  agree on for example the energy window.
+	 *
+	 *  @param abstractProperty The AbstractProperty to compare with.
+	 *  @param functionName The name of the calling function, used in the
+	 *  error message. */
+	virtual void assertCompatibleLayout(
+		const AbstractProperty &abstractProperty,
+		const std::string &functionName
+	) const;
+
+	/** Write the AbstractProperty as the nested object
+	 *  "abstractProperty" of the Serializeable::Mode::Binary
+	 *  serialization of a derived Property. The data is written directly
+	 *  to the destination of the BinaryWriter.
+	 *
+	 *  @param writer The BinaryWriter of the derived Property. */
+	void writeBinary(BinaryWriter &writer) const;
 private:
 	/** IndexDescriptor describing the memory layout of the data. */
 	IndexDescriptor indexDescriptor;
@@ -176,7 +286,7 @@ private:
 	unsigned int blockSize;
 
 	/** Number of data elements. */
-	unsigned int size;
+	std::uint64_t size;
 
 	/** Data. */
 	DataType *data;
@@ -186,8 +296,65 @@ private:
 
 	/** Default value used for out of bounds access. */
 	DataType defaultValue;
+
+	/** The file that data points into if the AbstractProperty is memory
+	 *  mapped. */
+	MemoryMappedFile memoryMappedFile;
+
+	/** Copy the data into memory and release the memory mapped file if
+	 *  the file is mapped read only. Called by every function that gives
+	 *  write access to the data. */
+	void makeWritable();
+
+	/** Release the data, either by deleting it or by releasing the memory
+	 *  mapped file. */
+	void releaseData();
+
+	/** Allocate data aligned to DATA_ALIGNMENT bytes. Elements are
+	 *  default constructed unless the DataType is trivially default
+	 *  constructible, in which case they are left uninitialized.
+	 *
+	 *  @param size The number of elements.
+	 *
+	 *  @return Pointer to the data, or nullptr if size is zero. */
+	static DataType* allocateData(std::uint64_t size);
+
+	/** Destruct and free data allocated with allocateData(). Destructors
+	 *  are only called if the DataType is not trivially destructible.
+	 *
+	 *  @param data The data.
+	 *  @param size The number of elements. */
+	static void freeData(DataType *data, std::uint64_t size);
+
+	/** Serialize on the Serializeable::Mode::Binary format. The data is
+	 *  stored as a single contiguous block. */
+	std::string serializeBinary() const;
+
+	/** Write the fields of the Serializeable::Mode::Binary format.
+	 *
+	 *  @param writer The BinaryWriter to write to. */
+	void writeBinaryFields(BinaryWriter &writer) const;
+
+	/** Read the members from a serialization string on the
+	 *  Serializeable::Mode::Binary format. The IndexDescriptor is assumed
+	 *  to already have been constructed. */
+	void deserializeBinary(const std::string &serialization);
 };
 
+template<typename DataType, bool isFundamental, bool isSerializeable>
+constexpr std::size_t AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::DATA_ALIGNMENT;
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+constexpr std::uint64_t AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::PARALLELIZATION_THRESHOLD;
+
 template<typename DataType, bool isFundamental, bool isSerializeable>
 inline unsigned int AbstractProperty<
 	DataType,
@@ -202,15 +369,14 @@ inline void AbstractProperty<
 	DataType,
 	isFundamental,
 	isSerializeable
->::setSize(unsigned int size){
+>::setSize(std::uint64_t size){
+	releaseData();
 	this->size = size;
-	if(data != nullptr)
-		delete [] data;
-	data = new DataType[size];
+	data = allocateData(size);
 }
 
 template<typename DataType, bool isFundamental, bool isSerializeable>
-inline unsigned int AbstractProperty<
+inline std::uint64_t AbstractProperty<
 	DataType,
 	isFundamental,
 	isSerializeable
@@ -233,11 +399,13 @@ inline DataType* AbstractProperty<
 	isFundamental,
 	isSerializeable
 >::getDataRW(){
+	makeWritable();
+
 	return data;
 }
 
 template<typename DataType, bool isFundamental, bool isSerializeable>
-inline unsigned int AbstractProperty<
+inline std::uint64_t AbstractProperty<
 	DataType,
 	isFundamental,
 	isSerializeable
@@ -251,6 +419,8 @@ inline char* AbstractProperty<
 	isFundamental,
 	isSerializeable
 >::getRawData(){
+	makeWritable();
+
 	return (char*)data;
 }
 
@@ -274,14 +444,14 @@ inline std::vector<int> AbstractProperty<
 }
 
 template<typename DataType, bool isFundamental, bool isSerializeable>
-inline int AbstractProperty<
+inline std::int64_t AbstractProperty<
 	DataType,
 	isFundamental,
 	isSerializeable
 >::getOffset(
 	const Index &index
 ) const{
-	return blockSize*indexDescriptor.getLinearIndex(
+	return (std::int64_t)blockSize*indexDescriptor.getLinearIndex(
 		index,
 		allowIndexOutOfBoundsAccess
 	);
@@ -318,7 +488,7 @@ inline const DataType& AbstractProperty<
 	unsigned int offset
 ) const{
 //	return data[getOffset(index) + offset];
-	int indexOffset = getOffset(index);
+	std::int64_t indexOffset = getOffset(index);
 	if(indexOffset < 0)
 		return defaultValue;
 	else
@@ -334,8 +504,9 @@ inline DataType& AbstractProperty<
 	const Index &index,
 	unsigned int offset
 ){
+	makeWritable();
 //	return data[getOffset(index) + offset];
-	int indexOffset = getOffset(index);
+	std::int64_t indexOffset = getOffset(index);
 	if(indexOffset < 0){
 		static DataType defaultValueNonConst = defaultValue;
 		return defaultValueNonConst;
@@ -350,7 +521,7 @@ inline const DataType& AbstractProperty<
 	DataType,
 	isFundamental,
 	isSerializeable
->::operator()(unsigned int offset) const{
+>::operator()(std::uint64_t offset) const{
 	return data[offset];
 }
 
@@ -359,7 +530,9 @@ inline DataType& AbstractProperty<
 	DataType,
 	isFundamental,
 	isSerializeable
->::operator()(unsigned int offset){
+>::operator()(std::uint64_t offset){
+	makeWritable();
+
 	return data[offset];
 }
 
@@ -381,6 +554,357 @@ inline void AbstractProperty<
 	this->defaultValue = defaultValue;
 }
 
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline bool AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::isMemoryMapped() const{
+	return memoryMappedFile.isMapped();
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>& AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::operator+=(const AbstractProperty &rhs){
+	assertCompatibleLayout(rhs, "operator+=()");
+	makeWritable();
+
+	DataType *lhsData = data;
+	const DataType *rhsData = rhs.data;
+	const std::uint64_t size = this->size;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD)
+#endif
+	for(std::uint64_t n = 0; n < size; n++)
+		lhsData[n] += rhsData[n];
+
+	return *this;
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>& AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::operator-=(const AbstractProperty &rhs){
+	assertCompatibleLayout(rhs, "operator-=()");
+	makeWritable();
+
+	DataType *lhsData = data;
+	const DataType *rhsData = rhs.data;
+	const std::uint64_t size = this->size;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD)
+#endif
+	for(std::uint64_t n = 0; n < size; n++)
+		lhsData[n] -= rhsData[n];
+
+	return *this;
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>& AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::operator*=(const DataType &rhs){
+	makeWritable();
+
+	DataType *lhsData = data;
+	const DataType factor = rhs;
+	const std::uint64_t size = this->size;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD)
+#endif
+	for(std::uint64_t n = 0; n < size; n++)
+		lhsData[n] *= factor;
+
+	return *this;
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>& AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::operator/=(const DataType &rhs){
+	makeWritable();
+
+	DataType *lhsData = data;
+	const DataType divisor = rhs;
+	const std::uint64_t size = this->size;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD)
+#endif
+	for(std::uint64_t n = 0; n < size; n++)
+		lhsData[n] /= divisor;
+
+	return *this;
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline void AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::axpy(const DataType &a, const AbstractProperty &x){
+	assertCompatibleLayout(x, "axpy()");
+	makeWritable();
+
+	DataType *yData = data;
+	const DataType *xData = x.data;
+	const DataType factor = a;
+	const std::uint64_t size = this->size;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD)
+#endif
+	for(std::uint64_t n = 0; n < size; n++)
+		yData[n] += factor*xData[n];
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline std::vector<DataType> AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::sum(const Index &pattern) const{
+	TBTKAssert(
+		indexDescriptor.getFormat() == IndexDescriptor::Format::Custom,
+		"AbstractProperty::sum()",
+		"Only supported for the IndexDescriptor format Custom.",
+		""
+	);
+
+	std::vector<Index> indices
+		= indexDescriptor.getIndexTree().getIndexList(pattern);
+	std::vector<std::uint64_t> offsets;
+	offsets.reserve(indices.size());
+	for(unsigned int n = 0; n < indices.size(); n++)
+		offsets.push_back(getOffset(indices[n]));
+
+	//Each thread sums a separate set of blocks into a partial sum, which
+	//keeps the memory access contiguous and also parallelizes the case
+	//of many small blocks. The partial sums are added at the end.
+	std::vector<DataType> result(blockSize, DataType());
+#ifdef TBTK_USE_OPEN_MP
+	const std::uint64_t numElements = blockSize*offsets.size();
+	#pragma omp parallel if(numElements > PARALLELIZATION_THRESHOLD)
+#endif
+	{
+		std::vector<DataType> partialSum(blockSize, DataType());
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp for
+#endif
+		for(unsigned int n = 0; n < offsets.size(); n++){
+			const DataType *block = data + offsets[n];
+			for(unsigned int e = 0; e < blockSize; e++)
+				partialSum[e] += block[e];
+		}
+
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp critical
+#endif
+		for(unsigned int e = 0; e < blockSize; e++)
+			result[e] += partialSum[e];
+	}
+
+	return result;
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline void AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::assertCompatibleLayout(
+	const AbstractProperty &abstractProperty,
+	const std::string &functionName
+) const{
+	TBTKAssert(
+		size == abstractProperty.size
+		&& blockSize == abstractProperty.blockSize
+		&& indexDescriptor.getFormat()
+			== abstractProperty.indexDescriptor.getFormat(),
+		"AbstractProperty::" + functionName,
+		"Incompatible memory layouts. The left hand side has size "
+		<< size << " and block size " << blockSize << ", while the"
+		<< " right hand side has size " << abstractProperty.size
+		<< " and block size " << abstractProperty.blockSize << ".",
+		"Both sides must have been created with the same Indices and"
+		<< " block size."
+	);
+
+	switch(indexDescriptor.getFormat()){
+	case IndexDescriptor::Format::Ranges:
+		TBTKAssert(
+			indexDescriptor.getRanges()
+				== abstractProperty.indexDescriptor.getRanges(),
+			"AbstractProperty::" + functionName,
+			"Incompatible ranges.",
+			"Both sides must have been created with the same ranges."
+		);
+		break;
+	case IndexDescriptor::Format::Custom:
+	{
+		const IndexTree &indexTree = indexDescriptor.getIndexTree();
+		const IndexTree &rhsIndexTree
+			= abstractProperty.indexDescriptor.getIndexTree();
+		TBTKAssert(
+			&indexTree == &rhsIndexTree
+			|| indexTree.equals(rhsIndexTree),
+			"AbstractProperty::" + functionName,
+			"Incompatible Indices.",
+			"Both sides must have been created with the same"
+			<< " Indices."
+		);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline void AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::releaseData(){
+	if(memoryMappedFile.isMapped())
+		memoryMappedFile = MemoryMappedFile();
+	else if(data != nullptr)
+		freeData(data, size);
+	data = nullptr;
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline void AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::makeWritable(){
+	if(!memoryMappedFile.isMapped() || memoryMappedFile.isWritable())
+		return;
+
+	DataType *copy = allocateData(size);
+	for(std::uint64_t n = 0; n < size; n++)
+		copy[n] = data[n];
+	memoryMappedFile = MemoryMappedFile();
+	data = copy;
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline DataType* AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::allocateData(std::uint64_t size){
+	if(size == 0)
+		return nullptr;
+
+	void *memory;
+	TBTKAssert(
+		posix_memalign(&memory, DATA_ALIGNMENT, size*sizeof(DataType))
+			== 0,
+		"AbstractProperty::allocateData()",
+		"Unable to allocate " << size*sizeof(DataType) << " bytes.",
+		""
+	);
+
+	DataType *data = (DataType*)memory;
+	if(!std::is_trivially_default_constructible<DataType>::value)
+		for(std::uint64_t n = 0; n < size; n++)
+			new (&data[n]) DataType();
+
+	return data;
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline void AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::freeData(DataType *data, std::uint64_t size){
+	if(!std::is_trivially_destructible<DataType>::value)
+		for(std::uint64_t n = 0; n < size; n++)
+			data[n].~DataType();
+	free(data);
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline std::string AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::serializeBinary() const{
+	BinaryWriter writer("AbstractProperty");
+	writeBinaryFields(writer);
+
+	return writer.releaseSerialization();
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline void AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::writeBinary(BinaryWriter &writer) const{
+	writer.writeObject(
+		"abstractProperty",
+		"AbstractProperty",
+		[this](BinaryWriter &abstractPropertyWriter){
+			writeBinaryFields(abstractPropertyWriter);
+		}
+	);
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline void AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::writeBinaryFields(BinaryWriter &writer) const{
+	writer.writeString(
+		"indexDescriptor",
+		indexDescriptor.serialize(Mode::Binary)
+	);
+	writer.write("blockSize", blockSize);
+	writer.write("size", size);
+	writer.writeArray("data", data, size);
+}
+
+template<typename DataType, bool isFundamental, bool isSerializeable>
+inline void AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::deserializeBinary(const std::string &serialization){
+	BinaryReader reader(serialization, "AbstractProperty");
+	blockSize = reader.read<unsigned int>("blockSize");
+	size = reader.getArraySize<DataType>("data");
+	data = allocateData(size);
+	reader.readArray("data", data);
+}
+
 template<>
 inline std::string AbstractProperty<
 	bool,
@@ -397,15 +921,18 @@ inline std::string AbstractProperty<
 		);
 		j["blockSize"] = blockSize;
 		j["size"] = size;
-		for(unsigned int n = 0; n < size; n++)
+		for(std::uint64_t n = 0; n < size; n++)
 			j["data"].push_back(data[n]);
 
 		return j.dump();
 	}
+	case Mode::Binary:
+		return serializeBinary();
 	default:
 		TBTKExit(
 			"AbstractProperty<DataType>::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -427,15 +954,18 @@ inline std::string AbstractProperty<
 		);
 		j["blockSize"] = blockSize;
 		j["size"] = size;
-		for(unsigned int n = 0; n < size; n++)
+		for(std::uint64_t n = 0; n < size; n++)
 			j["data"].push_back(data[n]);
 
 		return j.dump();
 	}
+	case Mode::Binary:
+		return serializeBinary();
 	default:
 		TBTKExit(
 			"AbstractProperty<DataType>::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -457,15 +987,18 @@ inline std::string AbstractProperty<
 		);
 		j["blockSize"] = blockSize;
 		j["size"] = size;
-		for(unsigned int n = 0; n < size; n++)
+		for(std::uint64_t n = 0; n < size; n++)
 			j["data"].push_back(data[n]);
 
 		return j.dump();
 	}
+	case Mode::Binary:
+		return serializeBinary();
 	default:
 		TBTKExit(
 			"AbstractProperty<DataType>::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -487,15 +1020,18 @@ inline std::string AbstractProperty<
 		);
 		j["blockSize"] = blockSize;
 		j["size"] = size;
-		for(unsigned int n = 0; n < size; n++)
+		for(std::uint64_t n = 0; n < size; n++)
 			j["data"].push_back(data[n]);
 
 		return j.dump();
 	}
+	case Mode::Binary:
+		return serializeBinary();
 	default:
 		TBTKExit(
 			"AbstractProperty<DataType>::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -517,15 +1053,18 @@ inline std::string AbstractProperty<
 		);
 		j["blockSize"] = blockSize;
 		j["size"] = size;
-		for(unsigned int n = 0; n < size; n++)
+		for(std::uint64_t n = 0; n < size; n++)
 			j["data"].push_back(data[n]);
 
 		return j.dump();
 	}
+	case Mode::Binary:
+		return serializeBinary();
 	default:
 		TBTKExit(
 			"AbstractProperty<DataType>::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -543,7 +1082,7 @@ inline std::string AbstractProperty<std::complex<double>, false, false>::seriali
 		);
 		j["blockSize"] = blockSize;
 		j["size"] = size;
-		for(unsigned int n = 0; n < size; n++){
+		for(std::uint64_t n = 0; n < size; n++){
 //			std::stringstream ss;
 //			ss << "(" << real(data[n]) << "," << imag(data[n]) << ")";
 			std::string s = Serializeable::serialize(data[n], mode);
@@ -552,10 +1091,13 @@ inline std::string AbstractProperty<std::complex<double>, false, false>::seriali
 
 		return j.dump();
 	}
+	case Mode::Binary:
+		return serializeBinary();
 	default:
 		TBTKExit(
 			"AbstractProperty<DataType>::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -593,8 +1135,8 @@ AbstractProperty<
 	this->blockSize = blockSize;
 
 	size = blockSize;
-	data = new DataType[size];
-	for(unsigned int n = 0; n < size; n++)
+	data = allocateData(size);
+	for(std::uint64_t n = 0; n < size; n++)
 		data[n] = 0.;
 }
 
@@ -612,8 +1154,8 @@ AbstractProperty<
 	this->blockSize = blockSize;
 
 	size = blockSize;
-	this->data = new DataType[size];
-	for(unsigned int n = 0; n < size; n++)
+	this->data = allocateData(size);
+	for(std::uint64_t n = 0; n < size; n++)
 		this->data[n] = data[n];
 }
 
@@ -638,8 +1180,8 @@ AbstractProperty<
 	indexDescriptor.setRanges(ranges, dimensions);
 
 	size = blockSize*indexDescriptor.getSize();
-	data = new DataType[size];
-	for(unsigned int n = 0; n < size; n++)
+	data = allocateData(size);
+	for(std::uint64_t n = 0; n < size; n++)
 		data[n] = 0.;
 }
 
@@ -665,8 +1207,8 @@ AbstractProperty<
 	indexDescriptor.setRanges(ranges, dimensions);
 
 	size = blockSize*indexDescriptor.getSize();
-	this->data = new DataType[size];
-	for(unsigned int n = 0; n < size; n++)
+	this->data = allocateData(size);
+	for(std::uint64_t n = 0; n < size; n++)
 		this->data[n] = data[n];
 }
 
@@ -686,8 +1228,8 @@ AbstractProperty<
 	indexDescriptor.setIndexTree(indexTree);
 
 	size = blockSize*indexDescriptor.getSize();
-	data = new DataType[size];
-	for(unsigned int n = 0; n < size; n++)
+	data = allocateData(size);
+	for(std::uint64_t n = 0; n < size; n++)
 		data[n] = 0.;
 }
 
@@ -708,8 +1250,8 @@ AbstractProperty<
 	indexDescriptor.setIndexTree(indexTree);
 
 	size = blockSize*indexDescriptor.getSize();
-	this->data = new DataType[size];
-	for(unsigned int n = 0; n < size; n++)
+	this->data = allocateData(size);
+	for(std::uint64_t n = 0; n < size; n++)
 		this->data[n] = data[n];
 }
 
@@ -730,8 +1272,8 @@ AbstractProperty<
 		data = nullptr;
 	}
 	else{
-		data = new DataType[size];
-		for(unsigned int n = 0; n < size; n++)
+		data = allocateData(size);
+		for(std::uint64_t n = 0; n < size; n++)
 			data[n] = abstractProperty.data[n];
 	}
 }
@@ -755,9 +1297,41 @@ AbstractProperty<
 	else{
 		data = abstractProperty.data;
 		abstractProperty.data = nullptr;
+		memoryMappedFile = std::move(abstractProperty.memoryMappedFile);
 	}
 }
 
+template<typename DataType, bool isFundamental, bool isSerializeable>
+AbstractProperty<
+	DataType,
+	isFundamental,
+	isSerializeable
+>::AbstractProperty(
+	const MemoryMappedFile &file,
+	const BinaryReader &reader
+) :
+	indexDescriptor(IndexDescriptor::Format::None),
+	memoryMappedFile(file)
+{
+	BinaryReader abstractPropertyReader = reader.getReader(
+		"abstractProperty",
+		"AbstractProperty"
+	);
+	indexDescriptor = IndexDescriptor(
+		abstractPropertyReader.readString("indexDescriptor"),
+		Mode::Binary
+	);
+	blockSize = abstractPropertyReader.read<unsigned int>("blockSize");
+	size = abstractPropertyReader.getArraySize<DataType>("data");
+
+	//If the mapping is read only, the data is copied to memory by
+	//makeWritable() before it is modified, which makes it safe to cast
+	//away the constness.
+	data = const_cast<DataType*>(
+		abstractPropertyReader.getArrayData<DataType>("data")
+	);
+}
+
 template<>
 inline AbstractProperty<double, true, false>::AbstractProperty(
 	const std::string &serialization,
@@ -781,10 +1355,10 @@ inline AbstractProperty<double, true, false>::AbstractProperty(
 		try{
 			nlohmann::json j = nlohmann::json::parse(serialization);
 			blockSize = j.at("blockSize").get<unsigned int>();
-			size = j.at("size").get<unsigned int>();
-			data = new double[size];
+			size = j.at("size").get<std::uint64_t>();
+			data = allocateData(size);
 			nlohmann::json d = j.at("data");
-			unsigned int counter = 0;
+			std::uint64_t counter = 0;
 			for(
 				nlohmann::json::iterator it = d.begin();
 				it < d.end();
@@ -803,11 +1377,16 @@ inline AbstractProperty<double, true, false>::AbstractProperty(
 			);
 		}
 
+		break;
+	case Mode::Binary:
+		deserializeBinary(serialization);
+
 		break;
 	default:
 		TBTKExit(
 			"AbstractProperty::AbstractProperty()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -836,10 +1415,10 @@ inline AbstractProperty<std::complex<double>, false, false>::AbstractProperty(
 		try{
 			nlohmann::json j = nlohmann::json::parse(serialization);
 			blockSize = j.at("blockSize").get<unsigned int>();
-			size = j.at("size").get<unsigned int>();
-			data = new std::complex<double>[size];
+			size = j.at("size").get<std::uint64_t>();
+			data = allocateData(size);
 			nlohmann::json d = j.at("data");
-			unsigned int counter = 0;
+			std::uint64_t counter = 0;
 			for(
 				nlohmann::json::iterator it = d.begin();
 				it < d.end();
@@ -860,11 +1439,16 @@ inline AbstractProperty<std::complex<double>, false, false>::AbstractProperty(
 			);
 		}
 
+		break;
+	case Mode::Binary:
+		deserializeBinary(serialization);
+
 		break;
 	default:
 		TBTKExit(
 			"AbstractProperty::AbstractProperty()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -889,8 +1473,7 @@ inline AbstractProperty<
 	isFundamental,
 	isSerializeable
 >::~AbstractProperty(){
-	if(data != nullptr)
-		delete [] data;
+	releaseData();
 }
 
 template<typename DataType, bool isFundamental, bool isSerializeable>
@@ -910,16 +1493,15 @@ AbstractProperty<
 
 		blockSize = rhs.blockSize;
 
+		releaseData();
 		size = rhs.size;
-		if(data != nullptr)
-			delete [] data;
 
 		if(rhs.data == nullptr){
 			data = nullptr;
 		}
 		else{
-			data = new DataType[size];
-			for(unsigned int n = 0; n < size; n++)
+			data = allocateData(size);
+			for(std::uint64_t n = 0; n < size; n++)
 				data[n] = rhs.data[n];
 		}
 	}
@@ -944,9 +1526,8 @@ AbstractProperty<
 
 		blockSize = rhs.blockSize;
 
+		releaseData();
 		size = rhs.size;
-		if(data != nullptr)
-			delete [] data;
 
 		if(rhs.data == nullptr){
 			data = nullptr;
@@ -954,6 +1535,7 @@ AbstractProperty<
 		else{
 			data = rhs.data;
 			rhs.data = nullptr;
+			memoryMappedFile = std::move(rhs.memoryMappedFile);
 		}
 	}
 
@@ -51,6 +51,16 @@ public:
 	/** Constructor. Constructs the DOS from a serialization string. */
 	DOS(const std::string &serialization, Mode mode);
 
+	/** Constructor. Constructs the DOS from a memory mapped file
+	 *  containing a Serializeable::Mode::Binary serialization of the
+	 *  DOS. Only the header is read immediately, while the data is read
+	 *  from disk on demand when it is accessed.
+	 *
+	 *  @param file The memory mapped file. If the file is mapped with
+	 *  MemoryMappedFile::Mode::ReadOnly, the data is copied into memory
+	 *  the first time it is modified. */
+	DOS(const MemoryMappedFile &file);
+
 	/** Destructor. */
 	~DOS();
 
@@ -72,6 +82,17 @@ public:
 	/** Overrides AbstractProperty::serialize(). */
 	virtual std::string serialize(Mode mode) const;
 private:
+	/** Overrides AbstractProperty::assertCompatibleLayout(). Also asserts
+	 *  that the energy windows agree. */
+	virtual void assertCompatibleLayout(
+		const AbstractProperty<double> &abstractProperty,
+		const std::string &functionName
+	) const;
+
+	/** Constructor. Constructs the DOS from a BinaryReader for its
+	 *  serialization in a memory mapped file. */
+	DOS(const MemoryMappedFile &file, const BinaryReader &reader);
+
 	/** Lower bound for the energy. */
 	double lowerBound;
 
@@ -54,6 +54,16 @@ public:
 	 */
 	Density(const std::string &serialization, Mode mode);
 
+	/** Constructor. Constructs the Density from a memory mapped file
+	 *  containing a Serializeable::Mode::Binary serialization of the
+	 *  Density. Only the header is read immediately, while the data is read
+	 *  from disk on demand when it is accessed.
+	 *
+	 *  @param file The memory mapped file. If the file is mapped with
+	 *  MemoryMappedFile::Mode::ReadOnly, the data is copied into memory
+	 *  the first time it is modified. */
+	Density(const MemoryMappedFile &file);
+
 	/** Destructor. */
 	~Density();
 
@@ -72,6 +82,9 @@ public:
 	/** Overrider AbstractProperty::serialize(). */
 	virtual std::string serialize(Mode mode) const;
 private:
+	/** Constructor. Constructs the Density from a BinaryReader for its
+	 *  serialization in a memory mapped file. */
+	Density(const MemoryMappedFile &file, const BinaryReader &reader);
 };
 
 };	//End namespace Property
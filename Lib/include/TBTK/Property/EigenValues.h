@@ -47,6 +47,16 @@ public:
 	 *  string. */
 	EigenValues(const std::string &serialization, Mode mode);
 
+	/** Constructor. Constructs the EigenValues from a memory mapped file
+	 *  containing a Serializeable::Mode::Binary serialization of the
+	 *  EigenValues. Only the header is read immediately, while the data is read
+	 *  from disk on demand when it is accessed.
+	 *
+	 *  @param file The memory mapped file. If the file is mapped with
+	 *  MemoryMappedFile::Mode::ReadOnly, the data is copied into memory
+	 *  the first time it is modified. */
+	EigenValues(const MemoryMappedFile &file);
+
 	/** Destructor. */
 	~EigenValues();
 
@@ -59,6 +69,9 @@ public:
 	/** Overrides AbstractProperty::serialize(). */
 	std::string serialize(Mode mode) const;
 private:
+	/** Constructor. Constructs the EigenValues from a BinaryReader for its
+	 *  serialization in a memory mapped file. */
+	EigenValues(const MemoryMappedFile &file, const BinaryReader &reader);
 };
 
 };	//End namespace Property
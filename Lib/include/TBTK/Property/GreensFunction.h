@@ -71,9 +71,26 @@ public:
 	/** Move constructor. */
 	GreensFunction(GreensFunction &&greensFunction);
 
+	/** Constructor. Construct the GreensFunction from a serialization
+	 *  string. */
+	GreensFunction(const std::string &serialization, Mode mode);
+
+	/** Constructor. Constructs the GreensFunction from a memory mapped
+	 *  file containing a Serializeable::Mode::Binary serialization of the
+	 *  GreensFunction. Only the header is read immediately, while the
+	 *  data is read from disk on demand when it is accessed.
+	 *
+	 *  @param file The memory mapped file. If the file is mapped with
+	 *  MemoryMappedFile::Mode::ReadOnly, the data is copied into memory
+	 *  the first time it is modified. */
+	GreensFunction(const MemoryMappedFile &file);
+
 	/** Destructor. */
 	~GreensFunction();
 
+	/** Get the Green's function type. */
+	Type getType() const;
+
 	/** Get lower bound for the energy. */
 	double getLowerBound() const;
 
@@ -91,7 +108,17 @@ public:
 
 	/** Move assignment operator. */
 	const GreensFunction& operator=(GreensFunction &&rhs);
+
+	/** Overrides AbstractProperty::serialize(). */
+	virtual std::string serialize(Mode mode) const;
 private:
+	/** Constructor. Constructs the GreensFunction from a BinaryReader for
+	 *  its serialization in a memory mapped file. */
+	GreensFunction(
+		const MemoryMappedFile &file,
+		const BinaryReader &reader
+	);
+
 	/** Green's function type. */
 	Type type;
 
@@ -108,6 +135,10 @@ private:
 //	std::complex<double> *data;
 };
 
+inline GreensFunction::Type GreensFunction::getType() const{
+	return type;
+}
+
 inline double GreensFunction::getLowerBound() const{
 	return lowerBound;
 }
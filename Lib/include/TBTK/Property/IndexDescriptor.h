@@ -27,6 +27,8 @@
 #include "TBTK/Serializeable.h"
 #include "TBTK/TBTKMacros.h"
 
+#include <cstdint>
+
 namespace TBTK{
 
 /** @brief Describes the index structure of data stored for several indices. */
@@ -88,8 +90,10 @@ public:
 		bool returnNegativeForMissingIndex = false
 	) const;
 
-	/** Get size. */
-	unsigned int getSize() const;
+	/** Get size.
+	 *
+	 *  @return The number of Indices described by the IndexDescriptor. */
+	std::uint64_t getSize() const;
 
 	/** Returns true if the index descriptor contains the given index. */
 	bool contains(const Index &index) const;
@@ -24,6 +24,7 @@
 #define COM_DAFER45_TBTK_LDOS
 
 #include "TBTK/Property/AbstractProperty.h"
+#include "TBTK/Property/Density.h"
 //#include "IndexDescriptor.h"
 
 namespace TBTK{
@@ -77,6 +78,16 @@ public:
 	/** Constructor. Construct the LDOS from a serialization string. */
 	LDOS(const std::string &serialization, Mode mode);
 
+	/** Constructor. Constructs the LDOS from a memory mapped file
+	 *  containing a Serializeable::Mode::Binary serialization of the
+	 *  LDOS. Only the header is read immediately, while the data is read
+	 *  from disk on demand when it is accessed.
+	 *
+	 *  @param file The memory mapped file. If the file is mapped with
+	 *  MemoryMappedFile::Mode::ReadOnly, the data is copied into memory
+	 *  the first time it is modified. */
+	LDOS(const MemoryMappedFile &file);
+
 	/** Destructor. */
 	~LDOS();
 
@@ -89,6 +100,22 @@ public:
 	/** Get energy resolution. (Number of energy intervals) */
 	int getResolution() const;
 
+	/** Integrate the LDOS over the full energy range.
+	 *
+	 *  @return A Density with the same Indices as the LDOS. */
+	Density integrate() const;
+
+	/** Integrate the LDOS over an energy interval. Energy intervals of
+	 *  the LDOS are included if their center lies between the limits. For
+	 *  example, integrating up to the chemical potential at zero
+	 *  temperature gives the Density.
+	 *
+	 *  @param lowerLimit The lower limit of the integration.
+	 *  @param upperLimit The upper limit of the integration.
+	 *
+	 *  @return A Density with the same Indices as the LDOS. */
+	Density integrate(double lowerLimit, double upperLimit) const;
+
 	/** Assignment operator. */
 	LDOS& operator=(const LDOS &ldos);
 
@@ -98,6 +125,17 @@ public:
 	/** Overrides AbstractProperty::serialize(). */
 	virtual std::string serialize(Mode mode) const;
 private:
+	/** Overrides AbstractProperty::assertCompatibleLayout(). Also asserts
+	 *  that the energy windows agree. */
+	virtual void assertCompatibleLayout(
+		const AbstractProperty<double> &abstractProperty,
+		const std::string &functionName
+	) const;
+
+	/** Constructor. Constructs the LDOS from a BinaryReader for its
+	 *  serialization in a memory mapped file. */
+	LDOS(const MemoryMappedFile &file, const BinaryReader &reader);
+
 	/** Lower bound for the energy. */
 	double lowerBound;
 
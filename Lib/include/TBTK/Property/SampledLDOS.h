@@ -0,0 +1,178 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @package TBTKcalc
+ *  @file SampledLDOS.h
+ *  @brief Property container for the local density of states (LDOS) at an
+ *  explicit list of energies.
+ *
+ *  @author Kristofer Björnson
+ */
+
+#ifndef COM_DAFER45_TBTK_SAMPLED_LDOS
+#define COM_DAFER45_TBTK_SAMPLED_LDOS
+
+#include "TBTK/Property/AbstractProperty.h"
+
+#include <vector>
+
+namespace TBTK{
+namespace Property{
+
+/** @brief Property container for the local density of states (LDOS) at an
+ *  explicit list of energies.
+ *
+ *  In contrast to the LDOS, which stores the density of states on a uniform
+ *  energy grid, the SampledLDOS only stores the values at a given list of
+ *  increasing energies. This allows for example maps of the LDOS at a few
+ *  bias voltages to be stored without storing the full energy dependence.
+ *
+ *  Each value is a sample of the LDOS at the corresponding energy. The
+ *  energies are not bin boundaries, and the SampledLDOS therefore says
+ *  nothing about the spectral weight between the energies. How a sample is
+ *  obtained, for example the width of the energy window that it is
+ *  averaged over, is determined by the PropertyExtractor. */
+class SampledLDOS : public AbstractProperty<double>{
+public:
+	/** Constructor.
+	 *
+	 *  @param dimensions Number of dimensions of the grid.
+	 *  @param ranges The ranges of the grid.
+	 *  @param energies The energies at which the LDOS is stored. Must be
+	 *  strictly increasing. */
+	SampledLDOS(
+		int dimensions,
+		const int *ranges,
+		const std::vector<double> &energies
+	);
+
+	/** Constructor.
+	 *
+	 *  @param dimensions Number of dimensions of the grid.
+	 *  @param ranges The ranges of the grid.
+	 *  @param energies The energies at which the LDOS is stored. Must be
+	 *  strictly increasing.
+	 *  @param data Raw data to initialize the SampledLDOS with. */
+	SampledLDOS(
+		int dimensions,
+		const int *ranges,
+		const std::vector<double> &energies,
+		const double *data
+	);
+
+	/** Constructor.
+	 *
+	 *  @param indexTree IndexTree containing the Indices for which the
+	 *  SampledLDOS is stored.
+	 *  @param energies The energies at which the LDOS is stored. Must be
+	 *  strictly increasing. */
+	SampledLDOS(
+		const IndexTree &indexTree,
+		const std::vector<double> &energies
+	);
+
+	/** Constructor.
+	 *
+	 *  @param indexTree IndexTree containing the Indices for which the
+	 *  SampledLDOS is stored.
+	 *  @param energies The energies at which the LDOS is stored. Must be
+	 *  strictly increasing.
+	 *  @param data Raw data to initialize the SampledLDOS with. */
+	SampledLDOS(
+		const IndexTree &indexTree,
+		const std::vector<double> &energies,
+		const double *data
+	);
+
+	/** Copy constructor. */
+	SampledLDOS(const SampledLDOS &sampledLDOS);
+
+	/** Move constructor. */
+	SampledLDOS(SampledLDOS &&sampledLDOS);
+
+	/** Constructor. Construct the SampledLDOS from a serialization
+	 *  string. */
+	SampledLDOS(const std::string &serialization, Mode mode);
+
+	/** Constructor. Constructs the SampledLDOS from a memory mapped file
+	 *  containing a Serializeable::Mode::Binary serialization of the
+	 *  SampledLDOS.
+	 *
+	 *  @param file The memory mapped file. If the file is mapped with
+	 *  MemoryMappedFile::Mode::ReadOnly, the data is copied into memory
+	 *  the first time it is modified. */
+	SampledLDOS(const MemoryMappedFile &file);
+
+	/** Destructor. */
+	~SampledLDOS();
+
+	/** Get the number of energies. */
+	unsigned int getNumEnergies() const;
+
+	/** Get energy.
+	 *
+	 *  @param n The position of the energy in the list of energies.
+	 *
+	 *  @return The nth energy. */
+	double getEnergy(unsigned int n) const;
+
+	/** Get the energies. */
+	const std::vector<double>& getEnergies() const;
+
+	/** Assignment operator. */
+	SampledLDOS& operator=(const SampledLDOS &sampledLDOS);
+
+	/** Move assignment operator. */
+	SampledLDOS& operator=(SampledLDOS &&sampledLDOS);
+
+	/** Overrides AbstractProperty::serialize(). */
+	virtual std::string serialize(Mode mode) const;
+private:
+	/** Overrides AbstractProperty::assertCompatibleLayout(). Also asserts
+	 *  that the energies agree. */
+	virtual void assertCompatibleLayout(
+		const AbstractProperty<double> &abstractProperty,
+		const std::string &functionName
+	) const;
+
+	/** Constructor. Constructs the SampledLDOS from a BinaryReader for its
+	 *  serialization in a memory mapped file. */
+	SampledLDOS(const MemoryMappedFile &file, const BinaryReader &reader);
+
+	/** The energies at which the LDOS is stored. */
+	std::vector<double> energies;
+
+	/** Assert that the energies are strictly increasing. */
+	static const std::vector<double>& validateEnergies(
+		const std::vector<double> &energies
+	);
+};
+
+inline unsigned int SampledLDOS::getNumEnergies() const{
+	return energies.size();
+}
+
+inline double SampledLDOS::getEnergy(unsigned int n) const{
+	return energies.at(n);
+}
+
+inline const std::vector<double>& SampledLDOS::getEnergies() const{
+	return energies;
+}
+
+};	//End namespace Property
+};	//End namespace TBTK
+
+#endif
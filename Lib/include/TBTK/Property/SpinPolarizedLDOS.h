@@ -103,6 +103,13 @@ public:
 	/** Overrides AbstractProperty::serialize(). */
 	std::string serialize(Mode mode) const;
 private:
+	/** Overrides AbstractProperty::assertCompatibleLayout(). Also asserts
+	 *  that the energy windows agree. */
+	virtual void assertCompatibleLayout(
+		const AbstractProperty<SpinMatrix> &abstractProperty,
+		const std::string &functionName
+	) const;
+
 	/** Lower bound for the energy. */
 	double lowerBound;
 
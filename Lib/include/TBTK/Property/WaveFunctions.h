@@ -75,6 +75,16 @@ public:
 	 *  string. */
 	WaveFunctions(const std::string &serialization, Mode mode);
 
+	/** Constructor. Constructs the WaveFunctions from a memory mapped file
+	 *  containing a Serializeable::Mode::Binary serialization of the
+	 *  WaveFunctions. Only the header is read immediately, while the data is read
+	 *  from disk on demand when it is accessed.
+	 *
+	 *  @param file The memory mapped file. If the file is mapped with
+	 *  MemoryMappedFile::Mode::ReadOnly, the data is copied into memory
+	 *  the first time it is modified. */
+	WaveFunctions(const MemoryMappedFile &file);
+
 	/** Destructor. */
 	~WaveFunctions();
 
@@ -115,6 +125,10 @@ public:
 	/** Overrides AbstractProperty::serialize(). */
 	virtual std::string serialize(Mode mode) const;
 private:
+	/** Constructor. Constructs the WaveFunctions from a BinaryReader for its
+	 *  serialization in a memory mapped file. */
+	WaveFunctions(const MemoryMappedFile &file, const BinaryReader &reader);
+
 	/** Flag indicating whether the state indices for a continuous set.
 	 *  Allows for quicker access. */
 	bool isContinuous;
@@ -117,6 +117,14 @@ public:
 		std::initializer_list<Index> pattern
 	);
 
+	/** Overrides PropertyExtractor::calculateSampledLDOS(). The Green's
+	 *  function is only evaluated at the given energies, which has to lie
+	 *  strictly inside the interval [-scaleFactor, scaleFactor]. */
+	virtual Property::SampledLDOS calculateSampledLDOS(
+		std::initializer_list<Index> patterns,
+		const std::vector<double> &energies
+	);
+
 	/** Overrides PropertyExtractor::calculateSpinPolarizedLDOS(). */
 	virtual Property::SpinPolarizedLDOS calculateSpinPolarizedLDOS(
 		Index pattern,
@@ -172,6 +180,15 @@ private:
 		int offset
 	);
 
+	/** Callback for calculating the local density of states at explicit
+	 *  energies. Used by calculateSampledLDOS. */
+	static void calculateSampledLDOSCallback(
+		PropertyExtractor *cb_this,
+		void *sampledLDOS,
+		const Index &index,
+		int offset
+	);
+
 	/** !!!Not tested!!! Callback for calculating spin-polarized local
 	 *  density of states. Used by calculateSP_LDOS. */
 	static void calculateSP_LDOSCallback(
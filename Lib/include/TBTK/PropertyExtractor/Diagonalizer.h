@@ -133,6 +133,35 @@ public:
 		std::initializer_list<Index> patterns
 	);
 
+	/** Overrides PropertyExtractor::calculateSampledLDOS(). Equivalent
+	 *  to the overload with an explicit bin width, with the bin width
+	 *  equal to the width of the bins used by calculateLDOS(), that is
+	 *  (upperBound - lowerBound)/energyResolution for the energy window
+	 *  set with setEnergyWindow(). */
+	virtual Property::SampledLDOS calculateSampledLDOS(
+		std::initializer_list<Index> patterns,
+		const std::vector<double> &energies
+	);
+
+	/** Calculate the local density of states sampled at an explicit list
+	 *  of energies. Each sample is the spectral weight of the eigenstates
+	 *  in the interval [E - binWidth/2, E + binWidth/2) divided by
+	 *  binWidth. The amplitudes are only calculated for eigenstates that
+	 *  fall inside at least one such interval.
+	 *
+	 *  @param patterns The Index patterns for which to calculate the
+	 *  LDOS.
+	 *  @param energies Strictly increasing list of energies.
+	 *  @param binWidth The width of the energy interval around each
+	 *  energy.
+	 *
+	 *  @return A SampledLDOS containing the LDOS at the given energies. */
+	Property::SampledLDOS calculateSampledLDOS(
+		std::initializer_list<Index> patterns,
+		const std::vector<double> &energies,
+		double binWidth
+	);
+
 	/** Overrides PropertyExtractor::calculateSpinPolarizedLDOS(). */
 	virtual Property::SpinPolarizedLDOS calculateSpinPolarizedLDOS(
 		Index pattern,
@@ -181,6 +210,15 @@ private:
 		int offset
 	);
 
+	/** Callback for calculating the local density of states at explicit
+	 *  energies. Used by calculateSampledLDOS. */
+	static void calculateSampledLDOSCallback(
+		PropertyExtractor *cb_this,
+		void *sampledLDOS,
+		const Index &index,
+		int offset
+	);
+
 	/** Callback for calculating spin-polarized local density of states.
 	 *  Used by calculateSP_LDOS. */
 	static void calculateSP_LDOSCallback(
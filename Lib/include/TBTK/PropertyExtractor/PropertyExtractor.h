@@ -29,6 +29,7 @@
 #include "TBTK/Property/Density.h"
 #include "TBTK/Property/DOS.h"
 #include "TBTK/Property/LDOS.h"
+#include "TBTK/Property/SampledLDOS.h"
 #include "TBTK/Property/Magnetization.h"
 #include "TBTK/Property/SpinPolarizedLDOS.h"
 
@@ -164,6 +165,22 @@ public:
 		std::initializer_list<Index> patterns
 	);
 
+	/** Calculate the local density of states sampled at an explicit list
+	 *  of energies. Only the requested energies are evaluated, which
+	 *  makes this cheaper than PropertyExtractor::calculateLDOS() when
+	 *  only a few energies are needed. See the derived
+	 *  PropertyExtractors for how each sample is obtained.
+	 *
+	 *  @param patterns The Index patterns for which to calculate the
+	 *  LDOS.
+	 *  @param energies Strictly increasing list of energies.
+	 *
+	 *  @return A SampledLDOS containing the LDOS at the given energies. */
+	virtual Property::SampledLDOS calculateSampledLDOS(
+		std::initializer_list<Index> patterns,
+		const std::vector<double> &energies
+	);
+
 	/** Calculate spin-polarized local density of states.
 	 *
 	 *  @param pattern Specifies the index pattern for which to calculate
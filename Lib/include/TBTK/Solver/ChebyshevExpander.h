@@ -212,6 +212,25 @@ public:
 		Type type = Type::Retarded
 	);
 
+	/** Genererate Green's function at an explicit list of energies.
+	 *  Does not use lookup table generated by
+	 *  ChebyshevExpander::generateLookupTable. Runs on CPU.
+	 *  @param coefficients Chebyshev coefficients calculated by
+	 *  ChebyshevExpander::calculateCoefficients.
+	 *  @param numCoefficeints Number of coefficients in coefficients.
+	 *  @param energies The energies at which to evaluate the Green's
+	 *  function. Has to lie strictly between -scaleFactor and scaleFactor.
+	 *  @param type The type of Green's function to generate.
+	 *
+	 *  @return Array with energies.size() elements containing the Green's
+	 *  function. The caller is responsible for deleting the array. */
+	std::complex<double>* generateGreensFunction(
+		std::complex<double> *coefficients,
+		int numCoefficients,
+		const std::vector<double> &energies,
+		Type type = Type::Retarded
+	);
+
 	/** Genererate Green's function. Uses lookup table generated by
 	 *  ChebyshevExpander::generateLookupTable. Runs on CPU.
 	 *  @param greensFunction Pointer to array able to hold Green's
@@ -94,11 +94,29 @@ inline unsigned int WignerSeitzCell::getMajorCellIndexInternal(
 	switch(getNumDimensions()){
 	case 1:
 	{
-		TBTKExit(
-			"WignerSeitzCell::getMajorCellIndexInternal()",
-			"Not yet implemented for 1D.",
-			""
-		);
+		const Vector3d &b0 = basisVectors.at(0);
+		double X = abs(2*coordinatesNorm/b0.norm());
+
+		for(int x = -X-1; x < X+1; x++){
+			if(x == 0)
+				continue;
+
+			Vector3d latticePoint = x*b0;
+
+			if(
+				Vector3d::dotProduct(
+					latticePoint,
+					coordinates
+				)/Vector3d::dotProduct(
+					latticePoint,
+					latticePoint
+				) > 1/2.
+			){
+				cellIndex++;
+			}
+		}
+
+		break;
 	}
 	case 2:
 	{
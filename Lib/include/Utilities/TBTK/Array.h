@@ -26,6 +26,8 @@
 #include "TBTK/Index.h"
 #include "TBTK/TBTKMacros.h"
 
+#include <cmath>
+#include <complex>
 #include <vector>
 
 namespace TBTK{
@@ -96,6 +98,48 @@ public:
 	/** Division operator. */
 	Array operator/(const DataType &rhs) const;
 
+	/** Addition assignment operator. */
+	Array& operator+=(const Array &rhs);
+
+	/** Subtraction assignment operator. */
+	Array& operator-=(const Array &rhs);
+
+	/** Multiplication assignment operator. */
+	Array& operator*=(const DataType &rhs);
+
+	/** Division assignment operator. */
+	Array& operator/=(const DataType &rhs);
+
+	/** Add a scaled Array with the same ranges in place, that is,
+	 *  this = this + a*x.
+	 *
+	 *  @param a The scale factor.
+	 *  @param x The Array to scale and add. */
+	void axpy(const DataType &a, const Array &x);
+
+	/** Get the sum of all elements.
+	 *
+	 *  @return The sum of all elements. */
+	DataType sum() const;
+
+	/** Get the Euclidean norm, that is, the square root of the sum of the
+	 *  squared absolute values of the elements.
+	 *
+	 *  @return The Euclidean norm of the Array. */
+	double norm() const;
+
+	/** Get the largest element. Only available for data types that are
+	 *  ordered. The Array must be non-empty.
+	 *
+	 *  @return The largest element. */
+	DataType max() const;
+
+	/** Get the smallest element. Only available for data types that are
+	 *  ordered. The Array must be non-empty.
+	 *
+	 *  @return The smallest element. */
+	DataType min() const;
+
 	/** Get slice. */
 	Array<DataType> getSlice(const std::vector<int> &index) const;
 
@@ -111,6 +155,10 @@ private:
 	/** Ranges. */
 	std::vector<unsigned int> ranges;
 
+	/** Minimum number of elements for which the element-wise operations
+	 *  and reductions are parallelized. */
+	static constexpr unsigned int PARALLELIZATION_THRESHOLD = 65536;
+
 	/** Fill slice. */
 	void fillSlice(
 		Array &array,
@@ -127,6 +175,9 @@ private:
 	) const;
 };
 
+template<typename DataType>
+constexpr unsigned int Array<DataType>::PARALLELIZATION_THRESHOLD;
+
 template<typename DataType>
 Array<DataType>::Array(){
 	size = 0;
@@ -290,7 +341,7 @@ template<typename DataType>
 inline Array<DataType> Array<DataType>::operator-(
 	const Array<DataType> &rhs
 ) const{
-	assertCompatibleRanges(rhs, "operator+()");
+	assertCompatibleRanges(rhs, "operator-()");
 
 	Array<DataType> result(ranges);
 	for(unsigned int n = 0; n < size; n++)
@@ -321,6 +372,166 @@ inline Array<DataType> Array<DataType>::operator/(
 	return result;
 }
 
+template<typename DataType>
+inline Array<DataType>& Array<DataType>::operator+=(
+	const Array<DataType> &rhs
+){
+	assertCompatibleRanges(rhs, "operator+=()");
+
+	DataType *lhsData = data;
+	const DataType *rhsData = rhs.data;
+	const unsigned int size = this->size;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD)
+#endif
+	for(unsigned int n = 0; n < size; n++)
+		lhsData[n] += rhsData[n];
+
+	return *this;
+}
+
+template<typename DataType>
+inline Array<DataType>& Array<DataType>::operator-=(
+	const Array<DataType> &rhs
+){
+	assertCompatibleRanges(rhs, "operator-=()");
+
+	DataType *lhsData = data;
+	const DataType *rhsData = rhs.data;
+	const unsigned int size = this->size;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD)
+#endif
+	for(unsigned int n = 0; n < size; n++)
+		lhsData[n] -= rhsData[n];
+
+	return *this;
+}
+
+template<typename DataType>
+inline Array<DataType>& Array<DataType>::operator*=(const DataType &rhs){
+	DataType *lhsData = data;
+	const DataType factor = rhs;
+	const unsigned int size = this->size;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD)
+#endif
+	for(unsigned int n = 0; n < size; n++)
+		lhsData[n] *= factor;
+
+	return *this;
+}
+
+template<typename DataType>
+inline Array<DataType>& Array<DataType>::operator/=(const DataType &rhs){
+	DataType *lhsData = data;
+	const DataType divisor = rhs;
+	const unsigned int size = this->size;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD)
+#endif
+	for(unsigned int n = 0; n < size; n++)
+		lhsData[n] /= divisor;
+
+	return *this;
+}
+
+template<typename DataType>
+inline void Array<DataType>::axpy(const DataType &a, const Array &x){
+	assertCompatibleRanges(x, "axpy()");
+
+	DataType *yData = data;
+	const DataType *xData = x.data;
+	const DataType factor = a;
+	const unsigned int size = this->size;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD)
+#endif
+	for(unsigned int n = 0; n < size; n++)
+		yData[n] += factor*xData[n];
+}
+
+template<typename DataType>
+inline DataType Array<DataType>::sum() const{
+	const DataType *arrayData = data;
+	const unsigned int size = this->size;
+	DataType result = DataType(0);
+#ifdef TBTK_USE_OPEN_MP
+	//The built in + reduction is restricted to arithmetic types, which
+	//excludes for example std::complex<double>.
+	#pragma omp declare reduction( \
+		arraySum : DataType : omp_out += omp_in \
+	) initializer(omp_priv = DataType(0))
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD) \
+		reduction(arraySum : result)
+#endif
+	for(unsigned int n = 0; n < size; n++)
+		result += arrayData[n];
+
+	return result;
+}
+
+template<typename DataType>
+inline double Array<DataType>::norm() const{
+	const DataType *arrayData = data;
+	const unsigned int size = this->size;
+	double result = 0;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD) \
+		reduction(+ : result)
+#endif
+	for(unsigned int n = 0; n < size; n++)
+		result += std::norm(arrayData[n]);
+
+	return sqrt(result);
+}
+
+template<typename DataType>
+inline DataType Array<DataType>::max() const{
+	TBTKAssert(
+		size > 0,
+		"Array::max()",
+		"The Array is empty.",
+		""
+	);
+
+	const DataType *arrayData = data;
+	const unsigned int size = this->size;
+	DataType result = arrayData[0];
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD) \
+		reduction(max : result)
+#endif
+	for(unsigned int n = 1; n < size; n++)
+		if(arrayData[n] > result)
+			result = arrayData[n];
+
+	return result;
+}
+
+template<typename DataType>
+inline DataType Array<DataType>::min() const{
+	TBTKAssert(
+		size > 0,
+		"Array::min()",
+		"The Array is empty.",
+		""
+	);
+
+	const DataType *arrayData = data;
+	const unsigned int size = this->size;
+	DataType result = arrayData[0];
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(size > PARALLELIZATION_THRESHOLD) \
+		reduction(min : result)
+#endif
+	for(unsigned int n = 1; n < size; n++)
+		if(arrayData[n] < result)
+			result = arrayData[n];
+
+	return result;
+}
+
 template<typename DataType>
 Array<DataType> Array<DataType>::getSlice(const std::vector<int> &index) const{
 	TBTKAssert(
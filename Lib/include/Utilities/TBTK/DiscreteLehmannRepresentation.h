@@ -0,0 +1,228 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @package TBTKcalc
+ *  @file DiscreteLehmannRepresentation.h
+ *  @brief Compact representation of functions of Matsubara frequencies.
+ *
+ *  @author Kristofer Björnson
+ */
+
+#ifndef COM_DAFER45_TBTK_DISCRETE_LEHMANN_REPRESENTATION
+#define COM_DAFER45_TBTK_DISCRETE_LEHMANN_REPRESENTATION
+
+#include "TBTK/Statistics.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace TBTK{
+
+/** @brief Compact representation of functions of Matsubara frequencies.
+ *
+ *  The DiscreteLehmannRepresentation (DLR) expands a function of Matsubara
+ *  frequencies with a spectral function that is confined to the energy
+ *  interval [-energyCutoff, energyCutoff] as
+ *  \f[
+ *	G(i\nu_n) = \sum_{l}\frac{g_l}{i\nu_n - \omega_l},
+ *  \f]
+ *  where the real poles \f$\omega_l\f$ are fixed by the temperature, the
+ *  energy cutoff, and the requested tolerance. The number of poles grows as
+ *  \f$\log(\Lambda)\log(1/\epsilon)\f$, where
+ *  \f$\Lambda = energyCutoff/kT\f$. Typically a few tens of coefficients
+ *  replace thousands of Matsubara frequencies.
+ *
+ *  The poles are selected from a fine real frequency grid using a pivoted
+ *  QR decomposition of the kernel \f$1/(i\nu_n - \omega)\f$, and an equal
+ *  number of interpolation frequencies are selected from the Matsubara
+ *  frequencies in the same way. A function is fitted by evaluating it at
+ *  the interpolation frequencies only.
+ *
+ *  Since every basis function is a simple pole, Matsubara sums and
+ *  correlations of two functions can be calculated analytically from the
+ *  coefficients.
+ *
+ *  All energies are given in the same unit as kT. */
+class DiscreteLehmannRepresentation{
+public:
+	/** Constructor.
+	 *
+	 *  @param statistics The statistics of the Matsubara frequencies.
+	 *  @param kT The temperature times the Boltzmann constant.
+	 *  @param energyCutoff The largest absolute value of the energy of a
+	 *  pole that is represented.
+	 *  @param tolerance The relative accuracy of the representation. */
+	DiscreteLehmannRepresentation(
+		Statistics statistics,
+		double kT,
+		double energyCutoff,
+		double tolerance
+	);
+
+	/** Get the statistics. */
+	Statistics getStatistics() const;
+
+	/** Get the number of basis functions. */
+	unsigned int getRank() const;
+
+	/** Get the poles. */
+	const std::vector<double>& getPoles() const;
+
+	/** Get the indices n of the Matsubara frequencies at which the
+	 *  functions should be given to fit(). */
+	const std::vector<int>& getInterpolationIndices() const;
+
+	/** Get the Matsubara energy \f$i\nu_n\f$ for a given index n. That is,
+	 *  \f$i\pi(2n+1)kT\f$ for Statistics::FermiDirac and \f$i2\pi nkT\f$
+	 *  for Statistics::BoseEinstein.
+	 *
+	 *  @param n The index of the Matsubara frequency.
+	 *
+	 *  @return The Matsubara energy. */
+	std::complex<double> getMatsubaraEnergy(int n) const;
+
+	/** Calculate the coefficients of one or several functions.
+	 *
+	 *  @param values The functions evaluated at the Matsubara frequencies
+	 *  given by getInterpolationIndices(), on the layout
+	 *  [function][frequency].
+	 *  @param coefficients Array with room for numFunctions*getRank()
+	 *  elements that the coefficients are written to on the layout
+	 *  [function][pole].
+	 *  @param numFunctions The number of functions. */
+	void fit(
+		const std::complex<double> *values,
+		std::complex<double> *coefficients,
+		unsigned int numFunctions = 1
+	) const;
+
+	/** Evaluate a function.
+	 *
+	 *  @param coefficients The coefficients of the function.
+	 *  @param energy The energy to evaluate the function at. Can be any
+	 *  complex number that is not a pole.
+	 *
+	 *  @return The value of the function. */
+	std::complex<double> evaluate(
+		const std::complex<double> *coefficients,
+		std::complex<double> energy
+	) const;
+
+	/** Calculate the Matsubara sum
+	 *  \f$kT\sum_{n}G(i\nu_n)e^{i\nu_n0^{+}}\f$.
+	 *
+	 *  @param coefficients The coefficients of the function.
+	 *
+	 *  @return The value of the sum. */
+	std::complex<double> sum(const std::complex<double> *coefficients) const;
+
+	/** Get the weights that gives the correlation between two functions
+	 *  \f[
+	 *	kT\sum_{n}A(i\nu_n)B(i\nu_n + z)
+	 *		= \sum_{lm}a_lW_{lm}(z)b_m,
+	 *  \f]
+	 *  where z is a bosonic Matsubara energy. The weights are
+	 *  \f$W_{lm}(z) = (f(\omega_l) - f(\omega_m))/(\omega_l - \omega_m
+	 *  + z)\f$, where f is the Fermi-Dirac distribution for
+	 *  Statistics::FermiDirac and minus the Bose-Einstein distribution for
+	 *  Statistics::BoseEinstein. For other values of z, the weights give
+	 *  the analytic continuation of the correlation.
+	 *
+	 *  @param energy The energy z.
+	 *  @param weights Array with room for getRank()*getRank() elements
+	 *  that the weights are written to on the row major layout [l][m]. */
+	void getCorrelationWeights(
+		std::complex<double> energy,
+		std::complex<double> *weights
+	) const;
+private:
+	/** The statistics. */
+	Statistics statistics;
+
+	/** The temperature times the Boltzmann constant. */
+	double kT;
+
+	/** The poles. */
+	std::vector<double> poles;
+
+	/** The indices of the interpolation frequencies. */
+	std::vector<int> interpolationIndices;
+
+	/** LU factorization of the weighted kernel at the interpolation
+	 *  frequencies and poles, stored column major. */
+	std::vector<std::complex<double>> interpolationMatrix;
+
+	/** Pivots of the LU factorization. */
+	std::vector<int> interpolationPivots;
+
+	/** Get the weight that multiplies the kernel for a pole at the given
+	 *  energy when poles and interpolation frequencies are selected, and
+	 *  when functions are fitted. */
+	double getKernelWeight(double energy) const;
+
+	/** Get f(energy), where f is the distribution used in the sum and
+	 *  correlation weights. */
+	double getDistribution(double energy) const;
+
+	/** Get the derivative of f(energy). */
+	double getDistributionDerivative(double energy) const;
+};
+
+inline Statistics DiscreteLehmannRepresentation::getStatistics() const{
+	return statistics;
+}
+
+inline unsigned int DiscreteLehmannRepresentation::getRank() const{
+	return poles.size();
+}
+
+inline const std::vector<double>& DiscreteLehmannRepresentation::getPoles(
+) const{
+	return poles;
+}
+
+inline const std::vector<int>&
+DiscreteLehmannRepresentation::getInterpolationIndices() const{
+	return interpolationIndices;
+}
+
+inline std::complex<double> DiscreteLehmannRepresentation::getMatsubaraEnergy(
+	int n
+) const{
+	switch(statistics){
+	case Statistics::FermiDirac:
+		return std::complex<double>(0, M_PI*(2*n + 1)*kT);
+	case Statistics::BoseEinstein:
+		return std::complex<double>(0, 2*M_PI*n*kT);
+	default:
+		return 0;
+	}
+}
+
+inline std::complex<double> DiscreteLehmannRepresentation::evaluate(
+	const std::complex<double> *coefficients,
+	std::complex<double> energy
+) const{
+	std::complex<double> result = 0;
+	for(unsigned int n = 0; n < poles.size(); n++)
+		result += coefficients[n]/(energy - poles[n]);
+
+	return result;
+}
+
+};	//End of namespace TBTK
+
+#endif
@@ -39,6 +39,12 @@
 #include <fstream>
 #include <stdio.h>
 
+namespace H5{
+	class DataSpace;
+	class DSetCreatPropList;
+	class H5File;
+};
+
 namespace TBTK{
 
 /** Writes data to a .hdf5-file. The default file name is TBTKResults.h5. Can
@@ -47,9 +53,18 @@ namespace TBTK{
  *  eigenvalues, DOS, Density etc. extracted by the PropertyExtractor. In the
  *  later case the data can immediately be plotted using the bundled python
  *  plotting scripts.
+ *
+ *  The file is written by a single process. TBTK does not use MPI, so
+ *  parallel HDF5 (MPI-IO) is not supported. Processes that run parameter
+ *  sweeps in parallel should write to separate files, or stream their
+ *  results through a single process using writeSlice().
  */
 class FileWriter{
 public:
+	/** Compression filters that can be applied to datasets. Compressed
+	 *  datasets are stored in chunks. */
+	enum class Compression {None, Deflate, SZIP};
+
 	/** Write model to file. */
 	static void writeModel(
 		const Model &model,
@@ -185,6 +200,82 @@ public:
 		std::string path = "/"
 	);
 
+	/** Write a slice of an extendible dataset of type int. The dataset
+	 *  has one more dimension than the slice, and the slice is written at
+	 *  the given position along the first dimension. The dataset is
+	 *  created on the first call and extended as needed, which allows
+	 *  results to be streamed to file as they are calculated, for example
+	 *  one slice per parameter value in a parameter sweep. The dataset is
+	 *  always stored in chunks.
+	 *
+	 *  @param data The data of the slice.
+	 *  @param rank The rank of the slice.
+	 *  @param dims The dimensions of the slice.
+	 *  @param slice The position of the slice along the first dimension
+	 *  of the dataset.
+	 *  @param name The name of the dataset.
+	 *  @param path The path of the dataset. */
+	static void writeSlice(
+		const int *data,
+		int rank,
+		const int *dims,
+		unsigned int slice,
+		std::string name,
+		std::string path = "/"
+	);
+
+	/** Write a slice of an extendible dataset of type double. See
+	 *  writeSlice() for int. */
+	static void writeSlice(
+		const double *data,
+		int rank,
+		const int *dims,
+		unsigned int slice,
+		std::string name,
+		std::string path = "/"
+	);
+
+	/** Write a slice of an extendible dataset of type complex<double>.
+	 *  The real and imaginary parts are written to two datasets with the
+	 *  suffixes Real and Imag, in the same way as for write(). See
+	 *  writeSlice() for int. */
+	static void writeSlice(
+		const std::complex<double> *data,
+		int rank,
+		const int *dims,
+		unsigned int slice,
+		std::string name,
+		std::string path = "/"
+	);
+
+	/** Set the compression used for datasets created after the call.
+	 *  Default is Compression::None, in which case datasets are stored
+	 *  contiguously. Deflate is combined with the shuffle filter, which
+	 *  improves the compression of floating point data considerably.
+	 *
+	 *  @param compression The compression filter.
+	 *  @param level The compression level between 0 and 9. Only used for
+	 *  Compression::Deflate. */
+	static void setCompression(
+		Compression compression,
+		unsigned int level = 6
+	);
+
+	/** Get the compression used for datasets. */
+	static Compression getCompression();
+
+	/** Set the approximate size in bytes of the chunks used for chunked
+	 *  datasets. Default is 1 MiB. */
+	static void setChunkSize(unsigned int chunkSize);
+
+	/** Open the file and keep it open until FileWriter::close() is
+	 *  called. Avoids opening and closing the file in every call when many
+	 *  datasets are written. */
+	static void open();
+
+	/** Close a file opened with FileWriter::open(). */
+	static void close();
+
 	/** Set output file name. Default is TBTKResults.h5. */
 	static void setFileName(std::string filename);
 
@@ -203,6 +294,79 @@ private:
 
 	/** File name of file to write to. */
 	static std::string filename;
+
+	/** Compression used for new datasets. */
+	static Compression compression;
+
+	/** Compression level used for Compression::Deflate. */
+	static unsigned int compressionLevel;
+
+	/** Approximate size of chunks in bytes. */
+	static unsigned int chunkSize;
+
+	/** File kept open between calls to FileWriter::open() and
+	 *  FileWriter::close(). */
+	static H5::H5File *file;
+
+	/** @brief Reference to the file to write to.
+	 *
+	 *  Refers to the file opened by FileWriter::open() if there is one.
+	 *  Otherwise the file is opened by the FileHandle and closed again
+	 *  when the FileHandle is destroyed. Only the owner of a file closes
+	 *  it, which means that writing never closes the file that is kept
+	 *  open by FileWriter::open(). */
+	class FileHandle{
+	public:
+		/** Constructor. */
+		FileHandle();
+
+		/** Copy constructor. Deleted since only one FileHandle can
+		 *  own the file. */
+		FileHandle(const FileHandle &fileHandle) = delete;
+
+		/** Destructor. Closes the file if it was opened by the
+		 *  FileHandle. */
+		~FileHandle();
+
+		/** Assignment operator. Deleted since only one FileHandle can
+		 *  own the file. */
+		FileHandle& operator=(const FileHandle &rhs) = delete;
+
+		/** Get the file. */
+		H5::H5File& getFile();
+	private:
+		/** The file. */
+		H5::H5File *file;
+
+		/** Flag indicating whether the file was opened by the
+		 *  FileHandle. */
+		bool isOwner;
+	};
+
+	/** Get the creation properties for a dataset with the given
+	 *  dataspace. Sets up chunking and compression.
+	 *
+	 *  @param dataspace The dataspace of the dataset.
+	 *  @param elementSize The size of the elements in bytes.
+	 *  @param isExtendible Whether the first dimension of the dataset is
+	 *  unlimited. Extendible datasets are always chunked. */
+	static H5::DSetCreatPropList createDataSetProperties(
+		const H5::DataSpace &dataspace,
+		unsigned int elementSize,
+		bool isExtendible = false
+	);
+
+	/** Write a slice of an extendible dataset using a hyperslab
+	 *  selection. Used by the writeSlice() functions. */
+	template<typename DataType>
+	static void writeHyperslab(
+		const DataType *data,
+		int rank,
+		const int *dims,
+		unsigned int slice,
+		const std::string &name,
+		const std::string &path
+	);
 };
 
 inline void FileWriter::writeSpectralFunction(
@@ -213,12 +377,26 @@ inline void FileWriter::writeSpectralFunction(
 	writeLDOS(spectralFunction, name, path);
 }
 
+inline H5::H5File& FileWriter::FileHandle::getFile(){
+	return *file;
+}
+
 inline void FileWriter::setFileName(std::string filename){
+	close();
 	FileWriter::filename = filename;
 	isInitialized = false;
 }
 
+inline FileWriter::Compression FileWriter::getCompression(){
+	return compression;
+}
+
+inline void FileWriter::setChunkSize(unsigned int chunkSize){
+	FileWriter::chunkSize = chunkSize;
+}
+
 inline void FileWriter::clear(){
+	close();
 	remove(filename.c_str());
 	isInitialized = false;
 }
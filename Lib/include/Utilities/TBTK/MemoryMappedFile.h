@@ -0,0 +1,182 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @package TBTKcalc
+ *  @file MemoryMappedFile.h
+ *  @brief Memory mapping of a file.
+ *
+ *  @author Kristofer Björnson
+ */
+
+#ifndef COM_DAFER45_TBTK_MEMORY_MAPPED_FILE
+#define COM_DAFER45_TBTK_MEMORY_MAPPED_FILE
+
+#include "TBTK/TBTKMacros.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace TBTK{
+
+/** @brief Memory mapping of a file.
+ *
+ *  The MemoryMappedFile maps a file into the address space of the process
+ *  without reading it. Pages are read from disk by the operating system the
+ *  first time they are accessed, which means that the memory usage is
+ *  proportional to the part of the file that actually is used.
+ *
+ *  The Mode determines whether the mapped memory can be written to. A
+ *  Mode::ReadOnly mapping can only be read. A Mode::CopyOnWrite mapping
+ *  can be written to, but the writes are private to the process and the
+ *  file is never modified. No swap space is reserved for the mapping, so
+ *  only the pages that actually are written to consume memory. A
+ *  Mode::ReadWrite mapping is shared with the file, which means that
+ *  writes are stored in the file.
+ *
+ *  The MemoryMappedFile acts as a handle to the mapping. Copies share the
+ *  same mapping, which is released when the last copy is destroyed. */
+class MemoryMappedFile{
+public:
+	/** Enum class for specifying how the file is mapped. */
+	enum class Mode{
+		ReadOnly,
+		CopyOnWrite,
+		ReadWrite
+	};
+
+	/** Default constructor. Constructs a MemoryMappedFile without a
+	 *  mapping. */
+	MemoryMappedFile();
+
+	/** Constructor. Maps the given file.
+	 *
+	 *  @param filename The name of the file to map.
+	 *  @param mode The Mode with which the file is mapped. */
+	MemoryMappedFile(
+		const std::string &filename,
+		Mode mode = Mode::ReadOnly
+	);
+
+	/** Get the mapped memory.
+	 *
+	 *  @return Pointer to the start of the mapped file, or nullptr if no
+	 *  file is mapped. */
+	const char* getData() const;
+
+	/** Get the mapped memory with write access. Only possible if the
+	 *  file is mapped with Mode::CopyOnWrite or Mode::ReadWrite.
+	 *
+	 *  @return Pointer to the start of the mapped file, or nullptr if no
+	 *  file is mapped. */
+	char* getDataRW() const;
+
+	/** Get the size of the mapped file.
+	 *
+	 *  @return The size of the mapped file in bytes. */
+	std::uint64_t getSize() const;
+
+	/** Get the Mode with which the file is mapped.
+	 *
+	 *  @return The Mode. */
+	Mode getMode() const;
+
+	/** Returns true if a file is mapped. */
+	bool isMapped() const;
+
+	/** Returns true if a file is mapped with write access. */
+	bool isWritable() const;
+private:
+	/** Owns the actual mapping. */
+	class Mapping{
+	public:
+		/** Constructor. */
+		Mapping(const std::string &filename, Mode mode);
+
+		/** Destructor. */
+		~Mapping();
+
+		/** Pointer to the mapped memory. */
+		char *data;
+
+		/** Size of the mapped memory. */
+		std::uint64_t size;
+
+		/** The mode of the mapping. */
+		Mode mode;
+	};
+
+	/** The mapping shared by all copies. */
+	std::shared_ptr<Mapping> mapping;
+};
+
+inline MemoryMappedFile::MemoryMappedFile(){
+}
+
+inline MemoryMappedFile::MemoryMappedFile(
+	const std::string &filename,
+	Mode mode
+) :
+	mapping(std::make_shared<Mapping>(filename, mode))
+{
+}
+
+inline const char* MemoryMappedFile::getData() const{
+	if(mapping)
+		return mapping->data;
+	else
+		return nullptr;
+}
+
+inline char* MemoryMappedFile::getDataRW() const{
+	if(!mapping)
+		return nullptr;
+
+	TBTKAssert(
+		mapping->mode != Mode::ReadOnly,
+		"MemoryMappedFile::getDataRW()",
+		"The file is mapped read only.",
+		"Map the file using MemoryMappedFile::Mode::CopyOnWrite or"
+		<< " MemoryMappedFile::Mode::ReadWrite."
+	);
+
+	return mapping->data;
+}
+
+inline std::uint64_t MemoryMappedFile::getSize() const{
+	if(mapping)
+		return mapping->size;
+	else
+		return 0;
+}
+
+inline MemoryMappedFile::Mode MemoryMappedFile::getMode() const{
+	if(mapping)
+		return mapping->mode;
+	else
+		return Mode::ReadOnly;
+}
+
+inline bool MemoryMappedFile::isMapped() const{
+	return (bool)mapping;
+}
+
+inline bool MemoryMappedFile::isWritable() const{
+	return mapping && mapping->mode != Mode::ReadOnly;
+}
+
+};	//End of namespace TBTK
+
+#endif
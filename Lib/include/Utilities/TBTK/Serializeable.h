@@ -26,8 +26,15 @@
 #include "TBTK/Statistics.h"
 #include "TBTK/TBTKMacros.h"
 
+#include <algorithm>
 #include <complex>
+#include <cstdint>
+#include <cstring>
+#include <map>
 #include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace TBTK{
@@ -141,6 +148,306 @@ protected:
 		std::string component
 	);
 
+	/** Version of the Mode::Binary format. */
+	static constexpr std::uint32_t BINARY_FORMAT_VERSION = 1;
+
+	/** Alignment of field payloads in the Mode::Binary format. Payloads
+	 *  are aligned to cache lines. */
+	static constexpr std::uint64_t BINARY_ALIGNMENT = 64;
+
+	/** @brief Writes serialization strings on the Mode::Binary format.
+	 *
+	 *  A binary serialization string starts with the magic bytes "TBTK",
+	 *  the format version and the ID of the serialized object. It is
+	 *  followed by a list of named fields, each consisting of the length
+	 *  of the name, the name, the size of the payload in bytes, zero
+	 *  padding up to the next multiple of BINARY_ALIGNMENT bytes from the
+	 *  start of the serialization, and the payload. Integers are stored
+	 *  as little-endian fixed width integers and floating point numbers
+	 *  as little-endian IEEE 754 values. Arrays are stored as raw
+	 *  contiguous blocks, and nested objects are stored as fields
+	 *  containing their own binary serialization. Since nested
+	 *  serializations are aligned as well, every array is aligned
+	 *  relative to the start of the outermost serialization, which allows
+	 *  arrays in memory mapped files to be accessed in place.
+	 *
+	 *  The serialization is either built in memory or written directly to
+	 *  an output stream, in which case arrays are converted in chunks and
+	 *  no copy of the full serialization is ever held in memory. Nested
+	 *  objects written with writeObject() are written directly to the same
+	 *  destination. */
+	class BinaryWriter{
+	public:
+		/** Constructor.
+		 *
+		 *  @param id The ID of the serialized object. */
+		BinaryWriter(const std::string &id);
+
+		/** Constructor. Writes the serialization to an output stream
+		 *  instead of building it in memory.
+		 *
+		 *  @param id The ID of the serialized object.
+		 *  @param stream The stream to write to. Must stay alive for
+		 *  the lifetime of the BinaryWriter and be opened in binary
+		 *  mode. */
+		BinaryWriter(const std::string &id, std::ostream &stream);
+
+		/** The BinaryWriter refers to its own serialization string and
+		 *  can therefore not be copied. */
+		BinaryWriter(const BinaryWriter &binaryWriter) = delete;
+
+		/** The BinaryWriter can not be assigned. */
+		BinaryWriter& operator=(
+			const BinaryWriter &binaryWriter
+		) = delete;
+
+		/** Write a fundamental value or complex number.
+		 *
+		 *  @param name The name of the field.
+		 *  @param value The value to write. */
+		template<typename DataType>
+		void write(const std::string &name, const DataType &value);
+
+		/** Write an array of fundamental values or complex numbers.
+		 *
+		 *  @param name The name of the field.
+		 *  @param data Pointer to the data.
+		 *  @param size The number of elements. */
+		template<typename DataType>
+		void writeArray(
+			const std::string &name,
+			const DataType *data,
+			std::uint64_t size
+		);
+
+		/** Write a string. Also used for nested serialization strings.
+		 *
+		 *  @param name The name of the field.
+		 *  @param str The string to write. */
+		void writeString(const std::string &name, const std::string &str);
+
+		/** Write a nested object directly to the destination of this
+		 *  BinaryWriter, without building its serialization as a
+		 *  separate string. The writeFunction is called twice: once to
+		 *  measure the size of the nested serialization, and once to
+		 *  write it. It must write the same fields both times.
+		 *
+		 *  @param name The name of the field.
+		 *  @param id The ID of the nested object.
+		 *  @param writeFunction Function that takes a BinaryWriter& and
+		 *  writes the fields of the nested object to it. */
+		template<typename WriteFunction>
+		void writeObject(
+			const std::string &name,
+			const std::string &id,
+			WriteFunction writeFunction
+		);
+
+		/** Get the serialization string. Empty if the serialization
+		 *  is written to a stream.
+		 *
+		 *  @return The serialization string. */
+		const std::string& getSerialization() const;
+
+		/** Move the serialization string out of the BinaryWriter,
+		 *  which avoids a copy of the serialization. The BinaryWriter
+		 *  can not be used afterwards.
+		 *
+		 *  @return The serialization string. */
+		std::string releaseSerialization();
+	private:
+		/** The serialization string. */
+		std::string serialization;
+
+		/** String to write to. Points to serialization, or to the
+		 *  serialization of the outermost BinaryWriter for nested
+		 *  objects. nullptr if the serialization is written to a stream
+		 *  or only measured. */
+		std::string *target;
+
+		/** Stream to write to, or nullptr if the serialization is built
+		 *  in memory or only measured. */
+		std::ostream *stream;
+
+		/** Number of bytes written so far. */
+		std::uint64_t size;
+
+		/** Number of bytes that are converted at a time when writing
+		 *  arrays to a stream. */
+		static constexpr std::uint64_t CHUNK_SIZE = 1 << 20;
+
+		/** Constructor. Constructs a BinaryWriter for a nested object
+		 *  that writes to the given destination. Only the size is
+		 *  counted if both target and stream are nullptr.
+		 *
+		 *  @param id The ID of the nested object.
+		 *  @param target The string to write to, or nullptr.
+		 *  @param stream The stream to write to, or nullptr. */
+		BinaryWriter(
+			const std::string &id,
+			std::string *target,
+			std::ostream *stream
+		);
+
+		/** Write the header of the serialization. */
+		void writeHeader(const std::string &id);
+
+		/** Append raw bytes to the serialization. */
+		void append(const char *bytes, std::uint64_t numBytes);
+
+		/** Append the header of a field. */
+		void writeFieldHeader(
+			const std::string &name,
+			std::uint64_t payloadSize
+		);
+	};
+
+	/** @brief Reads serialization strings on the Mode::Binary format. See
+	 *  BinaryWriter for a description of the format. */
+	class BinaryReader{
+	public:
+		/** Constructor.
+		 *
+		 *  @param serialization The serialization string.
+		 *  @param id The ID that the serialization string is expected to
+		 *  have. */
+		BinaryReader(
+			const std::string &serialization,
+			const std::string &id
+		);
+
+		/** The BinaryReader refers to the serialization string rather
+		 *  than copying it, which means that it can not be constructed
+		 *  from a temporary string. */
+		BinaryReader(
+			std::string &&serialization,
+			const std::string &id
+		) = delete;
+
+		/** Constructor. Reads the serialization directly from a buffer,
+		 *  for example a MemoryMappedFile. The buffer must remain valid
+		 *  for the lifetime of the BinaryReader.
+		 *
+		 *  @param buffer Pointer to the serialization.
+		 *  @param bufferSize The size of the serialization in bytes.
+		 *  @param id The ID that the serialization is expected to have. */
+		BinaryReader(
+			const char *buffer,
+			std::uint64_t bufferSize,
+			const std::string &id
+		);
+
+		/** Returns true if the serialization contains a field with the
+		 *  given name. */
+		bool hasField(const std::string &name) const;
+
+		/** Read a fundamental value or complex number.
+		 *
+		 *  @param name The name of the field.
+		 *
+		 *  @return The value. */
+		template<typename DataType>
+		DataType read(const std::string &name) const;
+
+		/** Get the number of elements in an array field.
+		 *
+		 *  @param name The name of the field.
+		 *
+		 *  @return The number of elements. */
+		template<typename DataType>
+		std::uint64_t getArraySize(const std::string &name) const;
+
+		/** Read an array of fundamental values or complex numbers.
+		 *
+		 *  @param name The name of the field.
+		 *  @param data Pointer to memory with room for
+		 *  getArraySize<DataType>(name) elements. */
+		template<typename DataType>
+		void readArray(const std::string &name, DataType *data) const;
+
+		/** Read an array into a vector.
+		 *
+		 *  @param name The name of the field.
+		 *
+		 *  @return A vector containing the array. */
+		template<typename DataType>
+		std::vector<DataType> readVector(const std::string &name) const;
+
+		/** Read a string. Also used for nested serialization strings.
+		 *
+		 *  @param name The name of the field.
+		 *
+		 *  @return The string. */
+		std::string readString(const std::string &name) const;
+
+		/** Get a BinaryReader for a nested serialization without copying
+		 *  it.
+		 *
+		 *  @param name The name of the field.
+		 *  @param id The ID that the nested serialization is expected to
+		 *  have.
+		 *
+		 *  @return A BinaryReader for the nested serialization. */
+		BinaryReader getReader(
+			const std::string &name,
+			const std::string &id
+		) const;
+
+		/** Get a pointer to an array in place, without copying it. Only
+		 *  possible on little-endian hosts.
+		 *
+		 *  @param name The name of the field.
+		 *
+		 *  @return Pointer to the first element of the array. */
+		template<typename DataType>
+		const DataType* getArrayData(const std::string &name) const;
+	private:
+		/** The serialization. */
+		const char *buffer;
+
+		/** The size of the serialization. */
+		std::uint64_t bufferSize;
+
+		/** Position and size of the payload for each field. */
+		std::map<std::string, std::pair<std::uint64_t, std::uint64_t>>
+			fields;
+
+		/** Get position and size of the payload for a field. */
+		const std::pair<std::uint64_t, std::uint64_t>& getField(
+			const std::string &name
+		) const;
+
+		/** Parse the fields. Called by the constructors. */
+		void parseFields(const std::string &id);
+	};
+
+	/** Parse the header of a binary serialization.
+	 *
+	 *  @param buffer Pointer to the serialization.
+	 *  @param bufferSize The size of the serialization.
+	 *  @param id Pointer to a string that will contain the ID. Can be
+	 *  nullptr.
+	 *
+	 *  @return The position of the first field, or 0 if the header is
+	 *  invalid. */
+	static std::uint64_t parseBinaryHeader(
+		const char *buffer,
+		std::uint64_t bufferSize,
+		std::string *id
+	);
+
+	/** Returns true if the host byte order is little-endian. */
+	static bool isLittleEndian();
+
+	/** Copy an array of fundamental values between host and little-endian
+	 *  byte order. */
+	template<typename DataType>
+	static void copyLittleEndian(
+		char *destination,
+		const char *source,
+		std::uint64_t size
+	);
+
 	/** Friend classes (Classes that are psudo-Serializeable because they
 	 *  are so small and often used that a virtual function would have a
 	 *  non-negligible performance penalty). */
@@ -148,6 +455,371 @@ protected:
 	friend class HoppingAmplitude;
 };
 
+inline bool Serializeable::isLittleEndian(){
+	const std::uint16_t one = 1;
+	char c;
+	std::memcpy(&c, &one, 1);
+
+	return c == 1;
+}
+
+template<typename DataType>
+inline void Serializeable::copyLittleEndian(
+	char *destination,
+	const char *source,
+	std::uint64_t size
+){
+	//Complex numbers are stored as pairs of their underlying type.
+	typedef typename std::conditional<
+		std::is_arithmetic<DataType>::value,
+		DataType,
+		double
+	>::type ElementType;
+	static_assert(
+		std::is_arithmetic<DataType>::value
+		|| std::is_same<DataType, std::complex<double>>::value,
+		"Only fundamental types and std::complex<double> can be"
+		" serialized on binary format."
+	);
+
+	std::uint64_t numBytes = size*sizeof(DataType);
+	if(isLittleEndian() || sizeof(ElementType) == 1){
+		std::memcpy(destination, source, numBytes);
+	}
+	else{
+		for(
+			std::uint64_t n = 0;
+			n < numBytes;
+			n += sizeof(ElementType)
+		){
+			for(unsigned int c = 0; c < sizeof(ElementType); c++){
+				destination[n + c]
+					= source[n + sizeof(ElementType) - 1 - c];
+			}
+		}
+	}
+}
+
+inline Serializeable::BinaryWriter::BinaryWriter(const std::string &id){
+	target = &serialization;
+	stream = nullptr;
+	size = 0;
+	writeHeader(id);
+}
+
+inline Serializeable::BinaryWriter::BinaryWriter(
+	const std::string &id,
+	std::ostream &stream
+){
+	target = nullptr;
+	this->stream = &stream;
+	size = 0;
+	writeHeader(id);
+}
+
+inline Serializeable::BinaryWriter::BinaryWriter(
+	const std::string &id,
+	std::string *target,
+	std::ostream *stream
+){
+	this->target = target;
+	this->stream = stream;
+	size = 0;
+	writeHeader(id);
+}
+
+template<typename DataType>
+inline void Serializeable::BinaryWriter::write(
+	const std::string &name,
+	const DataType &value
+){
+	writeArray(name, &value, 1);
+}
+
+template<>
+inline void Serializeable::BinaryWriter::write<bool>(
+	const std::string &name,
+	const bool &value
+){
+	std::uint8_t b = value;
+	writeArray(name, &b, 1);
+}
+
+template<typename DataType>
+inline void Serializeable::BinaryWriter::writeArray(
+	const std::string &name,
+	const DataType *data,
+	std::uint64_t size
+){
+	std::uint64_t numBytes = size*sizeof(DataType);
+	writeFieldHeader(name, numBytes);
+	if(target != nullptr){
+		std::uint64_t position = target->size();
+		target->resize(position + numBytes);
+		copyLittleEndian<DataType>(
+			&(*target)[position],
+			(const char*)data,
+			size
+		);
+		this->size += numBytes;
+
+		return;
+	}
+	if(stream == nullptr){
+		this->size += numBytes;
+
+		return;
+	}
+
+	std::uint64_t chunkElements = std::max(
+		CHUNK_SIZE/sizeof(DataType),
+		(std::uint64_t)1
+	);
+	std::vector<char> chunk(std::min(size, chunkElements)*sizeof(DataType));
+	for(std::uint64_t n = 0; n < size; n += chunkElements){
+		std::uint64_t numElements = std::min(chunkElements, size - n);
+		copyLittleEndian<DataType>(
+			chunk.data(),
+			(const char*)(data + n),
+			numElements
+		);
+		append(chunk.data(), numElements*sizeof(DataType));
+	}
+}
+
+inline void Serializeable::BinaryWriter::writeString(
+	const std::string &name,
+	const std::string &str
+){
+	writeFieldHeader(name, str.size());
+	append(str.data(), str.size());
+}
+
+template<typename WriteFunction>
+inline void Serializeable::BinaryWriter::writeObject(
+	const std::string &name,
+	const std::string &id,
+	WriteFunction writeFunction
+){
+	BinaryWriter measurement(id, nullptr, nullptr);
+	writeFunction(measurement);
+	writeFieldHeader(name, measurement.size);
+
+	//The payload starts at a multiple of BINARY_ALIGNMENT, which means
+	//that the nested BinaryWriter aligns its fields correctly relative to
+	//the outermost serialization as well.
+	BinaryWriter writer(id, target, stream);
+	writeFunction(writer);
+	TBTKAssert(
+		writer.size == measurement.size,
+		"Serializeable::BinaryWriter::writeObject()",
+		"The nested object '" << name << "' changed size while being"
+		<< " written.",
+		"The write function must write the same fields each time it is"
+		<< " called."
+	);
+	size += writer.size;
+}
+
+inline const std::string& Serializeable::BinaryWriter::getSerialization(
+) const{
+	return serialization;
+}
+
+inline std::string Serializeable::BinaryWriter::releaseSerialization(){
+	return std::move(serialization);
+}
+
+inline void Serializeable::BinaryWriter::writeFieldHeader(
+	const std::string &name,
+	std::uint64_t payloadSize
+){
+	char buffer[8];
+	std::uint32_t nameSize = name.size();
+	copyLittleEndian<std::uint32_t>(buffer, (const char*)&nameSize, 1);
+	append(buffer, 4);
+	append(name.data(), name.size());
+	copyLittleEndian<std::uint64_t>(buffer, (const char*)&payloadSize, 1);
+	append(buffer, 8);
+	const char padding[BINARY_ALIGNMENT] = {};
+	append(
+		padding,
+		(BINARY_ALIGNMENT - size%BINARY_ALIGNMENT)%BINARY_ALIGNMENT
+	);
+}
+
+inline void Serializeable::BinaryWriter::writeHeader(const std::string &id){
+	append("TBTK", 4);
+
+	char buffer[4];
+	std::uint32_t version = BINARY_FORMAT_VERSION;
+	copyLittleEndian<std::uint32_t>(buffer, (const char*)&version, 1);
+	append(buffer, 4);
+
+	std::uint32_t idSize = id.size();
+	copyLittleEndian<std::uint32_t>(buffer, (const char*)&idSize, 1);
+	append(buffer, 4);
+	append(id.data(), id.size());
+}
+
+inline void Serializeable::BinaryWriter::append(
+	const char *bytes,
+	std::uint64_t numBytes
+){
+	if(target != nullptr)
+		target->append(bytes, numBytes);
+	else if(stream != nullptr)
+		stream->write(bytes, numBytes);
+	size += numBytes;
+}
+
+inline Serializeable::BinaryReader::BinaryReader(
+	const std::string &serialization,
+	const std::string &id
+) :
+	buffer(serialization.data()),
+	bufferSize(serialization.size())
+{
+	parseFields(id);
+}
+
+inline Serializeable::BinaryReader::BinaryReader(
+	const char *buffer,
+	std::uint64_t bufferSize,
+	const std::string &id
+) :
+	buffer(buffer),
+	bufferSize(bufferSize)
+{
+	parseFields(id);
+}
+
+inline bool Serializeable::BinaryReader::hasField(
+	const std::string &name
+) const{
+	return fields.find(name) != fields.end();
+}
+
+template<typename DataType>
+inline DataType Serializeable::BinaryReader::read(
+	const std::string &name
+) const{
+	TBTKAssert(
+		getArraySize<DataType>(name) == 1,
+		"Serializeable::BinaryReader::read()",
+		"Field '" << name << "' does not contain a single value of the"
+		<< " requested type.",
+		""
+	);
+
+	DataType value;
+	readArray(name, &value);
+
+	return value;
+}
+
+template<>
+inline bool Serializeable::BinaryReader::read<bool>(
+	const std::string &name
+) const{
+	return read<std::uint8_t>(name) != 0;
+}
+
+template<typename DataType>
+inline std::uint64_t Serializeable::BinaryReader::getArraySize(
+	const std::string &name
+) const{
+	const std::pair<std::uint64_t, std::uint64_t> &field = getField(name);
+	TBTKAssert(
+		field.second%sizeof(DataType) == 0,
+		"Serializeable::BinaryReader::getArraySize()",
+		"The size of field '" << name << "' is not a multiple of the"
+		<< " size of the requested type.",
+		""
+	);
+
+	return field.second/sizeof(DataType);
+}
+
+template<typename DataType>
+inline void Serializeable::BinaryReader::readArray(
+	const std::string &name,
+	DataType *data
+) const{
+	const std::pair<std::uint64_t, std::uint64_t> &field = getField(name);
+	copyLittleEndian<DataType>(
+		(char*)data,
+		buffer + field.first,
+		field.second/sizeof(DataType)
+	);
+}
+
+template<typename DataType>
+inline std::vector<DataType> Serializeable::BinaryReader::readVector(
+	const std::string &name
+) const{
+	std::vector<DataType> result(getArraySize<DataType>(name));
+	if(result.size() != 0)
+		readArray(name, result.data());
+
+	return result;
+}
+
+inline std::string Serializeable::BinaryReader::readString(
+	const std::string &name
+) const{
+	const std::pair<std::uint64_t, std::uint64_t> &field = getField(name);
+
+	return std::string(buffer + field.first, field.second);
+}
+
+inline Serializeable::BinaryReader Serializeable::BinaryReader::getReader(
+	const std::string &name,
+	const std::string &id
+) const{
+	const std::pair<std::uint64_t, std::uint64_t> &field = getField(name);
+
+	return BinaryReader(buffer + field.first, field.second, id);
+}
+
+template<typename DataType>
+inline const DataType* Serializeable::BinaryReader::getArrayData(
+	const std::string &name
+) const{
+	const std::pair<std::uint64_t, std::uint64_t> &field = getField(name);
+	TBTKAssert(
+		isLittleEndian(),
+		"Serializeable::BinaryReader::getArrayData()",
+		"In place access is only possible on little-endian hosts.",
+		"Use Serializeable::BinaryReader::readArray() instead."
+	);
+	TBTKAssert(
+		(std::uintptr_t)(buffer + field.first)%alignof(DataType) == 0,
+		"Serializeable::BinaryReader::getArrayData()",
+		"The field '" << name << "' is not aligned.",
+		"The buffer must be aligned to BINARY_ALIGNMENT bytes."
+	);
+
+	return (const DataType*)(buffer + field.first);
+}
+
+inline const std::pair<std::uint64_t, std::uint64_t>&
+Serializeable::BinaryReader::getField(const std::string &name) const{
+	std::map<
+		std::string,
+		std::pair<std::uint64_t, std::uint64_t>
+	>::const_iterator iterator = fields.find(name);
+	TBTKAssert(
+		iterator != fields.end(),
+		"Serializeable::BinaryReader::getField()",
+		"The serialization does not contain the field '" << name
+		<< "'.",
+		""
+	);
+
+	return iterator->second;
+}
+
 inline std::string Serializeable::serialize(bool b, Mode mode){
 	switch(mode){
 	case Mode::Debug:
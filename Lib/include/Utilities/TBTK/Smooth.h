@@ -25,13 +25,28 @@
 
 #include "TBTK/Array.h"
 #include "TBTK/Property/DOS.h"
+#include "TBTK/Property/LDOS.h"
+#include "TBTK/Property/SpinPolarizedLDOS.h"
 #include "TBTK/TBTKMacros.h"
 
 #include <cmath>
+#include <complex>
 #include <vector>
 
 namespace TBTK{
 
+/** @brief Collection of functions for smoothing data.
+ *
+ *  The functions that take a window size convolve the data with a Gaussian
+ *  that is truncated to the window, at a cost proportional to the number of
+ *  points times the window size. The functions without a window size use a
+ *  recursive approximation of the Gaussian (Young and van Vliet, Signal
+ *  Processing 44, 139 (1995)), which has a cost proportional to the number
+ *  of points independently of sigma. In both cases the data is assumed to be
+ *  zero outside of the given range.
+ *
+ *  The LDOS and SpinPolarizedLDOS are smoothed for all Indices in a single
+ *  call, with the Indices distributed over the available threads. */
 class Smooth{
 public:
 	/** Gaussian smoothing of custom data. */
@@ -62,7 +77,132 @@ public:
 		double sigma,
 		int windowSize
 	);
+
+	/** Gaussian smoothing of LDOS. */
+	static Property::LDOS gaussian(
+		const Property::LDOS &ldos,
+		double sigma,
+		int windowSize
+	);
+
+	/** Gaussian smoothing of SpinPolarizedLDOS. */
+	static Property::SpinPolarizedLDOS gaussian(
+		const Property::SpinPolarizedLDOS &spinPolarizedLDOS,
+		double sigma,
+		int windowSize
+	);
+
+	/** Recursive Gaussian smoothing of custom data.
+	 *
+	 *  @param data The data to smooth.
+	 *  @param sigma The standard deviation in units of the data spacing.
+	 *
+	 *  @return The smoothed data. */
+	static std::vector<double> gaussian(
+		const std::vector<double> &data,
+		double sigma
+	);
+
+	/** Recursive Gaussian smoothing of DOS.
+	 *
+	 *  @param dos The DOS to smooth.
+	 *  @param sigma The standard deviation in units of energy.
+	 *
+	 *  @return The smoothed DOS. */
+	static Property::DOS gaussian(const Property::DOS &dos, double sigma);
+
+	/** Recursive Gaussian smoothing of LDOS.
+	 *
+	 *  @param ldos The LDOS to smooth.
+	 *  @param sigma The standard deviation in units of energy.
+	 *
+	 *  @return The smoothed LDOS. */
+	static Property::LDOS gaussian(
+		const Property::LDOS &ldos,
+		double sigma
+	);
+
+	/** Recursive Gaussian smoothing of SpinPolarizedLDOS.
+	 *
+	 *  @param spinPolarizedLDOS The SpinPolarizedLDOS to smooth.
+	 *  @param sigma The standard deviation in units of energy.
+	 *
+	 *  @return The smoothed SpinPolarizedLDOS. */
+	static Property::SpinPolarizedLDOS gaussian(
+		const Property::SpinPolarizedLDOS &spinPolarizedLDOS,
+		double sigma
+	);
 private:
+	/** Smallest sigma for which the recursive filter is accurate. Smaller
+	 *  sigmas fall back to a truncated convolution. */
+	static constexpr double MINIMUM_RECURSIVE_SIGMA = 0.5;
+
+	/** Filter that smooths a single series of data. A filter is created
+	 *  once per call and applied to every series, which allows the
+	 *  weights to be calculated only once. */
+	class Filter{
+	public:
+		/** Constructs a filter that convolves with a Gaussian truncated
+		 *  to the window. */
+		Filter(double sigma, int windowSize);
+
+		/** Constructs a recursive filter. */
+		Filter(double sigma);
+
+		/** Smooth a series of data. The input and output must not
+		 *  overlap. The buffer is used as working memory to avoid
+		 *  allocations for every series. */
+		template<typename DataType>
+		void apply(
+			const DataType *input,
+			DataType *output,
+			unsigned int size,
+			std::vector<DataType> &buffer
+		) const;
+	private:
+		/** Normalized weights for the truncated convolution. Empty for
+		 *  the recursive filter. */
+		std::vector<double> weights;
+
+		/** Coefficients for the recursive filter. */
+		double B, b1, b2, b3;
+
+		/** Number of zeros added to each side of the data for the
+		 *  recursive filter to decay. */
+		unsigned int padding;
+
+		/** Initialize the truncated convolution weights. */
+		void initWeights(double sigma, int windowSize);
+	};
+
+	/** Apply a filter to every block of contiguous data. */
+	template<typename DataType>
+	static void applyToBlocks(
+		const Filter &filter,
+		const DataType *input,
+		DataType *output,
+		std::uint64_t numBlocks,
+		unsigned int blockSize
+	);
+
+	/** Apply a filter to every block of a SpinPolarizedLDOS. Each of the
+	 *  four spin components is smoothed separately. */
+	static void applyToBlocks(
+		const Filter &filter,
+		const SpinMatrix *input,
+		SpinMatrix *output,
+		std::uint64_t numBlocks,
+		unsigned int blockSize
+	);
+
+	/** Convert sigma from units of energy to units of the energy
+	 *  spacing. */
+	static double getScaledSigma(
+		double sigma,
+		double lowerBound,
+		double upperBound,
+		int resolution
+	);
 };
 
 inline Array<double> Smooth::gaussian(
@@ -70,18 +210,6 @@ inline Array<double> Smooth::gaussian(
 	double sigma,
 	int windowSize
 ){
-	TBTKAssert(
-		windowSize > 0,
-		"Smooth::gaussian()",
-		"'windowSize' must be larger than zero.",
-		""
-	);
-	TBTKAssert(
-		windowSize%2 == 1,
-		"Smooth::gaussian()",
-		"'windowSize' must be odd.",
-		""
-	);
 	TBTKAssert(
 		data.getRanges().size() == 1,
 		"Smooth::gaussian()",
@@ -90,29 +218,15 @@ inline Array<double> Smooth::gaussian(
 		""
 	);
 
-	double normalization = 0;
-	for(int n = -windowSize/2; n <= windowSize/2; n++){
-		normalization += exp(-n*n/(2*sigma*sigma));
-	}
-	normalization = 1/normalization;
-
+	Filter filter(sigma, windowSize);
 	Array<double> result({data.getRanges()[0]}, 0);
-	for(unsigned int n = 0; n < data.getRanges()[0]; n++){
-		for(
-			int c = std::max(0, (int)n - (int)windowSize/2);
-			c < std::min(
-				(int)n + (int)windowSize/2 + 1,
-				(int)data.getRanges()[0]
-			);
-			c++
-		){
-			result[{(unsigned int)n}]
-				+= data[
-					{(unsigned int)c}
-				]*exp(-(c-n)*(c-n)/(2*sigma*sigma));
-		}
-		result[{(unsigned int)n}] *= normalization;
-	}
+	std::vector<double> buffer;
+	filter.apply(
+		&data[0],
+		&result[0],
+		data.getRanges()[0],
+		buffer
+	);
 
 	return result;
 }
@@ -122,6 +236,229 @@ inline std::vector<double> Smooth::gaussian(
 	double sigma,
 	int windowSize
 ){
+	return gaussian(data.data(), data.size(), sigma, windowSize);
+}
+
+inline std::vector<double> Smooth::gaussian(
+	const double *data,
+	unsigned int size,
+	double sigma,
+	int windowSize
+){
+	Filter filter(sigma, windowSize);
+	std::vector<double> result(size);
+	std::vector<double> buffer;
+	filter.apply(data, result.data(), size, buffer);
+
+	return result;
+}
+
+inline Property::DOS Smooth::gaussian(
+	const Property::DOS &dos,
+	double sigma,
+	int windowSize
+){
+	Filter filter(
+		getScaledSigma(
+			sigma,
+			dos.getLowerBound(),
+			dos.getUpperBound(),
+			dos.getResolution()
+		),
+		windowSize
+	);
+	Property::DOS result(dos);
+	applyToBlocks(
+		filter,
+		dos.getData(),
+		result.getDataRW(),
+		1,
+		dos.getResolution()
+	);
+
+	return result;
+}
+
+inline Property::LDOS Smooth::gaussian(
+	const Property::LDOS &ldos,
+	double sigma,
+	int windowSize
+){
+	Filter filter(
+		getScaledSigma(
+			sigma,
+			ldos.getLowerBound(),
+			ldos.getUpperBound(),
+			ldos.getResolution()
+		),
+		windowSize
+	);
+	Property::LDOS result(ldos);
+	applyToBlocks(
+		filter,
+		ldos.getData(),
+		result.getDataRW(),
+		ldos.getSize()/ldos.getResolution(),
+		ldos.getResolution()
+	);
+
+	return result;
+}
+
+inline Property::SpinPolarizedLDOS Smooth::gaussian(
+	const Property::SpinPolarizedLDOS &spinPolarizedLDOS,
+	double sigma,
+	int windowSize
+){
+	Filter filter(
+		getScaledSigma(
+			sigma,
+			spinPolarizedLDOS.getLowerBound(),
+			spinPolarizedLDOS.getUpperBound(),
+			spinPolarizedLDOS.getResolution()
+		),
+		windowSize
+	);
+	Property::SpinPolarizedLDOS result(spinPolarizedLDOS);
+	applyToBlocks(
+		filter,
+		spinPolarizedLDOS.getData(),
+		result.getDataRW(),
+		spinPolarizedLDOS.getSize()
+			/spinPolarizedLDOS.getResolution(),
+		spinPolarizedLDOS.getResolution()
+	);
+
+	return result;
+}
+
+inline std::vector<double> Smooth::gaussian(
+	const std::vector<double> &data,
+	double sigma
+){
+	Filter filter(sigma);
+	std::vector<double> result(data.size());
+	std::vector<double> buffer;
+	filter.apply(data.data(), result.data(), data.size(), buffer);
+
+	return result;
+}
+
+inline Property::DOS Smooth::gaussian(
+	const Property::DOS &dos,
+	double sigma
+){
+	Filter filter(
+		getScaledSigma(
+			sigma,
+			dos.getLowerBound(),
+			dos.getUpperBound(),
+			dos.getResolution()
+		)
+	);
+	Property::DOS result(dos);
+	applyToBlocks(
+		filter,
+		dos.getData(),
+		result.getDataRW(),
+		1,
+		dos.getResolution()
+	);
+
+	return result;
+}
+
+inline Property::LDOS Smooth::gaussian(
+	const Property::LDOS &ldos,
+	double sigma
+){
+	Filter filter(
+		getScaledSigma(
+			sigma,
+			ldos.getLowerBound(),
+			ldos.getUpperBound(),
+			ldos.getResolution()
+		)
+	);
+	Property::LDOS result(ldos);
+	applyToBlocks(
+		filter,
+		ldos.getData(),
+		result.getDataRW(),
+		ldos.getSize()/ldos.getResolution(),
+		ldos.getResolution()
+	);
+
+	return result;
+}
+
+inline Property::SpinPolarizedLDOS Smooth::gaussian(
+	const Property::SpinPolarizedLDOS &spinPolarizedLDOS,
+	double sigma
+){
+	Filter filter(
+		getScaledSigma(
+			sigma,
+			spinPolarizedLDOS.getLowerBound(),
+			spinPolarizedLDOS.getUpperBound(),
+			spinPolarizedLDOS.getResolution()
+		)
+	);
+	Property::SpinPolarizedLDOS result(spinPolarizedLDOS);
+	applyToBlocks(
+		filter,
+		spinPolarizedLDOS.getData(),
+		result.getDataRW(),
+		spinPolarizedLDOS.getSize()
+			/spinPolarizedLDOS.getResolution(),
+		spinPolarizedLDOS.getResolution()
+	);
+
+	return result;
+}
+
+inline Smooth::Filter::Filter(double sigma, int windowSize){
+	initWeights(sigma, windowSize);
+}
+
+inline Smooth::Filter::Filter(double sigma){
+	TBTKAssert(
+		sigma > 0,
+		"Smooth::gaussian()",
+		"'sigma' must be larger than zero.",
+		""
+	);
+
+	if(sigma < MINIMUM_RECURSIVE_SIGMA){
+		initWeights(sigma, 2*(int)std::ceil(4*sigma) + 1);
+
+		return;
+	}
+
+	//Coefficients from Young and van Vliet, Signal Processing 44, 139
+	//(1995).
+	double q;
+	if(sigma >= 2.5)
+		q = 0.98711*sigma - 0.96330;
+	else
+		q = 3.97156 - 4.14554*std::sqrt(1 - 0.26891*sigma);
+
+	double b0 = 1.57825 + 2.44413*q + 1.4281*q*q + 0.422205*q*q*q;
+	b1 = (2.44413*q + 2.85619*q*q + 1.26661*q*q*q)/b0;
+	b2 = -(1.4281*q*q + 1.26661*q*q*q)/b0;
+	b3 = 0.422205*q*q*q/b0;
+	B = 1 - (b1 + b2 + b3);
+
+	padding = (unsigned int)std::ceil(4*sigma) + 3;
+}
+
+inline void Smooth::Filter::initWeights(double sigma, int windowSize){
+	TBTKAssert(
+		sigma > 0,
+		"Smooth::gaussian()",
+		"'sigma' must be larger than zero.",
+		""
+	);
 	TBTKAssert(
 		windowSize > 0,
 		"Smooth::gaussian()",
@@ -137,73 +474,133 @@ inline std::vector<double> Smooth::gaussian(
 
 	double normalization = 0;
 	for(int n = -windowSize/2; n <= windowSize/2; n++){
-		normalization += exp(-n*n/(2*sigma*sigma));
+		weights.push_back(std::exp(-n*n/(2*sigma*sigma)));
+		normalization += weights.back();
 	}
-	normalization = 1/normalization;
-
-	std::vector<double> result;
-	for(unsigned int n = 0; n < data.size(); n++){
-		result.push_back(0);
-		for(
-			int c = std::max(0, (int)n - (int)windowSize/2);
-			c < std::min(
-				(int)n + (int)windowSize/2 + 1,
-				(int)data.size()
-			);
-			c++
-		){
-			result.at(n) += data.at(c)*exp(-(c-n)*(c-n)/(2*sigma*sigma));
+	for(unsigned int n = 0; n < weights.size(); n++)
+		weights[n] /= normalization;
+}
+
+template<typename DataType>
+inline void Smooth::Filter::apply(
+	const DataType *input,
+	DataType *output,
+	unsigned int size,
+	std::vector<DataType> &buffer
+) const{
+	if(weights.size() != 0){
+		int halfWindow = weights.size()/2;
+		for(int n = 0; n < (int)size; n++){
+			int begin = std::max(0, n - halfWindow);
+			int end = std::min(n + halfWindow + 1, (int)size);
+			DataType sum = DataType(0);
+			for(int c = begin; c < end; c++)
+				sum += input[c]*weights[c - n + halfWindow];
+			output[n] = sum;
 		}
-		result.at(n) *= normalization;
+
+		return;
 	}
 
-	return result;
+	//The data is padded with zeros on both sides, which makes the zero
+	//initial conditions of the forward and backward passes consistent with
+	//data that is zero outside of the range.
+	buffer.assign(size + 2*padding, DataType(0));
+	DataType *data = buffer.data();
+	for(unsigned int n = 0; n < size; n++)
+		data[padding + n] = input[n];
+
+	for(unsigned int n = padding; n < buffer.size(); n++){
+		data[n] = B*data[n]
+			+ b1*data[n-1] + b2*data[n-2] + b3*data[n-3];
+	}
+	for(int n = buffer.size() - 4; n >= (int)padding; n--){
+		data[n] = B*data[n]
+			+ b1*data[n+1] + b2*data[n+2] + b3*data[n+3];
+	}
+
+	for(unsigned int n = 0; n < size; n++)
+		output[n] = data[padding + n];
 }
 
-inline std::vector<double> Smooth::gaussian(
-	const double *data,
-	unsigned int size,
-	double sigma,
-	int windowSize
+template<typename DataType>
+inline void Smooth::applyToBlocks(
+	const Filter &filter,
+	const DataType *input,
+	DataType *output,
+	std::uint64_t numBlocks,
+	unsigned int blockSize
 ){
-	std::vector<double> dataVector;
-	for(unsigned int n = 0; n < size; n++)
-		dataVector.push_back(data[n]);
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel if(numBlocks > 1)
+#endif
+	{
+		std::vector<DataType> buffer;
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp for
+#endif
+		for(std::uint64_t n = 0; n < numBlocks; n++){
+			filter.apply(
+				input + n*blockSize,
+				output + n*blockSize,
+				blockSize,
+				buffer
+			);
+		}
+	}
+}
 
-	return gaussian(
-		dataVector,
-		sigma,
-		windowSize
-	);
+inline void Smooth::applyToBlocks(
+	const Filter &filter,
+	const SpinMatrix *input,
+	SpinMatrix *output,
+	std::uint64_t numBlocks,
+	unsigned int blockSize
+){
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel if(numBlocks > 1)
+#endif
+	{
+		std::vector<std::complex<double>> in(blockSize);
+		std::vector<std::complex<double>> out(blockSize);
+		std::vector<std::complex<double>> buffer;
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp for
+#endif
+		for(std::uint64_t n = 0; n < numBlocks; n++){
+			const SpinMatrix *inputBlock = input + n*blockSize;
+			SpinMatrix *outputBlock = output + n*blockSize;
+			for(unsigned int row = 0; row < 2; row++){
+				for(unsigned int col = 0; col < 2; col++){
+					for(unsigned int e = 0; e < blockSize; e++){
+						in[e] = inputBlock[e].at(
+							row,
+							col
+						);
+					}
+					filter.apply(
+						in.data(),
+						out.data(),
+						blockSize,
+						buffer
+					);
+					for(unsigned int e = 0; e < blockSize; e++){
+						outputBlock[e].at(row, col)
+							= out[e];
+					}
+				}
+			}
+		}
+	}
 }
 
-inline Property::DOS Smooth::gaussian(
-	const Property::DOS &dos,
+inline double Smooth::getScaledSigma(
 	double sigma,
-	int windowSize
+	double lowerBound,
+	double upperBound,
+	int resolution
 ){
-	const double *data = dos.getData();
-	std::vector<double> dataVector;
-	for(unsigned int n = 0; n < dos.getSize(); n++)
-		dataVector.push_back(data[n]);
-
-	double lowerBound = dos.getLowerBound();
-	double upperBound = dos.getUpperBound();
-	int resolution = dos.getResolution();
-	double scaledSigma = sigma/(upperBound - lowerBound)*resolution;
-
-	std::vector<double> smoothedData = gaussian(
-		dataVector,
-		scaledSigma,
-		windowSize
-	);
-
-	return Property::DOS(
-		lowerBound,
-		upperBound,
-		resolution,
-		smoothedData.data()
-	);
+	return sigma/(upperBound - lowerBound)*resolution;
 }
 
 };	//End of namespace TBTK
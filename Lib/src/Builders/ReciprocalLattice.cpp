@@ -23,7 +23,10 @@
 #include "TBTK/TBTKMacros.h"
 #include "TBTK/Vector3d.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <map>
 #include <typeinfo>
 
 using namespace std;
@@ -40,6 +43,7 @@ ReciprocalLattice::ReciprocalLattice(
 
 	setupReciprocalLatticeVectors(unitCell);
 	setupRealSpaceEnvironment(unitCell);
+	setupRealSpaceHamiltonian(unitCell);
 }
 
 ReciprocalLattice::~ReciprocalLattice(){
@@ -120,8 +124,6 @@ Model* ReciprocalLattice::generateModel(initializer_list<double> momentum) const
 }
 
 Model* ReciprocalLattice::generateModel(vector<double> momentum) const{
-	Model *model = new Model();
-
 	TBTKAssert(
 		momentum.size() == reciprocalLatticeVectors.at(0).size(),
 		"ReciprocalLattice::ReciprocalLattice()",
@@ -134,52 +136,19 @@ Model* ReciprocalLattice::generateModel(vector<double> momentum) const{
 		""
 	);
 
-	for(unsigned int from = 0; from < realSpaceReferenceCell->getStates().size(); from++){
-		//Get reference ket.
-		const AbstractState *referenceKet = realSpaceReferenceCell->getStates().at(from);
-
-		for(unsigned int to = 0; to < realSpaceReferenceCell->getStates().size(); to++){
-			//Get reference bra and its Index.
-			const AbstractState *referenceBra = realSpaceReferenceCell->getStates().at(to);
-			Index referenceBraIndex(referenceBra->getIndex());
+	vector<complex<double>> hamiltonian = calculateHamiltonians(
+		vector<vector<double>>({momentum})
+	);
 
-			//Get all bras that have a possible overlap with the
-			//reference ket.
-/*			const vector<const AbstractState*> *bras = realSpaceEnvironmentStateTree->getOverlappingStates(
-				referenceKet->getCoordinates(),
-				referenceKet->getExtent()
-			);*/
-			vector<const AbstractState*> *bras = realSpaceEnvironmentStateTree->getOverlappingStates(
-				referenceKet->getCoordinates(),
-				referenceKet->getExtent()
+	Model *model = new Model();
+	unsigned int numStates = stateIndices.size();
+	for(unsigned int from = 0; from < numStates; from++){
+		for(unsigned int to = 0; to < numStates; to++){
+			*model << HoppingAmplitude(
+				hamiltonian[numStates*to + from],
+				stateIndices[to],
+				stateIndices[from]
 			);
-
-			//Calculate momentum space amplitude
-			complex<double> amplitude = 0.;
-			for(unsigned int n = 0; n < bras->size(); n++){
-				//Loop over all states that have a possible
-				//finite overlap with the reference ket.
-				const AbstractState *bra = bras->at(n);
-				if(bra->getIndex().equals(referenceBraIndex)){
-					//Only states with the same Index as
-					//the reference ket contributes to the
-					//amplitude.
-
-					static const complex<double> i(0., 1.);
-					complex<double> exponent = 0.;
-					for(unsigned int c = 0; c < momentum.size(); c++)
-						exponent += i*(momentum.at(c))*(bra->getCoordinates().at(c) - referenceBra->getCoordinates().at(c));
-					amplitude += bras->at(n)->getMatrixElement(*referenceKet)*exp(exponent);
-				}
-			}
-
-			delete bras;
-
-			//Add HoppingAmplitude to Hamiltonian, unless the
-			//amplitude is exactly zero.
-//			if(amplitude != 0.)
-//				model->addHA(HoppingAmplitude(amplitude, referenceBraIndex, referenceKet->getIndex()));
-				*model << HoppingAmplitude(amplitude, referenceBraIndex, referenceKet->getIndex());
 		}
 	}
 
@@ -230,116 +199,249 @@ Model* ReciprocalLattice::generateModel(
 		);
 	}
 
+	vector<complex<double>> hamiltonians = calculateHamiltonians(momentums);
+
 	Model *model = new Model();
+	unsigned int numStates = stateIndices.size();
+	for(unsigned int from = 0; from < numStates; from++){
+		for(unsigned int to = 0; to < numStates; to++){
+			for(unsigned int n = 0; n < momentums.size(); n++){
+				*model << HoppingAmplitude(
+					hamiltonians[
+						numStates*(numStates*n + to)
+						+ from
+					],
+					Index(blockIndices[n], stateIndices[to]),
+					Index(blockIndices[n], stateIndices[from])
+				);
+			}
+		}
+	}
 
-	for(unsigned int from = 0; from < realSpaceReferenceCell->getStates().size(); from++){
-		//Get reference ket.
-		const AbstractState *referenceKet = realSpaceReferenceCell->getStates().at(from);
+	return model;
+}
 
-		for(unsigned int to = 0; to < realSpaceReferenceCell->getStates().size(); to++){
-			//Get reference bra and its Index.
-			const AbstractState *referenceBra = realSpaceReferenceCell->getStates().at(to);
-			Index referenceBraIndex(referenceBra->getIndex());
+extern "C" {
+	void zgemm_(
+		char *transA,
+		char *transB,
+		int *M,
+		int *N,
+		int *K,
+		complex<double> *alpha,
+		complex<double> *A,
+		int *lda,
+		complex<double> *B,
+		int *ldb,
+		complex<double> *beta,
+		complex<double> *C,
+		int *ldc
+	);
+}
 
-			//Get all bras that have a possible overlap with the
-			//reference ket.
-/*			const vector<const AbstractState*> *bras = realSpaceEnvironmentStateTree->getOverlappingStates(
-				referenceKet->getCoordinates(),
-				referenceKet->getExtent()
-			);*/
-			vector<const AbstractState*> *bras = realSpaceEnvironmentStateTree->getOverlappingStates(
-				referenceKet->getCoordinates(),
-				referenceKet->getExtent()
-			);
+vector<complex<double>> ReciprocalLattice::calculateHamiltonians(
+	const vector<vector<double>> &momentums
+) const{
+	const vector<vector<double>> latticeVectors
+		= unitCell->getLatticeVectors();
+	unsigned int numDimensions = latticeVectors.size();
+	for(unsigned int n = 0; n < momentums.size(); n++){
+		TBTKAssert(
+			momentums[n].size() == numDimensions,
+			"ReciprocalLattice::calculateHamiltonians()",
+			"Incompatible dimensions. The number of components of"
+			<< " momentums must be the same as the number of"
+			<< " components of the lattice vectors in the UnitCell."
+			<< " The the number of components of momentums[" << n
+			<< "] are " << momentums[n].size() << ", while the"
+			<< " number of components for the latticeVectors are "
+			<< numDimensions << ".",
+			""
+		);
+	}
 
-			//Calculate momentum space amplitudes
-			vector<complex<double>> amplitudes;
-			for(unsigned int n = 0; n < momentums.size(); n++)
-				amplitudes.push_back(0.);
+	unsigned int numStates = stateIndices.size();
+	unsigned int matrixSize = numStates*numStates;
+	unsigned int numDisplacements
+		= hoppingDisplacements.size()/numDimensions;
+
+	vector<complex<double>> hamiltonians(momentums.size()*matrixSize, 0.);
+	if(momentums.size() == 0 || numDisplacements == 0)
+		return hamiltonians;
+
+	//Phase factors exp(ik*R) on the layout [momentum][R]. Since
+	//R = sum_c n_c*a_c, the exponent is sum_c n_c*(k*a_c).
+	vector<complex<double>> phases(momentums.size()*numDisplacements);
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for
+#endif
+	for(unsigned int m = 0; m < momentums.size(); m++){
+		vector<double> projections(numDimensions, 0);
+		for(unsigned int c = 0; c < numDimensions; c++)
+			for(unsigned int i = 0; i < numDimensions; i++)
+				projections[c] += momentums[m][i]*latticeVectors[c][i];
+
+		for(unsigned int r = 0; r < numDisplacements; r++){
+			double exponent = 0;
+			for(unsigned int c = 0; c < numDimensions; c++){
+				exponent += hoppingDisplacements[
+					numDimensions*r + c
+				]*projections[c];
+			}
+			phases[numDisplacements*m + r] = polar(1., exponent);
+		}
+	}
 
-			for(unsigned int n = 0; n < bras->size(); n++){
-				//Loop over all states that have a possible
-				//finite overlap with the reference ket.
-				const AbstractState *bra = bras->at(n);
-				if(bra->getIndex().equals(referenceBraIndex)){
-					//Only states with the same Index as
-					//the reference ket contributes to the
-					//amplitude.
+	//H[momentum][to][from] = sum_R phases[momentum][R]*H[R][to][from].
+	//The row major matrices are passed as their column major transposes.
+	char transA = 'N';
+	char transB = 'N';
+	int M = matrixSize;
+	int N = momentums.size();
+	int K = numDisplacements;
+	complex<double> alpha = 1;
+	complex<double> beta = 0;
+	zgemm_(
+		&transA,
+		&transB,
+		&M,
+		&N,
+		&K,
+		&alpha,
+		const_cast<complex<double>*>(realSpaceHamiltonian.data()),
+		&M,
+		phases.data(),
+		&K,
+		&beta,
+		hamiltonians.data(),
+		&M
+	);
 
-					//Get matrix element.
-					complex<double> matrixElement
-						= bras->at(
-							n
-						)->getMatrixElement(
-							*referenceKet
-						);
-
-					//Get coordinates.
-					const vector<double> &braCoordinates
-						= bra->getCoordinates();
-					const vector<double> &referenceCoordinates
-						= referenceBra->getCoordinates();
-					vector<double> coordinatesDifference;
-					for(
-						unsigned int c = 0;
-						c < braCoordinates.size();
-						c++
-					){
-						coordinatesDifference.push_back(
-							braCoordinates[c]
-							- referenceCoordinates[c]
-						);
-					}
+	return hamiltonians;
+}
 
-					static const complex<double> i(0., 1.);
-					for(
-						unsigned int m = 0;
-						m < momentums.size();
-						m++
-					){
-						const vector<double> &momentum
-							= momentums[m];
-
-						double exponent = 0.;
-						for(
-							unsigned int c = 0;
-							c < momentums[m].size();
-							c++
-						){
-							exponent += momentum[c]*coordinatesDifference[c];
-						}
-
-						amplitudes[m]
-							+= matrixElement*exp(
-								i*exponent
-							);
-					}
-				}
-			}
+vector<complex<double>> ReciprocalLattice::calculateHamiltonians(
+	const vector<unsigned int> &numMeshPoints
+) const{
+	unsigned int numDimensions = unitCell->getLatticeVectors().size();
+	TBTKAssert(
+		numMeshPoints.size() == numDimensions,
+		"ReciprocalLattice::calculateHamiltonians()",
+		"Incompatible dimensions. 'numMeshPoints' has "
+		<< numMeshPoints.size() << " components, but the UnitCell has "
+		<< numDimensions << " lattice vectors.",
+		""
+	);
+	unsigned int meshSize = 1;
+	for(unsigned int c = 0; c < numDimensions; c++){
+		TBTKAssert(
+			numMeshPoints[c] > 0,
+			"ReciprocalLattice::calculateHamiltonians()",
+			"The number of mesh points must be larger than zero.",
+			""
+		);
+		meshSize *= numMeshPoints[c];
+	}
 
-			delete bras;
+	unsigned int numStates = stateIndices.size();
+	unsigned int matrixSize = numStates*numStates;
+	unsigned int numDisplacements
+		= hoppingDisplacements.size()/numDimensions;
+	if(numDisplacements == 0)
+		return vector<complex<double>>(meshSize*matrixSize, 0.);
+
+	//Range of the lattice vectors along each direction.
+	vector<int> minimum(numDimensions, numeric_limits<int>::max());
+	vector<int> range(numDimensions);
+	for(unsigned int c = 0; c < numDimensions; c++){
+		int maximum = numeric_limits<int>::min();
+		for(unsigned int r = 0; r < numDisplacements; r++){
+			int n = hoppingDisplacements[numDimensions*r + c];
+			minimum[c] = min(minimum[c], n);
+			maximum = max(maximum, n);
+		}
+		range[c] = maximum - minimum[c] + 1;
+	}
 
-			//Add HoppingAmplitude to Hamiltonian, unless the
-			//amplitude is exactly zero.
-			for(unsigned int n = 0; n < momentums.size(); n++){
-//				if(amplitude != 0.)
-//					model->addHA(HoppingAmplitude(amplitude, referenceBraIndex, referenceKet->getIndex()));
-					*model << HoppingAmplitude(
-						amplitudes[n],
-						Index(
-							blockIndices[n],
-							referenceBraIndex
-						),
-						Index(
-							blockIndices[n],
-							referenceKet->getIndex()
-						)
-					);
+	//Place H(R) on a dense box on the layout [n_0]...[n_D][to][from].
+	unsigned int boxSize = matrixSize;
+	for(unsigned int c = 0; c < numDimensions; c++)
+		boxSize *= range[c];
+	vector<complex<double>> current(boxSize, 0.);
+	for(unsigned int r = 0; r < numDisplacements; r++){
+		unsigned int position = 0;
+		for(unsigned int c = 0; c < numDimensions; c++){
+			position = range[c]*position
+				+ hoppingDisplacements[numDimensions*r + c]
+				- minimum[c];
+		}
+		for(unsigned int n = 0; n < matrixSize; n++){
+			current[matrixSize*position + n]
+				= realSpaceHamiltonian[matrixSize*r + n];
+		}
+	}
+
+	//Transform one direction at a time. Before transforming direction c,
+	//the data is on the layout [outer][n_c][inner], where outer runs over
+	//the already transformed directions and inner over the remaining
+	//directions and the matrix elements.
+	unsigned int outer = 1;
+	unsigned int inner = boxSize;
+	for(unsigned int c = 0; c < numDimensions; c++){
+		inner /= range[c];
+
+		//Phase factors exp(2*pi*i*m*n/N) on the layout [m][n].
+		vector<complex<double>> phases(numMeshPoints[c]*range[c]);
+		for(unsigned int m = 0; m < numMeshPoints[c]; m++){
+			for(int n = 0; n < range[c]; n++){
+				long long product = (long long)m*(n + minimum[c]);
+				long long remainder = (
+					product%numMeshPoints[c]
+					+ numMeshPoints[c]
+				)%numMeshPoints[c];
+				phases[range[c]*m + n] = polar(
+					1.,
+					2*M_PI*remainder/numMeshPoints[c]
+				);
 			}
 		}
+
+		vector<complex<double>> next(
+			(size_t)outer*numMeshPoints[c]*inner
+		);
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp parallel for
+#endif
+		for(unsigned int o = 0; o < outer; o++){
+			char transA = 'N';
+			char transB = 'N';
+			int M = inner;
+			int N = numMeshPoints[c];
+			int K = range[c];
+			complex<double> alpha = 1;
+			complex<double> beta = 0;
+			zgemm_(
+				&transA,
+				&transB,
+				&M,
+				&N,
+				&K,
+				&alpha,
+				current.data() + (size_t)o*range[c]*inner,
+				&M,
+				phases.data(),
+				&K,
+				&beta,
+				next.data() + (size_t)o*numMeshPoints[c]*inner,
+				&M
+			);
+		}
+
+		current.swap(next);
+		outer *= numMeshPoints[c];
 	}
 
-	return model;
+	return current;
 }
 
 void ReciprocalLattice::setupReciprocalLatticeVectors(const UnitCell *unitCell){
@@ -607,4 +709,99 @@ void ReciprocalLattice::setupRealSpaceEnvironment(const UnitCell *unitCell){
 	}
 }
 
+void ReciprocalLattice::setupRealSpaceHamiltonian(const UnitCell *unitCell){
+	unsigned int numDimensions = unitCell->getLatticeVectors().size();
+	const vector<AbstractState*> &referenceStates
+		= realSpaceReferenceCell->getStates();
+	unsigned int numStates = referenceStates.size();
+	unsigned int matrixSize = numStates*numStates;
+
+	stateIndices.clear();
+	for(unsigned int n = 0; n < numStates; n++)
+		stateIndices.push_back(referenceStates[n]->getIndex());
+
+	//Maps the lattice vectors to their position in hoppingDisplacements.
+	map<vector<int>, unsigned int> displacementPositions;
+
+	for(unsigned int from = 0; from < numStates; from++){
+		//Get reference ket.
+		const AbstractState *referenceKet = referenceStates[from];
+
+		//Get all bras that have a possible overlap with the reference
+		//ket.
+		vector<const AbstractState*> *bras
+			= realSpaceEnvironmentStateTree->getOverlappingStates(
+				referenceKet->getCoordinates(),
+				referenceKet->getExtent()
+			);
+
+		for(unsigned int to = 0; to < numStates; to++){
+			const AbstractState *referenceBra = referenceStates[to];
+
+			for(unsigned int n = 0; n < bras->size(); n++){
+				//Only states with the same Index as the
+				//reference bra contributes to H(R)[to][from].
+				const AbstractState *bra = bras->at(n);
+				if(!bra->getIndex().equals(stateIndices[to]))
+					continue;
+
+				//The bra is a copy of the reference bra displaced
+				//by a lattice vector. Express the lattice vector
+				//in units of the UnitCell lattice vectors.
+				const vector<double> &braCoordinates
+					= bra->getCoordinates();
+				const vector<double> &referenceCoordinates
+					= referenceBra->getCoordinates();
+				vector<int> displacement(numDimensions);
+				for(unsigned int c = 0; c < numDimensions; c++){
+					double projection = 0;
+					for(
+						unsigned int i = 0;
+						i < numDimensions;
+						i++
+					){
+						projection += (
+							braCoordinates[i]
+							- referenceCoordinates[i]
+						)*reciprocalLatticeVectors[c][i];
+					}
+					displacement[c] = (int)round(
+						projection/(2*M_PI)
+					);
+				}
+
+				map<vector<int>, unsigned int>::iterator iterator
+					= displacementPositions.find(
+						displacement
+					);
+				unsigned int position;
+				if(iterator == displacementPositions.end()){
+					position = displacementPositions.size();
+					displacementPositions[displacement]
+						= position;
+					hoppingDisplacements.insert(
+						hoppingDisplacements.end(),
+						displacement.begin(),
+						displacement.end()
+					);
+					realSpaceHamiltonian.resize(
+						(position + 1)*matrixSize,
+						0.
+					);
+				}
+				else{
+					position = iterator->second;
+				}
+
+				realSpaceHamiltonian[
+					matrixSize*position + numStates*to
+					+ from
+				] += bra->getMatrixElement(*referenceKet);
+			}
+		}
+
+		delete bras;
+	}
+}
+
 };	//End of namespace TBTK
@@ -0,0 +1,212 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file BasisIndexLookupTable.cpp
+ *
+ *  @author Kristofer Björnson
+ */
+
+#include "TBTK/BasisIndexLookupTable.h"
+#include "TBTK/TBTKMacros.h"
+
+using namespace std;
+
+namespace TBTK{
+
+constexpr unsigned long long BasisIndexLookupTable::EMPTY_KEY;
+
+BasisIndexLookupTable::BasisIndexLookupTable(){
+	type = Type::None;
+	isGenerated = false;
+	rank = 0;
+	hashMask = 0;
+}
+
+void BasisIndexLookupTable::generate(
+	const HoppingAmplitudeTree &hoppingAmplitudeTree
+){
+	clear();
+
+	int basisSize = hoppingAmplitudeTree.getBasisSize();
+	TBTKAssert(
+		basisSize >= 0,
+		"BasisIndexLookupTable::generate()",
+		"The basis indices have not been generated.",
+		"First call HoppingAmplitudeTree::generateBasisIndices()."
+	);
+
+	//Tabulate the physical indices in basis index order. The iterator
+	//visits the leaf nodes in basis index order, and the first
+	//HoppingAmplitude on each leaf node therefore marks a new basis
+	//index.
+	offsets.reserve(basisSize + 1);
+	offsets.push_back(0);
+	bool fixedRank = true;
+	HoppingAmplitudeTree::Iterator it = hoppingAmplitudeTree.begin();
+	const HoppingAmplitude *ha;
+	while((ha = it.getHA())){
+		if(it.currentHoppingAmplitude == 0){
+			const Index &index = ha->getFromIndex();
+			if(offsets.size() == 1)
+				rank = index.getSize();
+			else if(index.getSize() != rank)
+				fixedRank = false;
+
+			for(unsigned int n = 0; n < index.getSize(); n++){
+				subindices.push_back(index[n]);
+
+				if(fixedRank){
+					if(ranges.size() <= n)
+						ranges.push_back(0);
+					if(index[n] + 1 > ranges[n])
+						ranges[n] = index[n] + 1;
+				}
+			}
+			offsets.push_back(subindices.size());
+		}
+
+		it.searchNextHA();
+	}
+
+	TBTKAssert(
+		offsets.size() == (unsigned int)basisSize + 1,
+		"BasisIndexLookupTable::generate()",
+		"Encountered " << offsets.size() - 1 << " basis indices, but"
+		<< " the basis size is " << basisSize << ".",
+		"This should never happen, contact the developer."
+	);
+	isGenerated = true;
+
+	if(!fixedRank || basisSize == 0){
+		rank = 0;
+		ranges.clear();
+
+		return;
+	}
+
+	//Use the dense representation if the box spanned by the subindex
+	//ranges is not much larger than the basis.
+	unsigned long long denseSize = 1;
+	bool denseSizeIsSmall = true;
+	for(unsigned int n = 0; n < rank; n++){
+		denseSize *= ranges[n];
+		if(
+			denseSize > (unsigned long long)MAX_DENSE_FILL_RATIO
+				*basisSize
+		){
+			denseSizeIsSmall = false;
+			break;
+		}
+	}
+	if(denseSizeIsSmall){
+		generateDenseTable();
+
+		return;
+	}
+
+	//Use the hash representation if the subindices fit in a 63-bit key.
+	unsigned int numBits = 0;
+	for(unsigned int n = 0; n < rank; n++){
+		shifts.push_back(numBits);
+		unsigned int range = ranges[n];
+		while(range > 1){
+			numBits++;
+			range = (range + 1)/2;
+		}
+	}
+	if(numBits <= 63){
+		generateHashTable();
+
+		return;
+	}
+
+	rank = 0;
+	ranges.clear();
+	shifts.clear();
+}
+
+void BasisIndexLookupTable::clear(){
+	type = Type::None;
+	isGenerated = false;
+	rank = 0;
+	hashMask = 0;
+	ranges.clear();
+	strides.clear();
+	shifts.clear();
+	denseTable.clear();
+	hashKeys.clear();
+	hashValues.clear();
+	subindices.clear();
+	offsets.clear();
+}
+
+unsigned int BasisIndexLookupTable::getSizeInBytes() const{
+	return sizeof(*this)
+		+ ranges.capacity()*sizeof(int)
+		+ strides.capacity()*sizeof(unsigned long long)
+		+ shifts.capacity()*sizeof(unsigned int)
+		+ denseTable.capacity()*sizeof(int)
+		+ hashKeys.capacity()*sizeof(unsigned long long)
+		+ hashValues.capacity()*sizeof(int)
+		+ subindices.capacity()*sizeof(int)
+		+ offsets.capacity()*sizeof(unsigned int);
+}
+
+void BasisIndexLookupTable::generateDenseTable(){
+	type = Type::Dense;
+
+	strides.assign(rank, 1);
+	for(int n = rank-2; n >= 0; n--)
+		strides[n] = strides[n+1]*ranges[n+1];
+
+	denseTable.assign(strides[0]*ranges[0], -1);
+	for(unsigned int b = 0; b + 1 < offsets.size(); b++){
+		unsigned long long position = 0;
+		for(unsigned int n = 0; n < rank; n++)
+			position += strides[n]*subindices[offsets[b] + n];
+		denseTable[position] = b;
+	}
+}
+
+void BasisIndexLookupTable::generateHashTable(){
+	type = Type::Hash;
+
+	//Use a load factor of at most 0.5 to keep the probe sequences short.
+	unsigned int basisSize = offsets.size() - 1;
+	unsigned long long hashSize = 1;
+	while(hashSize < 2*(unsigned long long)basisSize)
+		hashSize *= 2;
+	hashMask = hashSize - 1;
+
+	hashKeys.assign(hashSize, EMPTY_KEY);
+	hashValues.assign(hashSize, -1);
+	for(unsigned int b = 0; b < basisSize; b++){
+		unsigned long long key = 0;
+		for(unsigned int n = 0; n < rank; n++){
+			key |= (
+				(unsigned long long)subindices[offsets[b] + n]
+			) << shifts[n];
+		}
+
+		unsigned long long slot = getSlot(key);
+		while(hashKeys[slot] != EMPTY_KEY)
+			slot = (slot + 1) & hashMask;
+
+		hashKeys[slot] = key;
+		hashValues[slot] = b;
+	}
+}
+
+};	//End of namespace TBTK
@@ -214,6 +214,49 @@ Geometry::Geometry(
 
 		break;
 	}
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "Geometry");
+		dimensions = reader.read<unsigned int>("dimensions");
+		numSpecifiers = reader.read<unsigned int>("numSpecifiers");
+
+		uint64_t basisSize = hoppingAmplitudeSet.getBasisSize();
+		TBTKAssert(
+			reader.getArraySize<double>("coordinates")
+				== dimensions*basisSize,
+			"Geometry::Geometry()",
+			"Incompatible array sizes. "
+			<< "'dimensions*hoppingAmplitudeSet.getBasisSize()'"
+			<< " is " << dimensions*basisSize << " but coordinates"
+			<< " has " << reader.getArraySize<double>("coordinates")
+			<< " elements.",
+			""
+		);
+		coordinates = new double[dimensions*basisSize];
+		reader.readArray("coordinates", coordinates);
+
+		if(numSpecifiers > 0){
+			TBTKAssert(
+				reader.getArraySize<int>("specifiers")
+					== numSpecifiers*basisSize,
+				"Geometry::Geometry()",
+				"Incompatible array sizes. "
+				<< "'numSpecifiers*hoppingAmplitudeSet.getBasisSize()'"
+				<< " is " << numSpecifiers*basisSize << " but"
+				<< " specifiers has "
+				<< reader.getArraySize<int>("specifiers")
+				<< " elements.",
+				""
+			);
+			specifiers = new int[numSpecifiers*basisSize];
+			reader.readArray("specifiers", specifiers);
+		}
+		else{
+			specifiers = nullptr;
+		}
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"Geometry::Geometry()",
@@ -487,6 +530,26 @@ string Geometry::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("Geometry");
+		writer.write("dimensions", dimensions);
+		writer.write("numSpecifiers", numSpecifiers);
+		writer.writeArray(
+			"coordinates",
+			coordinates,
+			dimensions*hoppingAmplitudeSet->getBasisSize()
+		);
+		if(numSpecifiers > 0){
+			writer.writeArray(
+				"specifiers",
+				specifiers,
+				numSpecifiers*hoppingAmplitudeSet->getBasisSize()
+			);
+		}
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"Geometry::Geometry()",
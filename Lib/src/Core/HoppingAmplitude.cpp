@@ -30,6 +30,25 @@ using namespace nlohmann;
 
 namespace TBTK{
 
+HoppingAmplitude::AmplitudeCallback::~AmplitudeCallback(){
+}
+
+void HoppingAmplitude::AmplitudeCallback::getHoppingAmplitudes(
+	unsigned int numAmplitudes,
+	const Index *const *toIndices,
+	const Index *const *fromIndices,
+	const int *toBasisIndices,
+	const int *fromBasisIndices,
+	complex<double> *amplitudes
+) const{
+	for(unsigned int n = 0; n < numAmplitudes; n++){
+		amplitudes[n] = getHoppingAmplitude(
+			*toIndices[n],
+			*fromIndices[n]
+		);
+	}
+}
+
 HoppingAmplitude::HoppingAmplitude(
 	complex<double> amplitude,
 	Index toIndex,
@@ -40,6 +59,7 @@ HoppingAmplitude::HoppingAmplitude(
 {
 	this->amplitude = amplitude;
 	this->amplitudeCallback = NULL;
+	this->amplitudeCallbackObject = nullptr;
 };
 
 HoppingAmplitude::HoppingAmplitude(
@@ -54,6 +74,19 @@ HoppingAmplitude::HoppingAmplitude(
 	toIndex(toIndex)
 {
 	this->amplitudeCallback = amplitudeCallback;
+	this->amplitudeCallbackObject = nullptr;
+};
+
+HoppingAmplitude::HoppingAmplitude(
+	const AmplitudeCallback &amplitudeCallback,
+	Index toIndex,
+	Index fromIndex
+) :
+	fromIndex(fromIndex),
+	toIndex(toIndex)
+{
+	this->amplitudeCallback = nullptr;
+	this->amplitudeCallbackObject = &amplitudeCallback;
 };
 
 HoppingAmplitude::HoppingAmplitude(
@@ -64,6 +97,18 @@ HoppingAmplitude::HoppingAmplitude(
 {
 	amplitude = ha.amplitude;
 	this->amplitudeCallback = ha.amplitudeCallback;
+	this->amplitudeCallbackObject = ha.amplitudeCallbackObject;
+}
+
+HoppingAmplitude::HoppingAmplitude(
+	HoppingAmplitude &&ha
+) noexcept :
+	fromIndex(std::move(ha.fromIndex)),
+	toIndex(std::move(ha.toIndex))
+{
+	amplitude = ha.amplitude;
+	this->amplitudeCallback = ha.amplitudeCallback;
+	this->amplitudeCallbackObject = ha.amplitudeCallbackObject;
 }
 
 HoppingAmplitude::HoppingAmplitude(
@@ -82,6 +127,8 @@ HoppingAmplitude::HoppingAmplitude(
 		""
 	);
 
+	amplitudeCallbackObject = nullptr;
+
 	switch(mode){
 	case Serializeable::Mode::Debug:
 	{
@@ -122,6 +169,20 @@ HoppingAmplitude::HoppingAmplitude(
 
 		break;
 	}
+	case Serializeable::Mode::Binary:
+	{
+		amplitudeCallback = nullptr;
+
+		Serializeable::BinaryReader reader(
+			serialization,
+			"HoppingAmplitude"
+		);
+		amplitude = reader.read<complex<double>>("amplitude");
+		toIndex = Index(reader.readString("toIndex"), mode);
+		fromIndex = Index(reader.readString("fromIndex"), mode);
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"HoppingAmplitude::HoppingAmplitude()",
@@ -131,9 +192,42 @@ HoppingAmplitude::HoppingAmplitude(
 	}
 }
 
+HoppingAmplitude& HoppingAmplitude::operator=(const HoppingAmplitude &rhs){
+	if(this != &rhs){
+		amplitude = rhs.amplitude;
+		amplitudeCallback = rhs.amplitudeCallback;
+		amplitudeCallbackObject = rhs.amplitudeCallbackObject;
+		fromIndex = rhs.fromIndex;
+		toIndex = rhs.toIndex;
+	}
+
+	return *this;
+}
+
+HoppingAmplitude& HoppingAmplitude::operator=(
+	HoppingAmplitude &&rhs
+) noexcept{
+	if(this != &rhs){
+		amplitude = rhs.amplitude;
+		amplitudeCallback = rhs.amplitudeCallback;
+		amplitudeCallbackObject = rhs.amplitudeCallbackObject;
+		fromIndex = std::move(rhs.fromIndex);
+		toIndex = std::move(rhs.toIndex);
+	}
+
+	return *this;
+}
+
 HoppingAmplitude HoppingAmplitude::getHermitianConjugate() const{
 	if(amplitudeCallback)
 		return HoppingAmplitude(amplitudeCallback, fromIndex, toIndex);
+	else if(amplitudeCallbackObject){
+		return HoppingAmplitude(
+			*amplitudeCallbackObject,
+			fromIndex,
+			toIndex
+		);
+	}
 	else
 		return HoppingAmplitude(conj(amplitude), fromIndex, toIndex);
 }
@@ -154,7 +248,8 @@ void HoppingAmplitude::print() const{
 
 string HoppingAmplitude::serialize(Serializeable::Mode mode) const{
 	TBTKAssert(
-		amplitudeCallback == nullptr,
+		amplitudeCallback == nullptr
+		&& amplitudeCallbackObject == nullptr,
 		"HoppingAmplitude::serialize()",
 		"Unable to serialize HoppingAmplitude that uses callback"
 		<< " value.",
@@ -193,6 +288,15 @@ string HoppingAmplitude::serialize(Serializeable::Mode mode) const{
 
 		return ss.str();*/
 	}
+	case Serializeable::Mode::Binary:
+	{
+		Serializeable::BinaryWriter writer("HoppingAmplitude");
+		writer.write("amplitude", amplitude);
+		writer.writeString("toIndex", toIndex.serialize(mode));
+		writer.writeString("fromIndex", fromIndex.serialize(mode));
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"HoppingAmplitude::serialize()",
@@ -22,6 +22,8 @@
 #include "TBTK/Streams.h"
 #include "TBTK/TBTKMacros.h"
 
+#include <unordered_map>
+
 #include "TBTK/json.hpp"
 
 using namespace std;
@@ -32,6 +34,7 @@ namespace TBTK{
 HoppingAmplitudeSet::HoppingAmplitudeSet(){
 	isConstructed = false;
 	isSorted = false;
+	useBasisIndexLookupTable = true;
 	numMatrixElements = -1;
 
 	cooRowIndices = NULL;
@@ -42,6 +45,7 @@ HoppingAmplitudeSet::HoppingAmplitudeSet(){
 HoppingAmplitudeSet::HoppingAmplitudeSet(const vector<unsigned int> &capacity){
 	isConstructed = false;
 	isSorted = false;
+	useBasisIndexLookupTable = true;
 	numMatrixElements = -1;
 
 	cooRowIndices = NULL;
@@ -57,6 +61,9 @@ HoppingAmplitudeSet::HoppingAmplitudeSet(
 	hoppingAmplitudeTree = hoppingAmplitudeSet.hoppingAmplitudeTree;
 	isConstructed = hoppingAmplitudeSet.isConstructed;
 	isSorted = hoppingAmplitudeSet.isSorted;
+	useBasisIndexLookupTable
+		= hoppingAmplitudeSet.useBasisIndexLookupTable;
+	basisIndexLookupTable = hoppingAmplitudeSet.basisIndexLookupTable;
 	numMatrixElements = hoppingAmplitudeSet.numMatrixElements;
 
 	if(numMatrixElements == -1){
@@ -74,6 +81,9 @@ HoppingAmplitudeSet::HoppingAmplitudeSet(
 			cooValues[n] = hoppingAmplitudeSet.cooValues[n];
 		}
 	}
+
+	if(isConstructed)
+		generateAmplitudeBatches();
 }
 
 HoppingAmplitudeSet::HoppingAmplitudeSet(
@@ -82,6 +92,11 @@ HoppingAmplitudeSet::HoppingAmplitudeSet(
 	hoppingAmplitudeTree = hoppingAmplitudeSet.hoppingAmplitudeTree;
 	isConstructed = hoppingAmplitudeSet.isConstructed;
 	isSorted = hoppingAmplitudeSet.isSorted;
+	useBasisIndexLookupTable
+		= hoppingAmplitudeSet.useBasisIndexLookupTable;
+	basisIndexLookupTable = std::move(
+		hoppingAmplitudeSet.basisIndexLookupTable
+	);
 	numMatrixElements = hoppingAmplitudeSet.numMatrixElements;
 
 	cooRowIndices = hoppingAmplitudeSet.cooRowIndices;
@@ -92,12 +107,17 @@ HoppingAmplitudeSet::HoppingAmplitudeSet(
 
 	cooValues = hoppingAmplitudeSet.cooValues;
 	hoppingAmplitudeSet.cooValues = nullptr;
+
+	if(isConstructed)
+		generateAmplitudeBatches();
 }
 
 HoppingAmplitudeSet::HoppingAmplitudeSet(
 	const string &serialization,
 	Mode mode
 ){
+	useBasisIndexLookupTable = true;
+
 	switch(mode){
 	case Mode::Debug:
 	{
@@ -249,6 +269,45 @@ HoppingAmplitudeSet::HoppingAmplitudeSet(
 
 		break;
 	}
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "HoppingAmplitudeSet");
+		hoppingAmplitudeTree = HoppingAmplitudeTree(
+			reader.readString("hoppingAmplitudeTree"),
+			mode
+		);
+		isConstructed = reader.read<bool>("isConstructed");
+		isSorted = reader.read<bool>("isSorted");
+		numMatrixElements = reader.read<int>("numMatrixElements");
+		if(numMatrixElements == -1){
+			cooRowIndices = nullptr;
+			cooColIndices = nullptr;
+			cooValues = nullptr;
+		}
+		else{
+			TBTKAssert(
+				reader.getArraySize<int>("cooRowIndices")
+					== (uint64_t)numMatrixElements
+				&& reader.getArraySize<int>("cooColIndices")
+					== (uint64_t)numMatrixElements
+				&& reader.getArraySize<complex<double>>(
+					"cooValues"
+				) == (uint64_t)numMatrixElements,
+				"HoppingAmplitudeSet::HoppingAmplitudeSet()",
+				"Incompatible array sizes.",
+				""
+			);
+
+			cooRowIndices = new int[numMatrixElements];
+			cooColIndices = new int[numMatrixElements];
+			cooValues = new complex<double>[numMatrixElements];
+			reader.readArray("cooRowIndices", cooRowIndices);
+			reader.readArray("cooColIndices", cooColIndices);
+			reader.readArray("cooValues", cooValues);
+		}
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"HoppingAmplitudeSet::HoppingAmplitudeSet()",
@@ -256,6 +315,11 @@ HoppingAmplitudeSet::HoppingAmplitudeSet(
 			""
 		);
 	}
+
+	if(isConstructed){
+		basisIndexLookupTable.generate(hoppingAmplitudeTree);
+		generateAmplitudeBatches();
+	}
 }
 
 HoppingAmplitudeSet::~HoppingAmplitudeSet(){
@@ -274,6 +338,8 @@ HoppingAmplitudeSet& HoppingAmplitudeSet::operator=(
 		hoppingAmplitudeTree = rhs.hoppingAmplitudeTree;
 		isConstructed = rhs.isConstructed;
 		isSorted = rhs.isSorted;
+		useBasisIndexLookupTable = rhs.useBasisIndexLookupTable;
+		basisIndexLookupTable = rhs.basisIndexLookupTable;
 		numMatrixElements = rhs.numMatrixElements;
 
 		if(numMatrixElements == -1){
@@ -291,6 +357,9 @@ HoppingAmplitudeSet& HoppingAmplitudeSet::operator=(
 				cooValues[n] = rhs.cooValues[n];
 			}
 		}
+
+		if(isConstructed)
+			generateAmplitudeBatches();
 	}
 
 	return *this;
@@ -301,6 +370,8 @@ HoppingAmplitudeSet& HoppingAmplitudeSet::operator=(HoppingAmplitudeSet &&rhs){
 		hoppingAmplitudeTree = rhs.hoppingAmplitudeTree;
 		isConstructed = rhs.isConstructed;
 		isSorted = rhs.isSorted;
+		useBasisIndexLookupTable = rhs.useBasisIndexLookupTable;
+		basisIndexLookupTable = std::move(rhs.basisIndexLookupTable);
 		numMatrixElements = rhs.numMatrixElements;
 
 		cooRowIndices = rhs.cooRowIndices;
@@ -311,6 +382,9 @@ HoppingAmplitudeSet& HoppingAmplitudeSet::operator=(HoppingAmplitudeSet &&rhs){
 
 		cooValues = rhs.cooValues;
 		rhs.cooValues = nullptr;
+
+		if(isConstructed)
+			generateAmplitudeBatches();
 	}
 
 	return *this;
@@ -422,9 +496,127 @@ void HoppingAmplitudeSet::destructCOO(){
 }
 
 void HoppingAmplitudeSet::reconstructCOO(){
-	if(numMatrixElements != -1){
-		destructCOO();
-		constructCOO();
+	if(numMatrixElements == -1)
+		return;
+
+	vector<complex<double>> amplitudes = getAmplitudes();
+
+	for(int n = 0; n < numMatrixElements; n++)
+		cooValues[n] = 0.;
+
+	int currentMatrixElement = -1;
+	int currentCol = -1;
+	int currentRow = -1;
+	for(unsigned int n = 0; n < amplitudes.size(); n++){
+		int col = fromBasisIndices[n];
+		int row = toBasisIndices[n];
+		if(col > currentCol){
+			currentCol = col;
+			currentRow = -1;
+		}
+		if(row > currentRow){
+			currentRow = row;
+			currentMatrixElement++;
+		}
+
+		//See constructCOO() for why the conjugate is taken.
+		cooValues[currentMatrixElement] += conj(amplitudes[n]);
+	}
+}
+
+vector<complex<double>> HoppingAmplitudeSet::getAmplitudes() const{
+	TBTKAssert(
+		isConstructed,
+		"HoppingAmplitudeSet::getAmplitudes()",
+		"HoppingAmplitudeSet not constructed.",
+		"Use Model::construct() to construct the HoppingAmplitudeSet."
+	);
+
+	//The constant amplitudes are already known, amplitudes that use a
+	//callback function are evaluated individually, while the remaining
+	//amplitudes are evaluated in one batch per AmplitudeCallback.
+	vector<complex<double>> amplitudes = constantAmplitudes;
+	for(unsigned int n = 0; n < callbackFunctionAmplitudes.size(); n++){
+		amplitudes[callbackFunctionPositions[n]]
+			= callbackFunctionAmplitudes[n]->getAmplitude();
+	}
+	vector<complex<double>> values;
+	for(unsigned int c = 0; c < amplitudeBatches.size(); c++){
+		const AmplitudeBatch &batch = amplitudeBatches[c];
+		unsigned int numAmplitudes = batch.positions.size();
+		values.resize(numAmplitudes);
+		batch.callback->getHoppingAmplitudes(
+			numAmplitudes,
+			batch.toIndices.data(),
+			batch.fromIndices.data(),
+			batch.toBasisIndices.data(),
+			batch.fromBasisIndices.data(),
+			values.data()
+		);
+
+		for(unsigned int n = 0; n < numAmplitudes; n++)
+			amplitudes[batch.positions[n]] = values[n];
+	}
+
+	return amplitudes;
+}
+
+void HoppingAmplitudeSet::generateAmplitudeBatches(){
+	toBasisIndices.clear();
+	fromBasisIndices.clear();
+	constantAmplitudes.clear();
+	callbackFunctionAmplitudes.clear();
+	callbackFunctionPositions.clear();
+	amplitudeBatches.clear();
+
+	unordered_map<const HoppingAmplitude::AmplitudeCallback*, unsigned int>
+		batchIDs;
+	HoppingAmplitudeSet::Iterator it = getIterator();
+	const HoppingAmplitude *ha;
+	while((ha = it.getHA())){
+		unsigned int position = constantAmplitudes.size();
+		int to = getBasisIndex(ha->getToIndex());
+		int from = getBasisIndex(ha->getFromIndex());
+		toBasisIndices.push_back(to);
+		fromBasisIndices.push_back(from);
+
+		const HoppingAmplitude::AmplitudeCallback *callback
+			= ha->getAmplitudeCallback();
+		if(ha->getIsAmplitudeConstant()){
+			constantAmplitudes.push_back(ha->getAmplitude());
+		}
+		else if(callback == nullptr){
+			constantAmplitudes.push_back(0.);
+			callbackFunctionAmplitudes.push_back(ha);
+			callbackFunctionPositions.push_back(position);
+		}
+		else{
+			constantAmplitudes.push_back(0.);
+
+			unordered_map<
+				const HoppingAmplitude::AmplitudeCallback*,
+				unsigned int
+			>::iterator iterator = batchIDs.find(callback);
+			unsigned int id;
+			if(iterator == batchIDs.end()){
+				id = amplitudeBatches.size();
+				batchIDs[callback] = id;
+				amplitudeBatches.push_back(AmplitudeBatch());
+				amplitudeBatches.back().callback = callback;
+			}
+			else{
+				id = iterator->second;
+			}
+
+			AmplitudeBatch &batch = amplitudeBatches[id];
+			batch.toIndices.push_back(&ha->getToIndex());
+			batch.fromIndices.push_back(&ha->getFromIndex());
+			batch.toBasisIndices.push_back(to);
+			batch.fromBasisIndices.push_back(from);
+			batch.positions.push_back(position);
+		}
+
+		it.searchNextHA();
 	}
 }
 
@@ -501,6 +693,36 @@ string HoppingAmplitudeSet::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("HoppingAmplitudeSet");
+		writer.writeString(
+			"hoppingAmplitudeTree",
+			hoppingAmplitudeTree.serialize(mode)
+		);
+		writer.write("isConstructed", isConstructed);
+		writer.write("isSorted", isSorted);
+		writer.write("numMatrixElements", numMatrixElements);
+		if(numMatrixElements != -1){
+			writer.writeArray(
+				"cooRowIndices",
+				cooRowIndices,
+				numMatrixElements
+			);
+			writer.writeArray(
+				"cooColIndices",
+				cooColIndices,
+				numMatrixElements
+			);
+			writer.writeArray(
+				"cooValues",
+				cooValues,
+				numMatrixElements
+			);
+		}
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"HoppingAmplitudeSet::serialize()",
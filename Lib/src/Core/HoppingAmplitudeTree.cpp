@@ -23,6 +23,9 @@
 #include "TBTK/Streams.h"
 
 #include <algorithm>
+#ifdef TBTK_USE_OPEN_MP
+#	include <omp.h>
+#endif
 
 #include "TBTK/json.hpp"
 
@@ -33,6 +36,28 @@ namespace TBTK{
 
 const HoppingAmplitudeTree HoppingAmplitudeTree::emptyTree;
 
+struct HoppingAmplitudeTree::BinaryData{
+	/** Node data in pre-order. */
+	vector<int> nodeBasisIndices;
+	vector<int> nodeBasisSizes;
+	vector<uint8_t> nodeIsPotentialBlockSeparator;
+	vector<uint32_t> nodeNumChildren;
+	vector<uint32_t> nodeNumHoppingAmplitudes;
+
+	/** HoppingAmplitude data in the order the nodes are visited. For each
+	 *  HoppingAmplitude, indexSizes contains the size of the to- and
+	 *  from-Index, and the subindices of both are concatenated into
+	 *  subindices. */
+	vector<complex<double>> amplitudes;
+	vector<uint32_t> indexSizes;
+	vector<int> subindices;
+
+	/** Read positions used during deserialization. */
+	unsigned int nodeCounter = 0;
+	unsigned int amplitudeCounter = 0;
+	unsigned int subindexCounter = 0;
+};
+
 HoppingAmplitudeTree::HoppingAmplitudeTree(){
 	basisIndex = -1;
 	basisSize = -1;
@@ -172,6 +197,64 @@ HoppingAmplitudeTree::HoppingAmplitudeTree(
 
 		break;
 	}
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "HoppingAmplitudeTree");
+		BinaryData binaryData;
+		binaryData.nodeBasisIndices
+			= reader.readVector<int>("nodeBasisIndices");
+		binaryData.nodeBasisSizes
+			= reader.readVector<int>("nodeBasisSizes");
+		binaryData.nodeIsPotentialBlockSeparator
+			= reader.readVector<uint8_t>(
+				"nodeIsPotentialBlockSeparator"
+			);
+		binaryData.nodeNumChildren
+			= reader.readVector<uint32_t>("nodeNumChildren");
+		binaryData.nodeNumHoppingAmplitudes
+			= reader.readVector<uint32_t>(
+				"nodeNumHoppingAmplitudes"
+			);
+		binaryData.amplitudes
+			= reader.readVector<complex<double>>("amplitudes");
+		binaryData.indexSizes
+			= reader.readVector<uint32_t>("indexSizes");
+		binaryData.subindices
+			= reader.readVector<int>("subindices");
+
+		unsigned int numNodes = binaryData.nodeBasisIndices.size();
+		TBTKAssert(
+			numNodes > 0
+			&& binaryData.nodeBasisSizes.size() == numNodes
+			&& binaryData.nodeIsPotentialBlockSeparator.size()
+				== numNodes
+			&& binaryData.nodeNumChildren.size() == numNodes
+			&& binaryData.nodeNumHoppingAmplitudes.size()
+				== numNodes
+			&& binaryData.indexSizes.size()
+				== 2*binaryData.amplitudes.size(),
+			"HoppingAmplitudeTree::HoppingAmplitudeTree()",
+			"Unable to parse binary serialization string as"
+			<< " HoppingAmplitudeTree.",
+			"The serialization string is corrupted."
+		);
+
+		readBinaryData(binaryData);
+
+		TBTKAssert(
+			binaryData.nodeCounter == numNodes
+			&& binaryData.amplitudeCounter
+				== binaryData.amplitudes.size()
+			&& binaryData.subindexCounter
+				== binaryData.subindices.size(),
+			"HoppingAmplitudeTree::HoppingAmplitudeTree()",
+			"Unable to parse binary serialization string as"
+			<< " HoppingAmplitudeTree.",
+			"The serialization string is corrupted."
+		);
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"HoppingAmplitudeTree::HoppingAmplitudeTree()",
@@ -184,6 +267,107 @@ HoppingAmplitudeTree::HoppingAmplitudeTree(
 HoppingAmplitudeTree::~HoppingAmplitudeTree(){
 }
 
+void HoppingAmplitudeTree::appendBinaryData(BinaryData &binaryData) const{
+	binaryData.nodeBasisIndices.push_back(basisIndex);
+	binaryData.nodeBasisSizes.push_back(basisSize);
+	binaryData.nodeIsPotentialBlockSeparator.push_back(
+		isPotentialBlockSeparator
+	);
+	binaryData.nodeNumChildren.push_back(children.size());
+	binaryData.nodeNumHoppingAmplitudes.push_back(
+		hoppingAmplitudes.size()
+	);
+
+	for(unsigned int n = 0; n < hoppingAmplitudes.size(); n++){
+		const HoppingAmplitude &ha = hoppingAmplitudes[n];
+		TBTKAssert(
+			ha.amplitudeCallback == nullptr
+			&& ha.amplitudeCallbackObject == nullptr,
+			"HoppingAmplitudeTree::serialize()",
+			"Unable to serialize HoppingAmplitude that uses callback"
+			<< " value.",
+			""
+		);
+
+		binaryData.amplitudes.push_back(ha.amplitude);
+		binaryData.indexSizes.push_back(ha.toIndex.getSize());
+		binaryData.indexSizes.push_back(ha.fromIndex.getSize());
+		for(unsigned int c = 0; c < ha.toIndex.getSize(); c++)
+			binaryData.subindices.push_back(ha.toIndex[c]);
+		for(unsigned int c = 0; c < ha.fromIndex.getSize(); c++)
+			binaryData.subindices.push_back(ha.fromIndex[c]);
+	}
+
+	for(unsigned int n = 0; n < children.size(); n++)
+		children[n].appendBinaryData(binaryData);
+}
+
+void HoppingAmplitudeTree::readBinaryData(BinaryData &binaryData){
+	TBTKAssert(
+		binaryData.nodeCounter < binaryData.nodeBasisIndices.size(),
+		"HoppingAmplitudeTree::HoppingAmplitudeTree()",
+		"Unable to parse binary serialization string as"
+		<< " HoppingAmplitudeTree.",
+		"The serialization string is corrupted."
+	);
+
+	unsigned int node = binaryData.nodeCounter++;
+	basisIndex = binaryData.nodeBasisIndices[node];
+	basisSize = binaryData.nodeBasisSizes[node];
+	isPotentialBlockSeparator
+		= binaryData.nodeIsPotentialBlockSeparator[node];
+
+	unsigned int numHoppingAmplitudes
+		= binaryData.nodeNumHoppingAmplitudes[node];
+	TBTKAssert(
+		binaryData.amplitudeCounter + numHoppingAmplitudes
+			<= binaryData.amplitudes.size(),
+		"HoppingAmplitudeTree::HoppingAmplitudeTree()",
+		"Unable to parse binary serialization string as"
+		<< " HoppingAmplitudeTree.",
+		"The serialization string is corrupted."
+	);
+	hoppingAmplitudes.reserve(numHoppingAmplitudes);
+	for(unsigned int n = 0; n < numHoppingAmplitudes; n++){
+		unsigned int a = binaryData.amplitudeCounter++;
+		unsigned int toSize = binaryData.indexSizes[2*a];
+		unsigned int fromSize = binaryData.indexSizes[2*a + 1];
+		TBTKAssert(
+			binaryData.subindexCounter + toSize + fromSize
+				<= binaryData.subindices.size(),
+			"HoppingAmplitudeTree::HoppingAmplitudeTree()",
+			"Unable to parse binary serialization string as"
+			<< " HoppingAmplitudeTree.",
+			"The serialization string is corrupted."
+		);
+
+		const int *subindices
+			= &binaryData.subindices[binaryData.subindexCounter];
+		Index toIndex;
+		toIndex.reserve(toSize);
+		for(unsigned int c = 0; c < toSize; c++)
+			toIndex.push_back(subindices[c]);
+		Index fromIndex;
+		fromIndex.reserve(fromSize);
+		for(unsigned int c = 0; c < fromSize; c++)
+			fromIndex.push_back(subindices[toSize + c]);
+		binaryData.subindexCounter += toSize + fromSize;
+
+		hoppingAmplitudes.push_back(
+			HoppingAmplitude(
+				binaryData.amplitudes[a],
+				std::move(toIndex),
+				std::move(fromIndex)
+			)
+		);
+	}
+
+	unsigned int numChildren = binaryData.nodeNumChildren[node];
+	children.resize(numChildren);
+	for(unsigned int n = 0; n < numChildren; n++)
+		children[n].readBinaryData(binaryData);
+}
+
 vector<Index> HoppingAmplitudeTree::getIndexList(const Index &pattern) const{
 	vector<Index> indexList;
 
@@ -312,10 +496,119 @@ void HoppingAmplitudeTree::add(HoppingAmplitude &ha, unsigned int subindex){
 			exit(1);
 		}*/
 		//Add HoppingAmplitude to node.
-		hoppingAmplitudes.push_back(ha);
+		hoppingAmplitudes.push_back(std::move(ha));
 	}
 }
 
+void HoppingAmplitudeTree::add(vector<HoppingAmplitude> &hoppingAmplitudes){
+	//Pair the first subindex of every HoppingAmplitude with its position.
+	//HoppingAmplitudes with an empty from-Index are stored on this node
+	//and are added directly, which also generates the appropriate error
+	//messages for incompatible indices.
+	vector<pair<int, unsigned int>> keys;
+	keys.reserve(hoppingAmplitudes.size());
+	for(unsigned int n = 0; n < hoppingAmplitudes.size(); n++){
+		const Index &fromIndex = hoppingAmplitudes[n].getFromIndex();
+		if(fromIndex.getSize() == 0){
+			add(hoppingAmplitudes[n], 0);
+			continue;
+		}
+
+		TBTKAssert(
+			fromIndex[0] >= 0,
+			"HoppingAmplitude:add()",
+			"Invalid Index. Only indices with non-negative"
+			<< " subindices can be added. But the from-Index "
+			<< fromIndex.toString() << " has a negative subindex"
+			<< " in position '0'.",
+			""
+		);
+		keys.push_back(make_pair(fromIndex[0], n));
+	}
+
+	if(keys.size() == 0){
+		hoppingAmplitudes.clear();
+
+		return;
+	}
+
+	//Error detection. A HoppingAmplitude with fewer subindices has
+	//previously been added to this node.
+	TBTKAssert(
+		this->hoppingAmplitudes.size() == 0,
+		"HoppingAmplitudeTree::add()",
+		"Incompatible HoppingAmplitudes. Tried to add a"
+		<< " HoppingAmplitude with a non-empty from-Index, but"
+		<< " HoppingAmplitude with from-Index "
+		<< this->hoppingAmplitudes[0].getFromIndex().toString()
+		<< " has already been added.",
+		""
+	);
+
+	//Group the HoppingAmplitudes by their first subindex. The positions
+	//are unique, which makes the sort stable with respect to the order
+	//in which the HoppingAmplitudes were given. Only the distinct
+	//subindices give rise to groups, which keeps the memory proportional
+	//to the number of HoppingAmplitudes also for sparse indices.
+	std::sort(keys.begin(), keys.end());
+	vector<unsigned int> groupOffsets;
+	for(unsigned int n = 0; n < keys.size(); n++)
+		if(n == 0 || keys[n].first != keys[n-1].first)
+			groupOffsets.push_back(n);
+	groupOffsets.push_back(keys.size());
+
+	//Create child nodes. Performed serially since the child vector is
+	//modified.
+	for(int n = children.size(); n <= keys.back().first; n++)
+		children.push_back(HoppingAmplitudeTree());
+
+	//Build the subtrees corresponding to different first subindices in
+	//parallel.
+	unsigned int numGroups = groupOffsets.size() - 1;
+	bool isBlockSeparator = true;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for schedule(dynamic) reduction(&&:isBlockSeparator)
+#endif
+	for(unsigned int g = 0; g < numGroups; g++){
+		int subindex = keys[groupOffsets[g]].first;
+		for(
+			unsigned int c = groupOffsets[g];
+			c < groupOffsets[g+1];
+			c++
+		){
+			HoppingAmplitude &ha = hoppingAmplitudes[keys[c].second];
+			const Index &toIndex = ha.getToIndex();
+			if(toIndex.getSize() == 0 || toIndex[0] != subindex)
+				isBlockSeparator = false;
+
+			children[subindex].add(ha, 1);
+		}
+	}
+	if(!isBlockSeparator)
+		isPotentialBlockSeparator = false;
+
+	hoppingAmplitudes.clear();
+}
+
+void HoppingAmplitudeTree::reserve(const vector<unsigned int> &capacity){
+	reserve(capacity, 0);
+}
+
+void HoppingAmplitudeTree::reserve(
+	const vector<unsigned int> &capacity,
+	unsigned int subindex
+){
+	if(subindex == capacity.size() || hoppingAmplitudes.size() != 0)
+		return;
+
+	children.reserve(capacity[subindex]);
+	for(unsigned int n = children.size(); n < capacity[subindex]; n++)
+		children.push_back(HoppingAmplitudeTree());
+
+	for(unsigned int n = 0; n < capacity[subindex]; n++)
+		children[n].reserve(capacity, subindex+1);
+}
+
 const HoppingAmplitudeTree* HoppingAmplitudeTree::getSubTree(
 	const Index &subspace
 ) const{
@@ -661,6 +954,55 @@ string HoppingAmplitudeTree::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryData binaryData;
+		appendBinaryData(binaryData);
+
+		BinaryWriter writer("HoppingAmplitudeTree");
+		writer.writeArray(
+			"nodeBasisIndices",
+			binaryData.nodeBasisIndices.data(),
+			binaryData.nodeBasisIndices.size()
+		);
+		writer.writeArray(
+			"nodeBasisSizes",
+			binaryData.nodeBasisSizes.data(),
+			binaryData.nodeBasisSizes.size()
+		);
+		writer.writeArray(
+			"nodeIsPotentialBlockSeparator",
+			binaryData.nodeIsPotentialBlockSeparator.data(),
+			binaryData.nodeIsPotentialBlockSeparator.size()
+		);
+		writer.writeArray(
+			"nodeNumChildren",
+			binaryData.nodeNumChildren.data(),
+			binaryData.nodeNumChildren.size()
+		);
+		writer.writeArray(
+			"nodeNumHoppingAmplitudes",
+			binaryData.nodeNumHoppingAmplitudes.data(),
+			binaryData.nodeNumHoppingAmplitudes.size()
+		);
+		writer.writeArray(
+			"amplitudes",
+			binaryData.amplitudes.data(),
+			binaryData.amplitudes.size()
+		);
+		writer.writeArray(
+			"indexSizes",
+			binaryData.indexSizes.data(),
+			binaryData.indexSizes.size()
+		);
+		writer.writeArray(
+			"subindices",
+			binaryData.subindices.data(),
+			binaryData.subindices.size()
+		);
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"HoppingAmplitudeTree::serialize()",
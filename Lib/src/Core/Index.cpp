@@ -31,53 +31,68 @@ using namespace nlohmann;
 
 namespace TBTK{
 
-Index::Index(const Index &head, const Index &tail){
-	indices.reserve(head.getSize() + tail.getSize());
-	indices.insert(
-		indices.end(),
-		head.indices.begin(),
-		head.indices.end()
-	);
-	indices.insert(
-		indices.end(),
-		tail.indices.begin(),
-		tail.indices.end()
-	);
+Index::Index(const Index &head, const Index &tail) :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
+	grow(head.size + tail.size);
+	for(unsigned int n = 0; n < head.size; n++)
+		indices[n] = head.indices[n];
+	for(unsigned int n = 0; n < tail.size; n++)
+		indices[head.size + n] = tail.indices[n];
+	size = head.size + tail.size;
 }
 
-Index::Index(initializer_list<initializer_list<int>> indexList){
+Index::Index(initializer_list<initializer_list<int>> indexList) :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
 	for(unsigned int n = 0; n < indexList.size(); n++){
 		if(n > 0)
-			indices.push_back(IDX_SEPARATOR);
+			push_back(IDX_SEPARATOR);
 		for(unsigned int c = 0; c < (indexList.begin()+n)->size(); c++)
-			indices.push_back(*((indexList.begin() + n)->begin() + c));
+			push_back(*((indexList.begin() + n)->begin() + c));
 	}
 }
 
-Index::Index(const vector<vector<int>> &indexList){
+Index::Index(const vector<vector<int>> &indexList) :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
 	for(unsigned int n = 0; n < indexList.size(); n++){
 		if(n > 0)
-			indices.push_back(IDX_SEPARATOR);
+			push_back(IDX_SEPARATOR);
 		for(unsigned int c = 0; c < indexList.at(n).size(); c++)
-			indices.push_back(indexList.at(n).at(c));
+			push_back(indexList.at(n).at(c));
 	}
 }
 
-Index::Index(initializer_list<Index> indexList){
+Index::Index(initializer_list<Index> indexList) :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
 	for(unsigned int n = 0; n < indexList.size(); n++){
 		if(n > 0)
-			indices.push_back(IDX_SEPARATOR);
+			push_back(IDX_SEPARATOR);
 		for(
 			unsigned int c = 0;
 			c < (indexList.begin() + n)->getSize();
 			c++
 		){
-			indices.push_back((indexList.begin() + n)->at(c));
+			push_back((indexList.begin() + n)->at(c));
 		}
 	}
 }
 
-Index::Index(const string &indexString){
+Index::Index(const string &indexString) :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
 	TBTKExceptionAssert(
 		indexString[0] == '{',
 		IndexException(
@@ -243,11 +258,17 @@ Index::Index(const string &indexString){
 		)
 	);
 
-	for(unsigned int n = 0; n < indexVector.size(); n++)
-		indices.push_back(indexVector.at(n));
+	assign(indexVector.data(), indexVector.size());
 }
 
-Index::Index(const string &serialization, Serializeable::Mode mode){
+Index::Index(
+	const string &serialization,
+	Serializeable::Mode mode
+) :
+	indices(stackIndices),
+	size(0),
+	capacity(STACK_CAPACITY)
+{
 	switch(mode){
 	case Serializeable::Mode::Debug:
 	{
@@ -267,7 +288,7 @@ Index::Index(const string &serialization, Serializeable::Mode mode){
 		ss.str(content);
 		int subindex;
 		while((ss >> subindex)){
-			indices.push_back(subindex);
+			push_back(subindex);
 			char c;
 			TBTKAssert(
 				!(ss >> c) || c == ',',
@@ -291,7 +312,9 @@ Index::Index(const string &serialization, Serializeable::Mode mode){
 
 		try{
 			json j = json::parse(serialization);
-			indices = j.at("indices").get<vector<int>>();
+			vector<int> subindices
+				= j.at("indices").get<vector<int>>();
+			assign(subindices.data(), subindices.size());
 		}
 		catch(json::exception e){
 			TBTKExit(
@@ -304,6 +327,14 @@ Index::Index(const string &serialization, Serializeable::Mode mode){
 
 		break;
 	}
+	case Serializeable::Mode::Binary:
+	{
+		Serializeable::BinaryReader reader(serialization, "Index");
+		vector<int> subindices = reader.readVector<int>("indices");
+		assign(subindices.data(), subindices.size());
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"Index::Index()",
@@ -377,11 +408,12 @@ Index Index::getUnitRange(){
 }
 
 Index Index::getSubIndex(int first, int last){
-	vector<int> newSubindices;
+	Index subIndex;
+	subIndex.reserve(last - first + 1);
 	for(int n = first; n <= last; n++)
-		newSubindices.push_back(indices.at(n));
+		subIndex.push_back(at(n));
 
-	return Index(newSubindices);
+	return subIndex;
 }
 
 string Index::serialize(Serializeable::Mode mode) const{
@@ -390,10 +422,10 @@ string Index::serialize(Serializeable::Mode mode) const{
 	{
 		stringstream ss;
 		ss << "Index(";
-		for(unsigned int n = 0; n < indices.size(); n++){
+		for(unsigned int n = 0; n < size; n++){
 			if(n != 0)
 				ss << ",";
-			ss << Serializeable::serialize(indices.at(n), mode);
+			ss << Serializeable::serialize(indices[n], mode);
 		}
 		ss << ")";
 
@@ -403,10 +435,17 @@ string Index::serialize(Serializeable::Mode mode) const{
 	{
 		json j;
 		j["id"] = "Index";
-		j["indices"] = json(indices);
+		j["indices"] = json(vector<int>(indices, indices + size));
 
 		return j.dump();
 	}
+	case Serializeable::Mode::Binary:
+	{
+		Serializeable::BinaryWriter writer("Index");
+		writer.writeArray("indices", indices, size);
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"Index::serialize()",
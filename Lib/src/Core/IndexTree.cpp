@@ -30,6 +30,18 @@ using namespace nlohmann;
 
 namespace TBTK{
 
+struct IndexTree::BinaryData{
+	/** Node data in pre-order. The flags contain indexIncluded,
+	 *  wildcardIndex, and indexSeparator as bit 0, 1, and 2. */
+	vector<uint32_t> numChildren;
+	vector<uint8_t> flags;
+	vector<int> wildcardTypes;
+	vector<int> linearIndices;
+
+	/** Read position used during deserialization. */
+	unsigned int nodeCounter = 0;
+};
+
 IndexTree::IndexTree(){
 	indexIncluded = false;
 	wildcardIndex = false;
@@ -122,6 +134,42 @@ IndexTree::IndexTree(const string &serialization, Mode mode){
 
 		break;
 	}
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "IndexTree");
+		BinaryData binaryData;
+		binaryData.numChildren
+			= reader.readVector<uint32_t>("numChildren");
+		binaryData.flags = reader.readVector<uint8_t>("flags");
+		binaryData.wildcardTypes
+			= reader.readVector<int>("wildcardTypes");
+		binaryData.linearIndices
+			= reader.readVector<int>("linearIndices");
+
+		unsigned int numNodes = binaryData.numChildren.size();
+		TBTKAssert(
+			numNodes > 0
+			&& binaryData.flags.size() == numNodes
+			&& binaryData.wildcardTypes.size() == numNodes
+			&& binaryData.linearIndices.size() == numNodes,
+			"IndexTree::IndexTree()",
+			"Unable to parse binary serialization string as"
+			<< " IndexTree.",
+			"The serialization string is corrupted."
+		);
+
+		readBinaryData(binaryData);
+		TBTKAssert(
+			binaryData.nodeCounter == numNodes,
+			"IndexTree::IndexTree()",
+			"Unable to parse binary serialization string as"
+			<< " IndexTree.",
+			"The serialization string is corrupted."
+		);
+		size = reader.read<int>("size");
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"IndexTree::IndexTree()",
@@ -134,6 +182,41 @@ IndexTree::IndexTree(const string &serialization, Mode mode){
 IndexTree::~IndexTree(){
 }
 
+void IndexTree::appendBinaryData(BinaryData &binaryData) const{
+	binaryData.numChildren.push_back(children.size());
+	binaryData.flags.push_back(
+		(indexIncluded ? 1 : 0)
+		| (wildcardIndex ? 2 : 0)
+		| (indexSeparator ? 4 : 0)
+	);
+	binaryData.wildcardTypes.push_back(wildcardType);
+	binaryData.linearIndices.push_back(linearIndex);
+
+	for(unsigned int n = 0; n < children.size(); n++)
+		children[n].appendBinaryData(binaryData);
+}
+
+void IndexTree::readBinaryData(BinaryData &binaryData){
+	TBTKAssert(
+		binaryData.nodeCounter < binaryData.numChildren.size(),
+		"IndexTree::IndexTree()",
+		"Unable to parse binary serialization string as IndexTree.",
+		"The serialization string is corrupted."
+	);
+
+	unsigned int node = binaryData.nodeCounter++;
+	indexIncluded = binaryData.flags[node] & 1;
+	wildcardIndex = binaryData.flags[node] & 2;
+	indexSeparator = binaryData.flags[node] & 4;
+	wildcardType = binaryData.wildcardTypes[node];
+	linearIndex = binaryData.linearIndices[node];
+	size = -1;
+
+	children.resize(binaryData.numChildren[node]);
+	for(unsigned int n = 0; n < children.size(); n++)
+		children[n].readBinaryData(binaryData);
+}
+
 void IndexTree::add(const Index &index){
 	add(index, 0);
 }
@@ -479,6 +562,26 @@ vector<Index> IndexTree::getIndexList(const Index &pattern) const{
 	return indexList;
 }
 
+bool IndexTree::equals(const IndexTree &indexTree) const{
+	if(
+		indexIncluded != indexTree.indexIncluded
+		|| wildcardIndex != indexTree.wildcardIndex
+		|| wildcardType != indexTree.wildcardType
+		|| indexSeparator != indexTree.indexSeparator
+		|| linearIndex != indexTree.linearIndex
+		|| size != indexTree.size
+		|| children.size() != indexTree.children.size()
+	){
+		return false;
+	}
+
+	for(unsigned int n = 0; n < children.size(); n++)
+		if(!children[n].equals(indexTree.children[n]))
+			return false;
+
+	return true;
+}
+
 void IndexTree::getPhysicalIndex(int linearIndex, vector<int> *indices) const{
 	if(this->linearIndex != -1)
 		return;
@@ -572,6 +675,36 @@ string IndexTree::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryData binaryData;
+		appendBinaryData(binaryData);
+
+		BinaryWriter writer("IndexTree");
+		writer.writeArray(
+			"numChildren",
+			binaryData.numChildren.data(),
+			binaryData.numChildren.size()
+		);
+		writer.writeArray(
+			"flags",
+			binaryData.flags.data(),
+			binaryData.flags.size()
+		);
+		writer.writeArray(
+			"wildcardTypes",
+			binaryData.wildcardTypes.data(),
+			binaryData.wildcardTypes.size()
+		);
+		writer.writeArray(
+			"linearIndices",
+			binaryData.linearIndices.data(),
+			binaryData.linearIndices.size()
+		);
+		writer.write("size", size);
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"IndexTree:IndexTree()",
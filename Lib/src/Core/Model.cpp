@@ -54,6 +54,17 @@ Model::Model(const vector<unsigned int> &capacity) : Communicator(true){
 }
 
 Model::Model(const Model &model) : Communicator(model){
+	TBTKAssert(
+		model.parameterizedHamiltonians.size() == 0,
+		"Model::Model()",
+		"Unable to copy a Model that contains a"
+		<< " ParameterizedHamiltonian.",
+		"The ParameterizedHamiltonian can only serve a single Model."
+		<< " Add the ParameterizedHamiltonian to the Model after it has"
+		<< " been copied, or use a separate ParameterizedHamiltonian"
+		<< " for each Model."
+	);
+
 	temperature = model.temperature;
 	chemicalPotential = model.chemicalPotential;
 
@@ -86,6 +97,8 @@ Model::Model(Model &&model) : Communicator(std::move(model)){
 
 	hoppingAmplitudeFilter = model.hoppingAmplitudeFilter;
 	model.hoppingAmplitudeFilter = nullptr;
+
+	parameterizedHamiltonians = std::move(model.parameterizedHamiltonians);
 }
 
 Model::Model(const string &serialization, Mode mode) : Communicator(true){
@@ -144,6 +157,22 @@ Model::Model(const string &serialization, Mode mode) : Communicator(true){
 
 		break;
 	}
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "Model");
+		temperature = reader.read<double>("temperature");
+		chemicalPotential = reader.read<double>("chemicalPotential");
+		singleParticleContext = new SingleParticleContext(
+			reader.readString("singleParticleContext"),
+			mode
+		);
+
+		manyBodyContext = nullptr;
+
+		hoppingAmplitudeFilter = nullptr;
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"Model::Model()",
@@ -164,6 +193,16 @@ Model::~Model(){
 
 Model& Model::operator=(const Model &rhs){
 	if(this != &rhs){
+		TBTKAssert(
+			rhs.parameterizedHamiltonians.size() == 0,
+			"Model::operator=()",
+			"Unable to assign a Model that contains a"
+			<< " ParameterizedHamiltonian.",
+			"The ParameterizedHamiltonian can only serve a single"
+			<< " Model. Use a separate ParameterizedHamiltonian for"
+			<< " each Model."
+		);
+
 		temperature = rhs.temperature;
 		chemicalPotential = rhs.chemicalPotential;
 
@@ -193,6 +232,8 @@ Model& Model::operator=(const Model &rhs){
 			hoppingAmplitudeFilter
 				= rhs.hoppingAmplitudeFilter->clone();
 		}
+
+		parameterizedHamiltonians.clear();
 	}
 
 	return *this;
@@ -217,16 +258,79 @@ Model& Model::operator=(Model &&rhs){
 			delete hoppingAmplitudeFilter;
 		hoppingAmplitudeFilter = rhs.hoppingAmplitudeFilter;
 		rhs.hoppingAmplitudeFilter = nullptr;
+
+		parameterizedHamiltonians
+			= std::move(rhs.parameterizedHamiltonians);
 	}
 
 	return *this;
 }
 
+void Model::addHoppingAmplitudes(vector<HoppingAmplitude> &hoppingAmplitudes){
+	if(hoppingAmplitudeFilter != nullptr){
+		unsigned int numIncluded = 0;
+		for(unsigned int n = 0; n < hoppingAmplitudes.size(); n++){
+			if(
+				hoppingAmplitudeFilter->isIncluded(
+					hoppingAmplitudes[n]
+				)
+			){
+				if(numIncluded != n){
+					hoppingAmplitudes[numIncluded] = std::move(
+						hoppingAmplitudes[n]
+					);
+				}
+				numIncluded++;
+			}
+		}
+		hoppingAmplitudes.erase(
+			hoppingAmplitudes.begin() + numIncluded,
+			hoppingAmplitudes.end()
+		);
+	}
+
+	singleParticleContext->addHoppingAmplitudes(hoppingAmplitudes);
+}
+
+void Model::addHoppingAmplitudes(
+	unsigned int numPartitions,
+	function<void(
+		unsigned int partition,
+		vector<HoppingAmplitude> &hoppingAmplitudes
+	)> generator
+){
+	vector<vector<HoppingAmplitude>> partitions(numPartitions);
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for schedule(dynamic)
+#endif
+	for(unsigned int n = 0; n < numPartitions; n++)
+		generator(n, partitions[n]);
+
+	unsigned int numHoppingAmplitudes = 0;
+	for(unsigned int n = 0; n < numPartitions; n++)
+		numHoppingAmplitudes += partitions[n].size();
+
+	vector<HoppingAmplitude> hoppingAmplitudes;
+	hoppingAmplitudes.reserve(numHoppingAmplitudes);
+	for(unsigned int n = 0; n < numPartitions; n++){
+		for(unsigned int c = 0; c < partitions[n].size(); c++){
+			hoppingAmplitudes.push_back(
+				std::move(partitions[n][c])
+			);
+		}
+		partitions[n].clear();
+		partitions[n].shrink_to_fit();
+	}
+
+	addHoppingAmplitudes(hoppingAmplitudes);
+}
+
 void Model::addModel(const Model &model, const Index &index){
+	vector<HoppingAmplitude> hoppingAmplitudes;
 	HoppingAmplitudeSet::Iterator it = model.getHoppingAmplitudeSet()->getIterator();
 	const HoppingAmplitude *ha;
 	while((ha = it.getHA())){
-		addHoppingAmplitude(
+		hoppingAmplitudes.push_back(
 			HoppingAmplitude(
 				ha->getAmplitude(),
 				Index(index, ha->getToIndex()),
@@ -236,6 +340,8 @@ void Model::addModel(const Model &model, const Index &index){
 
 		it.searchNextHA();
 	}
+
+	singleParticleContext->addHoppingAmplitudes(hoppingAmplitudes);
 }
 
 void Model::construct(){
@@ -243,6 +349,11 @@ void Model::construct(){
 		Streams::out << "Constructing system\n";
 
 	singleParticleContext->construct();
+	for(unsigned int n = 0; n < parameterizedHamiltonians.size(); n++){
+		parameterizedHamiltonians[n]->generateLookupTable(
+			*getHoppingAmplitudeSet()
+		);
+	}
 
 	int basisSize = getBasisSize();
 
@@ -250,6 +361,32 @@ void Model::construct(){
 		Streams::out << "\tBasis size: " << basisSize << "\n";
 }
 
+Model& Model::operator<<(ParameterizedHamiltonian &parameterizedHamiltonian){
+	parameterizedHamiltonian.lock();
+
+	vector<HoppingAmplitude> hoppingAmplitudes;
+	hoppingAmplitudes.reserve(
+		parameterizedHamiltonian.getNumMatrixElements()
+	);
+	for(
+		unsigned int n = 0;
+		n < parameterizedHamiltonian.getNumMatrixElements();
+		n++
+	){
+		hoppingAmplitudes.push_back(
+			HoppingAmplitude(
+				parameterizedHamiltonian,
+				parameterizedHamiltonian.getToIndex(n),
+				parameterizedHamiltonian.getFromIndex(n)
+			)
+		);
+	}
+	addHoppingAmplitudes(hoppingAmplitudes);
+	parameterizedHamiltonians.push_back(&parameterizedHamiltonian);
+
+	return *this;
+}
+
 string Model::serialize(Mode mode) const{
 	switch(mode){
 	case Mode::Debug:
@@ -275,6 +412,18 @@ string Model::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("Model");
+		writer.write("temperature", temperature);
+		writer.write("chemicalPotential", chemicalPotential);
+		writer.writeString(
+			"singleParticleContext",
+			singleParticleContext->serialize(mode)
+		);
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"Model::serialize()",
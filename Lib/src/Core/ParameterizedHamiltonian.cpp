@@ -0,0 +1,334 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file ParameterizedHamiltonian.cpp
+ *
+ *  @author Kristofer Björnson
+ */
+
+#include "TBTK/HoppingAmplitudeSet.h"
+#include "TBTK/ParameterizedHamiltonian.h"
+#include "TBTK/TBTKMacros.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace TBTK{
+
+ParameterizedHamiltonian::ParameterizedHamiltonian(){
+	isLocked = false;
+}
+
+void ParameterizedHamiltonian::addParameter(
+	const string &name,
+	complex<double> value
+){
+	for(unsigned int n = 0; n < parameterNames.size(); n++){
+		TBTKAssert(
+			parameterNames[n].compare(name) != 0,
+			"ParameterizedHamiltonian::addParameter()",
+			"Parameter '" << name << "' already exists.",
+			""
+		);
+	}
+
+	parameterNames.push_back(name);
+	parameterValues.push_back(value);
+	termMatrixElements.push_back(vector<unsigned int>());
+	termValues.push_back(vector<complex<double>>());
+	conjugateTermMatrixElements.push_back(vector<unsigned int>());
+	conjugateTermValues.push_back(vector<complex<double>>());
+}
+
+void ParameterizedHamiltonian::add(const HoppingAmplitude &hoppingAmplitude){
+	unsigned int matrixElement = getOrCreateMatrixElement(
+		hoppingAmplitude.getToIndex(),
+		hoppingAmplitude.getFromIndex()
+	);
+	baseValues[matrixElement] += hoppingAmplitude.getAmplitude();
+	values[matrixElement] += hoppingAmplitude.getAmplitude();
+}
+
+void ParameterizedHamiltonian::add(
+	const string &parameterName,
+	const HoppingAmplitude &hoppingAmplitude
+){
+	unsigned int parameterID = getParameterID(parameterName);
+	unsigned int matrixElement = getOrCreateMatrixElement(
+		hoppingAmplitude.getToIndex(),
+		hoppingAmplitude.getFromIndex()
+	);
+	termMatrixElements[parameterID].push_back(matrixElement);
+	termValues[parameterID].push_back(hoppingAmplitude.getAmplitude());
+	values[matrixElement]
+		+= parameterValues[parameterID]*hoppingAmplitude.getAmplitude();
+}
+
+void ParameterizedHamiltonian::addConjugate(
+	const string &parameterName,
+	const HoppingAmplitude &hoppingAmplitude
+){
+	unsigned int parameterID = getParameterID(parameterName);
+	unsigned int matrixElement = getOrCreateMatrixElement(
+		hoppingAmplitude.getToIndex(),
+		hoppingAmplitude.getFromIndex()
+	);
+	conjugateTermMatrixElements[parameterID].push_back(matrixElement);
+	conjugateTermValues[parameterID].push_back(
+		hoppingAmplitude.getAmplitude()
+	);
+	values[matrixElement] += conj(parameterValues[parameterID])
+		*hoppingAmplitude.getAmplitude();
+}
+
+void ParameterizedHamiltonian::setParameter(
+	const string &name,
+	complex<double> value
+){
+	parameterValues[getParameterID(name)] = value;
+	update();
+}
+
+void ParameterizedHamiltonian::setParameters(
+	const vector<complex<double>> &values
+){
+	TBTKAssert(
+		values.size() == parameterValues.size(),
+		"ParameterizedHamiltonian::setParameters()",
+		"Expected " << parameterValues.size() << " values, but"
+		<< " received " << values.size() << ".",
+		""
+	);
+
+	parameterValues = values;
+	update();
+}
+
+void ParameterizedHamiltonian::generateLookupTable(
+	const HoppingAmplitudeSet &hoppingAmplitudeSet
+){
+	TBTKAssert(
+		hoppingAmplitudeSet.getIsConstructed(),
+		"ParameterizedHamiltonian::generateLookupTable()",
+		"The HoppingAmplitudeSet is not constructed.",
+		""
+	);
+
+	//Collect the basis indices of the HoppingAmplitudes that use this
+	//ParameterizedHamiltonian and sort them by from- and to-basis index.
+	//Only HoppingAmplitudes that are present in the HoppingAmplitudeSet
+	//are considered, which means that matrix elements that have been
+	//filtered out of the Model are left out.
+	const vector<int> &toBasisIndices
+		= hoppingAmplitudeSet.getToBasisIndices();
+	const vector<int> &fromBasisIndices
+		= hoppingAmplitudeSet.getFromBasisIndices();
+	vector<tuple<int, int, unsigned int>> entries;
+	entries.reserve(values.size());
+	HoppingAmplitudeSet::Iterator iterator
+		= hoppingAmplitudeSet.getIterator();
+	const HoppingAmplitude *hoppingAmplitude;
+	unsigned int counter = 0;
+	while((hoppingAmplitude = iterator.getHA())){
+		if(hoppingAmplitude->getAmplitudeCallback() == this){
+			entries.push_back(
+				make_tuple(
+					fromBasisIndices[counter],
+					toBasisIndices[counter],
+					findMatrixElement(
+						hoppingAmplitude->getToIndex(),
+						hoppingAmplitude->getFromIndex()
+					)
+				)
+			);
+		}
+		counter++;
+
+		iterator.searchNextHA();
+	}
+	sort(entries.begin(), entries.end());
+
+	unsigned int basisSize = hoppingAmplitudeSet.getBasisSize();
+	lookupTableOffsets.assign(basisSize + 1, 0);
+	lookupTableToBasisIndices.resize(entries.size());
+	lookupTableMatrixElements.resize(entries.size());
+	for(unsigned int n = 0; n < entries.size(); n++){
+		lookupTableOffsets[get<0>(entries[n]) + 1]++;
+		lookupTableToBasisIndices[n] = get<1>(entries[n]);
+		lookupTableMatrixElements[n] = get<2>(entries[n]);
+	}
+	for(unsigned int n = 0; n < basisSize; n++)
+		lookupTableOffsets[n+1] += lookupTableOffsets[n];
+}
+
+complex<double> ParameterizedHamiltonian::getHoppingAmplitude(
+	const Index &toIndex,
+	const Index &fromIndex
+) const{
+	return values[findMatrixElement(toIndex, fromIndex)];
+}
+
+void ParameterizedHamiltonian::getHoppingAmplitudes(
+	unsigned int numAmplitudes,
+	const Index *const *toIndices,
+	const Index *const *fromIndices,
+	const int *toBasisIndices,
+	const int *fromBasisIndices,
+	complex<double> *amplitudes
+) const{
+	for(unsigned int n = 0; n < numAmplitudes; n++){
+		//Look up the matrix element using the basis indices. The
+		//Indices are compared to guard against the lookup table
+		//having been generated for a different Model.
+		int from = fromBasisIndices[n];
+		if(from >= 0 && from + 1 < (int)lookupTableOffsets.size()){
+			vector<int>::const_iterator begin
+				= lookupTableToBasisIndices.begin()
+					+ lookupTableOffsets[from];
+			vector<int>::const_iterator end
+				= lookupTableToBasisIndices.begin()
+					+ lookupTableOffsets[from+1];
+			vector<int>::const_iterator iterator = lower_bound(
+				begin,
+				end,
+				toBasisIndices[n]
+			);
+			if(iterator != end && *iterator == toBasisIndices[n]){
+				unsigned int matrixElement
+					= lookupTableMatrixElements[
+						iterator
+						- lookupTableToBasisIndices.begin()
+					];
+				if(
+					this->toIndices[matrixElement].equals(
+						*toIndices[n]
+					) && this->fromIndices[
+						matrixElement
+					].equals(*fromIndices[n])
+				){
+					amplitudes[n] = values[matrixElement];
+					continue;
+				}
+			}
+		}
+
+		amplitudes[n] = values[
+			findMatrixElement(*toIndices[n], *fromIndices[n])
+		];
+	}
+}
+
+vector<int> ParameterizedHamiltonian::getKey(
+	const Index &toIndex,
+	const Index &fromIndex
+){
+	//Physical subindices are non-negative, which makes -1 a safe
+	//separator between the two Indices.
+	vector<int> key;
+	key.reserve(toIndex.getSize() + fromIndex.getSize() + 1);
+	for(unsigned int n = 0; n < toIndex.getSize(); n++)
+		key.push_back(toIndex[n]);
+	key.push_back(-1);
+	for(unsigned int n = 0; n < fromIndex.getSize(); n++)
+		key.push_back(fromIndex[n]);
+
+	return key;
+}
+
+unsigned int ParameterizedHamiltonian::getOrCreateMatrixElement(
+	const Index &toIndex,
+	const Index &fromIndex
+){
+	TBTKAssert(
+		!isLocked,
+		"ParameterizedHamiltonian::add()",
+		"Unable to add HoppingAmplitudes after the"
+		<< " ParameterizedHamiltonian has been added to a Model.",
+		""
+	);
+
+	vector<int> key = getKey(toIndex, fromIndex);
+	map<vector<int>, unsigned int>::iterator iterator
+		= matrixElementMap.find(key);
+	if(iterator != matrixElementMap.end())
+		return iterator->second;
+
+	unsigned int matrixElement = values.size();
+	matrixElementMap[key] = matrixElement;
+	toIndices.push_back(toIndex);
+	fromIndices.push_back(fromIndex);
+	baseValues.push_back(0.);
+	values.push_back(0.);
+
+	return matrixElement;
+}
+
+unsigned int ParameterizedHamiltonian::findMatrixElement(
+	const Index &toIndex,
+	const Index &fromIndex
+) const{
+	map<vector<int>, unsigned int>::const_iterator iterator
+		= matrixElementMap.find(getKey(toIndex, fromIndex));
+	TBTKAssert(
+		iterator != matrixElementMap.end(),
+		"ParameterizedHamiltonian::findMatrixElement()",
+		"No matrix element with to-Index " << toIndex.toString()
+		<< " and from-Index " << fromIndex.toString() << ".",
+		""
+	);
+
+	return iterator->second;
+}
+
+unsigned int ParameterizedHamiltonian::getParameterID(
+	const string &name
+) const{
+	for(unsigned int n = 0; n < parameterNames.size(); n++)
+		if(parameterNames[n].compare(name) == 0)
+			return n;
+
+	TBTKExit(
+		"ParameterizedHamiltonian::getParameterID()",
+		"Unknown parameter '" << name << "'.",
+		"Use ParameterizedHamiltonian::addParameter() to add the"
+		<< " parameter."
+	);
+}
+
+void ParameterizedHamiltonian::update(){
+	values = baseValues;
+	for(unsigned int p = 0; p < parameterValues.size(); p++){
+		const complex<double> lambda = parameterValues[p];
+		if(lambda == 0.)
+			continue;
+
+		const vector<unsigned int> &elements = termMatrixElements[p];
+		const vector<complex<double>> &term = termValues[p];
+		for(unsigned int n = 0; n < elements.size(); n++)
+			values[elements[n]] += lambda*term[n];
+
+		const vector<unsigned int> &conjugateElements
+			= conjugateTermMatrixElements[p];
+		const vector<complex<double>> &conjugateTerm
+			= conjugateTermValues[p];
+		for(unsigned int n = 0; n < conjugateElements.size(); n++){
+			values[conjugateElements[n]]
+				+= conj(lambda)*conjugateTerm[n];
+		}
+	}
+}
+
+};	//End of namespace TBTK
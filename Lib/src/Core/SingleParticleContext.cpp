@@ -134,6 +134,31 @@ SingleParticleContext::SingleParticleContext(
 
 		break;
 	}
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "SingleParticleContext");
+		deserialize(
+			reader.readString("statistics"),
+			&statistics,
+			Mode::Debug
+		);
+		hoppingAmplitudeSet = new HoppingAmplitudeSet(
+			reader.readString("hoppingAmplitudeSet"),
+			mode
+		);
+		if(reader.hasField("geometry")){
+			geometry = new Geometry(
+				reader.readString("geometry"),
+				mode,
+				*hoppingAmplitudeSet
+			);
+		}
+		else{
+			geometry = nullptr;
+		}
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"SingleParticleContext::SingleParticleContext()",
@@ -233,6 +258,22 @@ string SingleParticleContext::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("SingleParticleContext");
+		writer.writeString(
+			"statistics",
+			Serializeable::serialize(statistics, Mode::Debug)
+		);
+		writer.writeString(
+			"hoppingAmplitudeSet",
+			hoppingAmplitudeSet->serialize(mode)
+		);
+		if(geometry != nullptr)
+			writer.writeString("geometry", geometry->serialize(mode));
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"SingleParticleContext::serialize()",
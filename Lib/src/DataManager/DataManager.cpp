@@ -19,10 +19,19 @@
  */
 
 #include "TBTK/DataManager.h"
-#include "TBTK/Resource.h"
+#include "TBTK/Streams.h"
 #include "TBTK/TBTKMacros.h"
 
 #include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
 
 #include "TBTK/json.hpp"
 
@@ -87,6 +96,13 @@ DataManager::DataManager(
 	this->dataManagerName = dataManagerName;
 
 	this->path = "";
+
+	useJournal = false;
+	useFileReservations = false;
+	leaseTime = 3600;
+	numPendingWrites = 0;
+	maxQueueSize = 16;
+	stopWriter = false;
 }
 
 DataManager::DataManager(const string &serialization, Mode mode){
@@ -98,6 +114,13 @@ DataManager::DataManager(const string &serialization, Mode mode){
 		""
 	);
 
+	useJournal = false;
+	useFileReservations = false;
+	leaseTime = 3600;
+	numPendingWrites = 0;
+	maxQueueSize = 16;
+	stopWriter = false;
+
 	switch(mode){
 	case Mode::JSON:
 		try{
@@ -144,9 +167,21 @@ DataManager::DataManager(const string &serialization, Mode mode){
 
 			numDataPoints = j.at("numDataPoints");
 
+			//When the journal is used, the completion table is
+			//not part of the serialization.
+			if(j.find("useJournal") != j.end())
+				useJournal = j.at("useJournal");
+			if(j.find("useFileReservations") != j.end()){
+				useFileReservations
+					= j.at("useFileReservations");
+				leaseTime = j.at("leaseTime");
+			}
+
 			json dataTypes = j.at("dataTypes");
 			json reservedDataPoints = j.at("reservedDataPoints");
-			json completedDataPoints = j.at("completedDataPoints");
+			json completedDataPoints;
+			if(!useJournal)
+				completedDataPoints = j.at("completedDataPoints");
 			int counter = 0;
 			for(
 				json::iterator it = dataTypes.begin();
@@ -170,14 +205,16 @@ DataManager::DataManager(const string &serialization, Mode mode){
 
 				bool *completed = new bool[numDataPoints];
 				for(unsigned int n = 0; n < numDataPoints; n++)
-					reserved[n] = false;
-				counter2 = 0;
-				for(
-					json::iterator it2 = completedDataPoints.at(counter).begin();
-					it2 < completedDataPoints.at(counter).end(); ++it2
-				){
-					completed[counter2] = *it2;
-					counter2++;
+					completed[n] = false;
+				if(!useJournal){
+					counter2 = 0;
+					for(
+						json::iterator it2 = completedDataPoints.at(counter).begin();
+						it2 < completedDataPoints.at(counter).end(); ++it2
+					){
+						completed[counter2] = *it2;
+						counter2++;
+					}
 				}
 				this->completedDataPoints.push_back(completed);
 
@@ -192,6 +229,9 @@ DataManager::DataManager(const string &serialization, Mode mode){
 			){
 				this->fileTypes.push_back(*it);
 			}
+
+			if(useJournal)
+				replayJournal();
 		}
 		catch(json::exception e){
 			TBTKExit(
@@ -212,6 +252,23 @@ DataManager::DataManager(const string &serialization, Mode mode){
 }
 
 DataManager::~DataManager(){
+	//Let the writer thread finish all pending writes before it
+	//terminates.
+	{
+		lock_guard<std::mutex> lock(mutex);
+		stopWriter = true;
+	}
+	writeRequested.notify_one();
+	if(writerThread.joinable())
+		writerThread.join();
+
+	//Destructors must not throw, so write errors that have not been
+	//reported by DataManager::flush() are printed instead.
+	if(!writeError.empty()){
+		Streams::err << "Error in DataManager::~DataManager(): A write"
+			<< " failed. " << writeError << "\n";
+	}
+
 	for(unsigned int n = 0; n < reservedDataPoints.size(); n++)
 		delete [] reservedDataPoints.at(n);
 	for(unsigned int n = 0; n < completedDataPoints.size(); n++)
@@ -227,6 +284,7 @@ void DataManager::setPath(const string &path){
 }
 
 void DataManager::addDataType(const std::string &dataType, FileType fileType){
+	lock_guard<std::mutex> lock(mutex);
 	for(unsigned int n = 0; n < dataTypes.size(); n++){
 		TBTKAssert(
 			dataTypes.at(n).compare(dataType) != 0,
@@ -243,6 +301,7 @@ void DataManager::addDataType(const std::string &dataType, FileType fileType){
 }
 
 int DataManager::reserveDataPoint(const std::string &dataType){
+	lock_guard<std::mutex> lock(mutex);
 	for(unsigned int n = 0; n < numDataPoints; n++){
 		if(reserveDataPoint(dataType, n))
 			return n;
@@ -289,6 +348,9 @@ string DataManager::getFilename(const string &dataType, int id) const{
 	case FileType::SerializeableJSON:
 		filename += ".json";
 		break;
+	case FileType::SerializeableBinary:
+		filename += ".tbtk";
+		break;
 	case FileType::PNG:
 		filename += ".png";
 		break;
@@ -314,14 +376,44 @@ void DataManager::markCompleted(
 		""
 	);
 
+	unique_lock<std::mutex> lock(mutex);
+	vector<unsigned int> dataTypeIndices;
 	if(dataType.compare("") == 0){
 		for(unsigned int n = 0; n < dataTypes.size(); n++)
-			completedDataPoints.at(n)[id] = true;
+			dataTypeIndices.push_back(n);
 	}
 	else{
-		int dataTypeIndex = getDataTypeIndex(dataType);
+		dataTypeIndices.push_back(getDataTypeIndex(dataType));
+	}
+	//The names are copied, since the data types can be modified by other
+	//threads once the lock is released.
+	vector<string> completedDataTypes;
+	vector<string> reservationFilenames;
+	for(unsigned int n = 0; n < dataTypeIndices.size(); n++){
+		completedDataPoints.at(dataTypeIndices[n])[id] = true;
+		completedDataTypes.push_back(dataTypes.at(dataTypeIndices[n]));
+		reservationFilenames.push_back(
+			getReservationFilename(dataTypeIndices[n], id)
+		);
+	}
+	bool useJournal = this->useJournal;
+	bool useFileReservations = this->useFileReservations;
+	lock.unlock();
 
-		completedDataPoints.at(dataTypeIndex)[id] = true;
+	for(unsigned int n = 0; n < dataTypeIndices.size(); n++){
+		string error = recordCompletion(
+			completedDataTypes[n],
+			reservationFilenames[n],
+			id,
+			useJournal,
+			useFileReservations
+		);
+		TBTKAssert(
+			error.empty(),
+			"DataManager::markCompleted()",
+			error,
+			""
+		);
 	}
 }
 
@@ -337,11 +429,21 @@ void DataManager::complete(
 		""
 	);
 
-	Resource resource;
-	string filename = path + getFilename(dataType, id);
-	switch(fileTypes.at(getDataTypeIndex(dataType))){
+	unsigned int dataTypeIndex;
+	FileType fileType;
+	{
+		lock_guard<std::mutex> lock(mutex);
+		dataTypeIndex = getDataTypeIndex(dataType);
+		fileType = fileTypes.at(dataTypeIndex);
+	}
+
+	string data;
+	switch(fileType){
 	case FileType::SerializeableJSON:
-		resource.setData(serializeable.serialize(Mode::JSON));
+		data = serializeable.serialize(Mode::JSON);
+		break;
+	case FileType::SerializeableBinary:
+		data = serializeable.serialize(Mode::Binary);
 		break;
 	default:
 		TBTKExit(
@@ -355,9 +457,290 @@ void DataManager::complete(
 		);
 	}
 
-	resource.write(filename);
+	unique_lock<std::mutex> lock(mutex);
+	if(!writerThread.joinable())
+		writerThread = thread(&DataManager::runWriter, this);
+
+	writeFinished.wait(
+		lock,
+		[this](){return numPendingWrites < maxQueueSize;}
+	);
+	if(!writeError.empty()){
+		string error = writeError;
+		lock.unlock();
+		TBTKExit(
+			"DataManager::complete()",
+			"A previous write failed. " << error,
+			""
+		);
+	}
+	writeQueue.push_back({
+		path + getFilename(dataType, id),
+		std::move(data),
+		dataType,
+		getReservationFilename(dataTypeIndex, id),
+		dataTypeIndex,
+		(unsigned int)id
+	});
+	numPendingWrites++;
+	writeRequested.notify_one();
+}
+
+void DataManager::setMaxQueueSize(unsigned int maxQueueSize){
+	TBTKAssert(
+		maxQueueSize > 0,
+		"DataManager::setMaxQueueSize()",
+		"The maximum queue size must be at least one.",
+		""
+	);
+
+	lock_guard<std::mutex> lock(mutex);
+	this->maxQueueSize = maxQueueSize;
+	writeFinished.notify_all();
+}
+
+void DataManager::flush(){
+	unique_lock<std::mutex> lock(mutex);
+	writeFinished.wait(lock, [this](){return numPendingWrites == 0;});
+	string error = writeError;
+	lock.unlock();
+	TBTKAssert(
+		error.empty(),
+		"DataManager::flush()",
+		"A write failed. " << error,
+		""
+	);
+}
+
+void DataManager::setUseJournal(bool useJournal){
+	lock_guard<std::mutex> lock(mutex);
+	if(useJournal && !this->useJournal){
+		//The completion table is no longer serialized, so data points
+		//that already are completed have to be recorded in the
+		//journal.
+		for(unsigned int n = 0; n < dataTypes.size(); n++){
+			for(unsigned int c = 0; c < numDataPoints; c++){
+				if(!completedDataPoints.at(n)[c])
+					continue;
+
+				string error = appendToJournal(
+					dataTypes.at(n),
+					c
+				);
+				TBTKAssert(
+					error.empty(),
+					"DataManager::setUseJournal()",
+					error,
+					""
+				);
+			}
+		}
+	}
+	this->useJournal = useJournal;
+}
+
+void DataManager::setUseFileReservations(bool useFileReservations){
+	lock_guard<std::mutex> lock(mutex);
+	this->useFileReservations = useFileReservations;
+}
+
+void DataManager::setLeaseTime(unsigned int leaseTime){
+	TBTKAssert(
+		leaseTime > 0,
+		"DataManager::setLeaseTime()",
+		"The lease time must be positive.",
+		""
+	);
+
+	lock_guard<std::mutex> lock(mutex);
+	this->leaseTime = leaseTime;
+}
+
+void DataManager::renewReservation(const string &dataType, int id){
+	TBTKAssert(
+		id >= 0 && (unsigned int)id < numDataPoints,
+		"DataManager::renewReservation()",
+		"The ID is out of range.",
+		""
+	);
+
+	lock_guard<std::mutex> lock(mutex);
+	TBTKAssert(
+		useFileReservations,
+		"DataManager::renewReservation()",
+		"File reservations are not enabled.",
+		"Use DataManager::setUseFileReservations() to enable file"
+		<< " reservations."
+	);
+
+	vector<unsigned int> dataTypeIndices;
+	if(dataType.compare("") == 0){
+		for(unsigned int n = 0; n < dataTypes.size(); n++)
+			dataTypeIndices.push_back(n);
+	}
+	else{
+		dataTypeIndices.push_back(getDataTypeIndex(dataType));
+	}
+
+	for(unsigned int n = 0; n < dataTypeIndices.size(); n++){
+		string lockFilename = getReservationFilename(
+			dataTypeIndices[n],
+			id
+		) + ".lock";
+		TBTKAssert(
+			utime(lockFilename.c_str(), nullptr) == 0,
+			"DataManager::renewReservation()",
+			"Unable to renew the reservation '" << lockFilename
+			<< "'.",
+			"The lease may have expired and the data point been"
+			<< " reserved by another process."
+		);
+	}
+}
+
+string DataManager::getJournalFilename() const{
+	string filename = path;
+	if(dataManagerName.compare("") != 0)
+		filename += dataManagerName + "_";
+	filename += "completed.journal";
+
+	return filename;
+}
+
+void DataManager::runWriter(){
+	unique_lock<std::mutex> lock(mutex);
+	while(true){
+		writeRequested.wait(
+			lock,
+			[this](){return stopWriter || !writeQueue.empty();}
+		);
+		if(writeQueue.empty())
+			break;
+
+		WriteRequest request = std::move(writeQueue.front());
+		writeQueue.pop_front();
+		bool useJournal = this->useJournal;
+		bool useFileReservations = this->useFileReservations;
+
+		//Perform the I/O without holding the lock, so that the compute
+		//threads can continue to reserve and complete data points.
+		//Errors are reported to the caller by DataManager::complete()
+		//and DataManager::flush() rather than terminating the writer
+		//thread.
+		lock.unlock();
+		string error = writeAtomically(request.filename, request.data);
+		if(error.empty()){
+			error = recordCompletion(
+				request.dataType,
+				request.reservationFilename,
+				request.id,
+				useJournal,
+				useFileReservations
+			);
+		}
+		lock.lock();
+
+		if(error.empty()){
+			completedDataPoints.at(
+				request.dataTypeIndex
+			)[request.id] = true;
+		}
+		else if(writeError.empty())
+			writeError = error;
+		numPendingWrites--;
+		writeFinished.notify_all();
+	}
+}
+
+string DataManager::writeAtomically(const string &filename, const string &data){
+	string temporaryFilename = filename + ".tmp";
+	ofstream fout(temporaryFilename, ios::binary);
+	if(!fout.is_open())
+		return "Unable to open file '" + temporaryFilename + "'.";
+	fout.write(data.data(), data.size());
+	fout.close();
+	if(fout.fail())
+		return "Unable to write to file '" + temporaryFilename + "'.";
+
+	if(rename(temporaryFilename.c_str(), filename.c_str()) != 0){
+		return "Unable to rename '" + temporaryFilename + "' to '"
+			+ filename + "'.";
+	}
+
+	return "";
+}
+
+string DataManager::recordCompletion(
+	const string &dataType,
+	const string &reservationFilename,
+	unsigned int id,
+	bool useJournal,
+	bool useFileReservations
+){
+	if(useJournal){
+		string error = appendToJournal(dataType, id);
+		if(!error.empty())
+			return error;
+	}
+	if(useFileReservations){
+		//The completion marker is created before the lock file is
+		//removed, so that the data point never appears to be free.
+		string error = writeAtomically(
+			reservationFilename + ".completed",
+			""
+		);
+		if(!error.empty())
+			return error;
+		releaseFileReservation(reservationFilename);
+	}
+
+	return "";
+}
+
+string DataManager::appendToJournal(const string &dataType, unsigned int id){
+	lock_guard<std::mutex> lock(journalMutex);
+	string filename = getJournalFilename();
+	ofstream fout(filename, ios::app);
+	if(!fout.is_open())
+		return "Unable to open journal '" + filename + "'.";
+	fout << id << " " << dataType << "\n";
+	fout.close();
+	if(fout.fail())
+		return "Unable to write to journal '" + filename + "'.";
+
+	return "";
+}
+
+void DataManager::replayJournal(){
+	ifstream fin(getJournalFilename());
+	if(!fin.is_open())
+		return;
+
+	string line;
+	while(getline(fin, line)){
+		//A last line without newline is the result of an interrupted
+		//append and is ignored.
+		if(fin.eof())
+			break;
+
+		size_t position = line.find(' ');
+		if(position == string::npos || position == 0)
+			continue;
+		string idString = line.substr(0, position);
+		if(idString.find_first_not_of("0123456789") != string::npos)
+			continue;
+		unsigned long id = stoul(idString);
+		if(id >= numDataPoints)
+			continue;
 
-	markCompleted(dataType, id);
+		string dataType = line.substr(position + 1);
+		for(unsigned int n = 0; n < dataTypes.size(); n++){
+			if(dataTypes.at(n).compare(dataType) == 0){
+				completedDataPoints.at(n)[id] = true;
+				break;
+			}
+		}
+	}
 }
 
 void DataManager::addDataTables(){
@@ -450,6 +833,19 @@ bool DataManager::reserveDataPoint(
 			}
 		}
 
+		if(useFileReservations){
+			for(unsigned int n = 0; n < dataTypes.size(); n++){
+				if(!acquireFileReservation(n, id)){
+					for(unsigned int c = 0; c < n; c++)
+						releaseFileReservation(
+							getReservationFilename(c, id)
+						);
+
+					return false;
+				}
+			}
+		}
+
 		for(unsigned int n = 0; n < dataTypes.size(); n++)
 			reservedDataPoints.at(n)[id] = true;
 		return true;
@@ -461,6 +857,13 @@ bool DataManager::reserveDataPoint(
 			!completedDataPoints.at(dataTypeIndex)[id]
 			&& !reservedDataPoints.at(dataTypeIndex)[id]
 		){
+			if(
+				useFileReservations
+				&& !acquireFileReservation(dataTypeIndex, id)
+			){
+				return false;
+			}
+
 			reservedDataPoints.at(dataTypeIndex)[id] = true;
 			return true;
 		}
@@ -469,7 +872,137 @@ bool DataManager::reserveDataPoint(
 	}
 }
 
+bool DataManager::acquireFileReservation(
+	unsigned int dataTypeIndex,
+	unsigned int id
+){
+	string filename = getReservationFilename(dataTypeIndex, id);
+	string completedFilename = filename + ".completed";
+	string lockFilename = filename + ".lock";
+
+	struct stat status;
+	if(stat(completedFilename.c_str(), &status) == 0){
+		completedDataPoints.at(dataTypeIndex)[id] = true;
+		return false;
+	}
+
+	//One attempt to create the lock file, and one more if an expired lock
+	//file was removed.
+	for(unsigned int attempt = 0; attempt < 2; attempt++){
+		int fileDescriptor = open(
+			lockFilename.c_str(),
+			O_WRONLY | O_CREAT | O_EXCL,
+			0644
+		);
+		if(fileDescriptor == -1){
+			TBTKAssert(
+				errno == EEXIST,
+				"DataManager::acquireFileReservation()",
+				"Unable to create lock file '" << lockFilename
+				<< "'.",
+				""
+			);
+			if(!breakExpiredLock(lockFilename))
+				return false;
+
+			continue;
+		}
+
+		//The owner is only stored to simplify debugging.
+		string owner = getProcessIdentifier() + "\n";
+		ssize_t numWritten = write(
+			fileDescriptor,
+			owner.c_str(),
+			owner.size()
+		);
+		close(fileDescriptor);
+		TBTKAssert(
+			numWritten == (ssize_t)owner.size(),
+			"DataManager::acquireFileReservation()",
+			"Unable to write to lock file '" << lockFilename
+			<< "'.",
+			""
+		);
+
+		//The data point may have been completed by another process
+		//between the check above and the creation of the lock file.
+		if(stat(completedFilename.c_str(), &status) == 0){
+			unlink(lockFilename.c_str());
+			completedDataPoints.at(dataTypeIndex)[id] = true;
+			return false;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+void DataManager::releaseFileReservation(const string &reservationFilename){
+	string lockFilename = reservationFilename + ".lock";
+	unlink(lockFilename.c_str());
+}
+
+bool DataManager::breakExpiredLock(const string &lockFilename) const{
+	struct stat status;
+	if(stat(lockFilename.c_str(), &status) != 0)
+		return errno == ENOENT;
+	if(difftime(time(nullptr), status.st_mtime) <= leaseTime)
+		return false;
+
+	//Rename the expired lock file to a name that is unique to this
+	//process. Only one of several processes that simultaneously detect
+	//the expired lock can succeed with the rename.
+	string staleFilename = lockFilename + ".stale." + getProcessIdentifier();
+	if(rename(lockFilename.c_str(), staleFilename.c_str()) != 0)
+		return errno == ENOENT;
+
+	//If another process broke the lock and created a new one between the
+	//stat and the rename, the new lock was renamed by mistake. Put it back
+	//unless yet another lock file has been created.
+	struct stat staleStatus;
+	if(
+		stat(staleFilename.c_str(), &staleStatus) == 0
+		&& staleStatus.st_ino != status.st_ino
+	){
+		//link() fails with EEXIST if yet another lock file exists, in
+		//which case the renamed lock is lost either way. On any other
+		//error the stale file is kept under its original name.
+		if(
+			link(staleFilename.c_str(), lockFilename.c_str()) == 0
+			|| errno == EEXIST
+		){
+			unlink(staleFilename.c_str());
+		}
+		else{
+			rename(staleFilename.c_str(), lockFilename.c_str());
+		}
+
+		return false;
+	}
+	unlink(staleFilename.c_str());
+
+	return true;
+}
+
+string DataManager::getReservationFilename(
+	unsigned int dataTypeIndex,
+	unsigned int id
+) const{
+	return path + getFilename(dataTypes.at(dataTypeIndex), id);
+}
+
+string DataManager::getProcessIdentifier(){
+	char hostname[256];
+	if(gethostname(hostname, sizeof(hostname)) != 0)
+		hostname[0] = '\0';
+	hostname[sizeof(hostname) - 1] = '\0';
+
+	return string(hostname) + "." + to_string(getpid());
+}
+
 string DataManager::serialize(Mode mode) const{
+	lock_guard<std::mutex> lock(mutex);
 	switch(mode){
 	case Mode::JSON:
 	{
@@ -484,17 +1017,26 @@ string DataManager::serialize(Mode mode) const{
 		j["dataManagerName"] = dataManagerName;
 		j["path"] = path;
 		j["numDataPoints"] = numDataPoints;
+		j["useJournal"] = useJournal;
+		j["useFileReservations"] = useFileReservations;
+		j["leaseTime"] = leaseTime;
 		for(unsigned int n = 0; n < dataTypes.size(); n++){
 			j["dataTypes"] = dataTypes;
 			j["fileTypes"] = fileTypes;
 			j["reservedDataPoints"].push_back(json());
-			j["completedDataPoints"].push_back(json());
 			for(unsigned int c = 0; c < numDataPoints; c++){
 				//Do not export information about reserved
 				//data. At least for now reservation is not
 				//persistent accross sessions.
 				j["reservedDataPoints"].at(n).push_back(false);
-				//Completion is preserved.
+			}
+
+			//Completion is preserved, either through the journal
+			//or through the completion table.
+			if(useJournal)
+				continue;
+			j["completedDataPoints"].push_back(json());
+			for(unsigned int c = 0; c < numDataPoints; c++){
 				j["completedDataPoints"].at(n).push_back(
 					completedDataPoints.at(n)[c]
 				);
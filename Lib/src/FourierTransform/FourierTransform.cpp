@@ -25,6 +25,77 @@ using namespace std;
 
 namespace TBTK{
 
+FourierTransform::PlanningRigor FourierTransform::planningRigor
+	= FourierTransform::PlanningRigor::Estimate;
+
+//Parameters for fftw_plan_many_dft() and its real counterparts. The number of
+//elements along the last dimension differs between the real and complex
+//data for real transforms.
+class BatchParameters{
+public:
+	BatchParameters(
+		const vector<unsigned int> &ranges,
+		unsigned int numTransforms,
+		FourierTransform::Layout layout,
+		bool isInputHalfComplex,
+		bool isOutputHalfComplex
+	){
+		TBTKAssert(
+			ranges.size() > 0,
+			"FourierTransform::Plan::Plan()",
+			"'ranges' must have at least one dimension.",
+			""
+		);
+		TBTKAssert(
+			numTransforms > 0,
+			"FourierTransform::Plan::Plan()",
+			"'numTransforms' must be larger than zero.",
+			""
+		);
+
+		logicalSize = 1;
+		for(unsigned int n = 0; n < ranges.size(); n++){
+			sizes.push_back(ranges[n]);
+			logicalSize *= ranges[n];
+		}
+
+		unsigned int halfComplexSize = logicalSize/ranges.back()
+			*(ranges.back()/2 + 1);
+		unsigned int inputSize
+			= isInputHalfComplex ? halfComplexSize : logicalSize;
+		unsigned int outputSize
+			= isOutputHalfComplex ? halfComplexSize : logicalSize;
+
+		switch(layout){
+		case FourierTransform::Layout::Consecutive:
+			stride = 1;
+			inputDistance = inputSize;
+			outputDistance = outputSize;
+			break;
+		case FourierTransform::Layout::Interleaved:
+			stride = numTransforms;
+			inputDistance = 1;
+			outputDistance = 1;
+			break;
+		default:
+			TBTKExit(
+				"FourierTransform::Plan::Plan()",
+				"Unknown layout.",
+				"This should never happen, contact the developer."
+			);
+		}
+
+		totalOutputSize = numTransforms*outputSize;
+	}
+
+	vector<int> sizes;
+	unsigned int logicalSize;
+	unsigned int totalOutputSize;
+	int stride;
+	int inputDistance;
+	int outputDistance;
+};
+
 void FourierTransform::transform(
 	complex<double> *in,
 	complex<double> *out,
@@ -124,7 +195,7 @@ FourierTransform::Plan<complex<double>>::Plan(
 		reinterpret_cast<fftw_complex*>(in),
 		reinterpret_cast<fftw_complex*>(out),
 		sign,
-		FFTW_ESTIMATE
+		getPlannerFlags()
 	);
 
 	input = in;
@@ -150,7 +221,7 @@ FourierTransform::Plan<complex<double>>::Plan(
 		reinterpret_cast<fftw_complex*>(in),
 		reinterpret_cast<fftw_complex*>(out),
 		sign,
-		FFTW_ESTIMATE
+		getPlannerFlags()
 	);
 
 	input = in;
@@ -178,7 +249,7 @@ FourierTransform::Plan<complex<double>>::Plan(
 		reinterpret_cast<fftw_complex*>(in),
 		reinterpret_cast<fftw_complex*>(out),
 		sign,
-		FFTW_ESTIMATE
+		getPlannerFlags()
 	);
 
 	input = in;
@@ -187,4 +258,195 @@ FourierTransform::Plan<complex<double>>::Plan(
 	normalizationFactor = sqrt(sizeX*sizeY*sizeZ);
 }
 
+template<>
+FourierTransform::Plan<complex<double>>::Plan(
+	complex<double> *in,
+	complex<double> *out,
+	const vector<unsigned int> &ranges,
+	unsigned int numTransforms,
+	Layout layout,
+	int sign
+){
+	BatchParameters parameters(ranges, numTransforms, layout, false, false);
+
+	plan = new fftw_plan();
+
+	#pragma omp critical (TBTK_FOURIER_TRANSFORM)
+	*plan = fftw_plan_many_dft(
+		parameters.sizes.size(),
+		parameters.sizes.data(),
+		numTransforms,
+		reinterpret_cast<fftw_complex*>(in),
+		nullptr,
+		parameters.stride,
+		parameters.inputDistance,
+		reinterpret_cast<fftw_complex*>(out),
+		nullptr,
+		parameters.stride,
+		parameters.outputDistance,
+		sign,
+		getPlannerFlags()
+	);
+
+	input = in;
+	output = out;
+	size = parameters.totalOutputSize;
+	normalizationFactor = sqrt(parameters.logicalSize);
+}
+
+template<>
+FourierTransform::Plan<double, complex<double>>::Plan(
+	double *in,
+	complex<double> *out,
+	const vector<unsigned int> &ranges,
+	unsigned int numTransforms,
+	Layout layout,
+	int sign
+){
+	TBTKAssert(
+		sign == -1,
+		"FourierTransform::Plan::Plan()",
+		"Real to complex transforms are only supported with sign -1.",
+		"Use a ForwardPlan."
+	);
+	BatchParameters parameters(ranges, numTransforms, layout, false, true);
+
+	plan = new fftw_plan();
+
+	#pragma omp critical (TBTK_FOURIER_TRANSFORM)
+	*plan = fftw_plan_many_dft_r2c(
+		parameters.sizes.size(),
+		parameters.sizes.data(),
+		numTransforms,
+		in,
+		nullptr,
+		parameters.stride,
+		parameters.inputDistance,
+		reinterpret_cast<fftw_complex*>(out),
+		nullptr,
+		parameters.stride,
+		parameters.outputDistance,
+		getPlannerFlags()
+	);
+
+	input = in;
+	output = out;
+	size = parameters.totalOutputSize;
+	normalizationFactor = sqrt(parameters.logicalSize);
+}
+
+template<>
+FourierTransform::Plan<complex<double>, double>::Plan(
+	complex<double> *in,
+	double *out,
+	const vector<unsigned int> &ranges,
+	unsigned int numTransforms,
+	Layout layout,
+	int sign
+){
+	TBTKAssert(
+		sign == 1,
+		"FourierTransform::Plan::Plan()",
+		"Complex to real transforms are only supported with sign 1.",
+		"Use an InversePlan."
+	);
+	BatchParameters parameters(ranges, numTransforms, layout, true, false);
+
+	plan = new fftw_plan();
+
+	#pragma omp critical (TBTK_FOURIER_TRANSFORM)
+	*plan = fftw_plan_many_dft_c2r(
+		parameters.sizes.size(),
+		parameters.sizes.data(),
+		numTransforms,
+		reinterpret_cast<fftw_complex*>(in),
+		nullptr,
+		parameters.stride,
+		parameters.inputDistance,
+		out,
+		nullptr,
+		parameters.stride,
+		parameters.outputDistance,
+		getPlannerFlags()
+	);
+
+	input = in;
+	output = out;
+	size = parameters.totalOutputSize;
+	normalizationFactor = sqrt(parameters.logicalSize);
+}
+
+void FourierTransform::setNumThreads(unsigned int numThreads){
+	TBTKAssert(
+		numThreads > 0,
+		"FourierTransform::setNumThreads()",
+		"'numThreads' must be larger than zero.",
+		""
+	);
+
+#ifdef TBTK_USE_FFTW3_THREADS
+	static bool threadsInitialized = false;
+	#pragma omp critical (TBTK_FOURIER_TRANSFORM)
+	{
+		if(!threadsInitialized){
+			TBTKAssert(
+				fftw_init_threads() != 0,
+				"FourierTransform::setNumThreads()",
+				"Unable to initialize FFTW3 threads.",
+				""
+			);
+			threadsInitialized = true;
+		}
+		fftw_plan_with_nthreads(numThreads);
+	}
+#else
+	TBTKAssert(
+		numThreads == 1,
+		"FourierTransform::setNumThreads()",
+		"TBTK is built without support for threaded FFTW3.",
+		"Install the threaded version of FFTW3 and rebuild TBTK."
+	);
+#endif
+}
+
+bool FourierTransform::importWisdom(const string &filename){
+	int success;
+	#pragma omp critical (TBTK_FOURIER_TRANSFORM)
+	success = fftw_import_wisdom_from_filename(filename.c_str());
+
+	return success != 0;
+}
+
+void FourierTransform::exportWisdom(const string &filename){
+	int success;
+	#pragma omp critical (TBTK_FOURIER_TRANSFORM)
+	success = fftw_export_wisdom_to_filename(filename.c_str());
+
+	TBTKAssert(
+		success != 0,
+		"FourierTransform::exportWisdom()",
+		"Unable to write wisdom to '" << filename << "'.",
+		""
+	);
+}
+
+unsigned int FourierTransform::getPlannerFlags(){
+	switch(planningRigor){
+	case PlanningRigor::Estimate:
+		return FFTW_ESTIMATE;
+	case PlanningRigor::Measure:
+		return FFTW_MEASURE;
+	case PlanningRigor::Patient:
+		return FFTW_PATIENT;
+	case PlanningRigor::Exhaustive:
+		return FFTW_EXHAUSTIVE;
+	default:
+		TBTKExit(
+			"FourierTransform::getPlannerFlags()",
+			"Unknown planning rigor.",
+			"This should never happen, contact the developer."
+		);
+	}
+}
+
 };
@@ -0,0 +1,220 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file MatsubaraConvolver.cpp
+ *
+ *  @author Kristofer Björnson
+ */
+
+#include "TBTK/MatsubaraConvolver.h"
+#include "TBTK/TBTKMacros.h"
+
+using namespace std;
+
+namespace TBTK{
+
+//Returns the smallest number larger than or equal to 'size' that has no prime
+//factors larger than seven. FFTW3 is most efficient for such sizes.
+static unsigned int getFFTFriendlySize(unsigned int size){
+	for(unsigned int n = size; ; n++){
+		unsigned int remainder = n;
+		for(unsigned int factor : {2, 3, 5, 7})
+			while(remainder%factor == 0)
+				remainder /= factor;
+
+		if(remainder == 1)
+			return n;
+	}
+}
+
+MatsubaraConvolver::MatsubaraConvolver(
+	const vector<unsigned int> &numMeshPoints,
+	unsigned int numFunctions,
+	unsigned int numInputEnergies,
+	unsigned int numOutputEnergies
+){
+	TBTKAssert(
+		numMeshPoints.size() > 0,
+		"MatsubaraConvolver::MatsubaraConvolver()",
+		"'numMeshPoints' must have at least one dimension.",
+		""
+	);
+	TBTKAssert(
+		numFunctions > 0,
+		"MatsubaraConvolver::MatsubaraConvolver()",
+		"'numFunctions' must be larger than zero.",
+		""
+	);
+	TBTKAssert(
+		numInputEnergies > 0 && numOutputEnergies > 0,
+		"MatsubaraConvolver::MatsubaraConvolver()",
+		"The number of energies must be larger than zero.",
+		""
+	);
+
+	this->numMeshPoints = numMeshPoints;
+	this->numFunctions = numFunctions;
+	this->numInputEnergies = numInputEnergies;
+	this->numOutputEnergies = numOutputEnergies;
+
+	meshSize = 1;
+	for(unsigned int n = 0; n < numMeshPoints.size(); n++)
+		meshSize *= numMeshPoints[n];
+
+	//The frequency axis is padded enough for the circular correlation
+	//calculated by the FFT to equal the linear correlation for every
+	//output energy.
+	paddedSize = getFFTFriendlySize(
+		max(numInputEnergies + numOutputEnergies/2, numOutputEnergies)
+	);
+	transformSize = meshSize*paddedSize;
+
+	workBuffer.resize(transformSize);
+
+	//The plans are created before any data is written to the buffers,
+	//since planning rigors other than Estimate overwrite the buffers.
+	vector<unsigned int> ranges = numMeshPoints;
+	ranges.push_back(paddedSize);
+	for(unsigned int n = 0; n < 2; n++){
+		transformBuffers[n].resize(transformSize);
+		forwardPlans[n]
+			= new FourierTransform::ForwardPlan<complex<double>>(
+				transformBuffers[n].data(),
+				transformBuffers[n].data(),
+				ranges
+			);
+		forwardPlans[n]->setNormalizationFactor(1.);
+		bufferedFunctions[n] = -1;
+	}
+	inversePlan = new FourierTransform::InversePlan<complex<double>>(
+		workBuffer.data(),
+		workBuffer.data(),
+		ranges
+	);
+	inversePlan->setNormalizationFactor(1.);
+
+	negatedIndices.resize(transformSize);
+	vector<unsigned int> coordinates(ranges.size(), 0);
+	for(unsigned int n = 0; n < transformSize; n++){
+		unsigned int negatedIndex = 0;
+		for(unsigned int c = 0; c < ranges.size(); c++){
+			negatedIndex = negatedIndex*ranges[c]
+				+ (ranges[c] - coordinates[c])%ranges[c];
+		}
+		negatedIndices[n] = negatedIndex;
+
+		for(int c = ranges.size() - 1; c >= 0; c--){
+			coordinates[c]++;
+			if(coordinates[c] < ranges[c])
+				break;
+			coordinates[c] = 0;
+		}
+	}
+
+	functions = nullptr;
+}
+
+MatsubaraConvolver::~MatsubaraConvolver(){
+	for(unsigned int n = 0; n < 2; n++)
+		delete forwardPlans[n];
+	delete inversePlan;
+}
+
+void MatsubaraConvolver::setFunctions(const complex<double> *functions){
+	this->functions = functions;
+	for(unsigned int n = 0; n < 2; n++)
+		bufferedFunctions[n] = -1;
+}
+
+void MatsubaraConvolver::correlate(
+	unsigned int a,
+	unsigned int b,
+	complex<double> *result
+){
+	TBTKAssert(
+		functions != nullptr,
+		"MatsubaraConvolver::correlate()",
+		"The functions have not been set.",
+		"Use MatsubaraConvolver::setFunctions() to set the functions."
+	);
+	TBTKAssert(
+		a < numFunctions && b < numFunctions,
+		"MatsubaraConvolver::correlate()",
+		"Function index out of bounds. The function indices are " << a
+		<< " and " << b << ", but there are only " << numFunctions
+		<< " functions.",
+		""
+	);
+
+	//The transform of the reflected function f_a(-k, -n) is the
+	//transform of f_a at -p.
+	int reservedBuffer = -1;
+	for(unsigned int n = 0; n < 2; n++)
+		if(bufferedFunctions[n] == (int)b)
+			reservedBuffer = n;
+	unsigned int bufferA = transformFunction(a, reservedBuffer);
+	unsigned int bufferB = transformFunction(b, bufferA);
+	const complex<double> *transformA = transformBuffers[bufferA].data();
+	const complex<double> *transformB = transformBuffers[bufferB].data();
+	complex<double> *work = workBuffer.data();
+	const unsigned int *negated = negatedIndices.data();
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for
+#endif
+	for(unsigned int n = 0; n < transformSize; n++)
+		work[n] = transformA[negated[n]]*transformB[n];
+
+	FourierTransform::transform(*inversePlan);
+
+	double normalization = 1./transformSize;
+	for(unsigned int q = 0; q < meshSize; q++){
+		for(unsigned int e = 0; e < numOutputEnergies; e++){
+			int shift = (int)e - (int)numOutputEnergies/2;
+			unsigned int n = (shift + (int)paddedSize)%paddedSize;
+			result[numOutputEnergies*q + e]
+				= work[paddedSize*q + n]*normalization;
+		}
+	}
+}
+
+unsigned int MatsubaraConvolver::transformFunction(
+	unsigned int function,
+	int reservedBuffer
+){
+	for(unsigned int n = 0; n < 2; n++)
+		if(bufferedFunctions[n] == (int)function)
+			return n;
+
+	unsigned int buffer = (reservedBuffer == 0 ? 1 : 0);
+	complex<double> *destination = transformBuffers[buffer].data();
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for
+#endif
+	for(unsigned int k = 0; k < meshSize; k++){
+		const complex<double> *source = functions
+			+ numInputEnergies*(numFunctions*k + function);
+		for(unsigned int n = 0; n < numInputEnergies; n++)
+			destination[k*paddedSize + n] = source[n];
+		for(unsigned int n = numInputEnergies; n < paddedSize; n++)
+			destination[k*paddedSize + n] = 0.;
+	}
+
+	FourierTransform::transform(*forwardPlans[buffer]);
+	bufferedFunctions[buffer] = function;
+
+	return buffer;
+}
+
+};	//End of namespace TBTK
@@ -111,15 +111,43 @@ DOS::DOS(
 		}
 
 		break;
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "DOS");
+		lowerBound = reader.read<double>("lowerBound");
+		upperBound = reader.read<double>("upperBound");
+		resolution = reader.read<int>("resolution");
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"DOS::DOS()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
 }
 
+DOS::DOS(
+	const MemoryMappedFile &file
+) :
+	DOS(file, BinaryReader(file.getData(), file.getSize(), "DOS"))
+{
+}
+
+DOS::DOS(
+	const MemoryMappedFile &file,
+	const BinaryReader &reader
+) :
+	AbstractProperty(file, reader)
+{
+	lowerBound = reader.read<double>("lowerBound");
+	upperBound = reader.read<double>("upperBound");
+	resolution = reader.read<int>("resolution");
+}
+
 DOS::~DOS(){
 }
 
@@ -145,6 +173,31 @@ DOS& DOS::operator=(DOS &&rhs){
 	return *this;
 }
 
+void DOS::assertCompatibleLayout(
+	const AbstractProperty<double> &abstractProperty,
+	const string &functionName
+) const{
+	AbstractProperty::assertCompatibleLayout(abstractProperty, functionName);
+
+	const DOS *dos
+		= dynamic_cast<const DOS*>(&abstractProperty);
+	TBTKAssert(
+		dos != nullptr,
+		"DOS::" + functionName,
+		"The right hand side is not a DOS.",
+		""
+	);
+	TBTKAssert(
+		lowerBound == dos->lowerBound
+		&& upperBound == dos->upperBound
+		&& resolution == dos->resolution,
+		"DOS::" + functionName,
+		"Incompatible energy windows.",
+		"Both sides must have been created with the same lower bound,"
+		<< " upper bound, and resolution."
+	);
+}
+
 string DOS::serialize(Mode mode) const{
 	switch(mode){
 	case Mode::JSON:
@@ -160,10 +213,21 @@ string DOS::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("DOS");
+		writer.write("lowerBound", lowerBound);
+		writer.write("upperBound", upperBound);
+		writer.write("resolution", resolution);
+		writeBinary(writer);
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"DOS::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -95,6 +95,24 @@ Density::Density(
 	);
 }
 
+Density::Density(
+	const MemoryMappedFile &file
+) :
+	Density(
+		file,
+		BinaryReader(file.getData(), file.getSize(), "Density")
+	)
+{
+}
+
+Density::Density(
+	const MemoryMappedFile &file,
+	const BinaryReader &reader
+) :
+	AbstractProperty(file, reader)
+{
+}
+
 Density::~Density(){
 }
 
@@ -144,10 +162,18 @@ string Density::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("Density");
+		writeBinary(writer);
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"Density::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -79,6 +79,24 @@ EigenValues::EigenValues(
 	);
 }
 
+EigenValues::EigenValues(
+	const MemoryMappedFile &file
+) :
+	EigenValues(
+		file,
+		BinaryReader(file.getData(), file.getSize(), "EigenValues")
+	)
+{
+}
+
+EigenValues::EigenValues(
+	const MemoryMappedFile &file,
+	const BinaryReader &reader
+) :
+	AbstractProperty(file, reader)
+{
+}
+
 EigenValues::~EigenValues(){
 }
 
@@ -108,10 +126,18 @@ string EigenValues::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("EigenValues");
+		writeBinary(writer);
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"EigenValues::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
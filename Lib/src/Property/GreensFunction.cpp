@@ -21,7 +21,10 @@
 #include "TBTK/Property/GreensFunction.h"
 #include "TBTK/TBTKMacros.h"
 
+#include "TBTK/json.hpp"
+
 using namespace std;
+using namespace nlohmann;
 
 namespace TBTK{
 namespace Property{
@@ -95,10 +98,129 @@ GreensFunction::GreensFunction(
 	greensFunction.data = nullptr;*/
 }
 
+GreensFunction::GreensFunction(
+	const string &serialization,
+	Mode mode
+) :
+	AbstractProperty(
+		Serializeable::extract(
+			serialization,
+			mode,
+			"abstractProperty"
+		),
+		mode
+	)
+{
+	TBTKAssert(
+		validate(serialization, "GreensFunction", mode),
+		"GreensFunction::GreensFunction()",
+		"Unable to parse string as GreensFunction '" << serialization
+		<< "'.",
+		""
+	);
+
+	switch(mode){
+	case Mode::JSON:
+		try{
+			json j = json::parse(serialization);
+			type = static_cast<Type>(j.at("type").get<int>());
+			lowerBound = j.at("lowerBound").get<double>();
+			upperBound = j.at("upperBound").get<double>();
+			resolution = j.at("resolution").get<unsigned int>();
+		}
+		catch(json::exception e){
+			TBTKExit(
+				"GreensFunction::GreensFunction()",
+				"Unable to parse string as GreensFunction '"
+				<< serialization << "'.",
+				""
+			);
+		}
+
+		break;
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "GreensFunction");
+		type = static_cast<Type>(reader.read<int>("type"));
+		lowerBound = reader.read<double>("lowerBound");
+		upperBound = reader.read<double>("upperBound");
+		resolution = reader.read<unsigned int>("resolution");
+
+		break;
+	}
+	default:
+		TBTKExit(
+			"GreensFunction::GreensFunction()",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
+			""
+		);
+	}
+}
+
+GreensFunction::GreensFunction(
+	const MemoryMappedFile &file
+) :
+	GreensFunction(
+		file,
+		BinaryReader(file.getData(), file.getSize(), "GreensFunction")
+	)
+{
+}
+
+GreensFunction::GreensFunction(
+	const MemoryMappedFile &file,
+	const BinaryReader &reader
+) :
+	AbstractProperty(file, reader)
+{
+	type = static_cast<Type>(reader.read<int>("type"));
+	lowerBound = reader.read<double>("lowerBound");
+	upperBound = reader.read<double>("upperBound");
+	resolution = reader.read<unsigned int>("resolution");
+}
+
 GreensFunction::~GreensFunction(){
 /*	if(data != nullptr)
 		delete [] data;*/
 }
 
+string GreensFunction::serialize(Mode mode) const{
+	switch(mode){
+	case Mode::JSON:
+	{
+		json j;
+		j["id"] = "GreensFunction";
+		j["type"] = static_cast<int>(type);
+		j["lowerBound"] = lowerBound;
+		j["upperBound"] = upperBound;
+		j["resolution"] = resolution;
+		j["abstractProperty"] = json::parse(
+			AbstractProperty::serialize(mode)
+		);
+
+		return j.dump();
+	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("GreensFunction");
+		writer.write("type", static_cast<int>(type));
+		writer.write("lowerBound", lowerBound);
+		writer.write("upperBound", upperBound);
+		writer.write("resolution", resolution);
+		writeBinary(writer);
+
+		return writer.releaseSerialization();
+	}
+	default:
+		TBTKExit(
+			"GreensFunction::serialize()",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
+			""
+		);
+	}
+}
+
 };	//End of namespace Property
 };	//End of namespace TBTK
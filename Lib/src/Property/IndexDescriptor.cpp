@@ -174,10 +174,49 @@ IndexDescriptor::IndexDescriptor(const std::string &serialization, Mode mode){
 			);
 		}
 		break;
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "IndexDescriptor");
+		string formatString = reader.readString("format");
+		if(formatString.compare("None") == 0){
+			format = Format::None;
+		}
+		else if(formatString.compare("Ranges") == 0){
+			format = Format::Ranges;
+
+			descriptor.rangeFormat.dimensions
+				= reader.getArraySize<int>("ranges");
+			descriptor.rangeFormat.ranges = new int[
+				descriptor.rangeFormat.dimensions
+			];
+			reader.readArray("ranges", descriptor.rangeFormat.ranges);
+		}
+		else if(formatString.compare("Custom") == 0){
+			format = Format::Custom;
+
+			descriptor.customFormat.indexTree = new IndexTree(
+				reader.readString("indexTree"),
+				mode
+			);
+		}
+		else{
+			TBTKExit(
+				"IndexDescriptor::IndexDescriptor",
+				"Unknown Format '" << formatString << "'.",
+				"The serialization string is either corrupted"
+				<< " or the serialization was created with a"
+				<< " newer version of TBTK that supports more"
+				<< " formats."
+			);
+		}
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"IndexDescriptor::IndexDescriptor()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -279,13 +318,13 @@ void IndexDescriptor::setIndexTree(const IndexTree &indexTree){
 	descriptor.customFormat.indexTree = new IndexTree(indexTree);
 }
 
-unsigned int IndexDescriptor::getSize() const{
+uint64_t IndexDescriptor::getSize() const{
 	switch(format){
 	case Format::None:
 		return 1;
 	case Format::Ranges:
 	{
-		int size = 1;
+		uint64_t size = 1;
 		for(unsigned int n = 0; n < descriptor.rangeFormat.dimensions; n++)
 			size *= descriptor.rangeFormat.ranges[n];
 
@@ -343,10 +382,45 @@ std::string IndexDescriptor::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("IndexDescriptor");
+		switch(format){
+		case Format::None:
+			writer.writeString("format", "None");
+			break;
+		case Format::Ranges:
+			writer.writeString("format", "Ranges");
+			writer.writeArray(
+				"ranges",
+				descriptor.rangeFormat.ranges,
+				descriptor.rangeFormat.dimensions
+			);
+			break;
+		case Format::Custom:
+			writer.writeString("format", "Custom");
+			writer.writeString(
+				"indexTree",
+				descriptor.customFormat.indexTree->serialize(
+					mode
+				)
+			);
+			break;
+		default:
+			TBTKExit(
+				"IndexDescriptor::serialize()",
+				"Unknown Format.",
+				"This should never happen, contact the developer."
+			);
+		}
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"IndexDescriptor::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -20,6 +20,8 @@
 
 #include "TBTK/Property/LDOS.h"
 
+#include <cmath>
+
 #include "TBTK/json.hpp"
 
 using namespace std;
@@ -142,15 +144,43 @@ LDOS::LDOS(
 		}
 
 		break;
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "LDOS");
+		lowerBound = reader.read<double>("lowerBound");
+		upperBound = reader.read<double>("upperBound");
+		resolution = reader.read<int>("resolution");
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"LDOS::LDOS()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
 }
 
+LDOS::LDOS(
+	const MemoryMappedFile &file
+) :
+	LDOS(file, BinaryReader(file.getData(), file.getSize(), "LDOS"))
+{
+}
+
+LDOS::LDOS(
+	const MemoryMappedFile &file,
+	const BinaryReader &reader
+) :
+	AbstractProperty(file, reader)
+{
+	lowerBound = reader.read<double>("lowerBound");
+	upperBound = reader.read<double>("upperBound");
+	resolution = reader.read<int>("resolution");
+}
+
 LDOS::~LDOS(){
 }
 
@@ -178,6 +208,81 @@ LDOS& LDOS::operator=(LDOS &&rhs){
 	return *this;
 }
 
+Density LDOS::integrate() const{
+	return integrate(lowerBound, upperBound);
+}
+
+Density LDOS::integrate(double lowerLimit, double upperLimit) const{
+	double dE = (upperBound - lowerBound)/resolution;
+	int firstEnergy = max(
+		(int)ceil((lowerLimit - lowerBound)/dE - 0.5),
+		0
+	);
+	int lastEnergy = min(
+		(int)floor((upperLimit - lowerBound)/dE - 0.5),
+		resolution - 1
+	);
+
+	const double *data = getData();
+	const uint64_t numPoints = getSize()/resolution;
+	vector<double> density(numPoints, 0.);
+	double *densityData = density.data();
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for if(getSize() > PARALLELIZATION_THRESHOLD)
+#endif
+	for(uint64_t n = 0; n < numPoints; n++){
+		const double *block = data + n*resolution;
+		double sum = 0;
+		for(int e = firstEnergy; e <= lastEnergy; e++)
+			sum += block[e];
+		densityData[n] = sum*dE;
+	}
+
+	const IndexDescriptor &indexDescriptor = getIndexDescriptor();
+	switch(indexDescriptor.getFormat()){
+	case IndexDescriptor::Format::Ranges:
+	{
+		vector<int> ranges = getRanges();
+
+		return Density(getDimensions(), ranges.data(), densityData);
+	}
+	case IndexDescriptor::Format::Custom:
+		return Density(indexDescriptor.getIndexTree(), densityData);
+	default:
+		TBTKExit(
+			"LDOS::integrate()",
+			"Only the IndexDescriptor formats Ranges and Custom are"
+			<< " supported.",
+			""
+		);
+	}
+}
+
+void LDOS::assertCompatibleLayout(
+	const AbstractProperty<double> &abstractProperty,
+	const string &functionName
+) const{
+	AbstractProperty::assertCompatibleLayout(abstractProperty, functionName);
+
+	const LDOS *ldos
+		= dynamic_cast<const LDOS*>(&abstractProperty);
+	TBTKAssert(
+		ldos != nullptr,
+		"LDOS::" + functionName,
+		"The right hand side is not a LDOS.",
+		""
+	);
+	TBTKAssert(
+		lowerBound == ldos->lowerBound
+		&& upperBound == ldos->upperBound
+		&& resolution == ldos->resolution,
+		"LDOS::" + functionName,
+		"Incompatible energy windows.",
+		"Both sides must have been created with the same lower bound,"
+		<< " upper bound, and resolution."
+	);
+}
+
 string LDOS::serialize(Mode mode) const{
 	switch(mode){
 	case Mode::JSON:
@@ -193,10 +298,21 @@ string LDOS::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("LDOS");
+		writer.write("lowerBound", lowerBound);
+		writer.write("upperBound", upperBound);
+		writer.write("resolution", resolution);
+		writeBinary(writer);
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"LDOS::serialize()",
-			"Onle Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -0,0 +1,269 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file SampledLDOS.cpp
+ *
+ *  @author Kristofer Björnson
+ */
+
+#include "TBTK/Property/SampledLDOS.h"
+
+#include "TBTK/json.hpp"
+
+using namespace std;
+using namespace nlohmann;
+
+namespace TBTK{
+namespace Property{
+
+SampledLDOS::SampledLDOS(
+	int dimensions,
+	const int *ranges,
+	const vector<double> &energies
+) :
+	AbstractProperty(
+		dimensions,
+		ranges,
+		validateEnergies(energies).size()
+	),
+	energies(energies)
+{
+}
+
+SampledLDOS::SampledLDOS(
+	int dimensions,
+	const int *ranges,
+	const vector<double> &energies,
+	const double *data
+) :
+	AbstractProperty(
+		dimensions,
+		ranges,
+		validateEnergies(energies).size(),
+		data
+	),
+	energies(energies)
+{
+}
+
+SampledLDOS::SampledLDOS(
+	const IndexTree &indexTree,
+	const vector<double> &energies
+) :
+	AbstractProperty(indexTree, validateEnergies(energies).size()),
+	energies(energies)
+{
+}
+
+SampledLDOS::SampledLDOS(
+	const IndexTree &indexTree,
+	const vector<double> &energies,
+	const double *data
+) :
+	AbstractProperty(indexTree, validateEnergies(energies).size(), data),
+	energies(energies)
+{
+}
+
+SampledLDOS::SampledLDOS(
+	const SampledLDOS &sampledLDOS
+) :
+	AbstractProperty(sampledLDOS),
+	energies(sampledLDOS.energies)
+{
+}
+
+SampledLDOS::SampledLDOS(
+	SampledLDOS &&sampledLDOS
+) :
+	AbstractProperty(std::move(sampledLDOS)),
+	energies(std::move(sampledLDOS.energies))
+{
+}
+
+SampledLDOS::SampledLDOS(
+	const string &serialization,
+	Mode mode
+) :
+	AbstractProperty(
+		Serializeable::extract(
+			serialization,
+			mode,
+			"abstractProperty"
+		),
+		mode
+	)
+{
+	TBTKAssert(
+		validate(serialization, "SampledLDOS", mode),
+		"SampledLDOS::SampledLDOS()",
+		"Unable to parse string as SampledLDOS '" << serialization
+		<< "'.",
+		""
+	);
+
+	switch(mode){
+	case Mode::JSON:
+		try{
+			json j = json::parse(serialization);
+			energies = j.at("energies").get<vector<double>>();
+		}
+		catch(json::exception e){
+			TBTKExit(
+				"SampledLDOS::SampledLDOS()",
+				"Unable to parse string as SampledLDOS '"
+				<< serialization << "'.",
+				""
+			);
+		}
+
+		break;
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "SampledLDOS");
+		energies = reader.readVector<double>("energies");
+
+		break;
+	}
+	default:
+		TBTKExit(
+			"SampledLDOS::SampledLDOS()",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
+			""
+		);
+	}
+}
+
+SampledLDOS::SampledLDOS(
+	const MemoryMappedFile &file
+) :
+	SampledLDOS(
+		file,
+		BinaryReader(file.getData(), file.getSize(), "SampledLDOS")
+	)
+{
+}
+
+SampledLDOS::SampledLDOS(
+	const MemoryMappedFile &file,
+	const BinaryReader &reader
+) :
+	AbstractProperty(file, reader)
+{
+	energies = reader.readVector<double>("energies");
+}
+
+SampledLDOS::~SampledLDOS(){
+}
+
+SampledLDOS& SampledLDOS::operator=(const SampledLDOS &rhs){
+	if(this != &rhs){
+		AbstractProperty::operator=(rhs);
+
+		energies = rhs.energies;
+	}
+
+	return *this;
+}
+
+SampledLDOS& SampledLDOS::operator=(SampledLDOS &&rhs){
+	if(this != &rhs){
+		AbstractProperty::operator=(std::move(rhs));
+
+		energies = std::move(rhs.energies);
+	}
+
+	return *this;
+}
+
+void SampledLDOS::assertCompatibleLayout(
+	const AbstractProperty<double> &abstractProperty,
+	const string &functionName
+) const{
+	AbstractProperty::assertCompatibleLayout(abstractProperty, functionName);
+
+	const SampledLDOS *sampledLDOS
+		= dynamic_cast<const SampledLDOS*>(&abstractProperty);
+	TBTKAssert(
+		sampledLDOS != nullptr,
+		"SampledLDOS::" + functionName,
+		"The right hand side is not a SampledLDOS.",
+		""
+	);
+	TBTKAssert(
+		energies == sampledLDOS->energies,
+		"SampledLDOS::" + functionName,
+		"Incompatible energies.",
+		"Both sides must have been created with the same energies."
+	);
+}
+
+string SampledLDOS::serialize(Mode mode) const{
+	switch(mode){
+	case Mode::JSON:
+	{
+		json j;
+		j["id"] = "SampledLDOS";
+		j["energies"] = energies;
+		j["abstractProperty"] = json::parse(
+			AbstractProperty::serialize(mode)
+		);
+
+		return j.dump();
+	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("SampledLDOS");
+		writer.writeArray("energies", energies.data(), energies.size());
+		writeBinary(writer);
+
+		return writer.releaseSerialization();
+	}
+	default:
+		TBTKExit(
+			"SampledLDOS::serialize()",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
+			""
+		);
+	}
+}
+
+const vector<double>& SampledLDOS::validateEnergies(
+	const vector<double> &energies
+){
+	TBTKAssert(
+		energies.size() > 0,
+		"SampledLDOS::SampledLDOS()",
+		"The list of energies is empty.",
+		""
+	);
+	for(unsigned int n = 1; n < energies.size(); n++){
+		TBTKAssert(
+			energies[n-1] < energies[n],
+			"SampledLDOS::SampledLDOS()",
+			"The energies must be strictly increasing, but energy "
+			<< n - 1 << " is " << energies[n-1] << " and energy "
+			<< n << " is " << energies[n] << ".",
+			""
+		);
+	}
+
+	return energies;
+}
+
+};	//End of namespace Property
+};	//End of namespace TBTK
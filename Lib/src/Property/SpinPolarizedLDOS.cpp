@@ -180,6 +180,31 @@ SpinPolarizedLDOS& SpinPolarizedLDOS::operator=(SpinPolarizedLDOS &&rhs){
 	return *this;
 }
 
+void SpinPolarizedLDOS::assertCompatibleLayout(
+	const AbstractProperty<SpinMatrix> &abstractProperty,
+	const string &functionName
+) const{
+	AbstractProperty::assertCompatibleLayout(abstractProperty, functionName);
+
+	const SpinPolarizedLDOS *spinPolarizedLDOS
+		= dynamic_cast<const SpinPolarizedLDOS*>(&abstractProperty);
+	TBTKAssert(
+		spinPolarizedLDOS != nullptr,
+		"SpinPolarizedLDOS::" + functionName,
+		"The right hand side is not a SpinPolarizedLDOS.",
+		""
+	);
+	TBTKAssert(
+		lowerBound == spinPolarizedLDOS->lowerBound
+		&& upperBound == spinPolarizedLDOS->upperBound
+		&& resolution == spinPolarizedLDOS->resolution,
+		"SpinPolarizedLDOS::" + functionName,
+		"Incompatible energy windows.",
+		"Both sides must have been created with the same lower bound,"
+		<< " upper bound, and resolution."
+	);
+}
+
 string SpinPolarizedLDOS::serialize(Mode mode) const{
 	switch(mode){
 	case Mode::JSON:
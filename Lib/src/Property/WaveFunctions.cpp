@@ -175,15 +175,44 @@ WaveFunctions::WaveFunctions(
 		}
 
 		break;
+	case Mode::Binary:
+	{
+		BinaryReader reader(serialization, "WaveFunctions");
+		isContinuous = reader.read<bool>("isContinuous");
+		states = reader.readVector<unsigned int>("states");
+
+		break;
+	}
 	default:
 		TBTKExit(
 			"WaveFunctions::WaveFunctions()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
 }
 
+WaveFunctions::WaveFunctions(
+	const MemoryMappedFile &file
+) :
+	WaveFunctions(
+		file,
+		BinaryReader(file.getData(), file.getSize(), "WaveFunctions")
+	)
+{
+}
+
+WaveFunctions::WaveFunctions(
+	const MemoryMappedFile &file,
+	const BinaryReader &reader
+) :
+	AbstractProperty(file, reader)
+{
+	isContinuous = reader.read<bool>("isContinuous");
+	states = reader.readVector<unsigned int>("states");
+}
+
 WaveFunctions::~WaveFunctions(){
 }
 
@@ -319,10 +348,20 @@ string WaveFunctions::serialize(Mode mode) const{
 
 		return j.dump();
 	}
+	case Mode::Binary:
+	{
+		BinaryWriter writer("WaveFunctions");
+		writer.write("isContinuous", isContinuous);
+		writer.writeArray("states", states.data(), states.size());
+		writeBinary(writer);
+
+		return writer.releaseSerialization();
+	}
 	default:
 		TBTKExit(
 			"WaveFunctions::serialize()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
 			""
 		);
 	}
@@ -567,6 +567,38 @@ Property::LDOS ChebyshevExpander::calculateLDOS(
 	return ldos;
 }
 
+Property::SampledLDOS ChebyshevExpander::calculateSampledLDOS(
+	std::initializer_list<Index> patterns,
+	const vector<double> &energies
+){
+	IndexTree allIndices = generateIndexTree(
+		patterns,
+		*cSolver->getModel().getHoppingAmplitudeSet(),
+		false,
+		true
+	);
+
+	IndexTree memoryLayout = generateIndexTree(
+		patterns,
+		*cSolver->getModel().getHoppingAmplitudeSet(),
+		true,
+		true
+	);
+
+	Property::SampledLDOS sampledLDOS(memoryLayout, energies);
+
+	hint = (void*)&energies;
+	calculate(
+		calculateSampledLDOSCallback,
+		allIndices,
+		memoryLayout,
+		sampledLDOS
+	);
+	hint = nullptr;
+
+	return sampledLDOS;
+}
+
 Property::SpinPolarizedLDOS ChebyshevExpander::calculateSpinPolarizedLDOS(
 	Index pattern,
 	Index ranges
@@ -761,6 +793,53 @@ void ChebyshevExpander::calculateLDOSCallback(
 		((double*)ldos)[offset + n] += imag(greensFunctionData[n])/M_PI*dE;
 }
 
+void ChebyshevExpander::calculateSampledLDOSCallback(
+	PropertyExtractor *cb_this,
+	void *sampledLDOS,
+	const Index &index,
+	int offset
+){
+	ChebyshevExpander *pe = (ChebyshevExpander*)cb_this;
+
+	const vector<double> &energies = *(const vector<double>*)pe->hint;
+
+	vector<Index> to;
+	to.push_back(index);
+	complex<double> *coefficients = new complex<double>[pe->numCoefficients];
+	if(pe->useGPUToCalculateCoefficients){
+		pe->cSolver->calculateCoefficientsGPU(
+			to,
+			index,
+			coefficients,
+			pe->numCoefficients
+		);
+	}
+	else{
+		pe->cSolver->calculateCoefficients(
+			to,
+			index,
+			coefficients,
+			pe->numCoefficients
+		);
+	}
+
+	complex<double> *greensFunctionData
+		= pe->cSolver->generateGreensFunction(
+			coefficients,
+			pe->numCoefficients,
+			energies,
+			Solver::ChebyshevExpander::Type::NonPrincipal
+		);
+
+	for(unsigned int n = 0; n < energies.size(); n++){
+		((double*)sampledLDOS)[offset + n]
+			+= imag(greensFunctionData[n])/M_PI;
+	}
+
+	delete [] greensFunctionData;
+	delete [] coefficients;
+}
+
 void ChebyshevExpander::calculateSP_LDOSCallback(
 	PropertyExtractor *cb_this,
 	void *sp_ldos,
@@ -22,6 +22,7 @@
 #include "TBTK/Functions.h"
 #include "TBTK/Streams.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
@@ -425,6 +426,60 @@ Property::LDOS Diagonalizer::calculateLDOS(
 	return ldos;
 }
 
+Property::SampledLDOS Diagonalizer::calculateSampledLDOS(
+	std::initializer_list<Index> patterns,
+	const vector<double> &energies
+){
+	return calculateSampledLDOS(
+		patterns,
+		energies,
+		(upperBound - lowerBound)/energyResolution
+	);
+}
+
+Property::SampledLDOS Diagonalizer::calculateSampledLDOS(
+	std::initializer_list<Index> patterns,
+	const vector<double> &energies,
+	double binWidth
+){
+	TBTKAssert(
+		binWidth > 0,
+		"PropertyExtractor::Diagonalizer::calculateSampledLDOS()",
+		"The bin width must be positive.",
+		""
+	);
+
+	IndexTree allIndices = generateIndexTree(
+		patterns,
+		*dSolver->getModel().getHoppingAmplitudeSet(),
+		false,
+		true
+	);
+
+	IndexTree memoryLayout = generateIndexTree(
+		patterns,
+		*dSolver->getModel().getHoppingAmplitudeSet(),
+		true,
+		true
+	);
+
+	Property::SampledLDOS sampledLDOS(memoryLayout, energies);
+
+	//hint[0]: energies
+	//hint[1]: binWidth
+	const void *sampledLDOSHint[2] = {&energies, &binWidth};
+	hint = (void*)sampledLDOSHint;
+	calculate(
+		calculateSampledLDOSCallback,
+		allIndices,
+		memoryLayout,
+		sampledLDOS
+	);
+	hint = nullptr;
+
+	return sampledLDOS;
+}
+
 Property::SpinPolarizedLDOS Diagonalizer::calculateSpinPolarizedLDOS(
 	Index pattern,
 	Index ranges
@@ -689,6 +744,44 @@ void Diagonalizer::calculateLDOSCallback(
 	}
 }
 
+void Diagonalizer::calculateSampledLDOSCallback(
+	PropertyExtractor *cb_this,
+	void *sampledLDOS,
+	const Index &index,
+	int offset
+){
+	Diagonalizer *pe = (Diagonalizer*)cb_this;
+
+	const vector<double> &energies
+		= *(const vector<double>*)((const void**)pe->hint)[0];
+	const double dE = *(const double*)((const void**)pe->hint)[1];
+	const double *eigenValues = pe->dSolver->getEigenValues();
+
+	//An eigenvalue contributes to the bins [E - dE/2, E + dE/2) that it
+	//falls inside, that is, to the energies in the interval
+	//(eigenValue - dE/2, eigenValue + dE/2]. The amplitude is only
+	//calculated for eigenvalues that contribute to at least one energy.
+	for(int n = 0; n < pe->dSolver->getModel().getBasisSize(); n++){
+		unsigned int e = upper_bound(
+			energies.begin(),
+			energies.end(),
+			eigenValues[n] - dE/2
+		) - energies.begin();
+		if(e == energies.size() || energies[e] > eigenValues[n] + dE/2)
+			continue;
+
+		complex<double> u = pe->dSolver->getAmplitude(n, index);
+		double weight = real(conj(u)*u)/dE;
+		for(
+			;
+			e < energies.size() && energies[e] <= eigenValues[n] + dE/2;
+			e++
+		){
+			((double*)sampledLDOS)[offset + e] += weight;
+		}
+	}
+}
+
 void Diagonalizer::calculateSP_LDOSCallback(
 	PropertyExtractor *cb_this,
 	void *sp_ldos,
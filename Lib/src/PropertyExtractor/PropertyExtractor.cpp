@@ -109,6 +109,17 @@ Property::LDOS PropertyExtractor::calculateLDOS(
 	);
 }
 
+Property::SampledLDOS PropertyExtractor::calculateSampledLDOS(
+	initializer_list<Index> pattern,
+	const vector<double> &energies
+){
+	TBTKExit(
+		"PropertyExtractor::calculateSampledLDOS()",
+		"The chosen property extractor does not support this function call.",
+		"See the API for list of supported calls."
+	);
+}
+
 Property::SpinPolarizedLDOS PropertyExtractor::calculateSpinPolarizedLDOS(
 	Index pattern,
 	Index ranges
@@ -688,82 +688,93 @@ complex<double>* ChebyshevExpander::generateGreensFunction(
 		"Use ChebyshevExpander::setScaleFactor to set a larger scale factor."
 	);
 
-	complex<double> *greensFunctionData = new complex<double>[energyResolution];
-	for(int e = 0; e < energyResolution; e++)
-		greensFunctionData[e] = 0.;
+	vector<double> energies;
+	energies.reserve(energyResolution);
+	for(int e = 0; e < energyResolution; e++){
+		energies.push_back(
+			lowerBound + (upperBound - lowerBound)*e/(double)energyResolution
+		);
+	}
 
-	const double DELTA = 0.0001;
-//	if(type == Property::GreensFunction::Type::Retarded){
-	if(type == Type::Retarded){
-		for(int n = 0; n < numCoefficients; n++){
-			double denominator = 1.;
-			if(n == 0)
-				denominator = 2.;
+	return generateGreensFunction(
+		coefficients,
+		numCoefficients,
+		energies,
+		type
+	);
+}
 
-			for(int e = 0; e < energyResolution; e++){
-				double E = (lowerBound + (upperBound - lowerBound)*e/(double)energyResolution)/scaleFactor;
-				greensFunctionData[e] += coefficients[n]*(1/scaleFactor)*(-2.*i/sqrt(1+DELTA - E*E))*exp(-i*((double)n)*acos(E))/denominator;
-			}
-		}
+complex<double>* ChebyshevExpander::generateGreensFunction(
+	complex<double> *coefficients,
+	int numCoefficients,
+	const vector<double> &energies,
+	Type type
+){
+	TBTKAssert(
+		numCoefficients > 0,
+		"ChebyshevExpander::generateGreensFunction()",
+		"numCoefficients has to be larger than 0.",
+		""
+	);
+	for(unsigned int e = 0; e < energies.size(); e++){
+		TBTKAssert(
+			energies[e] > -scaleFactor && energies[e] < scaleFactor,
+			"ChebyshevExpander::generateGreensFunction()",
+			"The energy " << energies[e] << " is outside of the"
+			<< " interval (-scaleFactor, scaleFactor).",
+			"Use ChebyshevExpander::setScaleFactor to set a larger scale factor."
+		);
 	}
-//	else if(type == Property::GreensFunction::Type::Advanced){
-	else if(type == Type::Advanced){
-		for(int n = 0; n < numCoefficients; n++){
-			double denominator = 1.;
-			if(n == 0)
-				denominator = 2.;
 
-			for(int e = 0; e < energyResolution; e++){
-				double E = (lowerBound + (upperBound - lowerBound)*e/(double)energyResolution)/scaleFactor;
-				greensFunctionData[e] += coefficients[n]*conj((1/scaleFactor)*(-2.*i/sqrt(1+DELTA - E*E))*exp(-i*((double)n)*acos(E))/denominator);
-			}
-		}
-	}
-//	else if(type == Property::GreensFunction::Type::Principal){
-	else if(type == Type::Principal){
-		for(int n = 0; n < numCoefficients; n++){
-			double denominator = 1.;
-			if(n == 0)
-				denominator = 2.;
+	complex<double> *greensFunctionData
+		= new complex<double>[energies.size()];
 
-			for(int e = 0; e < energyResolution; e++){
-				double E = (lowerBound + (upperBound - lowerBound)*e/(double)energyResolution)/scaleFactor;
-				greensFunctionData[e] += -coefficients[n]*real((1/scaleFactor)*(-2.*i/sqrt(1+DELTA - E*E))*exp(-i*((double)n)*acos(E))/denominator);
-			}
-		}
-	}
-//	else if(type == Property::GreensFunction::Type::NonPrincipal){
-	else if(type == Type::NonPrincipal){
+	//The generating function for coefficient n is
+	//prefactor*exp(-i*n*acos(E)), which is accumulated using the
+	//recurrence exp(-i*(n+1)*acos(E)) = exp(-i*n*acos(E))*exp(-i*acos(E)).
+	//The cost is therefore proportional to the number of energies times
+	//the number of coefficients.
+	const double DELTA = 0.0001;
+	for(unsigned int e = 0; e < energies.size(); e++){
+		double E = energies[e]/scaleFactor;
+		complex<double> prefactor = (1/scaleFactor)*(-2.*i/sqrt(1+DELTA - E*E));
+		complex<double> step = exp(-i*acos(E));
+		complex<double> phase = 1.;
+
+		complex<double> sum = 0.;
 		for(int n = 0; n < numCoefficients; n++){
 			double denominator = 1.;
 			if(n == 0)
 				denominator = 2.;
 
-			for(int e = 0; e < energyResolution; e++){
-				double E = (lowerBound + (upperBound - lowerBound)*e/(double)energyResolution)/scaleFactor;
-				greensFunctionData[e] -= coefficients[n]*i*imag((1/scaleFactor)*(-2.*i/sqrt(1+DELTA - E*E))*exp(-i*((double)n)*acos(E))/denominator);
+			complex<double> generatingFunction
+				= prefactor*phase/denominator;
+			switch(type){
+			case Type::Retarded:
+				sum += coefficients[n]*generatingFunction;
+				break;
+			case Type::Advanced:
+				sum += coefficients[n]*conj(generatingFunction);
+				break;
+			case Type::Principal:
+				sum += -coefficients[n]*real(generatingFunction);
+				break;
+			case Type::NonPrincipal:
+				sum -= coefficients[n]*i*imag(generatingFunction);
+				break;
+			default:
+				delete [] greensFunctionData;
+				TBTKExit(
+					"ChebyshevExpander::generateGreensFunction()",
+					"Unknown GreensFunctionType",
+					""
+				);
 			}
+
+			phase *= step;
 		}
+		greensFunctionData[e] = sum;
 	}
-	else{
-		TBTKExit(
-			"ChebyshevExpander::generateGreensFunction()",
-			"Unknown GreensFunctionType",
-			""
-		);
-	}
-
-/*	Property::GreensFunction *greensFunction = new Property::GreensFunction(
-		type,
-//		Property::GreensFunction::Format::Array,
-		lowerBound,
-		upperBound,
-		energyResolution,
-		greensFunctionData
-	);
-	delete [] greensFunctionData;
-
-	return greensFunction;*/
 
 	return greensFunctionData;
 }
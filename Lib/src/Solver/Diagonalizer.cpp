@@ -114,17 +114,19 @@ void Diagonalizer::update(){
 	for(int n = 0; n < (basisSize*(basisSize+1))/2; n++)
 		hamiltonian[n] = 0.;
 
-	HoppingAmplitudeSet::Iterator it = model.getHoppingAmplitudeSet()->getIterator();
-	const HoppingAmplitude *ha;
-	while((ha = it.getHA())){
-/*		int from = model->getHoppingAmplitudeSet()->getBasisIndex(ha->fromIndex);
-		int to = model->getHoppingAmplitudeSet()->getBasisIndex(ha->toIndex);*/
-		int from = model.getHoppingAmplitudeSet()->getBasisIndex(ha->getFromIndex());
-		int to = model.getHoppingAmplitudeSet()->getBasisIndex(ha->getToIndex());
+	const HoppingAmplitudeSet *hoppingAmplitudeSet
+		= model.getHoppingAmplitudeSet();
+	vector<complex<double>> amplitudes
+		= hoppingAmplitudeSet->getAmplitudes();
+	const vector<int> &toBasisIndices
+		= hoppingAmplitudeSet->getToBasisIndices();
+	const vector<int> &fromBasisIndices
+		= hoppingAmplitudeSet->getFromBasisIndices();
+	for(unsigned int n = 0; n < amplitudes.size(); n++){
+		int from = fromBasisIndices[n];
+		int to = toBasisIndices[n];
 		if(from >= to)
-			hamiltonian[to + (from*(from+1))/2] += ha->getAmplitude();
-
-		it.searchNextHA();
+			hamiltonian[to + (from*(from+1))/2] += amplitudes[n];
 	}
 }
 
@@ -0,0 +1,511 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file BrillouinZoneIntegrator.cpp
+ *
+ *  @author Kristofer Björnson
+ */
+
+#include "TBTK/RPA/BrillouinZoneIntegrator.h"
+#include "TBTK/TBTKMacros.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace TBTK{
+
+//Corners of the simplices that a mesh cell is divided into. Bit n of a corner
+//is the offset along direction n. All simplices share the diagonal from
+//corner 0 to the opposite corner.
+static const vector<vector<vector<unsigned int>>> simplexCorners = {
+	{},
+	{{0, 1}},
+	{{0, 1, 3}, {0, 2, 3}},
+	{
+		{0, 1, 3, 7}, {0, 1, 5, 7}, {0, 2, 3, 7},
+		{0, 2, 6, 7}, {0, 4, 5, 7}, {0, 4, 6, 7}
+	}
+};
+
+//Returns the fraction of a simplex with the given sorted corner energies that
+//has an energy smaller than 'energy', assuming linear interpolation.
+static double getCumulativeFraction(
+	const double *e,
+	unsigned int numCorners,
+	double energy
+){
+	if(energy <= e[0])
+		return 0;
+	if(energy >= e[numCorners-1])
+		return 1;
+
+	switch(numCorners){
+	case 2:
+		return (energy - e[0])/(e[1] - e[0]);
+	case 3:
+		if(energy < e[1]){
+			return (energy - e[0])*(energy - e[0])
+				/((e[1] - e[0])*(e[2] - e[0]));
+		}
+		else{
+			return 1 - (e[2] - energy)*(e[2] - energy)
+				/((e[2] - e[0])*(e[2] - e[1]));
+		}
+	case 4:
+		if(energy < e[1]){
+			double x = energy - e[0];
+			return x*x*x/((e[1] - e[0])*(e[2] - e[0])*(e[3] - e[0]));
+		}
+		else if(energy < e[2]){
+			double e21 = e[1] - e[0];
+			double e31 = e[2] - e[0];
+			double e41 = e[3] - e[0];
+			double e32 = e[2] - e[1];
+			double e42 = e[3] - e[1];
+			double x = energy - e[1];
+			return (
+				e21*e21 + 3*e21*x + 3*x*x
+				- (e31 + e42)/(e32*e42)*x*x*x
+			)/(e31*e41);
+		}
+		else{
+			double x = e[3] - energy;
+			return 1 - x*x*x/(
+				(e[3] - e[0])*(e[3] - e[1])*(e[3] - e[2])
+			);
+		}
+	default:
+		TBTKExit(
+			"BrillouinZoneIntegrator::getCumulativeFraction()",
+			"Unsupported number of corners.",
+			"This should never happen, contact the developer."
+		);
+	}
+}
+
+BrillouinZoneIntegrator::BrillouinZoneIntegrator(
+	const MomentumSpaceContext &momentumSpaceContext
+) :
+	momentumSpaceContext(momentumSpaceContext)
+{
+	unsigned int numDimensions
+		= momentumSpaceContext.getNumMeshPoints().size();
+	TBTKAssert(
+		numDimensions >= 1 && numDimensions <= 3,
+		"BrillouinZoneIntegrator::BrillouinZoneIntegrator()",
+		"Only one-, two-, and three-dimensional meshes are supported,"
+		<< " but the mesh has " << numDimensions << " dimensions.",
+		""
+	);
+}
+
+Property::DOS BrillouinZoneIntegrator::calculateDOSTetrahedron(
+	double lowerBound,
+	double upperBound,
+	int resolution
+) const{
+	TBTKAssert(
+		lowerBound < upperBound && resolution > 0,
+		"BrillouinZoneIntegrator::calculateDOSTetrahedron()",
+		"Invalid energy interval.",
+		"'lowerBound' must be smaller than 'upperBound' and"
+		<< " 'resolution' must be positive."
+	);
+
+	unsigned int numDimensions
+		= momentumSpaceContext.getNumMeshPoints().size();
+	unsigned int numCorners = numDimensions + 1;
+	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
+	vector<unsigned int> simplices = getSimplices();
+	unsigned int numSimplices = simplices.size()/numCorners;
+
+	//Each simplex holds 1/simplexCorners[numDimensions].size() states per
+	//band and cell, while the DOS from the BlockDiagonalizer integrates to
+	//one per state.
+	double dE = (upperBound - lowerBound)/resolution;
+	double simplexWeight = 1./(
+		simplexCorners[numDimensions].size()*dE
+	);
+
+	Property::DOS dos(lowerBound, upperBound, resolution);
+	double *data = dos.getDataRW();
+
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel
+#endif
+	{
+		vector<double> localData(resolution, 0);
+		vector<double> cornerEnergies(numCorners);
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp for
+#endif
+		for(unsigned int s = 0; s < numSimplices; s++){
+			for(unsigned int band = 0; band < numOrbitals; band++){
+				for(unsigned int c = 0; c < numCorners; c++){
+					cornerEnergies[c]
+						= momentumSpaceContext.getEnergy(
+							simplices[numCorners*s + c],
+							band
+						);
+				}
+				sort(cornerEnergies.begin(), cornerEnergies.end());
+
+				//Only the intervals that overlap with the band
+				//inside the simplex receive contributions.
+				int first = max(
+					0,
+					(int)floor(
+						(cornerEnergies[0] - lowerBound)/dE
+					)
+				);
+				int last = min(
+					resolution - 1,
+					(int)floor((
+						cornerEnergies[numCorners-1]
+						- lowerBound
+					)/dE)
+				);
+				double previous = getCumulativeFraction(
+					cornerEnergies.data(),
+					numCorners,
+					lowerBound + first*dE
+				);
+				for(int n = first; n <= last; n++){
+					double next = getCumulativeFraction(
+						cornerEnergies.data(),
+						numCorners,
+						lowerBound + (n + 1)*dE
+					);
+					localData[n] += (next - previous)
+						*simplexWeight;
+					previous = next;
+				}
+			}
+		}
+
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp critical (TBTK_BRILLOUIN_ZONE_INTEGRATOR)
+#endif
+		for(int n = 0; n < resolution; n++)
+			data[n] += localData[n];
+	}
+
+	return dos;
+}
+
+Property::DOS BrillouinZoneIntegrator::calculateDOSAdaptiveSmearing(
+	double lowerBound,
+	double upperBound,
+	int resolution,
+	double smearingFactor
+) const{
+	TBTKAssert(
+		lowerBound < upperBound && resolution > 0,
+		"BrillouinZoneIntegrator::calculateDOSAdaptiveSmearing()",
+		"Invalid energy interval.",
+		"'lowerBound' must be smaller than 'upperBound' and"
+		<< " 'resolution' must be positive."
+	);
+
+	unsigned int numMeshPoints = momentumSpaceContext.getMesh().size();
+	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
+	vector<double> broadenings = getAdaptiveBroadenings(smearingFactor);
+
+	double dE = (upperBound - lowerBound)/resolution;
+
+	Property::DOS dos(lowerBound, upperBound, resolution);
+	double *data = dos.getDataRW();
+
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel
+#endif
+	{
+		vector<double> localData(resolution, 0);
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp for
+#endif
+		for(unsigned int m = 0; m < numMeshPoints; m++){
+			for(unsigned int band = 0; band < numOrbitals; band++){
+				double energy = momentumSpaceContext.getEnergy(
+					m,
+					band
+				);
+				double sigma = max(
+					broadenings[numOrbitals*m + band],
+					dE
+				);
+
+				//The Gaussian is negligible beyond six standard
+				//deviations.
+				int first = max(
+					0,
+					(int)floor(
+						(energy - 6*sigma - lowerBound)/dE
+					)
+				);
+				int last = min(
+					resolution - 1,
+					(int)floor(
+						(energy + 6*sigma - lowerBound)/dE
+					)
+				);
+				double scale = 1./(sqrt(2.)*sigma);
+				double previous = erf(
+					(lowerBound + first*dE - energy)*scale
+				);
+				for(int n = first; n <= last; n++){
+					double next = erf((
+						lowerBound + (n + 1)*dE - energy
+					)*scale);
+					localData[n] += (next - previous)/(2*dE);
+					previous = next;
+				}
+			}
+		}
+
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp critical (TBTK_BRILLOUIN_ZONE_INTEGRATOR)
+#endif
+		for(int n = 0; n < resolution; n++)
+			data[n] += localData[n];
+	}
+
+	return dos;
+}
+
+vector<double> BrillouinZoneIntegrator::getAdaptiveBroadenings(
+	double smearingFactor
+) const{
+	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
+	unsigned int numDimensions
+		= momentumSpaceContext.getNumMeshPoints().size();
+	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
+
+	vector<double> broadenings(mesh.size()*numOrbitals);
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for
+#endif
+	for(unsigned int m = 0; m < mesh.size(); m++){
+		Index kIndex = momentumSpaceContext.getKIndex(mesh[m]);
+		vector<unsigned int> forward(numDimensions);
+		vector<unsigned int> backward(numDimensions);
+		for(unsigned int n = 0; n < numDimensions; n++){
+			vector<int> offset(numDimensions, 0);
+			offset[n] = 1;
+			forward[n] = getNeighbor(kIndex, offset);
+			offset[n] = -1;
+			backward[n] = getNeighbor(kIndex, offset);
+		}
+
+		for(unsigned int band = 0; band < numOrbitals; band++){
+			double squaredDifference = 0;
+			for(unsigned int n = 0; n < numDimensions; n++){
+				double difference = (
+					momentumSpaceContext.getEnergy(
+						forward[n],
+						band
+					) - momentumSpaceContext.getEnergy(
+						backward[n],
+						band
+					)
+				)/2.;
+				squaredDifference += difference*difference;
+			}
+			broadenings[numOrbitals*m + band]
+				= smearingFactor*sqrt(squaredDifference);
+		}
+	}
+
+	return broadenings;
+}
+
+vector<double> BrillouinZoneIntegrator::calculateOccupationsTetrahedron(
+	double fermiEnergy
+) const{
+	unsigned int numDimensions
+		= momentumSpaceContext.getNumMeshPoints().size();
+	TBTKAssert(
+		numDimensions == 3,
+		"BrillouinZoneIntegrator::calculateOccupationsTetrahedron()",
+		"Only three-dimensional meshes are supported, but the mesh has "
+		<< numDimensions << " dimensions.",
+		""
+	);
+
+	const unsigned int NUM_CORNERS = 4;
+	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
+	unsigned int numMeshPoints = momentumSpaceContext.getMesh().size();
+	vector<unsigned int> simplices = getSimplices();
+	unsigned int numSimplices = simplices.size()/NUM_CORNERS;
+
+	//Each mesh point is a corner of 24 tetrahedra that each contribute a
+	//quarter of their volume, which is 1/6 of a cell.
+	const double CORNER_WEIGHT = 1/24.;
+
+	vector<double> occupations(numMeshPoints*numOrbitals, 0);
+	for(unsigned int s = 0; s < numSimplices; s++){
+		for(unsigned int band = 0; band < numOrbitals; band++){
+			unsigned int corners[NUM_CORNERS];
+			for(unsigned int c = 0; c < NUM_CORNERS; c++)
+				corners[c] = simplices[NUM_CORNERS*s + c];
+			sort(
+				corners,
+				corners + NUM_CORNERS,
+				[&](unsigned int a, unsigned int b){
+					return momentumSpaceContext.getEnergy(
+						a,
+						band
+					) < momentumSpaceContext.getEnergy(
+						b,
+						band
+					);
+				}
+			);
+			double e[NUM_CORNERS];
+			for(unsigned int c = 0; c < NUM_CORNERS; c++){
+				e[c] = momentumSpaceContext.getEnergy(
+					corners[c],
+					band
+				);
+			}
+
+			double w[NUM_CORNERS];
+			double density;
+			double E = fermiEnergy;
+			if(E <= e[0]){
+				continue;
+			}
+			else if(E >= e[3]){
+				for(unsigned int c = 0; c < NUM_CORNERS; c++)
+					w[c] = 1;
+				density = 0;
+			}
+			else if(E < e[1]){
+				double e21 = e[1] - e[0];
+				double e31 = e[2] - e[0];
+				double e41 = e[3] - e[0];
+				double x = E - e[0];
+				double C = x*x*x/(e21*e31*e41);
+				w[0] = C*(4 - x*(1/e21 + 1/e31 + 1/e41));
+				w[1] = C*x/e21;
+				w[2] = C*x/e31;
+				w[3] = C*x/e41;
+				density = 3*x*x/(e21*e31*e41);
+			}
+			else if(E < e[2]){
+				double e21 = e[1] - e[0];
+				double e31 = e[2] - e[0];
+				double e41 = e[3] - e[0];
+				double e32 = e[2] - e[1];
+				double e42 = e[3] - e[1];
+				double x1 = E - e[0];
+				double x2 = E - e[1];
+				double x3 = e[2] - E;
+				double x4 = e[3] - E;
+				double C1 = x1*x1/(e41*e31);
+				double C2 = x1*x2*x3/(e41*e32*e31);
+				double C3 = x2*x2*x4/(e42*e32*e41);
+				w[0] = C1 + (C1 + C2)*x3/e31
+					+ (C1 + C2 + C3)*x4/e41;
+				w[1] = C1 + C2 + C3 + (C2 + C3)*x3/e32
+					+ C3*x4/e42;
+				w[2] = (C1 + C2)*x1/e31 + (C2 + C3)*x2/e32;
+				w[3] = (C1 + C2 + C3)*x1/e41 + C3*x2/e42;
+				density = (
+					3*e21 + 6*x2 - 3*(e31 + e42)*x2*x2
+						/(e32*e42)
+				)/(e31*e41);
+			}
+			else{
+				double e41 = e[3] - e[0];
+				double e42 = e[3] - e[1];
+				double e43 = e[3] - e[2];
+				double x = e[3] - E;
+				double C = x*x*x/(e41*e42*e43);
+				w[0] = 1 - C*x/e41;
+				w[1] = 1 - C*x/e42;
+				w[2] = 1 - C*x/e43;
+				w[3] = 1 - C*(4 - x*(1/e41 + 1/e42 + 1/e43));
+				density = 3*x*x/(e41*e42*e43);
+			}
+
+			//Blöchl's correction for the curvature of the bands.
+			double energySum = e[0] + e[1] + e[2] + e[3];
+			for(unsigned int c = 0; c < NUM_CORNERS; c++){
+				w[c] += density*(energySum - 4*e[c])/10.;
+				occupations[numOrbitals*corners[c] + band]
+					+= CORNER_WEIGHT*w[c];
+			}
+		}
+	}
+
+	return occupations;
+}
+
+vector<unsigned int> BrillouinZoneIntegrator::getSimplices() const{
+	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
+	unsigned int numDimensions
+		= momentumSpaceContext.getNumMeshPoints().size();
+	const vector<vector<unsigned int>> &cellSimplices
+		= simplexCorners[numDimensions];
+	unsigned int numCorners = numDimensions + 1;
+
+	vector<unsigned int> simplices(
+		mesh.size()*cellSimplices.size()*numCorners
+	);
+	for(unsigned int m = 0; m < mesh.size(); m++){
+		Index kIndex = momentumSpaceContext.getKIndex(mesh[m]);
+
+		vector<unsigned int> cellCorners(1 << numDimensions);
+		for(unsigned int c = 0; c < cellCorners.size(); c++){
+			vector<int> offset(numDimensions);
+			for(unsigned int n = 0; n < numDimensions; n++)
+				offset[n] = (c >> n) & 1;
+			cellCorners[c] = getNeighbor(kIndex, offset);
+		}
+
+		for(unsigned int s = 0; s < cellSimplices.size(); s++){
+			for(unsigned int c = 0; c < numCorners; c++){
+				simplices[
+					numCorners*(cellSimplices.size()*m + s)
+					+ c
+				] = cellCorners[cellSimplices[s][c]];
+			}
+		}
+	}
+
+	return simplices;
+}
+
+unsigned int BrillouinZoneIntegrator::getNeighbor(
+	const Index &kIndex,
+	const vector<int> &offset
+) const{
+	const vector<unsigned int> &numMeshPoints
+		= momentumSpaceContext.getNumMeshPoints();
+
+	Index neighbor = kIndex;
+	for(unsigned int n = 0; n < numMeshPoints.size(); n++){
+		neighbor[n] = (
+			kIndex[n] + offset[n] + (int)numMeshPoints[n]
+		)%numMeshPoints[n];
+	}
+
+	return momentumSpaceContext.getMeshPoint(neighbor);
+}
+
+};	//End of namespace TBTK
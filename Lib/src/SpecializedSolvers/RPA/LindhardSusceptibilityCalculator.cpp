@@ -37,6 +37,7 @@ LindhardSusceptibilityCalculator::LindhardSusceptibilityCalculator(
 	SusceptibilityCalculator(Algorithm::Lindhard, momentumSpaceContext)
 {
 	susceptibilityIsSafeFromPoles = false;
+	isMaster = true;
 
 	const Model& model = momentumSpaceContext.getModel();
 	fermiDiracLookupTable = new double[model.getBasisSize()];
@@ -51,197 +52,30 @@ LindhardSusceptibilityCalculator::LindhardSusceptibilityCalculator(
 
 LindhardSusceptibilityCalculator::LindhardSusceptibilityCalculator(
 	const MomentumSpaceContext &momentumSpaceContext,
-	int *kPlusQLookupTable,
 	double *fermiDiracLookupTable
 ) :
-	SusceptibilityCalculator(
-		Algorithm::Lindhard,
-		momentumSpaceContext,
-		kPlusQLookupTable
-	)
+	SusceptibilityCalculator(Algorithm::Lindhard, momentumSpaceContext)
 {
 	susceptibilityIsSafeFromPoles = false;
+	isMaster = false;
 
 	this->fermiDiracLookupTable = fermiDiracLookupTable;
 }
 
 LindhardSusceptibilityCalculator::~LindhardSusceptibilityCalculator(){
-	if(getIsMaster() && fermiDiracLookupTable != nullptr)
+	if(isMaster && fermiDiracLookupTable != nullptr)
 		delete [] fermiDiracLookupTable;
 }
 
 LindhardSusceptibilityCalculator* LindhardSusceptibilityCalculator::createSlave(){
-	return new LindhardSusceptibilityCalculator(
-		getMomentumSpaceContext(),
-		getKPlusQLookupTable(),
-		fermiDiracLookupTable
-	);
-}
-
-void LindhardSusceptibilityCalculator::precompute(unsigned int numWorkers){
-	TBTKNotYetImplemented("LindhardSusceptibilityCalculator::precompute()");
-/*	Timer::tick("1");
-	const MomentumSpaceContext &momentumSpaceContext = getMomentumSpaceContext();
-	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
-	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
-
-	vector<SusceptibilityCalculator*> susceptibilityCalculators;
-	for(unsigned int n = 0; n < numWorkers; n++){
-		susceptibilityCalculators.push_back(
-			new LindhardSusceptibilityCalculator(
-				momentumSpaceContext
-			)
-//			this->createSlave()
-		);
-		susceptibilityCalculators[n]->setEnergies(
-			getEnergies()
-		);
-		susceptibilityCalculators[n]->setEnergyType(
-			getEnergyType()
-		);
-		susceptibilityCalculators[n]->setEnergiesAreInversionSymmetric(
-			getEnergiesAreInversionSymmetric()
+	LindhardSusceptibilityCalculator *slave
+		= new LindhardSusceptibilityCalculator(
+			getMomentumSpaceContext(),
+			fermiDiracLookupTable
 		);
+	slave->susceptibilityIsSafeFromPoles = susceptibilityIsSafeFromPoles;
 
-		delete [] susceptibilityCalculators[n]->kPlusQLookupTable;
-		susceptibilityCalculators[n]->kPlusQLookupTable = kPlusQLookupTable;
-		delete [] susceptibilityCalculators[n]->fermiDiracLookupTable;
-		susceptibilityCalculators[n]->fermiDiracLookupTable = fermiDiracLookupTable;
-		susceptibilityCalculators[n]->isMaster = false;
-	}
-
-	vector<vector<vector<double>>> meshes;
-	unsigned int meshSegmentSize = mesh.size()/(numWorkers-1);
-	for(unsigned int n = 0; n < numWorkers-1; n++){
-		meshes.push_back(vector<vector<double>>());
-		for(
-			unsigned int c = n*meshSegmentSize;
-			c < (n+1)*meshSegmentSize;
-			c++
-		){
-			meshes[n].push_back(mesh.at(c));
-		}
-	}
-	meshes.push_back(vector<vector<double>>());
-	for(
-		unsigned int n = (numWorkers-1)*meshSegmentSize;
-		n < mesh.size();
-		n++
-	){
-		meshes.back().push_back(mesh.at(n));
-	}
-	Timer::tock();
-
-	Timer::tick("2");
-	#pragma omp parallel for
-	for(unsigned int n = 0; n < numWorkers; n++){
-		SusceptibilityCalculator &susceptibilityCalculator = *susceptibilityCalculators.at(n);
-		const vector<vector<double>> &mesh = meshes.at(n);
-
-		for(unsigned int c = 0; c < mesh.size(); c++){
-			for(
-				unsigned int orbital0 = 0;
-				orbital0 < numOrbitals;
-				orbital0++
-			){
-				for(
-					unsigned int orbital1 = 0;
-					orbital1 < numOrbitals;
-					orbital1++
-				){
-					for(
-						unsigned int orbital2 = 0;
-						orbital2 < numOrbitals;
-						orbital2++
-					){
-						for(
-							unsigned int orbital3 = 0;
-							orbital3 < numOrbitals;
-							orbital3++
-						){
-							susceptibilityCalculator.calculateSusceptibility(
-								mesh[c],
-								{
-									(int)orbital0,
-									(int)orbital1,
-									(int)orbital2,
-									(int)orbital3
-								}
-							);
-						}
-					}
-				}
-			}
-		}
-	}
-	Timer::tock();
-
-	Timer::tick("3");
-//	Streams::out << "Susceptibility tree size:\t" << susceptibilityTree.getSizeInBytes() << "\n";
-	for(unsigned int n = 0; n < numWorkers; n++){
-		SusceptibilityCalculator &susceptibilityCalculator = *susceptibilityCalculators.at(n);
-		const vector<vector<double>> &mesh = meshes.at(n);
-
-		for(unsigned int c = 0; c < mesh.size(); c++){
-			Index kIndex = momentumSpaceContext.getKIndex(
-				mesh[c]
-			);
-
-			for(
-				unsigned int orbital0 = 0;
-				orbital0 < numOrbitals;
-				orbital0++
-			){
-				for(
-					unsigned int orbital1 = 0;
-					orbital1 < numOrbitals;
-					orbital1++
-				){
-					for(
-						unsigned int orbital2 = 0;
-						orbital2 < numOrbitals;
-						orbital2++
-					){
-						for(
-							unsigned int orbital3 = 0;
-							orbital3 < numOrbitals;
-							orbital3++
-						){
-							SerializeableVector<complex<double>> result;
-							Index resultIndex = Index(
-								kIndex,
-								{
-									(int)orbital0,
-									(int)orbital1,
-									(int)orbital2,
-									(int)orbital3
-								}
-							);
-							TBTKAssert(
-								susceptibilityCalculator.susceptibilityTree.get(
-									result,
-									resultIndex
-								),
-								"SusceptibilityCalculator::precompute()",
-								"Unable to find requested susceptibility.",
-								"This should never happen, contact the developer."
-							);
-							susceptibilityTree.add(
-								result,
-								resultIndex
-							);
-						}
-					}
-				}
-			}
-		}
-	}
-
-	for(unsigned int n = 0; n < susceptibilityCalculators.size(); n++)
-		delete susceptibilityCalculators[n];
-
-	Streams::out << "Susceptibility tree size:\t" << susceptibilityTree.getSizeInBytes() << "\n";
-	Timer::tock();*/
+	return slave;
 }
 
 inline complex<double> LindhardSusceptibilityCalculator::getPoleTimesTwoFermi(
@@ -250,7 +84,7 @@ inline complex<double> LindhardSusceptibilityCalculator::getPoleTimesTwoFermi(
 	double e1,
 	double chemicalPotential,
 	double temperature,
-	int kPlusQLinearIndex,
+	unsigned int kPlusQMeshPoint,
 	unsigned int meshPoint,
 	unsigned int state2,
 	unsigned int state1,
@@ -273,7 +107,7 @@ inline complex<double> LindhardSusceptibilityCalculator::getPoleTimesTwoFermi(
 	else{
 		return (1./(energy + e2 - e1))*(
 			fermiDiracLookupTable[
-				kPlusQLinearIndex
+				kPlusQMeshPoint*numOrbitals
 				+ state2
 			]
 			- fermiDiracLookupTable[
@@ -294,20 +128,18 @@ complex<double> LindhardSusceptibilityCalculator::calculateSusceptibilityLindhar
 ){
 	const MomentumSpaceContext &momentumSpaceContext = getMomentumSpaceContext();
 	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
-	const vector<unsigned int> &numMeshPoints = momentumSpaceContext.getNumMeshPoints();
-	const BrillouinZone &brillouinZone = momentumSpaceContext.getBrillouinZone();
 	const Model &model = momentumSpaceContext.getModel();
 	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
 
+	//Get the mesh point closest to k.
+	unsigned int kMeshPoint = momentumSpaceContext.getMeshPoint(
+		momentumSpaceContext.getKIndex(k)
+	);
+
 	complex<double> result = 0;
 	for(unsigned int n = 0; n < mesh.size(); n++){
-		Index kPlusQIndex = brillouinZone.getMinorCellIndex(
-			{mesh[n][0] + k[0], mesh[n][1] + k[1]},
-			numMeshPoints
-		);
-		int kPlusQLinearIndex =  model.getHoppingAmplitudeSet()->getFirstIndexInBlock(
-			kPlusQIndex
-		);
+		unsigned int kPlusQMeshPoint
+			= momentumSpaceContext.getKPlusQMeshPoint(n, kMeshPoint);
 		for(unsigned int c = 0; c < numOrbitals; c++){
 			double e1 = momentumSpaceContext.getEnergy(n, c);
 			complex<double> a1 = momentumSpaceContext.getAmplitude(
@@ -323,7 +155,8 @@ complex<double> LindhardSusceptibilityCalculator::calculateSusceptibilityLindhar
 
 			for(unsigned int j = 0; j < numOrbitals; j++){
 				double e2 = momentumSpaceContext.getEnergy(
-					kPlusQLinearIndex + j
+					kPlusQMeshPoint,
+					j
 				);
 
 				complex<double> pttf = getPoleTimesTwoFermi(
@@ -332,7 +165,7 @@ complex<double> LindhardSusceptibilityCalculator::calculateSusceptibilityLindhar
 					e1,
 					model.getChemicalPotential(),
 					model.getTemperature(),
-					kPlusQLinearIndex,
+					kPlusQMeshPoint,
 					n,
 					j,
 					c,
@@ -340,12 +173,12 @@ complex<double> LindhardSusceptibilityCalculator::calculateSusceptibilityLindhar
 				);
 
 				complex<double> a3 = momentumSpaceContext.getAmplitude(
-					kPlusQLinearIndex/numOrbitals,
+					kPlusQMeshPoint,
 					j,
 					orbitalIndices.at(1)
 				);
 				complex<double> a4 = momentumSpaceContext.getAmplitude(
-					kPlusQLinearIndex/numOrbitals,
+					kPlusQMeshPoint,
 					j,
 					orbitalIndices.at(2)
 				);
@@ -360,228 +193,402 @@ complex<double> LindhardSusceptibilityCalculator::calculateSusceptibilityLindhar
 	return result;
 }
 
-/*template<>
-inline int SusceptibilityCalculator::getKPlusQLinearIndex<false>(
-	unsigned int meshIndex,
-	const vector<double> &k,
-	int kLinearIndex
-) const{
-	const vector<vector<double>> &mesh = momentumSpaceContext->getMesh();
+template<bool isSafeFromPoles>
+vector<complex<double>> LindhardSusceptibilityCalculator::calculateSusceptibilityLindhard(
+	const DualIndex &kDual,
+	const vector<int> &orbitalIndices
+){
+	//Try to return cashed result
+	const complex<double> *cachedResult = getCachedSusceptibility(
+		kDual,
+		orbitalIndices
+	);
+	if(cachedResult != nullptr){
+		return vector<complex<double>>(
+			cachedResult,
+			cachedResult + getEnergies().size()
+		);
+	}
+
+	//Calculate the susceptibility for all orbital indices at once. The
+	//cost is only a small fraction of calculating them one by one, and
+	//most applications need all of them.
+	vector<complex<double>> susceptibilities
+		= calculateSusceptibilityLindhardBatched<isSafeFromPoles>(kDual);
 
-	Index kPlusQIndex = momentumSpaceContext->getBrillouinZone().getMinorCellIndex(
-		{mesh[meshIndex][0] + k[0], mesh[meshIndex][1] + k[1]},
-		momentumSpaceContext->getNumMeshPoints()
+	unsigned int numOrbitals
+		= getMomentumSpaceContext().getNumOrbitals();
+	unsigned int numEnergies = getEnergies().size();
+	unsigned int offset = numEnergies*(
+		numOrbitals*(
+			numOrbitals*(
+				numOrbitals*orbitalIndices[0]
+				+ orbitalIndices[1]
+			) + orbitalIndices[2]
+		) + orbitalIndices[3]
 	);
-	return momentumSpaceContext->getModel().getHoppingAmplitudeSet()->getFirstIndexInBlock(
-		kPlusQIndex
+
+	return vector<complex<double>>(
+		susceptibilities.begin() + offset,
+		susceptibilities.begin() + offset + numEnergies
 	);
 }
 
-template<>
-inline int SusceptibilityCalculator::getKPlusQLinearIndex<true>(
-	unsigned int meshIndex,
-	const vector<double> &k,
-	int kLinearIndex
-) const{
-	return kPlusQLookupTable[
-		meshIndex*momentumSpaceContext->getMesh().size()
-		+ kLinearIndex/momentumSpaceContext->getNumOrbitals()
-	];
-}*/
+extern "C" {
+	void zgemm_(
+		char *transA,
+		char *transB,
+		int *M,
+		int *N,
+		int *K,
+		complex<double> *alpha,
+		complex<double> *A,
+		int *lda,
+		complex<double> *B,
+		int *ldb,
+		complex<double> *beta,
+		complex<double> *C,
+		int *ldc
+	);
+}
 
-template<bool useKPlusQLookupTable, bool isSafeFromPoles>
-vector<complex<double>> LindhardSusceptibilityCalculator::calculateSusceptibilityLindhard(
-	const DualIndex &kDual,
-	const vector<int> &orbitalIndices
+//Evaluates the same expression as the single energy version of
+//calculateSusceptibilityLindhard() above, but for all orbital indices and
+//energies at once. With a(k, s, o) the amplitude of orbital o in state s at
+//k, the band-pair weights factorize as
+//	P(k, s1, o3, o0) = a(k, s1, o3)a^{*}(k, s1, o0),
+//	Q(k+q, s2, o1, o2) = a(k+q, s2, o1)a^{*}(k+q, s2, o2).
+//With L(k, s1, s2, E) the Lindhard factor
+//(f(k+q, s2) - f(k, s1))/(E + e(k+q, s2) - e(k, s1)), the susceptibility is
+//then calculated using the two matrix products
+//	T(k, s1, o1, o2, E) = \sum_{s2}Q(k+q, s2, o1, o2)L(k, s1, s2, E),
+//	\chi(o0, o1, o2, o3, E) = -1/N\sum_{k, s1}P(k, s1, o3, o0)T(k, s1, o1, o2, E).
+template<bool isSafeFromPoles>
+vector<complex<double>> LindhardSusceptibilityCalculator::calculateSusceptibilityLindhardBatched(
+	const DualIndex &kDual
 ){
-	//Get kIndex and resultIndex
-//	const vector<double> &k = kDual.getContinuousIndex();
 	const vector<double> &k = kDual;
 	const Index &kIndex = kDual;
-	Index resultIndex = getSusceptibilityResultIndex(
-		kIndex,
-		orbitalIndices
-	);
-
-	//Try to return cashed result
-	SerializeableVector<complex<double>> result;
-	if(getSusceptibilityTree().get(result, resultIndex))
-		return result;
 
 	const MomentumSpaceContext &momentumSpaceContext = getMomentumSpaceContext();
 	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
 	const Model &model = momentumSpaceContext.getModel();
 	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
+	unsigned int numOrbitalPairs = numOrbitals*numOrbitals;
+	const vector<complex<double>> &energies = getEnergies();
+	unsigned int numEnergies = energies.size();
 
-	//Initialize result and isolate purely real energies. The real energies
-	//need extra careful treatment because they can result in evaluation of
-	// a term at a pole.
-	vector<complex<double>> realEnergies;
-	vector<complex<double>> complexEnergies;
+	vector<complex<double>> susceptibilities(
+		numOrbitalPairs*numOrbitalPairs*numEnergies
+	);
+	if(numEnergies == 0)
+		return susceptibilities;
+
+	//Split the energies into real and imaginary parts to allow the
+	//Lindhard factors to be vectorized over the energies. Purely real
+	//energies need extra careful treatment because they can result in
+	//evaluation of a term at a pole.
+	vector<double> realEnergyParts;
+	vector<double> imaginaryEnergyParts;
 	vector<unsigned int> realEnergyIndices;
-	vector<unsigned int> complexEnergyIndices;
-	const vector<complex<double>> &energies = getEnergies();
-	for(unsigned int n = 0; n < energies.size(); n++){
-		result.push_back(0);
-		complex<double> energy = energies.at(n);
-		if(abs(imag(energy)) < 1e-10){
-			realEnergies.push_back(energy);
-			realEnergyIndices.push_back(n);
-		}
-		else{
-			complexEnergies.push_back(energy);
-			complexEnergyIndices.push_back(n);
-		}
+	for(unsigned int e = 0; e < numEnergies; e++){
+		realEnergyParts.push_back(real(energies[e]));
+		imaginaryEnergyParts.push_back(imag(energies[e]));
+		if(abs(imag(energies[e])) < 1e-10)
+			realEnergyIndices.push_back(e);
 	}
 
-	//Get linear index corresponding to kIndex.
-	int kLinearIndex = model.getHoppingAmplitudeSet()->getFirstIndexInBlock(
-		kIndex
+	//Number of mesh points to include in each matrix product. Chosen
+	//such that the intermediate result T requires a few megabytes.
+	unsigned int blockSize = max(
+		1u,
+		(1u << 18)/(numOrbitalPairs*numEnergies*numOrbitals)
 	);
+	blockSize = min(blockSize, (unsigned int)mesh.size());
+
+	//L on the layout [s2][s1][E].
+	vector<complex<double>> lindhardFactors(
+		numOrbitals*numOrbitals*numEnergies
+	);
+	//Q on the layout [o1][o2][s2].
+	vector<complex<double>> q(numOrbitalPairs*numOrbitals);
+	//T on the layout [k][s1][E][o1][o2].
+	vector<complex<double>> t(
+		blockSize*numOrbitals*numEnergies*numOrbitalPairs
+	);
+	//P on the layout [o3][o0][k][s1].
+	vector<complex<double>> p(numOrbitalPairs*blockSize*numOrbitals);
+	//The result on the layout [o3][o0][E][o1][o2].
+	vector<complex<double>> result(
+		numOrbitalPairs*numEnergies*numOrbitalPairs,
+		0.
+	);
+
+	unsigned int kMeshPoint = momentumSpaceContext.getMeshPoint(kIndex);
+	double chemicalPotential = model.getChemicalPotential();
+	double temperature = model.getTemperature();
 
-	//Main loop
-	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
-		//Get linear index corresponding to k+q
-		int kPlusQLinearIndex = getKPlusQLinearIndex<useKPlusQLookupTable>(
-			meshPoint,
-			k,
-			kLinearIndex
+	for(
+		unsigned int blockStart = 0;
+		blockStart < mesh.size();
+		blockStart += blockSize
+	){
+		unsigned int currentBlockSize = min(
+			blockSize,
+			(unsigned int)mesh.size() - blockStart
 		);
-		int kPlusQMeshPoint = kPlusQLinearIndex/momentumSpaceContext.getNumOrbitals();
+		for(unsigned int b = 0; b < currentBlockSize; b++){
+			unsigned int meshPoint = blockStart + b;
+			unsigned int kPlusQMeshPoint
+				= momentumSpaceContext.getKPlusQMeshPoint(
+					meshPoint,
+					kMeshPoint
+				);
 
-		for(unsigned int state1 = 0; state1 < numOrbitals; state1++){
-			//Get energy and amplitude for first state.
-			double e1 = momentumSpaceContext.getEnergy(meshPoint, state1);
-			complex<double> a1 = momentumSpaceContext.getAmplitude(
-				meshPoint,
-				state1,
-				orbitalIndices[3]
-			);
-			complex<double> a2 = momentumSpaceContext.getAmplitude(
-				meshPoint,
-				state1,
-				orbitalIndices[0]
-			);
+			//Band-pair weights.
+			for(unsigned int s1 = 0; s1 < numOrbitals; s1++){
+				for(unsigned int o3 = 0; o3 < numOrbitals; o3++){
+					complex<double> a1
+						= momentumSpaceContext.getAmplitude(
+							meshPoint,
+							s1,
+							o3
+						);
+					for(
+						unsigned int o0 = 0;
+						o0 < numOrbitals;
+						o0++
+					){
+						p[
+							numOrbitals*(
+								currentBlockSize*(
+									numOrbitals*o3
+									+ o0
+								) + b
+							) + s1
+						] = a1*conj(
+							momentumSpaceContext.getAmplitude(
+								meshPoint,
+								s1,
+								o0
+							)
+						);
+					}
+				}
+			}
+			for(unsigned int s2 = 0; s2 < numOrbitals; s2++){
+				for(unsigned int o1 = 0; o1 < numOrbitals; o1++){
+					complex<double> a3
+						= momentumSpaceContext.getAmplitude(
+							kPlusQMeshPoint,
+							s2,
+							o1
+						);
+					for(
+						unsigned int o2 = 0;
+						o2 < numOrbitals;
+						o2++
+					){
+						q[
+							numOrbitals*(
+								numOrbitals*o1
+								+ o2
+							) + s2
+						] = a3*conj(
+							momentumSpaceContext.getAmplitude(
+								kPlusQMeshPoint,
+								s2,
+								o2
+							)
+						);
+					}
+				}
+			}
 
-			//Skip to the next state if the current state gives an
-			//obvious zero contribution.
-/*			if(abs(a1*a2) < 1e-10)
-				continue;*/
-			if(real(a1*a2*conj(a1*a2)) < 1e-10)
-				continue;
-
-			for(
-				unsigned int state2 = 0;
-				state2 < numOrbitals;
-				state2++
-			){
-				//Get energy and amplitudes for second state
+			//Lindhard factors.
+			for(unsigned int s2 = 0; s2 < numOrbitals; s2++){
 				double e2 = momentumSpaceContext.getEnergy(
-					kPlusQLinearIndex + state2
-				);
-				complex<double> a3 = momentumSpaceContext.getAmplitude(
-					kPlusQMeshPoint,
-					state2,
-					orbitalIndices[1]
-				);
-				complex<double> a4 = momentumSpaceContext.getAmplitude(
 					kPlusQMeshPoint,
-					state2,
-					orbitalIndices[2]
+					s2
 				);
-
-				//Skip to the next state if the current state
-				//gives an obvious zero contribution.
-/*				if(abs(a3*a4) < 1e-10)
-					continue;*/
-				if(real(a3*a4*conj(a3*a4)) < 1e-10)
-					continue;
-
-				if(realEnergies.size() > 0){
-					//If the expression is not safe from
-					//poles, the function
-					//poleTimesTwoFermi() is used to
-					//evaluate the Lindhard function to
-					//properly handle potential divisions
-					//by zero.
+				double f2 = fermiDiracLookupTable[
+					kPlusQMeshPoint*numOrbitals + s2
+				];
+				for(unsigned int s1 = 0; s1 < numOrbitals; s1++){
+					double e1 = momentumSpaceContext.getEnergy(
+						meshPoint,
+						s1
+					);
+					double f1 = fermiDiracLookupTable[
+						meshPoint*numOrbitals + s1
+					];
+					double energyDifference = e2 - e1;
+					double fermiDifference = f2 - f1;
+
+					complex<double> *factors
+						= lindhardFactors.data()
+						+ numEnergies*(numOrbitals*s2 + s1);
+					const double *x = realEnergyParts.data();
+					const double *y = imaginaryEnergyParts.data();
+#ifdef TBTK_USE_OPEN_MP
+					#pragma omp simd
+#endif
 					for(
 						unsigned int e = 0;
-						e < realEnergies.size();
+						e < numEnergies;
 						e++
 					){
-						complex<double> E = realEnergies.at(e);
-						complex<double> pttf = getPoleTimesTwoFermi(
-							E,
-							e2,
-							e1,
-							model.getChemicalPotential(),
-							model.getTemperature(),
-							kPlusQLinearIndex,
-							meshPoint,
-							state2,
-							state1,
-							numOrbitals
+						double re = x[e] + energyDifference;
+						double im = y[e];
+						double scale = fermiDifference/(
+							re*re + im*im
 						);
+						factors[e] = complex<double>(
+							re*scale,
+							-im*scale
+						);
+					}
 
-						result[
-							realEnergyIndices[e]
-						] -= a1*conj(a2)*a3*conj(a4)*pttf;
+					if(isSafeFromPoles)
+						continue;
+
+					for(
+						unsigned int n = 0;
+						n < realEnergyIndices.size();
+						n++
+					){
+						unsigned int e = realEnergyIndices[n];
+						if(
+							abs(energies[e] + energyDifference)
+							< 1e-10
+						){
+							factors[e] = getPoleTimesTwoFermi(
+								energies[e],
+								e2,
+								e1,
+								chemicalPotential,
+								temperature,
+								kPlusQMeshPoint,
+								meshPoint,
+								s2,
+								s1,
+								numOrbitals
+							);
+						}
 					}
 				}
-				if(complexEnergies.size() > 0){
-					//If the expression is safe from
-					//division by zero, the performance is
-					//improved by using a lookup table to
-					//evaluate the Fermi function.
-
-					//Calculate numerator of the Lindhard
-					//function
-					complex<double> numerator = a1*conj(a2)*a3*conj(a4)*(
-						fermiDiracLookupTable[
-							kPlusQLinearIndex
-							+ state2
-						]
-						- fermiDiracLookupTable[
-							meshPoint*numOrbitals
-							+ state1
-						]
-					);
-					//Skip to the next state if the
-					//numerator gives rise to an obvious
-					//zero contribution.
-					if(abs(numerator) < 1e-10)
-						continue;
+			}
+
+			//T = QL
+			char transA = 'T';
+			char transB = 'T';
+			int M = numOrbitalPairs;
+			int N = numEnergies*numOrbitals;
+			int K = numOrbitals;
+			complex<double> alpha = 1.;
+			complex<double> beta = 0.;
+			int lda = numOrbitals;
+			int ldb = numEnergies*numOrbitals;
+			int ldc = numOrbitalPairs;
+			zgemm_(
+				&transA,
+				&transB,
+				&M,
+				&N,
+				&K,
+				&alpha,
+				q.data(),
+				&lda,
+				lindhardFactors.data(),
+				&ldb,
+				&beta,
+				t.data() + b*numOrbitals*numEnergies*numOrbitalPairs,
+				&ldc
+			);
+		}
 
+		//result += -PT/N
+		char transA = 'N';
+		char transB = 'N';
+		int M = numOrbitalPairs*numEnergies;
+		int N = numOrbitalPairs;
+		int K = currentBlockSize*numOrbitals;
+		complex<double> alpha = -1./mesh.size();
+		complex<double> beta = 1.;
+		int lda = numOrbitalPairs*numEnergies;
+		int ldb = currentBlockSize*numOrbitals;
+		int ldc = numOrbitalPairs*numEnergies;
+		zgemm_(
+			&transA,
+			&transB,
+			&M,
+			&N,
+			&K,
+			&alpha,
+			t.data(),
+			&lda,
+			p.data(),
+			&ldb,
+			&beta,
+			result.data(),
+			&ldc
+		);
+	}
+
+	//Reorder the result to the layout [o0][o1][o2][o3][E] and cache it.
+	vector<complex<double>> entry(numEnergies);
+	for(unsigned int o0 = 0; o0 < numOrbitals; o0++){
+		for(unsigned int o1 = 0; o1 < numOrbitals; o1++){
+			for(unsigned int o2 = 0; o2 < numOrbitals; o2++){
+				for(
+					unsigned int o3 = 0;
+					o3 < numOrbitals;
+					o3++
+				){
+					const complex<double> *source
+						= result.data()
+						+ numOrbitalPairs*(
+							numEnergies*(
+								numOrbitals*o3
+								+ o0
+							)
+						) + numOrbitals*o1 + o2;
+					complex<double> *destination
+						= susceptibilities.data()
+						+ numEnergies*(
+							numOrbitals*(
+								numOrbitals*(
+									numOrbitals*o0
+									+ o1
+								) + o2
+							) + o3
+						);
 					for(
 						unsigned int e = 0;
-						e < complexEnergies.size();
+						e < numEnergies;
 						e++
 					){
-						//
-						complex<double> E = complexEnergies[e];
-						result[
-							complexEnergyIndices[e]
-						] -= numerator/(E + e2 - e1);
+						destination[e] = source[
+							numOrbitalPairs*e
+						];
 					}
+
+					entry.assign(
+						destination,
+						destination + numEnergies
+					);
+					cacheSusceptibility(
+						entry,
+						k,
+						{(int)o0, (int)o1, (int)o2, (int)o3},
+						kIndex
+					);
 				}
 			}
 		}
 	}
 
-	//Normalize result.
-	for(unsigned int n = 0; n < energies.size(); n++)
-		result[n] /= mesh.size();
-
-	//Cashe result
-	cacheSusceptibility(
-		result,
-		k,
-		orbitalIndices,
-		kIndex,
-		resultIndex
-	);
-
-	return result;
+	return susceptibilities;
 }
 
 complex<double> LindhardSusceptibilityCalculator::calculateSusceptibility(
@@ -616,45 +623,17 @@ vector<complex<double>> LindhardSusceptibilityCalculator::calculateSusceptibilit
 		""
 	);
 
-	if(getKPlusQLookupTable() != nullptr){
-		if(getSusceptibilityIsSafeFromPoles()){
-			return calculateSusceptibilityLindhard<
-				true,
-				true
-			>(
-				kDual,
-				orbitalIndices
-			);
-		}
-		else{
-			return calculateSusceptibilityLindhard<
-				true,
-				false
-			>(
-				kDual,
-				orbitalIndices
-			);
-		}
+	if(getSusceptibilityIsSafeFromPoles()){
+		return calculateSusceptibilityLindhard<true>(
+			kDual,
+			orbitalIndices
+		);
 	}
 	else{
-		if(getSusceptibilityIsSafeFromPoles()){
-			return calculateSusceptibilityLindhard<
-				false,
-				true
-			>(
-				kDual,
-				orbitalIndices
-			);
-		}
-		else{
-			return calculateSusceptibilityLindhard<
-				false,
-				false
-			>(
-				kDual,
-				orbitalIndices
-			);
-		}
+		return calculateSusceptibilityLindhard<false>(
+			kDual,
+			orbitalIndices
+		);
 	}
 }
 
@@ -18,8 +18,13 @@
  *  @author Kristofer Björnson
  */
 
+#include "TBTK/DiscreteLehmannRepresentation.h"
 #include "TBTK/RPA/MatsubaraSusceptibilityCalculator.h"
 
+#ifdef TBTK_USE_FFTW3
+#	include "TBTK/MatsubaraConvolver.h"
+#endif
+
 #include <complex>
 #include <iomanip>
 
@@ -35,31 +40,64 @@ MatsubaraSusceptibilityCalculator::MatsubaraSusceptibilityCalculator(
 	SusceptibilityCalculator(Algorithm::Matsubara, momentumSpaceContext)
 {
 	greensFunction = nullptr;
-}
-
-MatsubaraSusceptibilityCalculator::MatsubaraSusceptibilityCalculator(
-	const MomentumSpaceContext &momentumSpaceContext,
-	int *kPlusQLookupTable
-) :
-	SusceptibilityCalculator(
-		Algorithm::Matsubara,
-		momentumSpaceContext,
-		kPlusQLookupTable
-	)
-{
-	greensFunction = nullptr;
+	useFFTConvolution = false;
+	convolver = nullptr;
+	useDiscreteLehmannRepresentation = false;
+	discreteLehmannRepresentationTolerance = 1e-10;
+	discreteLehmannRepresentation = nullptr;
 }
 
 MatsubaraSusceptibilityCalculator::~MatsubaraSusceptibilityCalculator(){
-	if(greensFunction != nullptr)
-		delete [] greensFunction;
+	clearGreensFunction();
 }
 
 MatsubaraSusceptibilityCalculator* MatsubaraSusceptibilityCalculator::createSlave(){
-	return new MatsubaraSusceptibilityCalculator(
-		getMomentumSpaceContext(),
-		getKPlusQLookupTable()
+	MatsubaraSusceptibilityCalculator *slave
+		= new MatsubaraSusceptibilityCalculator(
+			getMomentumSpaceContext()
+		);
+	slave->summationEnergies = summationEnergies;
+	slave->useFFTConvolution = useFFTConvolution;
+	slave->useDiscreteLehmannRepresentation
+		= useDiscreteLehmannRepresentation;
+	slave->discreteLehmannRepresentationTolerance
+		= discreteLehmannRepresentationTolerance;
+
+	return slave;
+}
+
+void MatsubaraSusceptibilityCalculator::setUseFFTConvolution(
+	bool useFFTConvolution
+){
+#ifndef TBTK_USE_FFTW3
+	TBTKAssert(
+		!useFFTConvolution,
+		"MatsubaraSusceptibilityCalculator::setUseFFTConvolution()",
+		"TBTK is built without FFTW3.",
+		"Install FFTW3 and rebuild TBTK to use FFT convolution."
 	);
+#endif
+
+	this->useFFTConvolution = useFFTConvolution;
+}
+
+void MatsubaraSusceptibilityCalculator::setUseDiscreteLehmannRepresentation(
+	bool useDiscreteLehmannRepresentation,
+	double tolerance
+){
+	TBTKAssert(
+		tolerance > 0 && tolerance < 1,
+		"MatsubaraSusceptibilityCalculator::setUseDiscreteLehmannRepresentation()",
+		"'tolerance' must be between zero and one.",
+		""
+	);
+
+	this->useDiscreteLehmannRepresentation
+		= useDiscreteLehmannRepresentation;
+	discreteLehmannRepresentationTolerance = tolerance;
+
+	clearCache();
+	clearGreensFunction();
 }
 
 complex<double> MatsubaraSusceptibilityCalculator::calculateSusceptibility(
@@ -94,18 +132,7 @@ vector<complex<double>> MatsubaraSusceptibilityCalculator::calculateSusceptibili
 		""
 	);
 
-	if(getKPlusQLookupTable() != nullptr){
-		return calculateSusceptibilityMatsubara<true>(
-			kDual,
-			orbitalIndices
-		);
-	}
-	else{
-		return calculateSusceptibilityMatsubara<false>(
-			kDual,
-			orbitalIndices
-		);
-	}
+	return calculateSusceptibilityMatsubara(kDual, orbitalIndices);
 }
 
 complex<double> MatsubaraSusceptibilityCalculator::calculateSusceptibilityMatsubara(
@@ -118,7 +145,6 @@ complex<double> MatsubaraSusceptibilityCalculator::calculateSusceptibilityMatsub
 	);
 }
 
-template<bool useKPlusQLookupTable>
 vector<complex<double>> MatsubaraSusceptibilityCalculator::calculateSusceptibilityMatsubara(
 	const DualIndex &kDual,
 	const vector<int> &orbitalIndices
@@ -131,44 +157,46 @@ vector<complex<double>> MatsubaraSusceptibilityCalculator::calculateSusceptibili
 		""
 	);*/
 
-	//Get kIndex and resultIndex
+	//Get kIndex
 	const vector<double> &k = kDual;
 	const Index &kIndex = kDual;
-	Index resultIndex = getSusceptibilityResultIndex(
+
+	//Try to return cashed result
+	const vector<complex<double>> &energies = getEnergies();
+	const complex<double> *cachedResult = getCachedSusceptibility(
 		kIndex,
 		orbitalIndices
 	);
+	if(cachedResult != nullptr){
+		return vector<complex<double>>(
+			cachedResult,
+			cachedResult + energies.size()
+		);
+	}
 
-	//Try to return cashed result
-	SerializeableVector<complex<double>> result;
-	if(getSusceptibilityTree().get(result, resultIndex))
-		return result;
+	if(useDiscreteLehmannRepresentation)
+		return calculateSusceptibilityDLR(kDual, orbitalIndices);
+	if(useFFTConvolution)
+		return calculateSusceptibilityFFT(kDual, orbitalIndices);
 
-	const vector<complex<double>> &energies = getEnergies();
-	for(unsigned int n = 0; n < energies.size(); n++)
-		result.push_back(0);
+	vector<complex<double>> result(energies.size(), 0.);
 
 	calculateGreensFunction();
 
 	const MomentumSpaceContext &momentumSpaceContext = getMomentumSpaceContext();
 	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
 	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
-	const Model &model = momentumSpaceContext.getModel();
 
-	//Get linear index corresponding to kIndex.
-	int kLinearIndex = model.getHoppingAmplitudeSet()->getFirstIndexInBlock(
-		kIndex
-	);
+	//Get mesh point corresponding to kIndex.
+	unsigned int kMeshPoint = momentumSpaceContext.getMeshPoint(kIndex);
 
 	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
-		//Get linear index corresponding to k+q
-		int kPlusQLinearIndex = getKPlusQLinearIndex<useKPlusQLookupTable>(
-			meshPoint,
-			k,
-			kLinearIndex
-		);
-
-		int kPlusQMeshPoint = kPlusQLinearIndex/momentumSpaceContext.getNumOrbitals();
+		//Get mesh point corresponding to k+q
+		unsigned int kPlusQMeshPoint
+			= momentumSpaceContext.getKPlusQMeshPoint(
+				meshPoint,
+				kMeshPoint
+			);
 
 		for(unsigned int e = 0; e < energies.size(); e++){
 			for(unsigned int n = 0; n < summationEnergies.size(); n++){
@@ -218,13 +246,201 @@ vector<complex<double>> MatsubaraSusceptibilityCalculator::calculateSusceptibili
 		result,
 		k,
 		orbitalIndices,
-		kIndex,
-		resultIndex
+		kIndex
+	);
+
+	return result;
+}
+
+#ifdef TBTK_USE_FFTW3
+vector<complex<double>> MatsubaraSusceptibilityCalculator::calculateSusceptibilityFFT(
+	const DualIndex &kDual,
+	const vector<int> &orbitalIndices
+){
+	calculateGreensFunction();
+
+	const MomentumSpaceContext &momentumSpaceContext = getMomentumSpaceContext();
+	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
+	const vector<unsigned int> &numMeshPoints
+		= momentumSpaceContext.getNumMeshPoints();
+	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
+	const vector<complex<double>> &energies = getEnergies();
+
+	if(
+		convolver != nullptr
+		&& convolver->getNumOutputEnergies() != energies.size()
+	){
+		delete convolver;
+		convolver = nullptr;
+	}
+	if(convolver == nullptr){
+		convolver = new MatsubaraConvolver(
+			numMeshPoints,
+			numOrbitals*numOrbitals,
+			summationEnergies.size(),
+			energies.size()
+		);
+		convolver->setFunctions(greensFunction);
+	}
+
+	//The Green's function is stored on the layout
+	//[meshPoint][orbital0][orbital1][energy], where the mesh points are
+	//ordered row major in the integer mesh coordinates.
+	vector<complex<double>> correlation(mesh.size()*energies.size());
+	convolver->correlate(
+		numOrbitals*orbitalIndices[3] + orbitalIndices[0],
+		numOrbitals*orbitalIndices[1] + orbitalIndices[2],
+		correlation.data()
+	);
+
+	double temperature = UnitHandler::convertTemperatureNtB(
+		momentumSpaceContext.getModel().getTemperature()
+	);
+	double kT = UnitHandler::getK_BB()*temperature;
+
+	const Index &kIndex = kDual;
+	unsigned int kLinearIndex = 0;
+	for(unsigned int n = 0; n < numMeshPoints.size(); n++)
+		kLinearIndex = kLinearIndex*numMeshPoints[n] + kIndex[n];
+
+	vector<complex<double>> requestedResult;
+	vector<int> coordinates(numMeshPoints.size(), 0);
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		vector<complex<double>> result(energies.size());
+		for(unsigned int e = 0; e < energies.size(); e++){
+			result[e] = -correlation[energies.size()*meshPoint + e]
+				/(mesh.size()*kT);
+		}
+
+		Index qIndex(coordinates);
+		cacheSusceptibility(
+			result,
+			mesh[meshPoint],
+			orbitalIndices,
+			qIndex
+		);
+		if(meshPoint == kLinearIndex)
+			requestedResult = result;
+
+		for(int n = numMeshPoints.size() - 1; n >= 0; n--){
+			coordinates[n]++;
+			if(coordinates[n] < (int)numMeshPoints[n])
+				break;
+			coordinates[n] = 0;
+		}
+	}
+
+	return requestedResult;
+}
+#else
+vector<complex<double>> MatsubaraSusceptibilityCalculator::calculateSusceptibilityFFT(
+	const DualIndex &/*kDual*/,
+	const vector<int> &/*orbitalIndices*/
+){
+	TBTKExit(
+		"MatsubaraSusceptibilityCalculator::calculateSusceptibilityFFT()",
+		"TBTK is built without FFTW3.",
+		"Install FFTW3 and rebuild TBTK to use FFT convolution."
+	);
+}
+#endif
+
+vector<complex<double>> MatsubaraSusceptibilityCalculator::calculateSusceptibilityDLR(
+	const DualIndex &kDual,
+	const vector<int> &orbitalIndices
+){
+	calculateGreensFunctionCoefficients();
+
+	const MomentumSpaceContext &momentumSpaceContext = getMomentumSpaceContext();
+	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
+	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
+	const vector<complex<double>> &energies = getEnergies();
+	unsigned int rank = discreteLehmannRepresentation->getRank();
+
+	const Index &kIndex = kDual;
+	unsigned int kMeshPoint = momentumSpaceContext.getMeshPoint(kIndex);
+
+	//The susceptibility is -1/(NkT)\sum_{k}\sum_{n}G(k, i\omega_n)
+	//G(k+q, i\omega_n + i\nu_s), with s = e - energies.size()/2, which
+	//agrees with the sum over the summation energies in
+	//calculateSusceptibilityMatsubara(). Sum the outer products of the
+	//coefficients of G(k) and G(k+q) over k. The Matsubara sum is then a
+	//contraction of the result with the correlation weights for each
+	//energy.
+	vector<complex<double>> coefficientProducts(rank*rank, 0.);
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		unsigned int kPlusQMeshPoint
+			= momentumSpaceContext.getKPlusQMeshPoint(
+				meshPoint,
+				kMeshPoint
+			);
+
+		const complex<double> *a = &greensFunctionCoefficients[
+			rank*(
+				numOrbitals*(numOrbitals*meshPoint + orbitalIndices[3])
+				+ orbitalIndices[0]
+			)
+		];
+		const complex<double> *b = &greensFunctionCoefficients[
+			rank*(
+				numOrbitals*(
+					numOrbitals*kPlusQMeshPoint
+					+ orbitalIndices[1]
+				) + orbitalIndices[2]
+			)
+		];
+		for(unsigned int l = 0; l < rank; l++)
+			for(unsigned int m = 0; m < rank; m++)
+				coefficientProducts[rank*l + m] += a[l]*b[m];
+	}
+
+	double temperature = UnitHandler::convertTemperatureNtB(
+		momentumSpaceContext.getModel().getTemperature()
+	);
+	double kT = UnitHandler::getK_BB()*temperature;
+
+	//The correlation weights include a factor kT.
+	vector<complex<double>> result(energies.size(), 0.);
+	vector<complex<double>> weights(rank*rank);
+	for(unsigned int e = 0; e < energies.size(); e++){
+		int s = (int)e - (int)energies.size()/2;
+		discreteLehmannRepresentation->getCorrelationWeights(
+			complex<double>(0, 2*M_PI*s*kT),
+			weights.data()
+		);
+		for(unsigned int n = 0; n < rank*rank; n++)
+			result[e] -= coefficientProducts[n]*weights[n];
+		result[e] /= mesh.size()*kT*kT;
+	}
+
+	cacheSusceptibility(
+		result,
+		kDual,
+		orbitalIndices,
+		kIndex
 	);
 
 	return result;
 }
 
+void MatsubaraSusceptibilityCalculator::clearGreensFunction(){
+	if(greensFunction != nullptr){
+		delete [] greensFunction;
+		greensFunction = nullptr;
+	}
+	if(discreteLehmannRepresentation != nullptr){
+		delete discreteLehmannRepresentation;
+		discreteLehmannRepresentation = nullptr;
+	}
+	greensFunctionCoefficients.clear();
+#ifdef TBTK_USE_FFTW3
+	if(convolver != nullptr){
+		delete convolver;
+		convolver = nullptr;
+	}
+#endif
+}
+
 void MatsubaraSusceptibilityCalculator::calculateGreensFunction(){
 	if(greensFunction != nullptr)
 		return;
@@ -240,6 +456,8 @@ void MatsubaraSusceptibilityCalculator::calculateGreensFunction(){
 	const MomentumSpaceContext &momentumSpaceContext = getMomentumSpaceContext();
 	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
 	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
+	double chemicalPotential
+		= momentumSpaceContext.getModel().getChemicalPotential();
 
 	greensFunction = new complex<double>[
 		mesh.size()*numOrbitals*numOrbitals*summationEnergies.size()
@@ -258,7 +476,7 @@ void MatsubaraSusceptibilityCalculator::calculateGreensFunction(){
 			double energy = momentumSpaceContext.getEnergy(
 				meshPoint,
 				state
-			);
+			) - chemicalPotential;
 			for(
 				unsigned int orbital0 = 0;
 				orbital0 < numOrbitals;
@@ -299,4 +517,105 @@ void MatsubaraSusceptibilityCalculator::calculateGreensFunction(){
 	}
 }
 
+void MatsubaraSusceptibilityCalculator::calculateGreensFunctionCoefficients(){
+	if(discreteLehmannRepresentation != nullptr)
+		return;
+
+	const MomentumSpaceContext &momentumSpaceContext = getMomentumSpaceContext();
+	const Model &model = momentumSpaceContext.getModel();
+	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
+	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
+	double chemicalPotential = model.getChemicalPotential();
+
+	double temperature = UnitHandler::convertTemperatureNtB(
+		model.getTemperature()
+	);
+	double kT = UnitHandler::getK_BB()*temperature;
+
+	//The representation has to cover every pole of the Green's function.
+	double energyCutoff = kT;
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		for(unsigned int state = 0; state < numOrbitals; state++){
+			energyCutoff = max(
+				energyCutoff,
+				abs(
+					momentumSpaceContext.getEnergy(
+						meshPoint,
+						state
+					) - chemicalPotential
+				)
+			);
+		}
+	}
+	discreteLehmannRepresentation = new DiscreteLehmannRepresentation(
+		Statistics::FermiDirac,
+		kT,
+		1.1*energyCutoff,
+		discreteLehmannRepresentationTolerance
+	);
+
+	//Evaluate the Green's function at the interpolation frequencies and
+	//fit the coefficients.
+	const vector<int> &interpolationIndices
+		= discreteLehmannRepresentation->getInterpolationIndices();
+	unsigned int rank = discreteLehmannRepresentation->getRank();
+	unsigned int numFunctions = mesh.size()*numOrbitals*numOrbitals;
+	vector<complex<double>> values(numFunctions*rank, 0.);
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for
+#endif
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		for(unsigned int state = 0; state < numOrbitals; state++){
+			double energy = momentumSpaceContext.getEnergy(
+				meshPoint,
+				state
+			) - chemicalPotential;
+			for(
+				unsigned int orbital0 = 0;
+				orbital0 < numOrbitals;
+				orbital0++
+			){
+				complex<double> a0 = momentumSpaceContext.getAmplitude(
+					meshPoint,
+					state,
+					orbital0
+				);
+				for(
+					unsigned int orbital1 = 0;
+					orbital1 < numOrbitals;
+					orbital1++
+				){
+					complex<double> a1 = momentumSpaceContext.getAmplitude(
+						meshPoint,
+						state,
+						orbital1
+					);
+					complex<double> *destination = &values[
+						rank*(
+							numOrbitals*(
+								numOrbitals*meshPoint
+								+ orbital0
+							) + orbital1
+						)
+					];
+					for(unsigned int n = 0; n < rank; n++){
+						destination[n] += a0*conj(a1)/(
+							discreteLehmannRepresentation->getMatsubaraEnergy(
+								interpolationIndices[n]
+							) - energy
+						);
+					}
+				}
+			}
+		}
+	}
+
+	greensFunctionCoefficients.resize(numFunctions*rank);
+	discreteLehmannRepresentation->fit(
+		values.data(),
+		greensFunctionCoefficients.data(),
+		numFunctions
+	);
+}
+
 }	//End of namesapce TBTK
@@ -20,16 +20,20 @@
 
 #include "TBTK/RPA/MomentumSpaceContext.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace TBTK{
 
 MomentumSpaceContext::MomentumSpaceContext(){
+	model = nullptr;
 	brillouinZone = nullptr;
 	numOrbitals = 0;
 	propertyExtractor = nullptr;
 	energies = nullptr;
 	amplitudes = nullptr;
+	detectSymmetryOperations = false;
 	isInitialized = false;
 }
 
@@ -91,6 +95,94 @@ void MomentumSpaceContext::init(){
 		<< " are set using MomentumSpaceContext::setNumOrbitals()."
 	);
 
+	if(energies != nullptr)
+		delete [] energies;
+	energies = new double[model->getBasisSize()];
+
+	if(amplitudes != nullptr)
+		delete [] amplitudes;
+	amplitudes = new complex<double>[model->getBasisSize()*numOrbitals];
+
+	//Store the integer coordinates of every mesh point together with a
+	//lookup table from the coordinates back to the mesh point. This
+	//allows k+q and k-q to be calculated using modular arithmetic.
+	meshPointCoordinates.assign(mesh.size()*numMeshPoints.size(), 0);
+	meshPointLookupTable.assign(mesh.size(), mesh.size());
+
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		Index kIndex = brillouinZone->getMinorCellIndex(
+			mesh.at(meshPoint),
+			numMeshPoints
+		);
+
+		unsigned int linearIndex = 0;
+		for(unsigned int n = 0; n < numMeshPoints.size(); n++){
+			meshPointCoordinates[numMeshPoints.size()*meshPoint + n]
+				= kIndex[n];
+			linearIndex = numMeshPoints[n]*linearIndex + kIndex[n];
+		}
+		TBTKAssert(
+			meshPointLookupTable[linearIndex] == mesh.size(),
+			"MomentumSpaceContext::init()",
+			"Found two mesh points with the same Index "
+			<< kIndex.toString() << ".",
+			"This should never happen, contact the developer."
+		);
+		meshPointLookupTable[linearIndex] = meshPoint;
+	}
+
+	if(symmetryOperationGenerators.size() == 0 && !detectSymmetryOperations)
+		diagonalizeAllMeshPoints();
+	else
+		diagonalizeIrreducibleMeshPoints();
+
+	isInitialized = true;
+}
+
+void MomentumSpaceContext::addSymmetryOperation(
+	const vector<vector<int>> &rotation,
+	const vector<vector<complex<double>>> &orbitalRepresentation
+){
+	vector<int> rotationMatrix;
+	for(unsigned int row = 0; row < rotation.size(); row++){
+		TBTKAssert(
+			rotation[row].size() == rotation.size(),
+			"MomentumSpaceContext::addSymmetryOperation()",
+			"The rotation must be a square matrix.",
+			""
+		);
+		for(unsigned int col = 0; col < rotation[row].size(); col++)
+			rotationMatrix.push_back(rotation[row][col]);
+	}
+
+	vector<complex<double>> representationMatrix;
+	for(unsigned int row = 0; row < orbitalRepresentation.size(); row++){
+		TBTKAssert(
+			orbitalRepresentation[row].size()
+				== orbitalRepresentation.size(),
+			"MomentumSpaceContext::addSymmetryOperation()",
+			"The orbital representation must be a square matrix.",
+			""
+		);
+		for(
+			unsigned int col = 0;
+			col < orbitalRepresentation[row].size();
+			col++
+		){
+			representationMatrix.push_back(
+				orbitalRepresentation[row][col]
+			);
+		}
+	}
+
+	symmetryOperationGenerators.push_back(
+		make_pair(rotationMatrix, representationMatrix)
+	);
+
+	isInitialized = false;
+}
+
+void MomentumSpaceContext::diagonalizeAllMeshPoints(){
 	Timer::tick("Diagonalize");
 	solver = Solver::BlockDiagonalizer();
 	solver.setModel(*model);
@@ -101,18 +193,9 @@ void MomentumSpaceContext::init(){
 		delete propertyExtractor;
 	propertyExtractor = new PropertyExtractor::BlockDiagonalizer(solver);
 
-	if(energies != nullptr)
-		delete [] energies;
-	energies = new double[model->getBasisSize()];
-
-	if(amplitudes != nullptr)
-		delete [] amplitudes;
-	amplitudes = new complex<double>[model->getBasisSize()*numOrbitals];
-
 	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
-		vector<double> k = mesh.at(meshPoint);
 		Index kIndex = brillouinZone->getMinorCellIndex(
-			k,
+			mesh.at(meshPoint),
 			numMeshPoints
 		);
 
@@ -147,7 +230,558 @@ void MomentumSpaceContext::init(){
 		}
 	}
 
-	isInitialized = true;
+	//Only the identity.
+	unsigned int dimension = numMeshPoints.size();
+	symmetryRotations.assign(dimension*dimension, 0);
+	for(unsigned int n = 0; n < dimension; n++)
+		symmetryRotations[dimension*n + n] = 1;
+	orbitalRepresentations.assign(numOrbitals*numOrbitals, 0.);
+	for(unsigned int n = 0; n < numOrbitals; n++)
+		orbitalRepresentations[numOrbitals*n + n] = 1.;
+
+	irreducibleMeshPoints.clear();
+	representativeMeshPoints.clear();
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		irreducibleMeshPoints.push_back(meshPoint);
+		representativeMeshPoints.push_back(meshPoint);
+	}
+	meshPointSymmetryOperations.assign(mesh.size(), 0);
+}
+
+extern "C" {
+	void zheev_(
+		char *jobz,
+		char *uplo,
+		int *n,
+		complex<double> *a,
+		int *lda,
+		double *w,
+		complex<double> *work,
+		int *lwork,
+		double *rwork,
+		int *info
+	);
+}
+
+void MomentumSpaceContext::diagonalizeIrreducibleMeshPoints(){
+	if(propertyExtractor != nullptr){
+		delete propertyExtractor;
+		propertyExtractor = nullptr;
+	}
+
+	unsigned int dimension = numMeshPoints.size();
+	unsigned int rotationSize = dimension*dimension;
+	unsigned int representationSize = numOrbitals*numOrbitals;
+
+	//Start from the identity.
+	symmetryRotations.assign(rotationSize, 0);
+	for(unsigned int n = 0; n < dimension; n++)
+		symmetryRotations[dimension*n + n] = 1;
+	orbitalRepresentations.assign(representationSize, 0.);
+	for(unsigned int n = 0; n < numOrbitals; n++)
+		orbitalRepresentations[numOrbitals*n + n] = 1.;
+
+	//Reduces the elements of a rotation modulo the mesh size. This gives
+	//a unique representation of rotations that act identically on the
+	//mesh.
+	auto reduceRotation = [this, dimension](vector<int> &rotation){
+		for(unsigned int row = 0; row < dimension; row++){
+			for(unsigned int col = 0; col < dimension; col++){
+				int size = numMeshPoints[col];
+				int &element = rotation[dimension*row + col];
+				element = (element%size + size)%size;
+			}
+		}
+	};
+
+	//Adds a symmetry operation unless an operation with the same action
+	//on the mesh already exists. Returns true if the operation was added.
+	auto addOperation = [&](
+		vector<int> rotation,
+		const vector<complex<double>> &representation
+	){
+		reduceRotation(rotation);
+		unsigned int numOperations
+			= symmetryRotations.size()/rotationSize;
+		for(unsigned int n = 0; n < numOperations; n++){
+			if(
+				equal(
+					rotation.begin(),
+					rotation.end(),
+					symmetryRotations.begin() + rotationSize*n
+				)
+			){
+				return false;
+			}
+		}
+
+		symmetryRotations.insert(
+			symmetryRotations.end(),
+			rotation.begin(),
+			rotation.end()
+		);
+		orbitalRepresentations.insert(
+			orbitalRepresentations.end(),
+			representation.begin(),
+			representation.end()
+		);
+
+		return true;
+	};
+
+	for(unsigned int n = 0; n < symmetryOperationGenerators.size(); n++){
+		const vector<int> &rotation
+			= symmetryOperationGenerators[n].first;
+		vector<complex<double>> representation
+			= symmetryOperationGenerators[n].second;
+		TBTKAssert(
+			rotation.size() == rotationSize,
+			"MomentumSpaceContext::init()",
+			"The rotation of symmetry operation " << n << " has"
+			<< " the wrong dimension. The mesh has " << dimension
+			<< " dimensions.",
+			""
+		);
+		if(representation.size() == 0){
+			representation.assign(representationSize, 0.);
+			for(unsigned int c = 0; c < numOrbitals; c++)
+				representation[numOrbitals*c + c] = 1.;
+		}
+		TBTKAssert(
+			representation.size() == representationSize,
+			"MomentumSpaceContext::init()",
+			"The orbital representation of symmetry operation "
+			<< n << " has the wrong dimension. The number of"
+			<< " orbitals is " << numOrbitals << ".",
+			""
+		);
+		TBTKAssert(
+			isCompatibleWithMesh(rotation.data()),
+			"MomentumSpaceContext::init()",
+			"The rotation of symmetry operation " << n << " does"
+			<< " not map the mesh onto itself.",
+			"Make sure the number of mesh points is the same"
+			<< " along directions that are related by symmetry."
+		);
+
+		addOperation(rotation, representation);
+	}
+
+	if(detectSymmetryOperations){
+		vector<complex<double>> identity(representationSize, 0.);
+		for(unsigned int n = 0; n < numOrbitals; n++)
+			identity[numOrbitals*n + n] = 1.;
+
+		vector<vector<int>> rotations = detectSymmetryRotations();
+		for(unsigned int n = 0; n < rotations.size(); n++)
+			addOperation(rotations[n], identity);
+	}
+
+	//Complete the group by adding products of symmetry operations until
+	//no new operations appear.
+	bool operationAdded = true;
+	while(operationAdded){
+		operationAdded = false;
+		unsigned int numOperations
+			= symmetryRotations.size()/rotationSize;
+		for(unsigned int a = 0; a < numOperations; a++){
+			for(unsigned int b = 0; b < numOperations; b++){
+				vector<int> rotation(rotationSize, 0);
+				for(unsigned int r = 0; r < dimension; r++){
+					for(unsigned int c = 0; c < dimension; c++){
+						for(
+							unsigned int n = 0;
+							n < dimension;
+							n++
+						){
+							rotation[dimension*r + c]
+								+= symmetryRotations[
+									rotationSize*a
+									+ dimension*r
+									+ n
+								]*symmetryRotations[
+									rotationSize*b
+									+ dimension*n
+									+ c
+								];
+						}
+					}
+				}
+
+				vector<complex<double>> representation(
+					representationSize,
+					0.
+				);
+				for(unsigned int r = 0; r < numOrbitals; r++){
+					for(
+						unsigned int c = 0;
+						c < numOrbitals;
+						c++
+					){
+						for(
+							unsigned int n = 0;
+							n < numOrbitals;
+							n++
+						){
+							representation[
+								numOrbitals*r
+								+ c
+							] += orbitalRepresentations[
+								representationSize*a
+								+ numOrbitals*r
+								+ n
+							]*orbitalRepresentations[
+								representationSize*b
+								+ numOrbitals*n
+								+ c
+							];
+						}
+					}
+				}
+
+				if(addOperation(rotation, representation))
+					operationAdded = true;
+			}
+		}
+	}
+
+	//Divide the mesh into stars of symmetry related mesh points.
+	unsigned int numOperations = getNumSymmetryOperations();
+	irreducibleMeshPoints.clear();
+	representativeMeshPoints.assign(mesh.size(), mesh.size());
+	meshPointSymmetryOperations.assign(mesh.size(), 0);
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		if(representativeMeshPoints[meshPoint] != mesh.size())
+			continue;
+
+		irreducibleMeshPoints.push_back(meshPoint);
+		for(unsigned int n = 0; n < numOperations; n++){
+			unsigned int image = applySymmetryOperation(n, meshPoint);
+			if(representativeMeshPoints[image] == mesh.size()){
+				representativeMeshPoints[image] = meshPoint;
+				meshPointSymmetryOperations[image] = n;
+			}
+		}
+	}
+
+	//Diagonalize the Hamiltonian at the irreducible mesh points.
+	Timer::tick("Diagonalize");
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for schedule(dynamic)
+#endif
+	for(unsigned int n = 0; n < irreducibleMeshPoints.size(); n++){
+		unsigned int meshPoint = irreducibleMeshPoints[n];
+		vector<complex<double>> hamiltonian = getHamiltonian(meshPoint);
+
+		//The Hamiltonian is Hermitian, which means that the
+		//transpose of the row major matrix is its complex conjugate.
+		for(unsigned int c = 0; c < hamiltonian.size(); c++)
+			hamiltonian[c] = conj(hamiltonian[c]);
+
+		char jobz = 'V';
+		char uplo = 'U';
+		int size = numOrbitals;
+		int lwork = 2*numOrbitals;
+		vector<complex<double>> work(lwork);
+		vector<double> rwork(3*numOrbitals);
+		int info;
+		zheev_(
+			&jobz,
+			&uplo,
+			&size,
+			hamiltonian.data(),
+			&size,
+			energies + numOrbitals*meshPoint,
+			work.data(),
+			&lwork,
+			rwork.data(),
+			&info
+		);
+		TBTKAssert(
+			info == 0,
+			"MomentumSpaceContext::init()",
+			"Diagonalization failed. zheev returned info = "
+			<< info << ".",
+			""
+		);
+
+		//The eigenvectors are returned in the columns of the column
+		//major matrix, which is the layout [state][orbital] used for
+		//the amplitudes.
+		for(unsigned int c = 0; c < representationSize; c++){
+			amplitudes[representationSize*meshPoint + c]
+				= hamiltonian[c];
+		}
+	}
+	Timer::tock();
+
+	//Obtain the energies and amplitudes at the remaining mesh points by
+	//applying the orbital representations, and verify that the result
+	//is an eigenstate of the Hamiltonian.
+	vector<unsigned int> invalidOperations;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for schedule(dynamic)
+#endif
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		unsigned int representative
+			= representativeMeshPoints[meshPoint];
+		if(representative == meshPoint)
+			continue;
+
+		unsigned int operation = meshPointSymmetryOperations[meshPoint];
+		const complex<double> *representation
+			= getOrbitalRepresentation(operation);
+		for(unsigned int state = 0; state < numOrbitals; state++){
+			energies[numOrbitals*meshPoint + state]
+				= energies[numOrbitals*representative + state];
+
+			const complex<double> *source = amplitudes
+				+ representationSize*representative
+				+ numOrbitals*state;
+			complex<double> *destination = amplitudes
+				+ representationSize*meshPoint
+				+ numOrbitals*state;
+			for(unsigned int r = 0; r < numOrbitals; r++){
+				destination[r] = 0.;
+				for(unsigned int c = 0; c < numOrbitals; c++){
+					destination[r] += representation[
+						numOrbitals*r + c
+					]*source[c];
+				}
+			}
+		}
+
+		vector<complex<double>> hamiltonian = getHamiltonian(meshPoint);
+		double scale = 1;
+		for(unsigned int c = 0; c < hamiltonian.size(); c++)
+			scale = max(scale, abs(hamiltonian[c]));
+		for(unsigned int state = 0; state < numOrbitals; state++){
+			const complex<double> *amplitude = amplitudes
+				+ representationSize*meshPoint
+				+ numOrbitals*state;
+			double energy = energies[numOrbitals*meshPoint + state];
+			for(unsigned int r = 0; r < numOrbitals; r++){
+				complex<double> residual = -energy*amplitude[r];
+				for(unsigned int c = 0; c < numOrbitals; c++){
+					residual += hamiltonian[
+						numOrbitals*r + c
+					]*amplitude[c];
+				}
+				if(abs(residual) > 1e-8*scale){
+#ifdef TBTK_USE_OPEN_MP
+					#pragma omp critical (TBTK_MOMENTUM_SPACE_CONTEXT)
+#endif
+					invalidOperations.push_back(operation);
+					break;
+				}
+			}
+		}
+	}
+	TBTKAssert(
+		invalidOperations.size() == 0,
+		"MomentumSpaceContext::init()",
+		"The Model is not invariant under the symmetry operations.",
+		"Make sure the orbital representations satisfy"
+		<< " H(Rk) = UH(k)U^{\\dagger}."
+	);
+}
+
+vector<vector<int>> MomentumSpaceContext::detectSymmetryRotations(
+) const{
+	unsigned int dimension = numMeshPoints.size();
+	unsigned int rotationSize = dimension*dimension;
+
+	vector<vector<complex<double>>> hamiltonians;
+	double scale = 1;
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		hamiltonians.push_back(getHamiltonian(meshPoint));
+		for(unsigned int c = 0; c < hamiltonians.back().size(); c++)
+			scale = max(scale, abs(hamiltonians.back()[c]));
+	}
+
+	vector<vector<int>> rotations;
+	//Loop over all matrices with elements -1, 0, and 1.
+	unsigned int numCandidates = 1;
+	for(unsigned int n = 0; n < rotationSize; n++)
+		numCandidates *= 3;
+	for(unsigned int candidate = 0; candidate < numCandidates; candidate++){
+		vector<int> rotation(rotationSize);
+		unsigned int remainder = candidate;
+		for(unsigned int n = 0; n < rotationSize; n++){
+			rotation[n] = (int)(remainder%3) - 1;
+			remainder /= 3;
+		}
+
+		int determinant;
+		switch(dimension){
+		case 1:
+			determinant = rotation[0];
+			break;
+		case 2:
+			determinant = rotation[0]*rotation[3]
+				- rotation[1]*rotation[2];
+			break;
+		case 3:
+			determinant
+				= rotation[0]*(
+					rotation[4]*rotation[8]
+					- rotation[5]*rotation[7]
+				) - rotation[1]*(
+					rotation[3]*rotation[8]
+					- rotation[5]*rotation[6]
+				) + rotation[2]*(
+					rotation[3]*rotation[7]
+					- rotation[4]*rotation[6]
+				);
+			break;
+		default:
+			TBTKExit(
+				"MomentumSpaceContext::init()",
+				"Symmetry detection is only supported for one-,"
+				<< " two-, and three-dimensional meshes.",
+				""
+			);
+		}
+		if(abs(determinant) != 1)
+			continue;
+		if(!isCompatibleWithMesh(rotation.data()))
+			continue;
+
+		bool isSymmetry = true;
+		for(
+			unsigned int meshPoint = 0;
+			meshPoint < mesh.size() && isSymmetry;
+			meshPoint++
+		){
+			unsigned int image = applyRotation(
+				rotation.data(),
+				meshPoint
+			);
+			const vector<complex<double>> &hamiltonian
+				= hamiltonians[meshPoint];
+			const vector<complex<double>> &imageHamiltonian
+				= hamiltonians[image];
+			for(unsigned int c = 0; c < hamiltonian.size(); c++){
+				if(
+					abs(imageHamiltonian[c] - hamiltonian[c])
+					> 1e-10*scale
+				){
+					isSymmetry = false;
+					break;
+				}
+			}
+		}
+
+		if(isSymmetry)
+			rotations.push_back(rotation);
+	}
+
+	return rotations;
+}
+
+vector<complex<double>> MomentumSpaceContext::getHamiltonian(
+	unsigned int meshPoint
+) const{
+	vector<int> kSubindices;
+	for(unsigned int n = 0; n < numMeshPoints.size(); n++){
+		kSubindices.push_back(
+			meshPointCoordinates[numMeshPoints.size()*meshPoint + n]
+		);
+	}
+	Index kIndex(kSubindices);
+
+	const HoppingAmplitudeSet &hoppingAmplitudeSet
+		= *model->getHoppingAmplitudeSet();
+	HoppingAmplitudeSet::Iterator iterator
+		= hoppingAmplitudeSet.getIterator(kIndex);
+	int minBasisIndex = iterator.getMinBasisIndex();
+
+	//Lookup table from block local basis index to orbital.
+	vector<unsigned int> orbitals(numOrbitals);
+	for(unsigned int orbital = 0; orbital < numOrbitals; orbital++){
+		int basisIndex = hoppingAmplitudeSet.getBasisIndex(
+			Index(kIndex, {(int)orbital})
+		) - minBasisIndex;
+		TBTKAssert(
+			basisIndex >= 0 && basisIndex < (int)numOrbitals,
+			"MomentumSpaceContext::init()",
+			"Unable to find orbital " << orbital << " in block "
+			<< kIndex.toString() << ".",
+			""
+		);
+		orbitals[basisIndex] = orbital;
+	}
+
+	vector<complex<double>> hamiltonian(numOrbitals*numOrbitals, 0.);
+	const HoppingAmplitude *hoppingAmplitude;
+	while((hoppingAmplitude = iterator.getHA())){
+		int to = hoppingAmplitudeSet.getBasisIndex(
+			hoppingAmplitude->getToIndex()
+		) - minBasisIndex;
+		int from = hoppingAmplitudeSet.getBasisIndex(
+			hoppingAmplitude->getFromIndex()
+		) - minBasisIndex;
+		hamiltonian[numOrbitals*orbitals[to] + orbitals[from]]
+			+= hoppingAmplitude->getAmplitude();
+
+		iterator.searchNextHA();
+	}
+
+	return hamiltonian;
+}
+
+unsigned int MomentumSpaceContext::applyRotation(
+	const int *rotation,
+	unsigned int meshPoint
+) const{
+	unsigned int dimension = numMeshPoints.size();
+	const unsigned int *coordinates
+		= &meshPointCoordinates[dimension*meshPoint];
+
+	//The rotation acts on the reciprocal lattice coordinates
+	//coordinate/numMeshPoints.
+	unsigned int linearIndex = 0;
+	for(unsigned int row = 0; row < dimension; row++){
+		long long size = numMeshPoints[row];
+		long long coordinate = 0;
+		for(unsigned int col = 0; col < dimension; col++){
+			coordinate += rotation[dimension*row + col]
+				*(long long)numMeshPoints[row]
+				/(long long)numMeshPoints[col]
+				*coordinates[col];
+		}
+		coordinate = (coordinate%size + size)%size;
+
+		linearIndex = numMeshPoints[row]*linearIndex + coordinate;
+	}
+
+	return meshPointLookupTable[linearIndex];
+}
+
+bool MomentumSpaceContext::isCompatibleWithMesh(const int *rotation) const{
+	unsigned int dimension = numMeshPoints.size();
+	for(unsigned int row = 0; row < dimension; row++){
+		for(unsigned int col = 0; col < dimension; col++){
+			long long element = rotation[dimension*row + col];
+			if(
+				(element*numMeshPoints[row])%numMeshPoints[col]
+				!= 0
+			){
+				return false;
+			}
+		}
+	}
+
+	//The rotation must be a bijection on the mesh.
+	vector<bool> isImage(mesh.size(), false);
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		unsigned int image = applyRotation(rotation, meshPoint);
+		if(isImage[image])
+			return false;
+		isImage[image] = true;
+	}
+
+	return true;
 }
 
 }	//End of namesapce TBTK
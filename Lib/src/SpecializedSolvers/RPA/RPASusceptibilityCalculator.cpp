@@ -18,6 +18,7 @@
  *  @author Kristofer Björnson
  */
 
+#include "TBTK/Exception.h"
 #include "TBTK/Functions.h"
 #include "TBTK/RPA/MatsubaraSusceptibilityCalculator.h"
 #include "TBTK/RPA/RPASusceptibilityCalculator.h"
@@ -25,6 +26,7 @@
 
 #include <complex>
 #include <iomanip>
+#include <sstream>
 
 using namespace std;
 
@@ -41,10 +43,12 @@ RPASusceptibilityCalculator::RPASusceptibilityCalculator(
 		susceptibilityCalculator = new LindhardSusceptibilityCalculator(
 			momentumSpaceContext
 		);
+		break;
 	case SusceptibilityCalculator::Algorithm::Matsubara:
 		susceptibilityCalculator = new MatsubaraSusceptibilityCalculator(
 			momentumSpaceContext
 		);
+		break;
 	default:
 		TBTKExit(
 			"RPASusceptibilityCalculator::RPASusceptibilityCalculator()",
@@ -91,59 +95,18 @@ RPASusceptibilityCalculator* RPASusceptibilityCalculator::createSlave(){
 }
 
 extern "C" {
-	void zgetrf_(
-		int* M,
+	void zgesv_(
 		int *N,
+		int *NRHS,
 		complex<double> *A,
 		int *lda,
 		int *ipiv,
-		int *info
-	);
-	void zgetri_(
-		int *N,
-		complex<double> *A,
-		int *lda,
-		int *ipiv,
-		complex<double> *work,
-		int *lwork,
+		complex<double> *B,
+		int *ldb,
 		int *info
 	);
 }
 
-inline void RPASusceptibilityCalculator::invertMatrix(
-	complex<double> *matrix,
-	unsigned int dimensions
-){
-	int numRows = dimensions;
-	int numCols = dimensions;
-
-	int *ipiv = new int[min(numRows, numCols)];
-	int lwork = numCols*numCols;
-	complex<double> *work = new complex<double>[lwork];
-	int info;
-
-	zgetrf_(&numRows, &numCols, matrix, &numRows, ipiv, &info);
-	zgetri_(&numRows, matrix, &numRows, ipiv, work, &lwork, &info);
-
-	delete [] ipiv;
-	delete [] work;
-}
-
-void RPASusceptibilityCalculator::multiplyMatrices(
-	complex<double> *matrix1,
-	complex<double> *matrix2,
-	complex<double> *result,
-	unsigned int dimensions
-){
-	for(unsigned int n = 0; n < dimensions*dimensions; n++)
-		result[n] = 0.;
-
-	for(unsigned int row = 0; row < dimensions; row++)
-		for(unsigned int col = 0; col < dimensions; col++)
-			for(unsigned int n = 0; n < dimensions; n++)
-				result[dimensions*col + row] += matrix1[dimensions*n + row]*matrix2[dimensions*col + n];
-}
-
 void printMatrix(complex<double> *matrix, unsigned int dimension){
 	for(unsigned int r = 0; r < dimension; r++){
 		for(unsigned int c = 0; c < dimension; c++){
@@ -171,30 +134,20 @@ vector<vector<vector<complex<double>>>> RPASusceptibilityCalculator::rpaSuscepti
 		= susceptibilityCalculator->getMomentumSpaceContext();
 	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
 	unsigned int matrixDimension = numOrbitals*numOrbitals;
-	//Denominator in the expression chi_RPA = chi_0/(1 - U\chi_0)
-	vector<complex<double>*> denominators;
-
-	//Initialize denominator matrices to unit matrices
-	for(
-		unsigned int e = 0;
-		e < energies.size();
-		e++
-	){
-		//Create denominator matrix
-		denominators.push_back(
-			new complex<double>[matrixDimension*matrixDimension]
-		);
-		//Initialize denominator matrices to unit matrices
-		for(
-			unsigned int c = 0;
-			c < matrixDimension*matrixDimension;
-			c++
-		){
-			denominators.at(e)[c] = 0.;
-		}
+	unsigned int matrixSize = matrixDimension*matrixDimension;
+	unsigned int numEnergies = energies.size();
+
+	//The RPA susceptibility is given by chi_RPA = chi_0(1 + U\chi_0)^{-1},
+	//where chi_0 is a row vector with elements chi_0(o0, o1, d, c) indexed
+	//by (c, d). Rather than inverting the denominator, the system
+	//(1 + U\chi_0)^T chi_RPA^T = chi_0^T is solved for every energy. The
+	//transposed denominators are stored contiguously on the layout
+	//[energy][row][col] (column major matrices) and initialized to unit
+	//matrices.
+	vector<complex<double>> denominators(numEnergies*matrixSize, 0.);
+	for(unsigned int e = 0; e < numEnergies; e++)
 		for(unsigned int c = 0; c < matrixDimension; c++)
-			denominators.at(e)[c*matrixDimension + c] = 1.;
-	}
+			denominators[matrixSize*e + matrixDimension*c + c] = 1.;
 
 	//Calculate denominator = (1 + U\chi_0)
 	for(unsigned int n = 0; n < interactionAmplitudes.size(); n++){
@@ -214,49 +167,27 @@ vector<vector<vector<complex<double>>>> RPASusceptibilityCalculator::rpaSuscepti
 			for(unsigned int d = 0; d < numOrbitals; d++){
 				int col = numOrbitals*c + d;
 
-				vector<complex<double>> susceptibility
-					= susceptibilityCalculator->calculateSusceptibility(
+				const complex<double> *susceptibility
+					= susceptibilityCalculator->getSusceptibilityData(
 						kDual,
 						{c1, a0, (int)d, (int)c}
 					);
-				for(
-					unsigned int i = 0;
-					i < energies.size();
-					i++
-				){
-					denominators.at(i)[
-						matrixDimension*col + row
-					] += amplitude*susceptibility.at(i);
+				for(unsigned int e = 0; e < numEnergies; e++){
+					denominators[
+						matrixSize*e
+						+ matrixDimension*row + col
+					] += amplitude*susceptibility[e];
 				}
 			}
 		}
 	}
 
-	//Calculate (1 + U\chi_0)^{-1}
-	for(unsigned int n = 0; n < energies.size(); n++)
-		invertMatrix(denominators.at(n), matrixDimension);
-
-	//Initialize \chi_RPA
-	vector<vector<vector<complex<double>>>> rpaSusceptibility;
-	for(unsigned int orbital2 = 0; orbital2 < numOrbitals; orbital2++){
-		rpaSusceptibility.push_back(vector<vector<complex<double>>>());
-		for(unsigned int orbital3 = 0; orbital3 < numOrbitals; orbital3++){
-			rpaSusceptibility[orbital2].push_back(vector<complex<double>>());
-			for(
-				unsigned int e = 0;
-				e < energies.size();
-				e++
-			){
-				rpaSusceptibility[orbital2][orbital3].push_back(0.);
-			}
-		}
-	}
-
-	//Calculate \chi_RPA = \chi_0/(1 + U\chi_0)
+	//Right hand sides on the layout [energy][(c, d)].
+	vector<complex<double>> solutions(numEnergies*matrixDimension);
 	for(unsigned int c = 0; c < numOrbitals; c++){
 		for(unsigned int d = 0; d < numOrbitals; d++){
-			vector<complex<double>> susceptibility
-				= susceptibilityCalculator->calculateSusceptibility(
+			const complex<double> *susceptibility
+				= susceptibilityCalculator->getSusceptibilityData(
 					kDual,
 					{
 						orbitalIndices.at(0),
@@ -265,28 +196,80 @@ vector<vector<vector<complex<double>>>> RPASusceptibilityCalculator::rpaSuscepti
 						(int)c
 					}
 				);
-			for(unsigned int orbital2 = 0; orbital2 < numOrbitals; orbital2++){
-				for(unsigned int orbital3 = 0; orbital3 < numOrbitals; orbital3++){
-					for(
-						unsigned int i = 0;
-						i < energies.size();
-						i++
-					){
-						rpaSusceptibility[orbital2][orbital3].at(i) += denominators.at(i)[
-							matrixDimension*(
-								numOrbitals*orbital2
-								+ orbital3
-							) + numOrbitals*c + d
-						]*susceptibility.at(i);
-					}
-				}
+			for(unsigned int e = 0; e < numEnergies; e++){
+				solutions[
+					matrixDimension*e + numOrbitals*c + d
+				] = susceptibility[e];
 			}
 		}
 	}
 
-	//Free memory allocated for denominators
-	for(unsigned int n = 0; n < energies.size(); n++)
-		delete [] denominators.at(n);
+	//Solve for \chi_RPA. The solutions replace the right hand sides.
+	vector<int> infos(numEnergies, 0);
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel
+#endif
+	{
+		vector<int> ipiv(matrixDimension);
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp for
+#endif
+		for(unsigned int e = 0; e < numEnergies; e++){
+			int N = matrixDimension;
+			int NRHS = 1;
+			int lda = matrixDimension;
+			int ldb = matrixDimension;
+			zgesv_(
+				&N,
+				&NRHS,
+				denominators.data() + matrixSize*e,
+				&lda,
+				ipiv.data(),
+				solutions.data() + matrixDimension*e,
+				&ldb,
+				&infos[e]
+			);
+		}
+	}
+	//A singular denominator signals a divergence of the RPA
+	//susceptibility, which the caller may want to handle, for example by
+	//reducing the interaction strength.
+	for(unsigned int e = 0; e < numEnergies; e++){
+		if(infos[e] != 0){
+			stringstream message;
+			message << "Unable to solve for the RPA susceptibility"
+				<< " at energy " << energies[e] << ". zgesv"
+				<< " returned info = " << infos[e] << ".";
+			throw Exception(
+				"RPASusceptibilityCalculator::rpaSusceptibilityMainAlgorithm()",
+				TBTKWhere,
+				message.str(),
+				"The denominator is singular, which signals a"
+				" divergence of the RPA susceptibility."
+			);
+		}
+	}
+
+	//Reorder \chi_RPA to the layout [orbital2][orbital3][energy].
+	vector<vector<vector<complex<double>>>> rpaSusceptibility(
+		numOrbitals,
+		vector<vector<complex<double>>>(
+			numOrbitals,
+			vector<complex<double>>(numEnergies)
+		)
+	);
+	for(unsigned int orbital2 = 0; orbital2 < numOrbitals; orbital2++){
+		for(unsigned int orbital3 = 0; orbital3 < numOrbitals; orbital3++){
+			for(unsigned int e = 0; e < numEnergies; e++){
+				rpaSusceptibility[orbital2][orbital3][e]
+					= solutions[
+						matrixDimension*e
+						+ numOrbitals*orbital2
+						+ orbital3
+					];
+			}
+		}
+	}
 
 	return rpaSusceptibility;
 }
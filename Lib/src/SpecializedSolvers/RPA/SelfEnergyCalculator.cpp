@@ -26,6 +26,10 @@
 #include <complex>
 #include <iomanip>
 
+#ifdef TBTK_USE_OPEN_MP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 const complex<double> i(0, 1);
@@ -45,8 +49,6 @@ SelfEnergyCalculator::SelfEnergyCalculator(
 
 	isInitialized = false;
 
-	kMinusQLookupTable = nullptr;
-
 	U = 0.;
 	Up = 0.;
 	J = 0.;
@@ -63,8 +65,6 @@ SelfEnergyCalculator::SelfEnergyCalculator(
 }
 
 SelfEnergyCalculator::~SelfEnergyCalculator(){
-	if(kMinusQLookupTable != nullptr)
-		delete [] kMinusQLookupTable;
 }
 
 void SelfEnergyCalculator::init(){
@@ -76,11 +76,6 @@ void SelfEnergyCalculator::init(){
 		<< " the number of summation energies."
 	);
 
-	if(kMinusQLookupTable != nullptr){
-		delete [] kMinusQLookupTable;
-		kMinusQLookupTable = nullptr;
-	}
-
 	//Calculate kT
 	double temperature = UnitHandler::convertTemperatureNtB(
 		electronFluctuationVertexCalculators[0]->getMomentumSpaceContext(
@@ -111,129 +106,6 @@ void SelfEnergyCalculator::init(){
 	isInitialized = true;
 }
 
-void SelfEnergyCalculator::generateKMinusQLookupTable(){
-	if(kMinusQLookupTable != nullptr)
-		return;
-
-	Timer::tick("Calculate k-q lookup table.");
-	const MomentumSpaceContext &momentumSpaceContext = electronFluctuationVertexCalculators[0]->getMomentumSpaceContext();
-	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
-	const vector<unsigned int> &numMeshPoints = momentumSpaceContext.getNumMeshPoints();
-	const BrillouinZone &brillouinZone = momentumSpaceContext.getBrillouinZone();
-	const Model &model = momentumSpaceContext.getModel();
-	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
-
-	kMinusQLookupTable = new int[mesh.size()*mesh.size()];
-
-	string cacheName = "cache/kMinusQLookupTable";
-	for(
-		unsigned int n = 0;
-		n < numMeshPoints.size();
-		n++
-	){
-		cacheName += "_" + to_string(numMeshPoints.at(n));
-	}
-	ifstream fin(cacheName);
-	if(fin){
-		unsigned int counter = 0;
-		int value;
-		while(fin >> value){
-			TBTKAssert(
-				counter < mesh.size()*mesh.size(),
-				"SelfEnergyCalculator::generateKMinusQLookupTable()",
-				"Found cache file '" << cacheName << "',"
-				<< " but the cache is too large.",
-				"Clear the cache to recalculate"
-				<< " kMinusQLookupTable."
-			);
-			kMinusQLookupTable[counter] = value;
-			counter++;
-		}
-		fin.close();
-
-		TBTKAssert(
-			counter == mesh.size()*mesh.size(),
-			"SelfEnergyCalculator::generateKMinusQLookupTable()",
-			"Found cache file '" << cacheName << "',"
-			<< " but the cache is too small.",
-			"Clear the cache to recalculate kMinusQLookupTable."
-		);
-
-		Timer::tock();
-
-		return;
-	}
-
-#ifdef TBTK_USE_OPEN_MP
-	#pragma omp parallel for
-#endif
-	for(unsigned int k = 0; k < mesh.size(); k++){
-		const vector<double> &K = mesh.at(k);
-		for(unsigned int q = 0; q < mesh.size(); q++){
-			const vector<double> &Q = mesh.at(q);
-
-			vector<double> kMinusQ;
-			for(unsigned int n = 0; n < K.size(); n++)
-				kMinusQ.push_back(K.at(n) - Q.at(n));
-
-			Index qIndex = brillouinZone.getMinorCellIndex(
-				Q,
-				numMeshPoints
-			);
-			int qLinearIndex = model.getHoppingAmplitudeSet()->getFirstIndexInBlock(
-				qIndex
-			);
-			Index kMinusQIndex = brillouinZone.getMinorCellIndex(
-				kMinusQ,
-				numMeshPoints
-			);
-			kMinusQLookupTable[
-				k*mesh.size() + qLinearIndex/numOrbitals
-			] = model.getHoppingAmplitudeSet()->getFirstIndexInBlock(
-				kMinusQIndex
-			);
-		}
-	}
-
-	ofstream fout(cacheName);
-	if(fout)
-		for(unsigned int n = 0; n < mesh.size()*mesh.size(); n++)
-			fout << kMinusQLookupTable[n] << "\n";
-
-	Timer::tock();
-}
-
-template<>
-inline int SelfEnergyCalculator::getKMinusQLinearIndex<false>(
-	unsigned int meshIndex,
-	const vector<double> &k,
-	int kLinearIndex
-) const{
-	const MomentumSpaceContext &momentumSpaceContext = electronFluctuationVertexCalculators[0]->getMomentumSpaceContext();
-	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
-	Index kMinusQIndex = momentumSpaceContext.getBrillouinZone().getMinorCellIndex(
-		{mesh[meshIndex][0] + k[0], mesh[meshIndex][1] + k[1]},
-		momentumSpaceContext.getNumMeshPoints()
-	);
-	return momentumSpaceContext.getModel().getHoppingAmplitudeSet()->getFirstIndexInBlock(
-		kMinusQIndex
-	);
-}
-
-template<>
-inline int SelfEnergyCalculator::getKMinusQLinearIndex<true>(
-	unsigned int meshIndex,
-	const vector<double> &k,
-	int kLinearIndex
-) const{
-	const MomentumSpaceContext &momentumSpaceContext = electronFluctuationVertexCalculators[0]->getMomentumSpaceContext();
-	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
-	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
-	return kMinusQLookupTable[
-		meshIndex*mesh.size() + kLinearIndex/numOrbitals
-	];
-}
-
 vector<complex<double>> SelfEnergyCalculator::calculateSelfEnergy(
 	const vector<double> &k,
 	const vector<int> &orbitalIndices
@@ -366,8 +238,6 @@ void SelfEnergyCalculator::selfEnergyMainLoop(
 	const vector<int> &orbitalIndices,
 	vector<complex<double>> &result
 ){
-	generateKMinusQLookupTable();
-
 	const MomentumSpaceContext &momentumSpaceContext = electronFluctuationVertexCalculators[0]->getMomentumSpaceContext();
 	const Model &model = momentumSpaceContext.getModel();
 	const vector<vector<double>> &mesh = momentumSpaceContext.getMesh();
@@ -376,10 +246,8 @@ void SelfEnergyCalculator::selfEnergyMainLoop(
 	//Get kIndex
 	Index kIndex = momentumSpaceContext.getKIndex(k);
 
-	//Get linear index corresponding to kIndex.
-	int kLinearIndex = model.getHoppingAmplitudeSet()->getFirstIndexInBlock(
-		kIndex
-	);
+	//Get mesh point corresponding to kIndex.
+	unsigned int kMeshPoint = momentumSpaceContext.getMeshPoint(kIndex);
 
 	vector<vector<complex<double>>> results;
 	results.reserve(electronFluctuationVertexCalculators.size());
@@ -394,23 +262,26 @@ void SelfEnergyCalculator::selfEnergyMainLoop(
 			results[n].push_back(0);
 	}
 
-	//Main loop
-	#pragma omp parallel for default(none) shared(mesh, kLinearIndex, k, numOrbitals, orbitalIndices, momentumSpaceContext, model, results)
-	for(unsigned int worker = 0; worker < electronFluctuationVertexCalculators.size(); worker++){
-		unsigned int blockSize = mesh.size()/electronFluctuationVertexCalculators.size();
-		unsigned int begin = worker*blockSize;
-		unsigned int end = (worker+1)*blockSize;
-		if(worker == electronFluctuationVertexCalculators.size()-1)
-			end = mesh.size();
-
-		for(unsigned int n = begin; n < end; n++){
-			//Get linear index corresponding to k-q
-			int kMinusQLinearIndex = getKMinusQLinearIndex<true>(
-				n,
-				k,
-				kLinearIndex
-			);
-			int kMinusQMeshPoint = kMinusQLinearIndex/numOrbitals;
+	//Main loop. The mesh points are handed out dynamically to the workers
+	//since the cost of a mesh point depends on whether the vertex already
+	//is cached.
+	unsigned int numWorkers = electronFluctuationVertexCalculators.size();
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel num_threads(numWorkers)
+#endif
+	{
+		unsigned int worker = 0;
+#ifdef TBTK_USE_OPEN_MP
+		worker = omp_get_thread_num();
+		#pragma omp for schedule(dynamic)
+#endif
+		for(unsigned int n = 0; n < mesh.size(); n++){
+			//Get mesh point corresponding to k-q
+			unsigned int kMinusQMeshPoint
+				= momentumSpaceContext.getKMinusQMeshPoint(
+					n,
+					kMeshPoint
+				);
 
 			for(
 				unsigned int propagatorStart = 0;
@@ -439,7 +310,8 @@ void SelfEnergyCalculator::selfEnergyMainLoop(
 						state++
 					){
 						double e = momentumSpaceContext.getEnergy(
-							kMinusQLinearIndex + state
+							kMinusQMeshPoint,
+							state
 						);
 						complex<double> a0 = momentumSpaceContext.getAmplitude(
 							kMinusQMeshPoint,
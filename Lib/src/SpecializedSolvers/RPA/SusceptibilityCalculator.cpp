@@ -20,11 +20,18 @@
 
 #include "TBTK/Functions.h"
 #include "TBTK/RPA/SusceptibilityCalculator.h"
+#include "TBTK/Streams.h"
 #include "TBTK/UnitHandler.h"
 
+#include <chrono>
 #include <complex>
+#include <fstream>
 #include <iomanip>
 
+#ifdef TBTK_USE_OPEN_MP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 //const complex<double> i(0, 1);
@@ -34,341 +41,400 @@ namespace TBTK{
 SusceptibilityCalculator::SusceptibilityCalculator(
 	Algorithm algorithm,
 	const MomentumSpaceContext &momentumSpaceContext
-){
+) :
+	Communicator(false)
+{
 	this->algorithm = algorithm;
 	this->momentumSpaceContext = &momentumSpaceContext;
 
 	energyType = EnergyType::Complex;
 	energiesAreInversionSymmetric = false;
+}
 
-	kPlusQLookupTable = nullptr;
-	generateKPlusQLookupTable();
-
-	isMaster = true;
+SusceptibilityCalculator::~SusceptibilityCalculator(){
 }
 
-SusceptibilityCalculator::SusceptibilityCalculator(
-	Algorithm algorithm,
-	const MomentumSpaceContext &momentumSpaceContext,
-	int *kPlusQLookupTable
+const complex<double>* SusceptibilityCalculator::getSusceptibilityData(
+	const DualIndex &kDual,
+	const vector<int> &orbitalIndices
 ){
-	this->algorithm = algorithm;
-	this->momentumSpaceContext = &momentumSpaceContext;
+	const complex<double> *data = getCachedSusceptibility(
+		kDual,
+		orbitalIndices
+	);
+	if(data != nullptr)
+		return data;
 
-	energyType = EnergyType::Complex;
-	energiesAreInversionSymmetric = false;
+	calculateSusceptibility(kDual, orbitalIndices);
 
-	this->kPlusQLookupTable = kPlusQLookupTable;
+	data = getCachedSusceptibility(kDual, orbitalIndices);
+	TBTKAssert(
+		data != nullptr,
+		"SusceptibilityCalculator::getSusceptibilityData()",
+		"Unable to find requested susceptibility.",
+		"This should never happen, contact the developer."
+	);
 
-	isMaster = false;
+	return data;
 }
 
-SusceptibilityCalculator::~SusceptibilityCalculator(){
-	if(isMaster && kPlusQLookupTable != nullptr)
-		delete [] kPlusQLookupTable;
+//Applies the matrix M to one of the orbital indices of susceptibilities on the
+//layout [o0][o1][o2][o3][energy]. That is, the result is
+//out[..][o][..] = \sum_{p}M[o][p]in[..][p][..], where M is replaced by its
+//complex conjugate if 'conjugate' is true.
+static void transformOrbitalIndex(
+	const complex<double> *in,
+	complex<double> *out,
+	const complex<double> *matrix,
+	unsigned int numOrbitals,
+	unsigned int numEnergies,
+	unsigned int index,
+	bool conjugate
+){
+	unsigned int outerSize = 1;
+	for(unsigned int n = 0; n < index; n++)
+		outerSize *= numOrbitals;
+	unsigned int innerSize = numEnergies;
+	for(unsigned int n = index + 1; n < 4; n++)
+		innerSize *= numOrbitals;
+
+	for(unsigned int outer = 0; outer < outerSize; outer++){
+		for(unsigned int row = 0; row < numOrbitals; row++){
+			complex<double> *destination = out
+				+ innerSize*(numOrbitals*outer + row);
+			for(unsigned int inner = 0; inner < innerSize; inner++)
+				destination[inner] = 0.;
+
+			for(unsigned int col = 0; col < numOrbitals; col++){
+				complex<double> element
+					= matrix[numOrbitals*row + col];
+				if(conjugate)
+					element = conj(element);
+				if(element == 0.)
+					continue;
+
+				const complex<double> *source = in
+					+ innerSize*(numOrbitals*outer + col);
+				for(
+					unsigned int inner = 0;
+					inner < innerSize;
+					inner++
+				){
+					destination[inner] += element*source[inner];
+				}
+			}
+		}
+	}
 }
 
-/*void SusceptibilityCalculator::precompute(unsigned int numWorkers){
-	Timer::tick("1");
+void SusceptibilityCalculator::precompute(){
 	const vector<vector<double>> &mesh = momentumSpaceContext->getMesh();
 	unsigned int numOrbitals = momentumSpaceContext->getNumOrbitals();
+	unsigned int numOrbitalCombinations
+		= numOrbitals*numOrbitals*numOrbitals*numOrbitals;
+
+	SusceptibilityTensor &tensor = getSusceptibilityTensor();
+
+	//If the MomentumSpaceContext has symmetry operations, only the
+	//irreducible mesh points are calculated explicitly.
+	bool useSymmetries
+		= momentumSpaceContext->getNumSymmetryOperations() > 1;
+	vector<unsigned int> meshPoints;
+	if(useSymmetries){
+		meshPoints = momentumSpaceContext->getIrreducibleMeshPoints();
+	}
+	else{
+		for(unsigned int n = 0; n < mesh.size(); n++)
+			meshPoints.push_back(n);
+	}
 
-	vector<SusceptibilityCalculator*> susceptibilityCalculators;
+	unsigned int numWorkers = 1;
+#ifdef TBTK_USE_OPEN_MP
+	numWorkers = omp_get_max_threads();
+#endif
+
+	//Create one slave per thread that writes directly to the cache of this
+	//SusceptibilityCalculator.
+	vector<SusceptibilityCalculator*> workers;
 	for(unsigned int n = 0; n < numWorkers; n++){
-		susceptibilityCalculators.push_back(
-			new SusceptibilityCalculator(
-				*momentumSpaceContext
-			)
-		);
-		susceptibilityCalculators[n]->setEnergies(
-			energies
-		);
-		susceptibilityCalculators[n]->setEnergyType(
-			energyType
-		);
-		susceptibilityCalculators[n]->setEnergiesAreInversionSymmetric(
+		SusceptibilityCalculator *worker = createSlave();
+		worker->setEnergies(energies);
+		worker->setEnergyType(energyType);
+		worker->setEnergiesAreInversionSymmetric(
 			energiesAreInversionSymmetric
 		);
-
-		delete [] susceptibilityCalculators[n]->kPlusQLookupTable;
-		susceptibilityCalculators[n]->kPlusQLookupTable = kPlusQLookupTable;
-		delete [] susceptibilityCalculators[n]->fermiDiracLookupTable;
-		susceptibilityCalculators[n]->fermiDiracLookupTable = fermiDiracLookupTable;
-		susceptibilityCalculators[n]->isMaster = false;
+		worker->susceptibilityTensor = susceptibilityTensor;
+		workers.push_back(worker);
 	}
 
-	vector<vector<vector<double>>> meshes;
-	unsigned int meshSegmentSize = mesh.size()/(numWorkers-1);
-	for(unsigned int n = 0; n < numWorkers-1; n++){
-		meshes.push_back(vector<vector<double>>());
-		for(
-			unsigned int c = n*meshSegmentSize;
-			c < (n+1)*meshSegmentSize;
-			c++
-		){
-			meshes[n].push_back(mesh.at(c));
-		}
+	unsigned int numTasks = numOrbitalCombinations*meshPoints.size();
+	uint64_t numInitialEntries = tensor.getNumAddedEntries();
+	chrono::time_point<chrono::steady_clock> start
+		= chrono::steady_clock::now();
+
+	bool verbose = getGlobalVerbose() && getVerbose();
+	if(verbose){
+		Streams::out << "SusceptibilityCalculator::precompute\n";
+		Streams::out << "\tMesh points: " << meshPoints.size() << " of "
+			<< mesh.size() << "\n";
+		Streams::out << "\tTasks: " << numTasks << "\n";
+		Streams::out << "\tThreads: " << numWorkers << "\n";
+		Streams::out << "\tProgress (2% per dot): " << flush;
 	}
-	meshes.push_back(vector<vector<double>>());
-	for(
-		unsigned int n = (numWorkers-1)*meshSegmentSize;
-		n < mesh.size();
-		n++
-	){
-		meshes.back().push_back(mesh.at(n));
-	}
-	Timer::tock();
 
-	Timer::tick("2");
-	#pragma omp parallel for
-	for(unsigned int n = 0; n < numWorkers; n++){
-		SusceptibilityCalculator &susceptibilityCalculator = *susceptibilityCalculators.at(n);
-		const vector<vector<double>> &mesh = meshes.at(n);
-
-		for(unsigned int c = 0; c < mesh.size(); c++){
-			for(
-				unsigned int orbital0 = 0;
-				orbital0 < numOrbitals;
-				orbital0++
-			){
-				for(
-					unsigned int orbital1 = 0;
-					orbital1 < numOrbitals;
-					orbital1++
-				){
-					for(
-						unsigned int orbital2 = 0;
-						orbital2 < numOrbitals;
-						orbital2++
-					){
-						for(
-							unsigned int orbital3 = 0;
-							orbital3 < numOrbitals;
-							orbital3++
-						){
-							susceptibilityCalculator.calculateSusceptibility(
-								mesh[c],
-								{
-									(int)orbital0,
-									(int)orbital1,
-									(int)orbital2,
-									(int)orbital3
-								}
-							);
-						}
-					}
-				}
-			}
+	unsigned int numCompletedTasks = 0;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel for schedule(dynamic)
+#endif
+	for(unsigned int task = 0; task < numTasks; task++){
+		unsigned int worker = 0;
+#ifdef TBTK_USE_OPEN_MP
+		worker = omp_get_thread_num();
+#endif
+		unsigned int meshPoint = meshPoints[task%meshPoints.size()];
+		unsigned int orbitalCombination = task/meshPoints.size();
+		vector<int> orbitalIndices(4);
+		for(int n = 3; n >= 0; n--){
+			orbitalIndices[n] = orbitalCombination%numOrbitals;
+			orbitalCombination /= numOrbitals;
 		}
-	}
-	Timer::tock();
-
-	Timer::tick("3");
-	Streams::out << "Susceptibility tree size:\t" << susceptibilityTree.getSizeInBytes() << "\n";
-	for(unsigned int n = 0; n < numWorkers; n++){
-		SusceptibilityCalculator &susceptibilityCalculator = *susceptibilityCalculators.at(n);
-		const vector<vector<double>> &mesh = meshes.at(n);
 
-		for(unsigned int c = 0; c < mesh.size(); c++){
-			Index kIndex = momentumSpaceContext->getKIndex(
-				mesh[c]
+		const vector<double> &k = mesh[meshPoint];
+		if(
+			workers[worker]->getCachedSusceptibility(
+				momentumSpaceContext->getKIndex(k),
+				orbitalIndices
+			) == nullptr
+		){
+			workers[worker]->calculateSusceptibility(
+				k,
+				orbitalIndices
 			);
+		}
 
-			for(
-				unsigned int orbital0 = 0;
-				orbital0 < numOrbitals;
-				orbital0++
+		if(verbose){
+			unsigned int completed;
+#ifdef TBTK_USE_OPEN_MP
+			#pragma omp atomic capture
+#endif
+			completed = ++numCompletedTasks;
+			if(50*(uint64_t)completed/numTasks
+				!= 50*(uint64_t)(completed - 1)/numTasks
 			){
-				for(
-					unsigned int orbital1 = 0;
-					orbital1 < numOrbitals;
-					orbital1++
-				){
-					for(
-						unsigned int orbital2 = 0;
-						orbital2 < numOrbitals;
-						orbital2++
-					){
-						for(
-							unsigned int orbital3 = 0;
-							orbital3 < numOrbitals;
-							orbital3++
-						){
-							SerializeableVector<complex<double>> result;
-							Index resultIndex = Index(
-								kIndex,
-								{
-									(int)orbital0,
-									(int)orbital1,
-									(int)orbital2,
-									(int)orbital3
-								}
-							);
-							TBTKAssert(
-								susceptibilityCalculator.susceptibilityTree.get(
-									result,
-									resultIndex
-								),
-								"SusceptibilityCalculator::precompute()",
-								"Unable to find requested susceptibility.",
-								"This should never happen, contact the developer."
-							);
-							susceptibilityTree.add(
-								result,
-								resultIndex
-							);
-						}
-					}
-				}
+#ifdef TBTK_USE_OPEN_MP
+				#pragma omp critical (TBTK_SUSCEPTIBILITY_CALCULATOR)
+#endif
+				Streams::out << "." << flush;
 			}
 		}
 	}
-
-	for(unsigned int n = 0; n < susceptibilityCalculators.size(); n++)
-		delete susceptibilityCalculators[n];
-
-	Streams::out << "Susceptibility tree size:\t" << susceptibilityTree.getSizeInBytes() << "\n";
-	Timer::tock();
-}*/
-
-void SusceptibilityCalculator::generateKPlusQLookupTable(){
-	if(kPlusQLookupTable != nullptr)
-		return;
-
-	Timer::tick("Calculate k+q lookup table.");
-	const vector<vector<double>> &mesh = momentumSpaceContext->getMesh();
-	const vector<unsigned int> &numMeshPoints = momentumSpaceContext->getNumMeshPoints();
-	const BrillouinZone &brillouinZone = momentumSpaceContext->getBrillouinZone();
-	const Model &model = momentumSpaceContext->getModel();
-	unsigned int numOrbitals = momentumSpaceContext->getNumOrbitals();
-
-	kPlusQLookupTable = new int[mesh.size()*mesh.size()];
-
-	string cacheName = "cache/kPlusQLookupTable";
-	for(
-		unsigned int n = 0;
-		n < numMeshPoints.size();
-		n++
-	){
-		cacheName += "_" + to_string(numMeshPoints.at(n));
-	}
-	ifstream fin(cacheName);
-	if(fin){
-		unsigned int counter = 0;
-		int value;
-		while(fin >> value){
-			TBTKAssert(
-				counter < mesh.size()*mesh.size(),
-				"SusceptibilityCalculator::generateKPlusQLookupTable()",
-				"Found cache file '" << cacheName << "',"
-				<< " but it is too large.",
-				"Clear the cache to recalculate"
-				<< " kPlusQLookupTable."
-			);
-			kPlusQLookupTable[counter] = value;
-			counter++;
+	if(verbose)
+		Streams::out << "\n";
+
+	for(unsigned int n = 0; n < workers.size(); n++)
+		delete workers[n];
+
+	if(useSymmetries)
+		applySymmetryOperations();
+
+	if(verbose){
+		double time = chrono::duration<double>(
+			chrono::steady_clock::now() - start
+		).count();
+		uint64_t numCalculatedEntries
+			= tensor.getNumAddedEntries() - numInitialEntries;
+		Streams::out << "\tCalculated " << numCalculatedEntries
+			<< " entries in " << time << "s";
+		if(time > 0){
+			Streams::out << " (" << numCalculatedEntries/time
+				<< " entries/s)";
 		}
-		fin.close();
-
-		TBTKAssert(
-			counter == mesh.size()*mesh.size(),
-			"SusceptibilityCalculator::generateKPlusQLookupTable()",
-			"Found cache file" << cacheName << ","
-			<< " but it is too small.",
-			"Clear the cache to recalculate kPlusQLookupTable."
-		);
-
-		Timer::tock();
-
-		return;
+		Streams::out << ".\n";
 	}
+}
 
+void SusceptibilityCalculator::applySymmetryOperations(){
+	const vector<vector<double>> &mesh = momentumSpaceContext->getMesh();
+	unsigned int numOrbitals = momentumSpaceContext->getNumOrbitals();
+	unsigned int numOrbitalCombinations
+		= numOrbitals*numOrbitals*numOrbitals*numOrbitals;
+	SusceptibilityTensor &tensor = getSusceptibilityTensor();
+
+	//The susceptibility at the remaining mesh points is obtained from
+	//chi(Rq, o0, o1, o2, o3)
+	//	= \sum_{p}U*[o0][p0]U[o1][p1]U*[o2][p2]U[o3][p3]chi(q, p),
+	//where R is a symmetry operation with orbital representation U.
+	unsigned int numEnergies = energies.size();
+	unsigned int blockSize = numOrbitalCombinations*numEnergies;
 #ifdef TBTK_USE_OPEN_MP
-	#pragma omp parallel for
+	#pragma omp parallel for schedule(dynamic)
 #endif
-	for(unsigned int k = 0; k < mesh.size(); k++){
-		const vector<double>& K = mesh.at(k);
-		for(unsigned int q = 0; q < mesh.size(); q++){
-			vector<double> Q = mesh.at(q);
+	for(unsigned int meshPoint = 0; meshPoint < mesh.size(); meshPoint++){
+		unsigned int representative
+			= momentumSpaceContext->getRepresentativeMeshPoint(
+				meshPoint
+			);
+		if(representative == meshPoint)
+			continue;
 
-			vector<double> kPlusQ;
-			for(unsigned int n = 0; n < K.size(); n++)
-				kPlusQ.push_back(K.at(n)+Q.at(n));
+		vector<complex<double>> block(blockSize);
+		vector<complex<double>> workspace(blockSize);
+		for(
+			unsigned int orbitalCombination = 0;
+			orbitalCombination < numOrbitalCombinations;
+			orbitalCombination++
+		){
+			vector<int> orbitalIndices(4);
+			unsigned int remainder = orbitalCombination;
+			for(int n = 3; n >= 0; n--){
+				orbitalIndices[n] = remainder%numOrbitals;
+				remainder /= numOrbitals;
+			}
 
-			Index qIndex = brillouinZone.getMinorCellIndex(
-				Q,
-				numMeshPoints
+			const complex<double> *data = tensor.get(
+				representative,
+				orbitalIndices
 			);
-			int qLinearIndex = model.getHoppingAmplitudeSet()->getFirstIndexInBlock(
-				qIndex
+			TBTKAssert(
+				data != nullptr,
+				"SusceptibilityCalculator::precompute()",
+				"Unable to find requested susceptibility.",
+				"This should never happen, contact the"
+				<< " developer."
 			);
-			Index kPlusQIndex = brillouinZone.getMinorCellIndex(
-				kPlusQ,
-				numMeshPoints
+			for(unsigned int e = 0; e < numEnergies; e++){
+				block[numEnergies*orbitalCombination + e]
+					= data[e];
+			}
+		}
+
+		const complex<double> *orbitalRepresentation
+			= momentumSpaceContext->getOrbitalRepresentation(
+				momentumSpaceContext->getSymmetryOperation(
+					meshPoint
+				)
 			);
-			kPlusQLookupTable[
-				k*mesh.size() + qLinearIndex/numOrbitals
-			] = model.getHoppingAmplitudeSet()->getFirstIndexInBlock(
-				kPlusQIndex
+		for(unsigned int index = 0; index < 4; index++){
+			transformOrbitalIndex(
+				block.data(),
+				workspace.data(),
+				orbitalRepresentation,
+				numOrbitals,
+				numEnergies,
+				index,
+				index%2 == 0
 			);
+			block.swap(workspace);
 		}
-	}
 
-	ofstream fout(cacheName);
-	if(fout)
-		for(unsigned int n = 0; n < mesh.size()*mesh.size(); n++)
-			fout << kPlusQLookupTable[n] << "\n";
+		for(
+			unsigned int orbitalCombination = 0;
+			orbitalCombination < numOrbitalCombinations;
+			orbitalCombination++
+		){
+			vector<int> orbitalIndices(4);
+			unsigned int remainder = orbitalCombination;
+			for(int n = 3; n >= 0; n--){
+				orbitalIndices[n] = remainder%numOrbitals;
+				remainder /= numOrbitals;
+			}
 
-	Timer::tock();
+			tensor.add(
+				block.data() + numEnergies*orbitalCombination,
+				meshPoint,
+				orbitalIndices
+			);
+		}
+	}
 }
 
-/*template<>
-inline int SusceptibilityCalculator::getKPlusQLinearIndex<false>(
-	unsigned int meshIndex,
-	const vector<double> &k,
-	int kLinearIndex
+void SusceptibilityCalculator::saveSusceptibilities(
+	const string &filename
 ) const{
-	const vector<vector<double>> &mesh = momentumSpaceContext->getMesh();
-
-	Index kPlusQIndex = momentumSpaceContext->getBrillouinZone().getMinorCellIndex(
-		{mesh[meshIndex][0] + k[0], mesh[meshIndex][1] + k[1]},
-		momentumSpaceContext->getNumMeshPoints()
+	//The tensor is streamed to the file to avoid holding a second copy of
+	//it in memory.
+	ofstream fout(filename, ios::binary);
+	TBTKAssert(
+		fout,
+		"SusceptibilityCalculator::saveSusceptibilities()",
+		"Unable to open '" << filename << "' for writing.",
+		""
 	);
-	return momentumSpaceContext->getModel().getHoppingAmplitudeSet()->getFirstIndexInBlock(
-		kPlusQIndex
+	if(susceptibilityTensor){
+		susceptibilityTensor->serialize(
+			Serializeable::Mode::Binary,
+			fout
+		);
+	}
+	else{
+		SusceptibilityTensor emptyTensor(
+			momentumSpaceContext->getMesh().size(),
+			momentumSpaceContext->getNumOrbitals(),
+			energies.size()
+		);
+		emptyTensor.serialize(Serializeable::Mode::Binary, fout);
+	}
+	fout.close();
+	TBTKAssert(
+		fout,
+		"SusceptibilityCalculator::saveSusceptibilities()",
+		"Failed to write '" << filename << "'.",
+		""
 	);
 }
 
-template<>
-inline int SusceptibilityCalculator::getKPlusQLinearIndex<true>(
-	unsigned int meshIndex,
-	const vector<double> &k,
-	int kLinearIndex
-) const{
-	return kPlusQLookupTable[
-		meshIndex*momentumSpaceContext->getMesh().size()
-		+ kLinearIndex/momentumSpaceContext->getNumOrbitals()
-	];
-}*/
+void SusceptibilityCalculator::loadSusceptibilities(const string &filename){
+	shared_ptr<SusceptibilityTensor> tensor
+		= make_shared<SusceptibilityTensor>(
+			MemoryMappedFile(
+				filename,
+				MemoryMappedFile::Mode::CopyOnWrite
+			)
+		);
+
+	TBTKAssert(
+		tensor->getMeshSize() == momentumSpaceContext->getMesh().size()
+		&& tensor->getNumOrbitals()
+			== momentumSpaceContext->getNumOrbitals()
+		&& tensor->getNumEnergies() == energies.size(),
+		"SusceptibilityCalculator::loadSusceptibilities()",
+		"The susceptibilities in '" << filename << "' have"
+		<< " incompatible dimensions. The file contains "
+		<< tensor->getMeshSize() << " mesh points, "
+		<< tensor->getNumOrbitals() << " orbitals, and "
+		<< tensor->getNumEnergies() << " energies, but the"
+		<< " SusceptibilityCalculator has "
+		<< momentumSpaceContext->getMesh().size() << " mesh points, "
+		<< momentumSpaceContext->getNumOrbitals() << " orbitals, and "
+		<< energies.size() << " energies.",
+		"Make sure the energies have been set before loading the"
+		<< " susceptibilities."
+	);
+
+	susceptibilityTensor = tensor;
+}
 
 void SusceptibilityCalculator::cacheSusceptibility(
 	const vector<complex<double>> &result,
 	const vector<double> &k,
 	const vector<int> &orbitalIndices,
-	const Index &kIndex,
-	const Index &resultIndex
+	const Index &kIndex
 ){
+	SusceptibilityTensor &tensor = getSusceptibilityTensor();
+	unsigned int kMeshPoint = momentumSpaceContext->getMeshPoint(kIndex);
+
 	//Cashe result
-	susceptibilityTree.add(
-		result,
-		resultIndex
-	);
+	tensor.add(result.data(), kMeshPoint, orbitalIndices);
 
 	const vector<unsigned int> &numMeshPoints = momentumSpaceContext->getNumMeshPoints();
 	const BrillouinZone &brillouinZone = momentumSpaceContext->getBrillouinZone();
 
-	//<Needs proper checking>
-	//Use symmetries to extend result to other entries.
+	//Use symmetries to extend result to other entries. For inversion
+	//symmetric Matsubara energies, G_{ab}(k, iw)^* = G_{ba}(k, -iw) and
+	//relabeling of the summation momentum give
+	//chi(q, o3, o2, o1, o0)(iv) = chi(q, o0, o1, o2, o3)(-iv)^*,
+	//chi(-q, o2, o3, o0, o1)(iv) = chi(q, o0, o1, o2, o3)(-iv),
+	//chi(-q, o1, o0, o3, o2)(iv) = chi(q, o0, o1, o2, o3)(iv)^*.
 	if(
 		getEnergyType() == EnergyType::Imaginary
 		&& getEnergiesAreInversionSymmetric()
@@ -377,9 +443,7 @@ void SusceptibilityCalculator::cacheSusceptibility(
 		vector<complex<double>> conjugatedResult;
 		vector<complex<double>> reversedConjugatedResult;
 		for(unsigned int n = 0; n < result.size(); n++){
-			reversedResult.push_back(
-				conj(result.at(result.size()-1-n))
-			);
+			reversedResult.push_back(result.at(result.size()-1-n));
 			conjugatedResult.push_back(conj(result.at(n)));
 			reversedConjugatedResult.push_back(
 				conj(result.at(result.size()-1-n))
@@ -389,50 +453,56 @@ void SusceptibilityCalculator::cacheSusceptibility(
 		vector<double> kMinus;
 		for(unsigned int n = 0; n < k.size(); n++)
 			kMinus.push_back(-k.at(n));
-		Index kMinusIndex = brillouinZone.getMinorCellIndex(
-			kMinus,
-			numMeshPoints
+		unsigned int kMinusMeshPoint = momentumSpaceContext->getMeshPoint(
+			brillouinZone.getMinorCellIndex(
+				kMinus,
+				numMeshPoints
+			)
 		);
 
-		susceptibilityTree.add(
-			reversedConjugatedResult,
-			Index(
-				kIndex,
-				{
-					orbitalIndices.at(3),
-					orbitalIndices.at(2),
-					orbitalIndices.at(1),
-					orbitalIndices.at(0)
-				}
-			)
+		tensor.add(
+			reversedConjugatedResult.data(),
+			kMeshPoint,
+			{
+				orbitalIndices.at(3),
+				orbitalIndices.at(2),
+				orbitalIndices.at(1),
+				orbitalIndices.at(0)
+			}
 		);
-		susceptibilityTree.add(
-			reversedResult,
-			Index(
-				kMinusIndex,
-				{
-					orbitalIndices.at(2),
-					orbitalIndices.at(3),
-					orbitalIndices.at(0),
-					orbitalIndices.at(1)
-				}
-			)
+		tensor.add(
+			reversedResult.data(),
+			kMinusMeshPoint,
+			{
+				orbitalIndices.at(2),
+				orbitalIndices.at(3),
+				orbitalIndices.at(0),
+				orbitalIndices.at(1)
+			}
 		);
-		susceptibilityTree.add(
-			conjugatedResult,
-			Index(
-				kMinusIndex,
-				{
-					orbitalIndices.at(1),
-					orbitalIndices.at(0),
-					orbitalIndices.at(3),
-					orbitalIndices.at(2)
-				}
-			)
+		tensor.add(
+			conjugatedResult.data(),
+			kMinusMeshPoint,
+			{
+				orbitalIndices.at(1),
+				orbitalIndices.at(0),
+				orbitalIndices.at(3),
+				orbitalIndices.at(2)
+			}
 		);
 	}
-	//</Needs proper checking>
 }
 
-}	//End of namesapce TBTK
+SusceptibilityTensor& SusceptibilityCalculator::getSusceptibilityTensor(){
+	if(!susceptibilityTensor){
+		susceptibilityTensor = make_shared<SusceptibilityTensor>(
+			momentumSpaceContext->getMesh().size(),
+			momentumSpaceContext->getNumOrbitals(),
+			energies.size()
+		);
+	}
+
+	return *susceptibilityTensor;
+}
 
+}	//End of namesapce TBTK
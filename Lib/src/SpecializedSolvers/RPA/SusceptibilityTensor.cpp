@@ -0,0 +1,198 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file SusceptibilityTensor.cpp
+ *
+ *  @author Kristofer Björnson
+ */
+
+#include "TBTK/RPA/SusceptibilityTensor.h"
+#include "TBTK/TBTKMacros.h"
+
+using namespace std;
+
+namespace TBTK{
+
+constexpr unsigned char SusceptibilityTensor::EMPTY;
+constexpr unsigned char SusceptibilityTensor::WRITING;
+constexpr unsigned char SusceptibilityTensor::READY;
+
+SusceptibilityTensor::SusceptibilityTensor(
+	unsigned int meshSize,
+	unsigned int numOrbitals,
+	unsigned int numEnergies
+){
+	this->meshSize = meshSize;
+	this->numOrbitals = numOrbitals;
+	this->numEnergies = numEnergies;
+	numEntries = (uint64_t)meshSize
+		*numOrbitals*numOrbitals*numOrbitals*numOrbitals;
+
+	statusStorage.assign(numEntries, EMPTY);
+	dataStorage.assign(numEntries*numEnergies, 0.);
+	status = statusStorage.data();
+	data = dataStorage.data();
+	mappedStatus = nullptr;
+}
+
+SusceptibilityTensor::SusceptibilityTensor(
+	const MemoryMappedFile &file
+) :
+	memoryMappedFile(file)
+{
+	TBTKAssert(
+		file.isMapped(),
+		"SusceptibilityTensor::SusceptibilityTensor()",
+		"The MemoryMappedFile does not map any file.",
+		""
+	);
+	BinaryReader reader(
+		file.getData(),
+		file.getSize(),
+		"SusceptibilityTensor"
+	);
+	meshSize = reader.read<unsigned int>("meshSize");
+	numOrbitals = reader.read<unsigned int>("numOrbitals");
+	numEnergies = reader.read<unsigned int>("numEnergies");
+	numEntries = (uint64_t)meshSize
+		*numOrbitals*numOrbitals*numOrbitals*numOrbitals;
+
+	TBTKAssert(
+		reader.getArraySize<unsigned char>("status") == numEntries
+		&& reader.getArraySize<complex<double>>("data")
+			== numEntries*numEnergies,
+		"SusceptibilityTensor::SusceptibilityTensor()",
+		"The size of the stored data does not match the dimensions of"
+		<< " the SusceptibilityTensor.",
+		""
+	);
+
+	//Entries that were being written when the tensor was serialized are
+	//incomplete. The status flags are copied rather than reset in place to
+	//avoid dirtying the mapped pages.
+	const unsigned char *storedStatus
+		= reader.getArrayData<unsigned char>("status");
+	statusStorage.resize(numEntries);
+	for(uint64_t n = 0; n < numEntries; n++)
+		statusStorage[n] = (storedStatus[n] == READY) ? READY : EMPTY;
+	status = statusStorage.data();
+
+	//add() refuses to write to read only mappings, which makes it safe to
+	//cast away the constness.
+	data = const_cast<complex<double>*>(
+		reader.getArrayData<complex<double>>("data")
+	);
+	if(file.getMode() == MemoryMappedFile::Mode::ReadWrite)
+		mappedStatus = const_cast<unsigned char*>(storedStatus);
+	else
+		mappedStatus = nullptr;
+}
+
+bool SusceptibilityTensor::add(
+	const complex<double> *values,
+	unsigned int meshPoint,
+	const vector<int> &orbitalIndices
+){
+	TBTKAssert(
+		!memoryMappedFile.isMapped() || memoryMappedFile.isWritable(),
+		"SusceptibilityTensor::add()",
+		"The SusceptibilityTensor is mapped read only.",
+		"Map the file using MemoryMappedFile::Mode::CopyOnWrite or"
+		<< " MemoryMappedFile::Mode::ReadWrite to add entries."
+	);
+	uint64_t entry = getEntry(meshPoint, orbitalIndices);
+
+	bool claimed = false;
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp critical (TBTK_SUSCEPTIBILITY_TENSOR)
+#endif
+	{
+		if(status[entry] == EMPTY){
+			status[entry] = WRITING;
+			claimed = true;
+		}
+	}
+	if(!claimed)
+		return false;
+
+	complex<double> *destination = data + entry*numEnergies;
+	for(unsigned int n = 0; n < numEnergies; n++)
+		destination[n] = values[n];
+
+	//Make sure the values are visible before the status is set.
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp flush
+	#pragma omp atomic write
+#endif
+	status[entry] = READY;
+	if(mappedStatus != nullptr)
+		mappedStatus[entry] = READY;
+
+	return true;
+}
+
+uint64_t SusceptibilityTensor::getNumAddedEntries() const{
+	uint64_t numAddedEntries = 0;
+	for(uint64_t n = 0; n < numEntries; n++)
+		if(status[n] == READY)
+			numAddedEntries++;
+
+	return numAddedEntries;
+}
+
+string SusceptibilityTensor::serialize(Mode mode) const{
+	switch(mode){
+	case Mode::Binary:
+	{
+		BinaryWriter writer("SusceptibilityTensor");
+		writeBinary(writer);
+
+		return writer.releaseSerialization();
+	}
+	default:
+		TBTKExit(
+			"SusceptibilityTensor::serialize()",
+			"Only Serializeable::Mode::Binary is supported yet.",
+			""
+		);
+	}
+}
+
+void SusceptibilityTensor::serialize(Mode mode, ostream &stream) const{
+	switch(mode){
+	case Mode::Binary:
+	{
+		BinaryWriter writer("SusceptibilityTensor", stream);
+		writeBinary(writer);
+		break;
+	}
+	default:
+		TBTKExit(
+			"SusceptibilityTensor::serialize()",
+			"Only Serializeable::Mode::Binary is supported yet.",
+			""
+		);
+	}
+}
+
+void SusceptibilityTensor::writeBinary(BinaryWriter &writer) const{
+	writer.write("meshSize", meshSize);
+	writer.write("numOrbitals", numOrbitals);
+	writer.write("numEnergies", numEnergies);
+	writer.writeArray("status", status, numEntries);
+	writer.writeArray("data", data, numEntries*numEnergies);
+}
+
+};	//End of namespace TBTK
@@ -80,22 +80,30 @@ void ZFactorCalculator::init(){
 }
 
 extern "C" {
-	void zgetrf_(
-		int* M,
+	void zgesv_(
 		int *N,
+		int *NRHS,
 		complex<double> *A,
 		int *lda,
 		int *ipiv,
+		complex<double> *B,
+		int *ldb,
 		int *info
 	);
-	void zgetri_(
+	void zgemm_(
+		char *transA,
+		char *transB,
+		int *M,
 		int *N,
+		int *K,
+		complex<double> *alpha,
 		complex<double> *A,
 		int *lda,
-		int *ipiv,
-		complex<double> *work,
-		int *lwork,
-		int *info
+		complex<double> *B,
+		int *ldb,
+		complex<double> *beta,
+		complex<double> *C,
+		int *ldc
 	);
 }
 
@@ -103,19 +111,28 @@ void ZFactorCalculator::invertMatrix(
 	complex<double> *matrix,
 	unsigned int dimensions
 ){
-	int numRows = dimensions;
-	int numCols = dimensions;
-
-	int *ipiv = new int[min(numRows, numCols)];
-	int lwork = numCols*numCols;
-	complex<double> *work = new complex<double>[lwork];
+	//Solve A X = 1 instead of calling zgetrf + zgetri, which avoids the
+	//workspace required by zgetri.
+	vector<complex<double>> inverse(dimensions*dimensions, 0.);
+	for(unsigned int n = 0; n < dimensions; n++)
+		inverse[dimensions*n + n] = 1.;
+
+	int N = dimensions;
+	int lda = dimensions;
+	int ldb = dimensions;
+	vector<int> ipiv(dimensions);
 	int info;
+	zgesv_(&N, &N, matrix, &lda, ipiv.data(), inverse.data(), &ldb, &info);
+	TBTKAssert(
+		info == 0,
+		"ZFactorCalculator::invertMatrix()",
+		"Unable to invert matrix. zgesv returned info = " << info
+		<< ".",
+		""
+	);
 
-	zgetrf_(&numRows, &numCols, matrix, &numRows, ipiv, &info);
-	zgetri_(&numRows, matrix, &numRows, ipiv, work, &lwork, &info);
-
-	delete [] ipiv;
-	delete [] work;
+	for(unsigned int n = 0; n < dimensions*dimensions; n++)
+		matrix[n] = inverse[n];
 }
 
 void ZFactorCalculator::multiplyMatrices(
@@ -124,13 +141,26 @@ void ZFactorCalculator::multiplyMatrices(
 	complex<double> *result,
 	unsigned int dimensions
 ){
-	for(unsigned int n = 0; n < dimensions*dimensions; n++)
-		result[n] = 0.;
-
-	for(unsigned int row = 0; row < dimensions; row++)
-		for(unsigned int col = 0; col < dimensions; col++)
-			for(unsigned int n = 0; n < dimensions; n++)
-				result[dimensions*col + row] += matrix1[dimensions*n + row]*matrix2[dimensions*col + n];
+	char transA = 'N';
+	char transB = 'N';
+	int N = dimensions;
+	complex<double> alpha = 1.;
+	complex<double> beta = 0.;
+	zgemm_(
+		&transA,
+		&transB,
+		&N,
+		&N,
+		&N,
+		&alpha,
+		matrix1,
+		&N,
+		matrix2,
+		&N,
+		&beta,
+		result,
+		&N
+	);
 }
 
 void ZFactorCalculator::printMatrix(complex<double> *matrix, unsigned int dimension){
@@ -151,8 +181,6 @@ vector<complex<double>> ZFactorCalculator::calculateZFactor(
 	const BrillouinZone &brillouinZone = momentumSpaceContext.getBrillouinZone();
 	const vector<unsigned int> &numMeshPoints = momentumSpaceContext.getNumMeshPoints();
 	unsigned int numOrbitals = momentumSpaceContext.getNumOrbitals();
-	const PropertyExtractor::BlockDiagonalizer &propertyExtractor
-		= momentumSpaceContext.getPropertyExtractorBlockDiagonalizer();
 
 	//Calculate kT
 	double temperature = UnitHandler::convertTemperatureNtB(
@@ -197,12 +225,13 @@ vector<complex<double>> ZFactorCalculator::calculateZFactor(
 	complex<double> *eigenVectorsHermitianConjugate = new complex<double>[
 		numOrbitals*numOrbitals
 	];
+	unsigned int meshPoint = momentumSpaceContext.getMeshPoint(kIndex);
 	for(unsigned int row = 0; row < numOrbitals; row++){
 		for(unsigned int col = 0; col < numOrbitals; col++){
-			complex<double> amplitude = propertyExtractor.getAmplitude(
-				kIndex,
+			complex<double> amplitude = momentumSpaceContext.getAmplitude(
+				meshPoint,
 				row,
-				{(int)col}
+				col
 			);
 
 			eigenVectors[numOrbitals*col + row] = amplitude;
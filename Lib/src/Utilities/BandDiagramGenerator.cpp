@@ -19,15 +19,32 @@
  */
 
 #include "TBTK/BandDiagramGenerator.h"
-#include "TBTK/Solver/Diagonalizer.h"
 #include "TBTK/ParametrizedLine.h"
-#include "TBTK/Timer.h"
+#include "TBTK/TBTKMacros.h"
 #include "TBTK/VectorNd.h"
 
+#include <algorithm>
+#include <complex>
+
 using namespace std;
 
 namespace TBTK{
 
+extern "C" {
+	void zheev_(
+		char *jobz,
+		char *uplo,
+		int *n,
+		complex<double> *a,
+		int *lda,
+		double *w,
+		complex<double> *work,
+		int *lwork,
+		double *rwork,
+		int *info
+	);
+}
+
 BandDiagramGenerator::BandDiagramGenerator(){
 	reciprocalLattice = nullptr;
 }
@@ -81,9 +98,9 @@ vector<vector<double>> BandDiagramGenerator::generateBandDiagram(
 
 	unsigned int numBands = reciprocalLattice->getNumBands();
 
-	vector<vector<double>> bandDiagram;
-	for(unsigned int n = 0; n < numBands*nesting.size(); n++)
-		bandDiagram.push_back(vector<double>());
+	//Collect all momentums first, so that the Hamiltonians can be
+	//calculated in a single batch.
+	vector<vector<double>> momentums;
 	for(unsigned int n = 1; n < kPoints.size(); n++){
 		const initializer_list<double> kPointStart = *(kPoints.begin() + n - 1);
 		const initializer_list<double> kPointEnd = *(kPoints.begin() + n);
@@ -109,21 +126,64 @@ vector<vector<double>> BandDiagramGenerator::generateBandDiagram(
 						latticePoint.at(i) + nesting.at(m).at(i)
 					);
 				}
-				Timer::tick("Diagonalizing");
-				Model *model = reciprocalLattice->generateModel(
-					nestedPoint
-				);
-				model->construct();
+				momentums.push_back(nestedPoint);
+			}
+		}
+	}
 
-				Solver::Diagonalizer solver;
-				solver.setModel(*model);
-				solver.run();
+	vector<complex<double>> hamiltonians
+		= reciprocalLattice->calculateHamiltonians(momentums);
 
-				for(unsigned int i = 0; i < numBands; i++)
-					bandDiagram[i + numBands*m].push_back(solver.getEigenValue(i));
+	//Diagonalize the Hamiltonians in parallel. The Hamiltonians are
+	//stored row major, which zheev sees as the transpose. The transpose
+	//has the same eigenvalues.
+	unsigned int numPoints = momentums.size()/nesting.size();
+	vector<vector<double>> bandDiagram(
+		numBands*nesting.size(),
+		vector<double>(numPoints)
+	);
+#ifdef TBTK_USE_OPEN_MP
+	#pragma omp parallel
+#endif
+	{
+		int n = numBands;
+		int lwork = max(1, 2*n - 1);
+		vector<complex<double>> work(lwork);
+		vector<double> rwork(max(1, 3*n - 2));
+		vector<double> eigenValues(numBands);
+#ifdef TBTK_USE_OPEN_MP
+		#pragma omp for
+#endif
+		for(unsigned int k = 0; k < momentums.size(); k++){
+			char jobz = 'N';
+			char uplo = 'U';
+			int info;
+			zheev_(
+				&jobz,
+				&uplo,
+				&n,
+				hamiltonians.data() + (size_t)numBands*numBands*k,
+				&n,
+				eigenValues.data(),
+				work.data(),
+				&lwork,
+				rwork.data(),
+				&info
+			);
+			TBTKAssert(
+				info == 0,
+				"BandDiagramGenerator::generateBandDiagram()",
+				"Diagonalization failed with error code "
+				<< info << ".",
+				"This should never happen, contact the"
+				<< " developer."
+			);
 
-				delete model;
-				Timer::tock();
+			unsigned int point = k/nesting.size();
+			unsigned int m = k%nesting.size();
+			for(unsigned int i = 0; i < numBands; i++){
+				bandDiagram[i + numBands*m][point]
+					= eigenValues[i];
 			}
 		}
 	}
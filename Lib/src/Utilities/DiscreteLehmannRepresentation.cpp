@@ -0,0 +1,411 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file DiscreteLehmannRepresentation.cpp
+ *
+ *  @author Kristofer Björnson
+ */
+
+#include "TBTK/DiscreteLehmannRepresentation.h"
+#include "TBTK/TBTKMacros.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace TBTK{
+
+extern "C" {
+	void zgeqp3_(
+		int *m,
+		int *n,
+		complex<double> *a,
+		int *lda,
+		int *jpvt,
+		complex<double> *tau,
+		complex<double> *work,
+		int *lwork,
+		double *rwork,
+		int *info
+	);
+	void zgetrf_(
+		int *m,
+		int *n,
+		complex<double> *a,
+		int *lda,
+		int *ipiv,
+		int *info
+	);
+	void zgetrs_(
+		char *trans,
+		int *n,
+		int *nrhs,
+		complex<double> *a,
+		int *lda,
+		int *ipiv,
+		complex<double> *b,
+		int *ldb,
+		int *info
+	);
+}
+
+//Number of Chebyshev nodes per panel of the fine real frequency grid.
+static const unsigned int NUM_NODES_PER_PANEL = 24;
+
+//Matsubara frequencies with |n| below this value are all included in the
+//candidate set of interpolation frequencies. Above it, the candidates are
+//spaced logarithmically.
+static const int NUM_DENSE_MATSUBARA_FREQUENCIES = 128;
+
+//Performs a pivoted QR decomposition of the column major m x n matrix and
+//returns the pivoted columns in order, together with the diagonal of R.
+static void pivotedQR(
+	vector<complex<double>> &matrix,
+	int m,
+	int n,
+	vector<int> &pivots,
+	vector<double> &diagonal
+){
+	pivots.assign(n, 0);
+	vector<complex<double>> tau(min(m, n));
+	vector<double> rwork(2*n);
+	int lwork = -1;
+	complex<double> workSize;
+	int info;
+	zgeqp3_(
+		&m,
+		&n,
+		matrix.data(),
+		&m,
+		pivots.data(),
+		tau.data(),
+		&workSize,
+		&lwork,
+		rwork.data(),
+		&info
+	);
+	lwork = (int)real(workSize);
+	vector<complex<double>> work(lwork);
+	zgeqp3_(
+		&m,
+		&n,
+		matrix.data(),
+		&m,
+		pivots.data(),
+		tau.data(),
+		work.data(),
+		&lwork,
+		rwork.data(),
+		&info
+	);
+	TBTKAssert(
+		info == 0,
+		"DiscreteLehmannRepresentation::DiscreteLehmannRepresentation()",
+		"QR decomposition failed. zgeqp3 returned info = " << info
+		<< ".",
+		""
+	);
+
+	//Convert to zero based indices.
+	for(int c = 0; c < n; c++)
+		pivots[c]--;
+
+	diagonal.clear();
+	for(int c = 0; c < min(m, n); c++)
+		diagonal.push_back(abs(matrix[m*c + c]));
+}
+
+DiscreteLehmannRepresentation::DiscreteLehmannRepresentation(
+	Statistics statistics,
+	double kT,
+	double energyCutoff,
+	double tolerance
+){
+	TBTKAssert(
+		kT > 0,
+		"DiscreteLehmannRepresentation::DiscreteLehmannRepresentation()",
+		"'kT' must be larger than zero.",
+		""
+	);
+	TBTKAssert(
+		energyCutoff > 0,
+		"DiscreteLehmannRepresentation::DiscreteLehmannRepresentation()",
+		"'energyCutoff' must be larger than zero.",
+		""
+	);
+	TBTKAssert(
+		tolerance > 0 && tolerance < 1,
+		"DiscreteLehmannRepresentation::DiscreteLehmannRepresentation()",
+		"'tolerance' must be between zero and one.",
+		""
+	);
+
+	this->statistics = statistics;
+	this->kT = kT;
+
+	//Fine grid of candidate poles in units of kT. The grid consists of
+	//panels of Chebyshev nodes that are refined dyadically towards zero,
+	//where the kernel varies the most.
+	double cutoff = energyCutoff/kT;
+	vector<double> panelEdges = {cutoff};
+	while(panelEdges.back() > 1)
+		panelEdges.push_back(panelEdges.back()/2);
+	panelEdges.push_back(0);
+
+	vector<double> candidatePoles;
+	for(unsigned int panel = 0; panel + 1 < panelEdges.size(); panel++){
+		double center = (panelEdges[panel] + panelEdges[panel + 1])/2;
+		double halfWidth
+			= (panelEdges[panel] - panelEdges[panel + 1])/2;
+		for(unsigned int n = 0; n < NUM_NODES_PER_PANEL; n++){
+			double node = center + halfWidth*cos(
+				M_PI*(2*n + 1)/(2*NUM_NODES_PER_PANEL)
+			);
+			candidatePoles.push_back(node);
+			candidatePoles.push_back(-node);
+		}
+	}
+
+	//Candidate interpolation frequencies. All frequencies are included up
+	//to NUM_DENSE_MATSUBARA_FREQUENCIES, after which they are spaced
+	//logarithmically up to well beyond the cutoff.
+	int maxIndex = max(
+		NUM_DENSE_MATSUBARA_FREQUENCIES,
+		(int)ceil(4*cutoff)
+	);
+	vector<int> candidateIndices;
+	for(int n = 0; n < maxIndex; ){
+		candidateIndices.push_back(n);
+		if(n < NUM_DENSE_MATSUBARA_FREQUENCIES)
+			n++;
+		else
+			n = max(n + 1, (int)(1.1*n));
+	}
+	candidateIndices.push_back(maxIndex);
+	unsigned int numNonNegative = candidateIndices.size();
+	for(unsigned int n = 0; n < numNonNegative; n++){
+		if(statistics == Statistics::FermiDirac)
+			candidateIndices.push_back(-candidateIndices[n] - 1);
+		else if(candidateIndices[n] != 0)
+			candidateIndices.push_back(-candidateIndices[n]);
+	}
+
+	//Select the poles. For bosons, the kernel is multiplied by
+	//tanh(omega/2kT) to remove the divergence at zero frequency, which
+	//otherwise dominates the selection.
+	int numFrequencies = candidateIndices.size();
+	int numCandidatePoles = candidatePoles.size();
+	vector<complex<double>> kernel(numFrequencies*numCandidatePoles);
+	for(int c = 0; c < numCandidatePoles; c++){
+		double weight = getKernelWeight(candidatePoles[c]*kT);
+		for(int r = 0; r < numFrequencies; r++){
+			kernel[numFrequencies*c + r] = weight/(
+				getMatsubaraEnergy(candidateIndices[r])/kT
+				- candidatePoles[c]
+			);
+		}
+	}
+	vector<int> pivots;
+	vector<double> diagonal;
+	pivotedQR(kernel, numFrequencies, numCandidatePoles, pivots, diagonal);
+
+	unsigned int rank = 0;
+	while(
+		rank < diagonal.size()
+		&& diagonal[rank] > tolerance*diagonal[0]
+	){
+		rank++;
+	}
+	for(unsigned int n = 0; n < rank; n++)
+		poles.push_back(candidatePoles[pivots[n]]);
+	sort(poles.begin(), poles.end());
+
+	//Select the interpolation frequencies.
+	vector<complex<double>> transposedKernel(rank*numFrequencies);
+	for(int c = 0; c < numFrequencies; c++){
+		for(unsigned int r = 0; r < rank; r++){
+			transposedKernel[rank*c + r] = getKernelWeight(
+				poles[r]*kT
+			)/(
+				getMatsubaraEnergy(candidateIndices[c])/kT
+				- poles[r]
+			);
+		}
+	}
+	pivotedQR(transposedKernel, rank, numFrequencies, pivots, diagonal);
+	for(unsigned int n = 0; n < rank; n++)
+		interpolationIndices.push_back(candidateIndices[pivots[n]]);
+	sort(interpolationIndices.begin(), interpolationIndices.end());
+
+	//Convert the poles to energies and factorize the kernel at the
+	//interpolation frequencies.
+	for(unsigned int n = 0; n < rank; n++)
+		poles[n] *= kT;
+
+	interpolationMatrix.resize(rank*rank);
+	for(unsigned int c = 0; c < rank; c++){
+		double weight = getKernelWeight(poles[c]);
+		for(unsigned int r = 0; r < rank; r++){
+			interpolationMatrix[rank*c + r] = weight/(
+				getMatsubaraEnergy(interpolationIndices[r])
+				- poles[c]
+			);
+		}
+	}
+	int size = rank;
+	int info;
+	interpolationPivots.resize(rank);
+	zgetrf_(
+		&size,
+		&size,
+		interpolationMatrix.data(),
+		&size,
+		interpolationPivots.data(),
+		&info
+	);
+	TBTKAssert(
+		info == 0,
+		"DiscreteLehmannRepresentation::DiscreteLehmannRepresentation()",
+		"LU factorization failed. zgetrf returned info = " << info
+		<< ".",
+		""
+	);
+}
+
+void DiscreteLehmannRepresentation::fit(
+	const complex<double> *values,
+	complex<double> *coefficients,
+	unsigned int numFunctions
+) const{
+	unsigned int rank = poles.size();
+	for(unsigned int n = 0; n < numFunctions*rank; n++)
+		coefficients[n] = values[n];
+
+	char trans = 'N';
+	int size = rank;
+	int numRightHandSides = numFunctions;
+	int info;
+	zgetrs_(
+		&trans,
+		&size,
+		&numRightHandSides,
+		const_cast<complex<double>*>(interpolationMatrix.data()),
+		&size,
+		const_cast<int*>(interpolationPivots.data()),
+		coefficients,
+		&size,
+		&info
+	);
+	TBTKAssert(
+		info == 0,
+		"DiscreteLehmannRepresentation::fit()",
+		"zgetrs returned info = " << info << ".",
+		""
+	);
+
+	//Undo the weighting of the kernel.
+	for(unsigned int n = 0; n < rank; n++){
+		double weight = getKernelWeight(poles[n]);
+		for(unsigned int c = 0; c < numFunctions; c++)
+			coefficients[rank*c + n] *= weight;
+	}
+}
+
+complex<double> DiscreteLehmannRepresentation::sum(
+	const complex<double> *coefficients
+) const{
+	complex<double> result = 0;
+	for(unsigned int n = 0; n < poles.size(); n++)
+		result += coefficients[n]*getDistribution(poles[n]);
+
+	return result;
+}
+
+void DiscreteLehmannRepresentation::getCorrelationWeights(
+	complex<double> energy,
+	complex<double> *weights
+) const{
+	unsigned int rank = poles.size();
+	vector<double> distribution(rank);
+	for(unsigned int n = 0; n < rank; n++)
+		distribution[n] = getDistribution(poles[n]);
+
+	for(unsigned int l = 0; l < rank; l++){
+		for(unsigned int m = 0; m < rank; m++){
+			complex<double> denominator = poles[l] - poles[m] + energy;
+			if(abs(denominator) < 1e-12*kT){
+				//The limit of the difference quotient.
+				weights[rank*l + m]
+					= getDistributionDerivative(poles[l]);
+			}
+			else{
+				weights[rank*l + m] = (
+					distribution[l] - distribution[m]
+				)/denominator;
+			}
+		}
+	}
+}
+
+double DiscreteLehmannRepresentation::getKernelWeight(double energy) const{
+	if(statistics == Statistics::BoseEinstein)
+		return tanh(energy/(2*kT));
+	else
+		return 1;
+}
+
+double DiscreteLehmannRepresentation::getDistribution(double energy) const{
+	switch(statistics){
+	case Statistics::FermiDirac:
+		//Written in terms of exp(-|x|) to avoid overflow.
+		if(energy > 0)
+			return exp(-energy/kT)/(1 + exp(-energy/kT));
+		else
+			return 1/(1 + exp(energy/kT));
+	case Statistics::BoseEinstein:
+		return -1/(exp(energy/kT) - 1);
+	default:
+		TBTKExit(
+			"DiscreteLehmannRepresentation::getDistribution()",
+			"Unknown statistics.",
+			"This should never happen, contact the developer."
+		);
+	}
+}
+
+double DiscreteLehmannRepresentation::getDistributionDerivative(
+	double energy
+) const{
+	switch(statistics){
+	case Statistics::FermiDirac:
+	{
+		double distribution = getDistribution(energy);
+		return -distribution*(1 - distribution)/kT;
+	}
+	case Statistics::BoseEinstein:
+	{
+		double distribution = -getDistribution(energy);
+		return distribution*(1 + distribution)/kT;
+	}
+	default:
+		TBTKExit(
+			"DiscreteLehmannRepresentation::getDistributionDerivative()",
+			"Unknown statistics.",
+			"This should never happen, contact the developer."
+		);
+	}
+}
+
+};	//End of namespace TBTK
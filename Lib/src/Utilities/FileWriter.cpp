@@ -23,6 +23,7 @@
 
 #include <H5Cpp.h>
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -37,6 +38,26 @@ namespace TBTK{
 
 bool FileWriter::isInitialized = false;
 string FileWriter::filename = "TBTKResults.h5";
+FileWriter::Compression FileWriter::compression = Compression::None;
+unsigned int FileWriter::compressionLevel = 6;
+unsigned int FileWriter::chunkSize = 1024*1024;
+H5File *FileWriter::file = nullptr;
+
+namespace{
+	/** Get the HDF5 type corresponding to a C++ type. */
+	template<typename DataType>
+	const PredType& getNativeType();
+
+	template<>
+	const PredType& getNativeType<int>(){
+		return PredType::NATIVE_INT;
+	}
+
+	template<>
+	const PredType& getNativeType<double>(){
+		return PredType::NATIVE_DOUBLE;
+	}
+};
 
 void FileWriter::init(){
 	if(isInitialized)
@@ -55,6 +76,164 @@ void FileWriter::init(){
 	isInitialized = true;
 }
 
+void FileWriter::open(){
+	init();
+
+	if(file != nullptr)
+		return;
+
+	try{
+		Exception::dontPrint();
+		file = new H5File(filename, H5F_ACC_RDWR);
+	}
+	catch(FileIException error){
+		Streams::log << error.getCDetailMsg() << "\n";
+		TBTKExit(
+			"FileWriter::open()",
+			"Unable to open " << filename << ".",
+			""
+		);
+	}
+}
+
+void FileWriter::close(){
+	if(file == nullptr)
+		return;
+
+	file->close();
+	delete file;
+	file = nullptr;
+}
+
+void FileWriter::setCompression(
+	Compression compression,
+	unsigned int level
+){
+	H5Z_filter_t filter;
+	switch(compression){
+	case Compression::None:
+		filter = H5Z_FILTER_NONE;
+		break;
+	case Compression::Deflate:
+		TBTKAssert(
+			level <= 9,
+			"FileWriter::setCompression()",
+			"Invalid compression level '" << level << "'.",
+			"The compression level must be between 0 and 9."
+		);
+		filter = H5Z_FILTER_DEFLATE;
+		break;
+	case Compression::SZIP:
+		filter = H5Z_FILTER_SZIP;
+		break;
+	default:
+		TBTKExit(
+			"FileWriter::setCompression()",
+			"Unknown compression.",
+			"This should never happen, contact the developer."
+		);
+	}
+
+	if(filter != H5Z_FILTER_NONE){
+		unsigned int filterInfo = 0;
+		if(H5Zfilter_avail(filter) > 0)
+			H5Zget_filter_info(filter, &filterInfo);
+		TBTKAssert(
+			filterInfo & H5Z_FILTER_CONFIG_ENCODE_ENABLED,
+			"FileWriter::setCompression()",
+			"The requested compression is not available in the HDF5"
+			<< " library.",
+			""
+		);
+	}
+
+	FileWriter::compression = compression;
+	compressionLevel = level;
+}
+
+FileWriter::FileHandle::FileHandle(){
+	if(FileWriter::file != nullptr){
+		file = FileWriter::file;
+		isOwner = false;
+	}
+	else{
+		file = new H5File(filename, H5F_ACC_RDWR);
+		isOwner = true;
+	}
+}
+
+FileWriter::FileHandle::~FileHandle(){
+	if(isOwner){
+		file->close();
+		delete file;
+	}
+}
+
+DSetCreatPropList FileWriter::createDataSetProperties(
+	const DataSpace &dataspace,
+	unsigned int elementSize,
+	bool isExtendible
+){
+	DSetCreatPropList properties;
+	if(compression == Compression::None && !isExtendible)
+		return properties;
+
+	int rank = dataspace.getSimpleExtentNdims();
+	if(rank == 0)
+		return properties;
+
+	vector<hsize_t> dims(rank);
+	dataspace.getSimpleExtentDims(dims.data());
+	for(int n = (isExtendible ? 1 : 0); n < rank; n++)
+		if(dims[n] == 0)
+			return properties;
+
+	//Keep the trailing dimensions whole and split the leading dimensions
+	//such that each chunk contains roughly chunkSize bytes. The first
+	//dimension of extendible datasets has no fixed size and is filled up
+	//with as many slices as fit.
+	vector<hsize_t> chunkDims(rank);
+	hsize_t numElements = max(chunkSize/elementSize, 1u);
+	hsize_t numChunkElements = 1;
+	for(int n = rank-1; n >= 0; n--){
+		hsize_t size = dims[n];
+		if(n == 0 && isExtendible)
+			size = numElements;
+		chunkDims[n] = max(min(size, numElements), (hsize_t)1);
+		numElements = max(numElements/chunkDims[n], (hsize_t)1);
+		numChunkElements *= chunkDims[n];
+	}
+	properties.setChunk(rank, chunkDims.data());
+
+	switch(compression){
+	case Compression::None:
+		break;
+	case Compression::Deflate:
+		properties.setShuffle();
+		properties.setDeflate(compressionLevel);
+		break;
+	case Compression::SZIP:
+	{
+		//SZIP requires at least one block of pixels per chunk.
+		const unsigned int PIXELS_PER_BLOCK = 16;
+		if(numChunkElements >= PIXELS_PER_BLOCK)
+			properties.setSzip(
+				H5_SZIP_NN_OPTION_MASK,
+				PIXELS_PER_BLOCK
+			);
+		break;
+	}
+	default:
+		TBTKExit(
+			"FileWriter::createDataSetProperties()",
+			"Unknown compression.",
+			"This should never happen, contact the developer."
+		);
+	}
+
+	return properties;
+}
+
 void FileWriter::writeModel(const Model &model, string name, string path){
 	init();
 
@@ -108,7 +287,8 @@ void FileWriter::writeHoppingAmplitudeSet(
 
 	try{
 		Exception::dontPrint();
-		H5File file(filename, H5F_ACC_RDWR);
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
 
 		stringstream ss;
 		ss << path;
@@ -117,7 +297,14 @@ void FileWriter::writeHoppingAmplitudeSet(
 		ss << name << "Indices";
 
 		DataSpace dataspace = DataSpace(INDEX_RANK, indexDims);
-		DataSet dataset = DataSet(file.createDataSet(ss.str(), PredType::STD_I32BE, dataspace));
+		DataSet dataset = DataSet(
+			file.createDataSet(
+				ss.str(),
+				PredType::NATIVE_INT,
+				dataspace,
+				createDataSetProperties(dataspace, sizeof(int))
+			)
+		);
 		dataset.write(indices, PredType::NATIVE_INT);
 		dataspace.close();
 		dataset.close();
@@ -129,12 +316,17 @@ void FileWriter::writeHoppingAmplitudeSet(
 		ss << name << "Amplitudes";
 
 		dataspace = DataSpace(AMPLITUDE_RANK, amplitudeDims);
-		dataset = DataSet(file.createDataSet(ss.str(), PredType::IEEE_F64BE, dataspace));
+		dataset = DataSet(
+			file.createDataSet(
+				ss.str(),
+				PredType::NATIVE_DOUBLE,
+				dataspace,
+				createDataSetProperties(dataspace, sizeof(double))
+			)
+		);
 		dataset.write(amplitudes, PredType::NATIVE_DOUBLE);
 		dataspace.close();
 		dataset.close();
-
-		file.close();
 	}
 	catch(FileIException error){
 		Streams::log << error.getCDetailMsg() << "\n";
@@ -188,7 +380,8 @@ void FileWriter::writeGeometry(
 
 	try{
 		Exception::dontPrint();
-		H5File file(filename, H5F_ACC_RDWR);
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
 
 		stringstream ss;
 		ss << path;
@@ -197,7 +390,14 @@ void FileWriter::writeGeometry(
 		ss << name << "Coordinates";
 
 		DataSpace dataspace = DataSpace(RANK, dDims);
-		DataSet dataset = DataSet(file.createDataSet(ss.str(), PredType::IEEE_F64BE, dataspace));
+		DataSet dataset = DataSet(
+			file.createDataSet(
+				ss.str(),
+				PredType::NATIVE_DOUBLE,
+				dataspace,
+				createDataSetProperties(dataspace, sizeof(double))
+			)
+		);
 		dataset.write(coordinates, PredType::NATIVE_DOUBLE);
 		dataset.close();
 		dataspace.close();
@@ -209,7 +409,14 @@ void FileWriter::writeGeometry(
 		ss << name << "Specifiers";
 
 		dataspace = DataSpace(RANK, sDims);
-		dataset = DataSet(file.createDataSet(ss.str(), PredType::STD_I32BE, dataspace));
+		dataset = DataSet(
+			file.createDataSet(
+				ss.str(),
+				PredType::NATIVE_INT,
+				dataspace,
+				createDataSetProperties(dataspace, sizeof(int))
+			)
+		);
 		if(numSpecifiers != 0){
 			dataset.write(specifiers, PredType::NATIVE_INT);
 		}
@@ -219,8 +426,6 @@ void FileWriter::writeGeometry(
 		}
 		dataspace.close();
 		dataset.close();
-
-		file.close();
 	}
 	catch(FileIException error){
 		Streams::log << error.getCDetailMsg() << "\n";
@@ -278,7 +483,8 @@ void FileWriter::writeIndexTree(
 	hsize_t dims[RANK] = {serializedIndices.size()};
 	try{
 		Exception::dontPrint();
-		H5File file(filename, H5F_ACC_RDWR);
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
 
 		stringstream ss;
 		ss << path;
@@ -287,12 +493,17 @@ void FileWriter::writeIndexTree(
 		ss << name;
 
 		DataSpace dataspace = DataSpace(RANK, dims);
-		DataSet dataset = DataSet(file.createDataSet(ss.str(), PredType::STD_I32BE, dataspace));
+		DataSet dataset = DataSet(
+			file.createDataSet(
+				ss.str(),
+				PredType::NATIVE_INT,
+				dataspace,
+				createDataSetProperties(dataspace, sizeof(int))
+			)
+		);
 		dataset.write(serializedIndices.data(), PredType::NATIVE_INT);
 		dataspace.close();
 		dataset.close();
-
-		file.close();
 	}
 	catch(FileIException error){
 		Streams::log << error.getCDetailMsg() << "\n";
@@ -339,15 +550,21 @@ void FileWriter::writeEigenValues(
 		ss << name;
 
 		Exception::dontPrint();
-		H5File file(filename, H5F_ACC_RDWR);
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
 
 		DataSpace dataspace = DataSpace(RANK, dims);
-		DataSet dataset = DataSet(file.createDataSet(name, PredType::IEEE_F64BE, dataspace));
+		DataSet dataset = DataSet(
+			file.createDataSet(
+				name,
+				PredType::NATIVE_DOUBLE,
+				dataspace,
+				createDataSetProperties(dataspace, sizeof(double))
+			)
+		);
 		dataset.write(ev.getData(), PredType::NATIVE_DOUBLE);
 		dataspace.close();
 		dataset.close();
-
-		file.close();
 	}
 	catch(FileIException error){
 		Streams::log << error.getCDetailMsg() << "\n";
@@ -453,20 +670,26 @@ void FileWriter::writeDOS(const Property::DOS &dos, string name, string path){
 		ss << name;
 
 		Exception::dontPrint();
-		H5File file(filename, H5F_ACC_RDWR);
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
 
 		DataSpace dataspace = DataSpace(DOS_RANK, dos_dims);
-		DataSet dataset = DataSet(file.createDataSet(name, PredType::IEEE_F64BE, dataspace));
+		DataSet dataset = DataSet(
+			file.createDataSet(
+				name,
+				PredType::NATIVE_DOUBLE,
+				dataspace,
+				createDataSetProperties(dataspace, sizeof(double))
+			)
+		);
 		dataset.write(dos.getData(), PredType::NATIVE_DOUBLE);
 		dataspace.close();
 
 		dataspace = DataSpace(LIMITS_RANK, limits_dims);
-		Attribute attribute = dataset.createAttribute("UpLowLimits", PredType::IEEE_F64BE, dataspace);
+		Attribute attribute = dataset.createAttribute("UpLowLimits", PredType::NATIVE_DOUBLE, dataspace);
 		attribute.write(PredType::NATIVE_DOUBLE, limits);
 		dataspace.close();
 		dataset.close();
-
-		file.close();
 	}
 	catch(FileIException error){
 		Streams::log << error.getCDetailMsg() << "\n";
@@ -522,7 +745,7 @@ void FileWriter::writeDensity(
 //		const int *dims = density.getRanges();
 		vector<int> dims = density.getRanges();
 
-		hsize_t density_dims[rank];
+		vector<hsize_t> density_dims(rank);
 		for(int n = 0; n < rank; n++)
 			density_dims[n] = dims[n];
 
@@ -534,14 +757,21 @@ void FileWriter::writeDensity(
 			ss << name;
 
 			Exception::dontPrint();
-			H5File file(filename, H5F_ACC_RDWR);
-
-			DataSpace dataspace = DataSpace(rank, density_dims);
-			DataSet dataset = DataSet(file.createDataSet(name, PredType::IEEE_F64BE, dataspace));
+			FileHandle fileHandle;
+			H5File &file = fileHandle.getFile();
+
+			DataSpace dataspace = DataSpace(rank, density_dims.data());
+			DataSet dataset = DataSet(
+				file.createDataSet(
+					name,
+					PredType::NATIVE_DOUBLE,
+					dataspace,
+					createDataSetProperties(dataspace, sizeof(double))
+				)
+			);
 			dataset.write(density.getData(), PredType::NATIVE_DOUBLE);
 			dataspace.close();
 			dataset.close();
-			file.close();
 		}
 		catch(FileIException error){
 			Streams::log << error.getCDetailMsg() << "\n";
@@ -623,7 +853,7 @@ void FileWriter::writeMagnetization(
 		vector<int> dims = magnetization.getRanges();
 		const SpinMatrix *data = magnetization.getData();
 
-		hsize_t mag_dims[rank+2];//Last two dimension for matrix elements and real/imaginary decomposition.
+		vector<hsize_t> mag_dims(rank+2);//Last two dimension for matrix elements and real/imaginary decomposition.
 		for(int n = 0; n < rank; n++)
 			mag_dims[n] = dims[n];
 		const int NUM_MATRIX_ELEMENTS = 4;
@@ -654,14 +884,21 @@ void FileWriter::writeMagnetization(
 			ss << name;
 
 			Exception::dontPrint();
-			H5File file(filename, H5F_ACC_RDWR);
-
-			DataSpace dataspace = DataSpace(rank+2, mag_dims);
-			DataSet dataset = DataSet(file.createDataSet(name, PredType::IEEE_F64BE, dataspace));
+			FileHandle fileHandle;
+			H5File &file = fileHandle.getFile();
+
+			DataSpace dataspace = DataSpace(rank+2, mag_dims.data());
+			DataSet dataset = DataSet(
+				file.createDataSet(
+					name,
+					PredType::NATIVE_DOUBLE,
+					dataspace,
+					createDataSetProperties(dataspace, sizeof(double))
+				)
+			);
 			dataset.write(mag_decomposed, PredType::NATIVE_DOUBLE);
 			dataspace.close();
 			dataset.close();
-			file.close();
 		}
 		catch(FileIException error){
 			Streams::log << error.getCDetailMsg() << "\n";
@@ -772,7 +1009,7 @@ void FileWriter::writeLDOS(
 //		const int *dims = ldos.getRanges();
 		vector<int> dims = ldos.getRanges();
 
-		hsize_t ldos_dims[rank+1];//Last dimension is for energy
+		vector<hsize_t> ldos_dims(rank+1);//Last dimension is for energy
 		for(int n = 0; n < rank; n++)
 			ldos_dims[n] = dims[n];
 		ldos_dims[rank] = ldos.getResolution();
@@ -792,20 +1029,26 @@ void FileWriter::writeLDOS(
 			ss << name;
 
 			Exception::dontPrint();
-			H5File file(filename, H5F_ACC_RDWR);
-
-			DataSpace dataspace = DataSpace(rank+1, ldos_dims);
-			DataSet dataset = DataSet(file.createDataSet(name, PredType::IEEE_F64BE, dataspace));
+			FileHandle fileHandle;
+			H5File &file = fileHandle.getFile();
+
+			DataSpace dataspace = DataSpace(rank+1, ldos_dims.data());
+			DataSet dataset = DataSet(
+				file.createDataSet(
+					name,
+					PredType::NATIVE_DOUBLE,
+					dataspace,
+					createDataSetProperties(dataspace, sizeof(double))
+				)
+			);
 			dataset.write(ldos.getData(), PredType::NATIVE_DOUBLE);
 			dataspace.close();
 
 			dataspace = DataSpace(LIMITS_RANK, limits_dims);
-			Attribute attribute = dataset.createAttribute("UpLowLimits", PredType::IEEE_F64BE, dataspace);
+			Attribute attribute = dataset.createAttribute("UpLowLimits", PredType::NATIVE_DOUBLE, dataspace);
 			attribute.write(PredType::NATIVE_DOUBLE, limits);
 			dataspace.close();
 			dataset.close();
-
-			file.close();
 		}
 		catch(FileIException error){
 			Streams::log << error.getCDetailMsg() << "\n";
@@ -907,7 +1150,7 @@ void FileWriter::writeSpinPolarizedLDOS(
 		const SpinMatrix *data = spinPolarizedLDOS.getData();
 
 		const int NUM_MATRIX_ELEMENTS = 4;
-		hsize_t sp_ldos_dims[rank+2];//Three last dimensions are for energy, spin components, and real/imaginary decomposition.
+		vector<hsize_t> sp_ldos_dims(rank+3);//Three last dimensions are for energy, spin components, and real/imaginary decomposition.
 		for(int n = 0; n < rank; n++)
 			sp_ldos_dims[n] = dims[n];
 		sp_ldos_dims[rank] = spinPolarizedLDOS.getResolution();
@@ -946,20 +1189,27 @@ void FileWriter::writeSpinPolarizedLDOS(
 			ss << name;
 
 			Exception::dontPrint();
-			H5File file(filename, H5F_ACC_RDWR);
-
-			DataSpace dataspace = DataSpace(rank+3, sp_ldos_dims);
-			DataSet dataset = DataSet(file.createDataSet(name, PredType::IEEE_F64BE, dataspace));
+			FileHandle fileHandle;
+			H5File &file = fileHandle.getFile();
+
+			DataSpace dataspace = DataSpace(rank+3, sp_ldos_dims.data());
+			DataSet dataset = DataSet(
+				file.createDataSet(
+					name,
+					PredType::NATIVE_DOUBLE,
+					dataspace,
+					createDataSetProperties(dataspace, sizeof(double))
+				)
+			);
 			dataset.write(sp_ldos_decomposed, PredType::NATIVE_DOUBLE);
 			dataspace.close();
 
 			dataspace = DataSpace(LIMITS_RANK, limits_dims);
-			Attribute attribute = dataset.createAttribute("UpLowLimits", PredType::IEEE_F64BE, dataspace);
+			Attribute attribute = dataset.createAttribute("UpLowLimits", PredType::NATIVE_DOUBLE, dataspace);
 			attribute.write(PredType::NATIVE_DOUBLE, limits);
 			dataspace.close();
 			dataset.close();
 
-			file.close();
 			dataspace.close();
 		}
 		catch(FileIException error){
@@ -1034,7 +1284,7 @@ void FileWriter::write(
 ){
 	init();
 
-	hsize_t data_dims[rank];
+	vector<hsize_t> data_dims(rank);
 	for(int n = 0; n < rank; n++)
 		data_dims[n] = dims[n];
 
@@ -1046,15 +1296,22 @@ void FileWriter::write(
 		ss << name;
 
 		Exception::dontPrint();
-		H5File file(filename, H5F_ACC_RDWR);
-
-		DataSpace dataspace = DataSpace(rank, data_dims);
-		DataSet dataset = DataSet(file.createDataSet(name, PredType::STD_I32BE, dataspace));
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
+
+		DataSpace dataspace = DataSpace(rank, data_dims.data());
+		DataSet dataset = DataSet(
+			file.createDataSet(
+				name,
+				PredType::NATIVE_INT,
+				dataspace,
+				createDataSetProperties(dataspace, sizeof(int))
+			)
+		);
 		dataset.write(data, PredType::NATIVE_INT);
 		dataspace.close();
 
 		dataset.close();
-		file.close();
 	}
 	catch(FileIException error){
 		Streams::log << error.getCDetailMsg() << "\n";
@@ -1091,7 +1348,7 @@ void FileWriter::write(
 ){
 	init();
 
-	hsize_t data_dims[rank];
+	vector<hsize_t> data_dims(rank);
 	for(int n = 0; n < rank; n++)
 		data_dims[n] = dims[n];
 
@@ -1103,15 +1360,22 @@ void FileWriter::write(
 		ss << name;
 
 		Exception::dontPrint();
-		H5File file(filename, H5F_ACC_RDWR);
-
-		DataSpace dataspace = DataSpace(rank, data_dims);
-		DataSet dataset = DataSet(file.createDataSet(name, PredType::IEEE_F64BE, dataspace));
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
+
+		DataSpace dataspace = DataSpace(rank, data_dims.data());
+		DataSet dataset = DataSet(
+			file.createDataSet(
+				name,
+				PredType::NATIVE_DOUBLE,
+				dataspace,
+				createDataSetProperties(dataspace, sizeof(double))
+			)
+		);
 		dataset.write(data, PredType::NATIVE_DOUBLE);
 		dataspace.close();
 
 		dataset.close();
-		file.close();
 	}
 	catch(FileIException error){
 		Streams::log << error.getCDetailMsg() << "\n";
@@ -1189,18 +1453,18 @@ void FileWriter::writeAttributes(
 		ss << name;
 
 		Exception::dontPrint();
-		H5File file(filename, H5F_ACC_RDWR);
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
 
 		DataSpace dataspace = DataSpace(ATTRIBUTES_RANK, limits_dims);
-		DataSet dataset = DataSet(file.createDataSet(name, PredType::STD_I64BE, dataspace));
+		DataSet dataset = DataSet(file.createDataSet(name, PredType::NATIVE_INT64, dataspace));
 		for(int n = 0; n < num; n++){
-			Attribute attribute = dataset.createAttribute(attribute_names[n], PredType::STD_I64BE, dataspace);
+			Attribute attribute = dataset.createAttribute(attribute_names[n], PredType::NATIVE_INT64, dataspace);
 			attribute.write(PredType::NATIVE_INT, &(attributes[n]));
 		}
 		dataspace.close();
 		dataset.close();
 
-		file.close();
 		dataspace.close();
 	}
 	catch(FileIException error){
@@ -1250,18 +1514,18 @@ void FileWriter::writeAttributes(
 		ss << name;
 
 		Exception::dontPrint();
-		H5File file(filename, H5F_ACC_RDWR);
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
 
 		DataSpace dataspace = DataSpace(ATTRIBUTES_RANK, limits_dims);
-		DataSet dataset = DataSet(file.createDataSet(name, PredType::IEEE_F64BE, dataspace));
+		DataSet dataset = DataSet(file.createDataSet(name, PredType::NATIVE_DOUBLE, dataspace));
 		for(int n = 0; n < num; n++){
-			Attribute attribute = dataset.createAttribute(attribute_names[n], PredType::IEEE_F64BE, dataspace);
+			Attribute attribute = dataset.createAttribute(attribute_names[n], PredType::NATIVE_DOUBLE, dataspace);
 			attribute.write(PredType::NATIVE_DOUBLE, &(attributes[n]));
 		}
 		dataspace.close();
 		dataset.close();
 
-		file.close();
 		dataspace.close();
 	}
 	catch(FileIException error){
@@ -1298,6 +1562,192 @@ bool FileWriter::exists(){
 	return exists;
 }
 
+void FileWriter::writeSlice(
+	const int *data,
+	int rank,
+	const int *dims,
+	unsigned int slice,
+	string name,
+	string path
+){
+	writeHyperslab(data, rank, dims, slice, name, path);
+}
+
+void FileWriter::writeSlice(
+	const double *data,
+	int rank,
+	const int *dims,
+	unsigned int slice,
+	string name,
+	string path
+){
+	writeHyperslab(data, rank, dims, slice, name, path);
+}
+
+void FileWriter::writeSlice(
+	const complex<double> *data,
+	int rank,
+	const int *dims,
+	unsigned int slice,
+	string name,
+	string path
+){
+	unsigned int size = 1;
+	for(unsigned int n = 0; n < (unsigned int)rank; n++)
+		size *= dims[n];
+
+	double *realData = new double[size];
+	double *imagData = new double[size];
+	for(unsigned int n = 0; n < size; n++){
+		realData[n] = real(data[n]);
+		imagData[n] = imag(data[n]);
+	}
+
+	stringstream ss;
+	ss << name << "Real";
+	writeSlice(realData, rank, dims, slice, ss.str(), path);
+	ss.str("");
+	ss << name << "Imag";
+	writeSlice(imagData, rank, dims, slice, ss.str(), path);
+
+	delete [] realData;
+	delete [] imagData;
+}
+
+template<typename DataType>
+void FileWriter::writeHyperslab(
+	const DataType *data,
+	int rank,
+	const int *dims,
+	unsigned int slice,
+	const string &name,
+	const string &path
+){
+	init();
+
+	vector<hsize_t> sliceDims(rank+1);
+	vector<hsize_t> offset(rank+1);
+	sliceDims[0] = 1;
+	offset[0] = slice;
+	for(int n = 0; n < rank; n++){
+		sliceDims[n+1] = dims[n];
+		offset[n+1] = 0;
+	}
+
+	try{
+		stringstream ss;
+		ss << path;
+		if(path.back() != '/')
+			ss << "/";
+		ss << name;
+
+		Exception::dontPrint();
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
+
+		DataSet dataset;
+		if(H5Lexists(file.getId(), ss.str().c_str(), H5P_DEFAULT) > 0){
+			dataset = file.openDataSet(ss.str());
+
+			DataSpace dataspace = dataset.getSpace();
+			TBTKAssert(
+				dataspace.getSimpleExtentNdims() == rank+1,
+				"FileWriter::writeSlice()",
+				"The rank of the slice is incompatible with the"
+				<< " dataset " << name << ".",
+				""
+			);
+			vector<hsize_t> datasetDims(rank+1);
+			dataspace.getSimpleExtentDims(datasetDims.data());
+			for(int n = 1; n < rank+1; n++){
+				TBTKAssert(
+					datasetDims[n] == sliceDims[n],
+					"FileWriter::writeSlice()",
+					"The dimensions of the slice are"
+					<< " incompatible with the dataset "
+					<< name << ".",
+					""
+				);
+			}
+			dataspace.close();
+
+			if(slice >= datasetDims[0]){
+				datasetDims[0] = slice + 1;
+				dataset.extend(datasetDims.data());
+			}
+		}
+		else{
+			vector<hsize_t> datasetDims(rank+1);
+			vector<hsize_t> maxDims(rank+1);
+			datasetDims[0] = slice + 1;
+			maxDims[0] = H5S_UNLIMITED;
+			for(int n = 1; n < rank+1; n++){
+				datasetDims[n] = sliceDims[n];
+				maxDims[n] = sliceDims[n];
+			}
+
+			DataSpace dataspace(
+				rank+1,
+				datasetDims.data(),
+				maxDims.data()
+			);
+			dataset = file.createDataSet(
+				ss.str(),
+				getNativeType<DataType>(),
+				dataspace,
+				createDataSetProperties(
+					dataspace,
+					sizeof(DataType),
+					true
+				)
+			);
+			dataspace.close();
+		}
+
+		DataSpace fileSpace = dataset.getSpace();
+		fileSpace.selectHyperslab(
+			H5S_SELECT_SET,
+			sliceDims.data(),
+			offset.data()
+		);
+		DataSpace memorySpace(rank+1, sliceDims.data());
+		dataset.write(
+			data,
+			getNativeType<DataType>(),
+			memorySpace,
+			fileSpace
+		);
+		memorySpace.close();
+		fileSpace.close();
+
+		dataset.close();
+	}
+	catch(FileIException error){
+		Streams::log << error.getCDetailMsg() << "\n";
+		TBTKExit(
+			"FileWriter::writeSlice()",
+			"While writing to " << name << ".",
+			""
+		);
+	}
+	catch(DataSetIException error){
+		Streams::log << error.getCDetailMsg() << "\n";
+		TBTKExit(
+			"FileWriter::writeSlice()",
+			"While writing to " << name << ".",
+			""
+		);
+	}
+	catch(DataSpaceIException error){
+		Streams::log << error.getCDetailMsg() << "\n";
+		TBTKExit(
+			"FileWriter::writeSlice()",
+			"While writing to " << name << ".",
+			""
+		);
+	}
+}
+
 void FileWriter::writeParameterSet(
 	const ParameterSet *parameterSet,
 	std::string name,
@@ -1316,21 +1766,22 @@ void FileWriter::writeParameterSet(
 		ss << name;
 
 		Exception::dontPrint();
-		H5File file(filename, H5F_ACC_RDWR);
+		FileHandle fileHandle;
+		H5File &file = fileHandle.getFile();
 
 		DataSpace dataspace = DataSpace(ATTRIBUTES_RANK, attribute_dims);
-		DataSet dataset = DataSet(file.createDataSet(name + "Int", PredType::STD_I64BE, dataspace));
+		DataSet dataset = DataSet(file.createDataSet(name + "Int", PredType::NATIVE_INT64, dataspace));
 
 		for(int n = 0; n < parameterSet->getNumInt(); n++){
-			Attribute attribute = dataset.createAttribute(parameterSet->getIntName(n), PredType::STD_I64BE, dataspace);
+			Attribute attribute = dataset.createAttribute(parameterSet->getIntName(n), PredType::NATIVE_INT64, dataspace);
 			int value = parameterSet->getIntValue(n);
 			attribute.write(PredType::NATIVE_INT, &value);
 		}
 
-		dataset = DataSet(file.createDataSet(name + "Double", PredType::IEEE_F64BE, dataspace));
+		dataset = DataSet(file.createDataSet(name + "Double", PredType::NATIVE_DOUBLE, dataspace));
 
 		for(int n = 0; n < parameterSet->getNumDouble(); n++){
-			Attribute attribute = dataset.createAttribute(parameterSet->getDoubleName(n), PredType::IEEE_F64BE, dataspace);
+			Attribute attribute = dataset.createAttribute(parameterSet->getDoubleName(n), PredType::NATIVE_DOUBLE, dataspace);
 			double value = parameterSet->getDoubleValue(n);
 			attribute.write(PredType::NATIVE_DOUBLE, &value);
 		}
@@ -1338,7 +1789,7 @@ void FileWriter::writeParameterSet(
 		const int COMPLEX_RANK = 1;
 		const hsize_t complex_dims[COMPLEX_RANK] = {2};
 		ArrayType complexDataType(PredType::NATIVE_DOUBLE, COMPLEX_RANK, complex_dims);
-		dataset = DataSet(file.createDataSet(name + "Complex", PredType::IEEE_F64BE, dataspace));
+		dataset = DataSet(file.createDataSet(name + "Complex", PredType::NATIVE_DOUBLE, dataspace));
 
 		for(int n = 0; n < parameterSet->getNumComplex(); n++){
 			Attribute attribute = dataset.createAttribute(parameterSet->getComplexName(n), complexDataType, dataspace);
@@ -1357,17 +1808,16 @@ void FileWriter::writeParameterSet(
 			attribute.write(strDataType, strWriteBuf);
 		}
 
-		dataset = DataSet(file.createDataSet(name + "Bool", PredType::STD_I64BE, dataspace));
+		dataset = DataSet(file.createDataSet(name + "Bool", PredType::NATIVE_INT64, dataspace));
 
 		for(int n = 0; n < parameterSet->getNumBool(); n++){
-			Attribute attribute = dataset.createAttribute(parameterSet->getBoolName(n), PredType::STD_I64BE, dataspace);
+			Attribute attribute = dataset.createAttribute(parameterSet->getBoolName(n), PredType::NATIVE_INT64, dataspace);
 			int value = parameterSet->getBoolValue(n);
 			attribute.write(PredType::NATIVE_INT, &value);
 		}
 
 		dataspace.close();
 		dataset.close();
-		file.close();
 	}
 	catch(FileIException error){
 		TBTKExit(
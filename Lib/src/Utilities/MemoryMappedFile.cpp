@@ -0,0 +1,119 @@
+/* Copyright 2018 Kristofer Björnson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file MemoryMappedFile.cpp
+ *
+ *  @author Kristofer Björnson
+ */
+
+#include "TBTK/MemoryMappedFile.h"
+#include "TBTK/TBTKMacros.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace TBTK{
+
+MemoryMappedFile::Mapping::Mapping(
+	const string &filename,
+	Mode mode
+) :
+	mode(mode)
+{
+	int fileDescriptor = open(
+		filename.c_str(),
+		mode == Mode::ReadWrite ? O_RDWR : O_RDONLY
+	);
+	TBTKAssert(
+		fileDescriptor != -1,
+		"MemoryMappedFile::MemoryMappedFile()",
+		"Unable to open file '" << filename << "'.",
+		""
+	);
+
+	struct stat fileStatus;
+	if(fstat(fileDescriptor, &fileStatus) == -1){
+		close(fileDescriptor);
+		TBTKExit(
+			"MemoryMappedFile::MemoryMappedFile()",
+			"Unable to determine the size of '" << filename
+			<< "'.",
+			""
+		);
+	}
+	size = fileStatus.st_size;
+
+	if(size == 0){
+		data = nullptr;
+		close(fileDescriptor);
+
+		return;
+	}
+
+	//Private writable mappings are copy-on-write. MAP_NORESERVE avoids
+	//reserving swap space for the whole file up front, since typically
+	//only a small part of the mapping is written to.
+	int protection;
+	int flags;
+	switch(mode){
+	case Mode::ReadOnly:
+		protection = PROT_READ;
+		flags = MAP_PRIVATE;
+		break;
+	case Mode::CopyOnWrite:
+		protection = PROT_READ | PROT_WRITE;
+		flags = MAP_PRIVATE | MAP_NORESERVE;
+		break;
+	case Mode::ReadWrite:
+		protection = PROT_READ | PROT_WRITE;
+		flags = MAP_SHARED;
+		break;
+	default:
+		close(fileDescriptor);
+		TBTKExit(
+			"MemoryMappedFile::MemoryMappedFile()",
+			"Unknown mode.",
+			"This should never happen, contact the developer."
+		);
+	}
+	void *address = mmap(
+		nullptr,
+		size,
+		protection,
+		flags,
+		fileDescriptor,
+		0
+	);
+	//The mapping remains valid after the file descriptor is closed.
+	close(fileDescriptor);
+	TBTKAssert(
+		address != MAP_FAILED,
+		"MemoryMappedFile::MemoryMappedFile()",
+		"Unable to map file '" << filename << "'.",
+		""
+	);
+	data = (char*)address;
+}
+
+MemoryMappedFile::Mapping::~Mapping(){
+	if(data != nullptr)
+		munmap(data, size);
+}
+
+};	//End of namespace TBTK
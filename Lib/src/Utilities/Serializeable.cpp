@@ -28,6 +28,10 @@ using namespace nlohmann;
 
 namespace TBTK{
 
+constexpr std::uint32_t Serializeable::BINARY_FORMAT_VERSION;
+constexpr std::uint64_t Serializeable::BINARY_ALIGNMENT;
+constexpr std::uint64_t Serializeable::BinaryWriter::CHUNK_SIZE;
+
 bool Serializeable::validate(
 	const string &serialization,
 	const std::string &id,
@@ -69,6 +73,19 @@ bool Serializeable::validate(
 			return false;
 		}
 	}
+	case Mode::Binary:
+	{
+		string serializationID;
+		uint64_t position = parseBinaryHeader(
+			serialization.data(),
+			serialization.size(),
+			&serializationID
+		);
+		if(position == 0)
+			return false;
+
+		return serializationID.compare(id) == 0;
+	}
 	default:
 		TBTKExit(
 			"Serializeable::validate()",
@@ -97,6 +114,12 @@ bool Serializeable::hasID(const string &serialization, Mode mode){
 		catch(json::exception e){
 			return false;
 		}
+	case Mode::Binary:
+		return parseBinaryHeader(
+			serialization.data(),
+			serialization.size(),
+			nullptr
+		) != 0;
 	default:
 		TBTKExit(
 			"Serializeable::hasID()",
@@ -134,6 +157,22 @@ string Serializeable::getID(const string &serialization, Mode mode){
 				""
 			);
 		}
+	case Mode::Binary:
+	{
+		string id;
+		TBTKAssert(
+			parseBinaryHeader(
+				serialization.data(),
+				serialization.size(),
+				&id
+			) != 0,
+			"Serializeable::getID()",
+			"Unable to parse binary serialization string.",
+			""
+		);
+
+		return id;
+	}
 	default:
 		TBTKExit(
 			"Serializeable::getID()",
@@ -246,12 +285,120 @@ string Serializeable::extract(
 				""
 			);
 		}
+	case Mode::Binary:
+	{
+		string id;
+		TBTKAssert(
+			parseBinaryHeader(
+				serialization.data(),
+				serialization.size(),
+				&id
+			) != 0,
+			"Serializeable::extract()",
+			"Unable to parse binary serialization string.",
+			""
+		);
+		BinaryReader reader(serialization, id);
+
+		return reader.readString(component);
+	}
 	default:
 		TBTKExit(
 			"Serializeable::extract()",
-			"Only Serializeable::Mode::JSON is supported yet.",
+			"Only Serializeable::Mode::JSON and"
+			<< " Serializeable::Mode::Binary are supported yet.",
+			""
+		);
+	}
+}
+
+uint64_t Serializeable::parseBinaryHeader(
+	const char *buffer,
+	uint64_t bufferSize,
+	string *id
+){
+	if(bufferSize < 12 || string(buffer, 4).compare("TBTK") != 0)
+		return 0;
+
+	uint32_t formatVersion;
+	copyLittleEndian<uint32_t>((char*)&formatVersion, buffer + 4, 1);
+	if(formatVersion == 0 || formatVersion > BINARY_FORMAT_VERSION)
+		return 0;
+
+	uint32_t idSize;
+	copyLittleEndian<uint32_t>((char*)&idSize, buffer + 8, 1);
+	if(bufferSize < 12 + (uint64_t)idSize)
+		return 0;
+
+	if(id != nullptr)
+		*id = string(buffer + 12, idSize);
+
+	return 12 + idSize;
+}
+
+void Serializeable::BinaryReader::parseFields(const string &id){
+	string serializationID;
+	uint64_t position = parseBinaryHeader(
+		buffer,
+		bufferSize,
+		&serializationID
+	);
+	TBTKAssert(
+		position != 0,
+		"Serializeable::BinaryReader::BinaryReader()",
+		"Unable to parse binary serialization string. The string is"
+		<< " either corrupted or was created with a newer version of"
+		<< " TBTK.",
+		""
+	);
+	TBTKAssert(
+		serializationID.compare(id) == 0,
+		"Serializeable::BinaryReader::BinaryReader()",
+		"Expected a serialization of '" << id << "', but found '"
+		<< serializationID << "'.",
+		""
+	);
+
+	while(position < bufferSize){
+		TBTKAssert(
+			position + 4 <= bufferSize,
+			"Serializeable::BinaryReader::BinaryReader()",
+			"Unexpected end of binary serialization string.",
+			""
+		);
+		uint32_t nameSize;
+		copyLittleEndian<uint32_t>((char*)&nameSize, buffer + position, 1);
+		position += 4;
+
+		TBTKAssert(
+			position + nameSize + 8 <= bufferSize,
+			"Serializeable::BinaryReader::BinaryReader()",
+			"Unexpected end of binary serialization string.",
+			""
+		);
+		string name(buffer + position, nameSize);
+		position += nameSize;
+
+		uint64_t payloadSize;
+		copyLittleEndian<uint64_t>(
+			(char*)&payloadSize,
+			buffer + position,
+			1
+		);
+		position += 8;
+
+		position += (BINARY_ALIGNMENT - position%BINARY_ALIGNMENT)
+			%BINARY_ALIGNMENT;
+
+		TBTKAssert(
+			position <= bufferSize
+			&& payloadSize <= bufferSize - position,
+			"Serializeable::BinaryReader::BinaryReader()",
+			"Unexpected end of binary serialization string.",
 			""
 		);
+		fields[name] = make_pair(position, payloadSize);
+		position += payloadSize;
 	}
 }
 
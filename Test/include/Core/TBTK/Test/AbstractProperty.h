@@ -0,0 +1,170 @@
+#include "TBTK/IndexTree.h"
+#include "TBTK/Property/LDOS.h"
+#include "TBTK/Streams.h"
+
+#include "gtest/gtest.h"
+
+namespace TBTK{
+
+//Returns an LDOS for the Indices {x, spin} with x < numSites, where the
+//value at energy n is x + 10*spin + 100*n.
+inline Property::LDOS createAbstractPropertyTestLDOS(
+	unsigned int numSites,
+	double lowerBound = -1,
+	double upperBound = 1,
+	int resolution = 4
+){
+	IndexTree indexTree;
+	for(unsigned int x = 0; x < numSites; x++){
+		indexTree.add({(int)x, 0});
+		indexTree.add({(int)x, 1});
+	}
+	indexTree.generateLinearMap();
+
+	Property::LDOS ldos(indexTree, lowerBound, upperBound, resolution);
+	for(unsigned int x = 0; x < numSites; x++)
+		for(int spin = 0; spin < 2; spin++)
+			for(int n = 0; n < resolution; n++)
+				ldos({(int)x, spin}, n) = x + 10*spin + 100*n;
+
+	return ldos;
+}
+
+TEST(AbstractProperty, operatorAdditionAssignment){
+	std::string errorMessage = "operator+=() failed.";
+	Property::LDOS ldos0 = createAbstractPropertyTestLDOS(3);
+	Property::LDOS ldos1 = createAbstractPropertyTestLDOS(3);
+	ldos0 += ldos1;
+	for(int x = 0; x < 3; x++)
+		for(int spin = 0; spin < 2; spin++)
+			for(int n = 0; n < 4; n++)
+				EXPECT_EQ(
+					ldos0({x, spin}, n),
+					2*(x + 10*spin + 100*n)
+				) << errorMessage;
+
+	//Different Indices.
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			Property::LDOS ldos2 = createAbstractPropertyTestLDOS(3);
+			Property::LDOS ldos3 = createAbstractPropertyTestLDOS(2);
+			ldos2 += ldos3;
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+
+	//Same size and block size, but different Indices.
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			IndexTree indexTree;
+			for(int x = 1; x < 4; x++){
+				indexTree.add({x, 0});
+				indexTree.add({x, 1});
+			}
+			indexTree.generateLinearMap();
+			Property::LDOS ldos2(indexTree, -1, 1, 4);
+			Property::LDOS ldos3 = createAbstractPropertyTestLDOS(3);
+			ldos2 += ldos3;
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+
+	//Same Indices and block size, but different energy windows.
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			Property::LDOS ldos2 = createAbstractPropertyTestLDOS(3);
+			Property::LDOS ldos3 = createAbstractPropertyTestLDOS(
+				3,
+				-2,
+				2
+			);
+			ldos2 += ldos3;
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+}
+
+TEST(AbstractProperty, operatorSubtractionAssignment){
+	std::string errorMessage = "operator-=() failed.";
+	Property::LDOS ldos0 = createAbstractPropertyTestLDOS(3);
+	Property::LDOS ldos1 = createAbstractPropertyTestLDOS(3);
+	ldos1 *= 3.;
+	ldos0 -= ldos1;
+	for(int x = 0; x < 3; x++)
+		for(int spin = 0; spin < 2; spin++)
+			for(int n = 0; n < 4; n++)
+				EXPECT_EQ(
+					ldos0({x, spin}, n),
+					-2*(x + 10*spin + 100*n)
+				) << errorMessage;
+}
+
+TEST(AbstractProperty, operatorMultiplicationAssignment){
+	std::string errorMessage = "operator*=() failed.";
+	Property::LDOS ldos = createAbstractPropertyTestLDOS(3);
+	ldos *= 2.;
+	for(int x = 0; x < 3; x++)
+		for(int spin = 0; spin < 2; spin++)
+			for(int n = 0; n < 4; n++)
+				EXPECT_EQ(
+					ldos({x, spin}, n),
+					2*(x + 10*spin + 100*n)
+				) << errorMessage;
+}
+
+TEST(AbstractProperty, operatorDivisionAssignment){
+	std::string errorMessage = "operator/=() failed.";
+	Property::LDOS ldos = createAbstractPropertyTestLDOS(3);
+	ldos /= 4.;
+	for(int x = 0; x < 3; x++)
+		for(int spin = 0; spin < 2; spin++)
+			for(int n = 0; n < 4; n++)
+				EXPECT_EQ(
+					ldos({x, spin}, n),
+					(x + 10*spin + 100*n)/4.
+				) << errorMessage;
+}
+
+TEST(AbstractProperty, axpy){
+	std::string errorMessage = "axpy() failed.";
+	Property::LDOS ldos0 = createAbstractPropertyTestLDOS(3);
+	Property::LDOS ldos1 = createAbstractPropertyTestLDOS(3);
+	ldos0.axpy(0.5, ldos1);
+	for(int x = 0; x < 3; x++)
+		for(int spin = 0; spin < 2; spin++)
+			for(int n = 0; n < 4; n++)
+				EXPECT_EQ(
+					ldos0({x, spin}, n),
+					1.5*(x + 10*spin + 100*n)
+				) << errorMessage;
+}
+
+TEST(AbstractProperty, sum){
+	std::string errorMessage = "sum() failed.";
+
+	//Large enough for the sum to be parallelized over the blocks.
+	const unsigned int NUM_SITES = 20000;
+	Property::LDOS ldos = createAbstractPropertyTestLDOS(NUM_SITES);
+
+	std::vector<double> spinUp = ldos.sum({IDX_ALL, 0});
+	ASSERT_EQ(spinUp.size(), 4) << errorMessage;
+	for(int n = 0; n < 4; n++){
+		EXPECT_DOUBLE_EQ(
+			spinUp[n],
+			NUM_SITES*(NUM_SITES - 1)/2. + 100.*n*NUM_SITES
+		) << errorMessage;
+	}
+
+	std::vector<double> site = ldos.sum({7, IDX_ALL});
+	ASSERT_EQ(site.size(), 4) << errorMessage;
+	for(int n = 0; n < 4; n++)
+		EXPECT_EQ(site[n], 2*7 + 10 + 200*n) << errorMessage;
+}
+
+};
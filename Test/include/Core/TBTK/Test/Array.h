@@ -0,0 +1,179 @@
+#include "TBTK/Array.h"
+#include "TBTK/Streams.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <complex>
+
+namespace TBTK{
+
+//Sizes on both sides of the threshold above which the element-wise
+//operations and reductions are parallelized.
+inline std::vector<unsigned int> getArrayTestSizes(){
+	return {100, 200000};
+}
+
+//Returns an Array with ranges {size/4, 4} and integer values, which makes
+//sums independent of the summation order.
+inline Array<double> createArrayTestArray(unsigned int size, int offset){
+	Array<double> array({size/4, 4});
+	for(unsigned int n = 0; n < size; n++)
+		array[n] = (int)((n*7 + offset)%23) - 11;
+
+	return array;
+}
+
+TEST(Array, operatorAdditionAssignment){
+	std::string errorMessage = "operator+=() failed.";
+
+	for(unsigned int size : getArrayTestSizes()){
+		Array<double> lhs = createArrayTestArray(size, 0);
+		Array<double> rhs = createArrayTestArray(size, 5);
+		Array<double> expected = createArrayTestArray(size, 0);
+		for(unsigned int n = 0; n < size; n++)
+			expected[n] += rhs[n];
+		lhs += rhs;
+		for(unsigned int n = 0; n < size; n++)
+			EXPECT_EQ(lhs[n], expected[n]) << errorMessage;
+	}
+}
+
+TEST(Array, operatorSubtractionAssignment){
+	std::string errorMessage = "operator-=() failed.";
+
+	for(unsigned int size : getArrayTestSizes()){
+		Array<double> lhs = createArrayTestArray(size, 0);
+		Array<double> rhs = createArrayTestArray(size, 5);
+		Array<double> expected = createArrayTestArray(size, 0);
+		for(unsigned int n = 0; n < size; n++)
+			expected[n] -= rhs[n];
+		lhs -= rhs;
+		for(unsigned int n = 0; n < size; n++)
+			EXPECT_EQ(lhs[n], expected[n]) << errorMessage;
+	}
+}
+
+TEST(Array, operatorMultiplicationAssignment){
+	std::string errorMessage = "operator*=() failed.";
+
+	for(unsigned int size : getArrayTestSizes()){
+		Array<double> array = createArrayTestArray(size, 0);
+		array *= 3;
+		Array<double> original = createArrayTestArray(size, 0);
+		for(unsigned int n = 0; n < size; n++)
+			EXPECT_EQ(array[n], 3*original[n]) << errorMessage;
+	}
+}
+
+TEST(Array, operatorDivisionAssignment){
+	std::string errorMessage = "operator/=() failed.";
+
+	for(unsigned int size : getArrayTestSizes()){
+		Array<double> array = createArrayTestArray(size, 0);
+		array /= 4;
+		Array<double> original = createArrayTestArray(size, 0);
+		for(unsigned int n = 0; n < size; n++)
+			EXPECT_EQ(array[n], original[n]/4) << errorMessage;
+	}
+}
+
+TEST(Array, axpy){
+	std::string errorMessage = "axpy() failed.";
+
+	for(unsigned int size : getArrayTestSizes()){
+		Array<double> y = createArrayTestArray(size, 0);
+		Array<double> x = createArrayTestArray(size, 5);
+		y.axpy(2, x);
+		Array<double> original = createArrayTestArray(size, 0);
+		for(unsigned int n = 0; n < size; n++){
+			EXPECT_EQ(y[n], original[n] + 2*x[n])
+				<< errorMessage;
+		}
+	}
+
+	//Arrays with different ranges are incompatible.
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			Array<double> y({4, 4});
+			Array<double> x({2, 8});
+			y.axpy(1, x);
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+}
+
+TEST(Array, sum){
+	std::string errorMessage = "sum() failed.";
+
+	for(unsigned int size : getArrayTestSizes()){
+		Array<double> array = createArrayTestArray(size, 3);
+		double expected = 0;
+		for(unsigned int n = 0; n < size; n++)
+			expected += array[n];
+		EXPECT_EQ(array.sum(), expected) << errorMessage;
+
+		Array<std::complex<double>> complexArray({size});
+		std::complex<double> complexExpected = 0;
+		for(unsigned int n = 0; n < size; n++){
+			complexArray[n] = std::complex<double>(
+				array[n],
+				(int)(n%5)
+			);
+			complexExpected += complexArray[n];
+		}
+		EXPECT_EQ(complexArray.sum(), complexExpected) << errorMessage;
+	}
+}
+
+TEST(Array, norm){
+	std::string errorMessage = "norm() failed.";
+
+	for(unsigned int size : getArrayTestSizes()){
+		Array<double> array = createArrayTestArray(size, 3);
+		double expected = 0;
+		for(unsigned int n = 0; n < size; n++)
+			expected += array[n]*array[n];
+		EXPECT_DOUBLE_EQ(array.norm(), sqrt(expected)) << errorMessage;
+
+		Array<std::complex<double>> complexArray({size}, {3, 4});
+		EXPECT_NEAR(complexArray.norm(), 5*sqrt(size), 1e-10*size)
+			<< errorMessage;
+	}
+}
+
+TEST(Array, max){
+	std::string errorMessage = "max() failed.";
+
+	for(unsigned int size : getArrayTestSizes()){
+		Array<double> array = createArrayTestArray(size, 3);
+		EXPECT_EQ(array.max(), 11) << errorMessage;
+		array[size - 2] = 100;
+		EXPECT_EQ(array.max(), 100) << errorMessage;
+	}
+
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			Array<double> array({0});
+			array.max();
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+}
+
+TEST(Array, min){
+	std::string errorMessage = "min() failed.";
+
+	for(unsigned int size : getArrayTestSizes()){
+		Array<double> array = createArrayTestArray(size, 3);
+		EXPECT_EQ(array.min(), -11) << errorMessage;
+		array[size - 2] = -100;
+		EXPECT_EQ(array.min(), -100) << errorMessage;
+	}
+}
+
+};
@@ -0,0 +1,105 @@
+#include "TBTK/BasisIndexLookupTable.h"
+
+#include "gtest/gtest.h"
+
+namespace TBTK{
+
+TEST(BasisIndexLookupTable, Constructor){
+	BasisIndexLookupTable basisIndexLookupTable;
+	EXPECT_FALSE(basisIndexLookupTable.getIsGenerated());
+	EXPECT_TRUE(
+		basisIndexLookupTable.getType()
+		== BasisIndexLookupTable::Type::None
+	);
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({0, 0, 0}), -1);
+}
+
+TEST(BasisIndexLookupTable, generateDense){
+	HoppingAmplitudeTree hoppingAmplitudeTree;
+	for(int x = 0; x < 3; x++){
+		for(int y = 0; y < 4; y++){
+			hoppingAmplitudeTree.add(
+				HoppingAmplitude(1, {x, y}, {x, y})
+			);
+		}
+	}
+	hoppingAmplitudeTree.generateBasisIndices();
+
+	BasisIndexLookupTable basisIndexLookupTable;
+	basisIndexLookupTable.generate(hoppingAmplitudeTree);
+	EXPECT_TRUE(basisIndexLookupTable.getIsGenerated());
+	EXPECT_TRUE(
+		basisIndexLookupTable.getType()
+		== BasisIndexLookupTable::Type::Dense
+	);
+
+	for(int x = 0; x < 3; x++){
+		for(int y = 0; y < 4; y++){
+			EXPECT_EQ(
+				basisIndexLookupTable.getBasisIndex({x, y}),
+				hoppingAmplitudeTree.getBasisIndex({x, y})
+			);
+		}
+	}
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({3, 0}), -1);
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({0}), -1);
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({0, 0, 0}), -1);
+
+	for(int n = 0; n < 12; n++){
+		EXPECT_TRUE(
+			basisIndexLookupTable.getPhysicalIndex(n).equals(
+				hoppingAmplitudeTree.getPhysicalIndex(n)
+			)
+		);
+	}
+}
+
+TEST(BasisIndexLookupTable, generateHash){
+	HoppingAmplitudeTree hoppingAmplitudeTree;
+	hoppingAmplitudeTree.add(HoppingAmplitude(1, {0, 0, 0}, {0, 0, 0}));
+	hoppingAmplitudeTree.add(HoppingAmplitude(1, {0, 0, 1}, {0, 0, 1}));
+	hoppingAmplitudeTree.add(HoppingAmplitude(1, {0, 0, 1}, {0, 0, 2}));
+	hoppingAmplitudeTree.add(HoppingAmplitude(1, {0, 0, 2}, {0, 0, 1}));
+	hoppingAmplitudeTree.add(HoppingAmplitude(1, {9, 9, 0}, {9, 9, 0}));
+	hoppingAmplitudeTree.add(HoppingAmplitude(1, {9, 9, 0}, {9, 9, 1}));
+	hoppingAmplitudeTree.add(HoppingAmplitude(1, {9, 9, 1}, {9, 9, 0}));
+	hoppingAmplitudeTree.generateBasisIndices();
+
+	BasisIndexLookupTable basisIndexLookupTable;
+	basisIndexLookupTable.generate(hoppingAmplitudeTree);
+	EXPECT_TRUE(
+		basisIndexLookupTable.getType()
+		== BasisIndexLookupTable::Type::Hash
+	);
+
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({0, 0, 0}), 0);
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({0, 0, 1}), 1);
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({0, 0, 2}), 2);
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({9, 9, 0}), 3);
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({9, 9, 1}), 4);
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({1, 1, 1}), -1);
+
+	EXPECT_TRUE(basisIndexLookupTable.getPhysicalIndex(3).equals({9, 9, 0}));
+}
+
+TEST(BasisIndexLookupTable, generateMixedRank){
+	HoppingAmplitudeTree hoppingAmplitudeTree;
+	hoppingAmplitudeTree.add(HoppingAmplitude(1, {0, 0}, {0, 0}));
+	hoppingAmplitudeTree.add(HoppingAmplitude(1, {1, 0, 0}, {1, 0, 0}));
+	hoppingAmplitudeTree.generateBasisIndices();
+
+	BasisIndexLookupTable basisIndexLookupTable;
+	basisIndexLookupTable.generate(hoppingAmplitudeTree);
+	EXPECT_TRUE(basisIndexLookupTable.getIsGenerated());
+	EXPECT_TRUE(
+		basisIndexLookupTable.getType()
+		== BasisIndexLookupTable::Type::None
+	);
+	EXPECT_EQ(basisIndexLookupTable.getBasisIndex({0, 0}), -1);
+	EXPECT_TRUE(basisIndexLookupTable.getPhysicalIndex(0).equals({0, 0}));
+	EXPECT_TRUE(
+		basisIndexLookupTable.getPhysicalIndex(1).equals({1, 0, 0})
+	);
+}
+
+};
@@ -0,0 +1,202 @@
+#include "TBTK/BrillouinZone.h"
+#include "TBTK/Model.h"
+#include "TBTK/Property/DOS.h"
+#include "TBTK/RPA/BrillouinZoneIntegrator.h"
+#include "TBTK/RPA/MomentumSpaceContext.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace TBTK{
+
+//Returns the basis vectors of the cubic Brillouin zone in the given number
+//of dimensions.
+inline std::vector<std::vector<double>> getBrillouinZoneIntegratorTestBasisVectors(
+	unsigned int dimension
+){
+	std::vector<std::vector<double>> basisVectors;
+	for(unsigned int n = 0; n < dimension; n++){
+		basisVectors.push_back(std::vector<double>(dimension, 0));
+		basisVectors[n][n] = 2*M_PI;
+	}
+
+	return basisVectors;
+}
+
+//Adds a two orbital model on a cubic mesh to the Model and initializes the
+//MomentumSpaceContext. The band energies lie in the interval
+//[-2*dimension - 1, 2*dimension + 1.5].
+inline void initBrillouinZoneIntegratorTestContext(
+	Model &model,
+	const BrillouinZone &brillouinZone,
+	unsigned int numMeshPointsPerDimension,
+	MomentumSpaceContext &momentumSpaceContext
+){
+	unsigned int dimension = brillouinZone.getNumDimensions();
+	std::vector<unsigned int> numMeshPoints(
+		dimension,
+		numMeshPointsPerDimension
+	);
+
+	model.setTemperature(300);
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(numMeshPoints);
+	for(unsigned int n = 0; n < mesh.size(); n++){
+		const std::vector<double> &k = mesh[n];
+		Index kIndex = brillouinZone.getMinorCellIndex(k, numMeshPoints);
+		double energy = 0;
+		std::vector<int> index0;
+		for(unsigned int c = 0; c < dimension; c++){
+			energy -= 2*cos(k[c]);
+			index0.push_back(kIndex[c]);
+		}
+		std::vector<int> index1 = index0;
+		index0.push_back(0);
+		index1.push_back(1);
+		model << HoppingAmplitude(energy, index0, index0);
+		model << HoppingAmplitude(-energy + 0.3, index1, index1);
+		model << HoppingAmplitude(0.2, index0, index1) + HC;
+	}
+	model.construct();
+
+	momentumSpaceContext.setModel(model);
+	momentumSpaceContext.setBrillouinZone(brillouinZone);
+	momentumSpaceContext.setNumMeshPoints(numMeshPoints);
+	momentumSpaceContext.setNumOrbitals(2);
+	momentumSpaceContext.init();
+}
+
+//Returns the integral of the DOS divided by the number of mesh points.
+inline double integrateBrillouinZoneIntegratorTestDOS(
+	const Property::DOS &dos,
+	unsigned int meshSize
+){
+	double dE = (dos.getUpperBound() - dos.getLowerBound())
+		/dos.getResolution();
+	double integral = 0;
+	for(int n = 0; n < dos.getResolution(); n++)
+		integral += dos(n)*dE/meshSize;
+
+	return integral;
+}
+
+TEST(BrillouinZoneIntegrator, calculateDOSTetrahedron){
+	std::string errorMessage = "calculateDOSTetrahedron() failed.";
+
+	//When the energy window covers all bands, the DOS integrates to the
+	//number of states per mesh point independently of the resolution.
+	for(unsigned int dimension = 1; dimension <= 3; dimension++){
+		BrillouinZone brillouinZone(
+			getBrillouinZoneIntegratorTestBasisVectors(dimension),
+			SpacePartition::MeshType::Nodal
+		);
+		Model model;
+		MomentumSpaceContext momentumSpaceContext;
+		initBrillouinZoneIntegratorTestContext(
+			model,
+			brillouinZone,
+			dimension == 3 ? 8 : 16,
+			momentumSpaceContext
+		);
+		unsigned int meshSize = momentumSpaceContext.getMesh().size();
+		BrillouinZoneIntegrator integrator(momentumSpaceContext);
+		for(int resolution : {7, 40, 1000}){
+			Property::DOS dos = integrator.calculateDOSTetrahedron(
+				-2.*dimension - 1,
+				2.*dimension + 1.5,
+				resolution
+			);
+			EXPECT_NEAR(
+				integrateBrillouinZoneIntegratorTestDOS(
+					dos,
+					meshSize
+				),
+				2,
+				1e-10
+			) << errorMessage;
+		}
+	}
+}
+
+TEST(BrillouinZoneIntegrator, calculateDOSAdaptiveSmearing){
+	std::string errorMessage = "calculateDOSAdaptiveSmearing() failed.";
+
+	//The Gaussians are normalized, so only the tails outside of the
+	//energy window are lost.
+	for(unsigned int dimension = 1; dimension <= 3; dimension++){
+		BrillouinZone brillouinZone(
+			getBrillouinZoneIntegratorTestBasisVectors(dimension),
+			SpacePartition::MeshType::Nodal
+		);
+		Model model;
+		MomentumSpaceContext momentumSpaceContext;
+		initBrillouinZoneIntegratorTestContext(
+			model,
+			brillouinZone,
+			dimension == 3 ? 8 : 16,
+			momentumSpaceContext
+		);
+		unsigned int meshSize = momentumSpaceContext.getMesh().size();
+		BrillouinZoneIntegrator integrator(momentumSpaceContext);
+		Property::DOS dos = integrator.calculateDOSAdaptiveSmearing(
+			-2.*dimension - 4,
+			2.*dimension + 4.5,
+			400
+		);
+		EXPECT_NEAR(
+			integrateBrillouinZoneIntegratorTestDOS(dos, meshSize),
+			2,
+			1e-3
+		) << errorMessage;
+	}
+}
+
+TEST(BrillouinZoneIntegrator, calculateOccupationsTetrahedron){
+	std::string errorMessage = "calculateOccupationsTetrahedron() failed.";
+
+	//The occupations sum to the integral of the tetrahedron DOS up to the
+	//Fermi energy, and to the number of states when all states are
+	//occupied.
+	BrillouinZone brillouinZone(
+		getBrillouinZoneIntegratorTestBasisVectors(3),
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	MomentumSpaceContext momentumSpaceContext;
+	initBrillouinZoneIntegratorTestContext(
+		model,
+		brillouinZone,
+		8,
+		momentumSpaceContext
+	);
+	unsigned int meshSize = momentumSpaceContext.getMesh().size();
+	BrillouinZoneIntegrator integrator(momentumSpaceContext);
+	for(double fermiEnergy : {-3., -0.7, 0.4, 7.5}){
+		std::vector<double> occupations
+			= integrator.calculateOccupationsTetrahedron(fermiEnergy);
+		ASSERT_EQ(occupations.size(), 2*meshSize) << errorMessage;
+		double occupation = 0;
+		for(unsigned int n = 0; n < occupations.size(); n++)
+			occupation += occupations[n]/meshSize;
+
+		Property::DOS dos = integrator.calculateDOSTetrahedron(
+			-7,
+			fermiEnergy,
+			100
+		);
+		EXPECT_NEAR(
+			occupation,
+			integrateBrillouinZoneIntegratorTestDOS(dos, meshSize),
+			1e-10
+		) << errorMessage;
+	}
+	std::vector<double> occupations
+		= integrator.calculateOccupationsTetrahedron(7.5);
+	double occupation = 0;
+	for(unsigned int n = 0; n < occupations.size(); n++)
+		occupation += occupations[n]/meshSize;
+	EXPECT_NEAR(occupation, 2, 1e-10) << errorMessage;
+}
+
+};
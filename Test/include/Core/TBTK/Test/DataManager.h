@@ -0,0 +1,314 @@
+#include "TBTK/DataManager.h"
+#include "TBTK/Property/DOS.h"
+#include "TBTK/Streams.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utime.h>
+
+namespace TBTK{
+
+inline bool dataManagerTestFileExists(const std::string &filename){
+	struct stat status;
+	return stat(filename.c_str(), &status) == 0;
+}
+
+//Temporary directory for the files written by a test. The directory and its
+//content are removed when the object goes out of scope, also when the test
+//fails.
+class DataManagerTestDirectory{
+public:
+	DataManagerTestDirectory(){
+		const char *temporaryDirectory = getenv("TMPDIR");
+		std::string pattern = std::string(
+			temporaryDirectory == nullptr ? "/tmp" : temporaryDirectory
+		) + "/TBTKTestDataManagerXXXXXX";
+		std::vector<char> buffer(pattern.begin(), pattern.end());
+		buffer.push_back('\0');
+		if(mkdtemp(buffer.data()) != nullptr)
+			path = std::string(buffer.data()) + "/";
+	}
+
+	~DataManagerTestDirectory(){
+		if(path.empty())
+			return;
+
+		DIR *directory = opendir(path.c_str());
+		if(directory != nullptr){
+			while(struct dirent *entry = readdir(directory)){
+				std::string filename = entry->d_name;
+				if(filename != "." && filename != "..")
+					std::remove((path + filename).c_str());
+			}
+			closedir(directory);
+		}
+		rmdir(path.c_str());
+	}
+
+	const std::string& getPath() const{
+		return path;
+	}
+private:
+	std::string path;
+};
+
+//Sets up a DataManager with one data type that uses file reservations in
+//the given directory.
+inline void initDataManagerTestReservations(
+	DataManager &dataManager,
+	const std::string &path
+){
+	dataManager.setPath(path);
+	dataManager.addDataType("DOS", DataManager::FileType::Custom);
+	dataManager.setUseFileReservations(true);
+	dataManager.setLeaseTime(60);
+}
+
+TEST(DataManager, FileReservations){
+	std::string errorMessage = "File reservation failed.";
+	std::string name = "TBTKTestDataManagerFileReservations";
+	DataManagerTestDirectory directory;
+	ASSERT_FALSE(directory.getPath().empty()) << errorMessage;
+	std::string lockFilename = directory.getPath() + name + "_0_DOS.lock";
+
+	DataManager dataManager0({0}, {1}, {3}, {"x"}, name);
+	initDataManagerTestReservations(dataManager0, directory.getPath());
+	EXPECT_EQ(dataManager0.reserveDataPoint("DOS"), 0) << errorMessage;
+	EXPECT_TRUE(dataManagerTestFileExists(lockFilename)) << errorMessage;
+
+	//A lock that is within its lease is respected.
+	DataManager dataManager1({0}, {1}, {3}, {"x"}, name);
+	initDataManagerTestReservations(dataManager1, directory.getPath());
+	EXPECT_EQ(dataManager1.reserveDataPoint("DOS"), 1) << errorMessage;
+
+	//An expired lock is broken.
+	struct utimbuf times;
+	times.actime = time(nullptr) - 120;
+	times.modtime = times.actime;
+	utime(lockFilename.c_str(), &times);
+	DataManager dataManager2({0}, {1}, {3}, {"x"}, name);
+	initDataManagerTestReservations(dataManager2, directory.getPath());
+	EXPECT_EQ(dataManager2.reserveDataPoint("DOS"), 0) << errorMessage;
+	EXPECT_TRUE(dataManagerTestFileExists(lockFilename)) << errorMessage;
+
+	//Renewing the reservation extends the lease.
+	utime(lockFilename.c_str(), &times);
+	dataManager2.renewReservation("DOS", 0);
+	struct stat status;
+	ASSERT_EQ(stat(lockFilename.c_str(), &status), 0) << errorMessage;
+	EXPECT_GT(status.st_mtime, times.modtime) << errorMessage;
+
+	//Completion replaces the lock by a completion marker, which prevents
+	//the data point from being reserved again.
+	dataManager2.markCompleted("DOS", 0);
+	EXPECT_FALSE(dataManagerTestFileExists(lockFilename)) << errorMessage;
+	EXPECT_TRUE(
+		dataManagerTestFileExists(
+			directory.getPath() + name + "_0_DOS.completed"
+		)
+	) << errorMessage;
+	dataManager1.markCompleted("DOS", 1);
+	DataManager dataManager3({0}, {1}, {3}, {"x"}, name);
+	initDataManagerTestReservations(dataManager3, directory.getPath());
+	EXPECT_EQ(dataManager3.reserveDataPoint("DOS"), 2) << errorMessage;
+	EXPECT_EQ(dataManager3.reserveDataPoint("DOS"), -1) << errorMessage;
+}
+
+TEST(DataManager, FileReservationsMultipleProcesses){
+	std::string errorMessage = "File reservations between processes failed.";
+	std::string name = "TBTKTestDataManagerMultipleProcesses";
+	DataManagerTestDirectory directory;
+	ASSERT_FALSE(directory.getPath().empty()) << errorMessage;
+	const int NUM_DATA_POINTS = 100;
+	const unsigned int NUM_WORKERS = 4;
+
+	//Each worker process reserves and completes data points until none
+	//are left, and records the completed data points in a file of its
+	//own. The workers only use the DataManager and terminate through
+	//_exit(), since the process may have been forked from a multithreaded
+	//process.
+	std::vector<pid_t> workers;
+	for(unsigned int n = 0; n < NUM_WORKERS; n++){
+		pid_t pid = fork();
+		ASSERT_GE(pid, 0) << errorMessage;
+		if(pid == 0){
+			DataManager dataManager(
+				{0},
+				{1},
+				{NUM_DATA_POINTS},
+				{"x"},
+				name
+			);
+			initDataManagerTestReservations(
+				dataManager,
+				directory.getPath()
+			);
+			std::ofstream fout(
+				directory.getPath() + "worker"
+				+ std::to_string(n)
+			);
+			int id;
+			while((id = dataManager.reserveDataPoint("DOS")) != -1){
+				fout << id << "\n";
+				dataManager.markCompleted("DOS", id);
+			}
+			fout.close();
+			_exit(fout.fail() ? 1 : 0);
+		}
+		workers.push_back(pid);
+	}
+	for(unsigned int n = 0; n < workers.size(); n++){
+		int status;
+		ASSERT_EQ(waitpid(workers[n], &status, 0), workers[n])
+			<< errorMessage;
+		EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0)
+			<< errorMessage;
+	}
+
+	//Every data point is completed by exactly one worker.
+	std::multiset<int> completedIDs;
+	for(unsigned int n = 0; n < NUM_WORKERS; n++){
+		std::ifstream fin(directory.getPath() + "worker" + std::to_string(n));
+		int id;
+		while(fin >> id)
+			completedIDs.insert(id);
+	}
+	EXPECT_EQ(completedIDs.size(), NUM_DATA_POINTS) << errorMessage;
+	for(int n = 0; n < NUM_DATA_POINTS; n++)
+		EXPECT_EQ(completedIDs.count(n), 1) << errorMessage;
+}
+
+TEST(DataManager, complete){
+	std::string errorMessage = "complete() failed.";
+	std::string name = "TBTKTestDataManagerComplete";
+	DataManagerTestDirectory directory;
+	ASSERT_FALSE(directory.getPath().empty()) << errorMessage;
+
+	DataManager dataManager({0}, {1}, {2}, {"x"}, name);
+	dataManager.setPath(directory.getPath());
+	dataManager.addDataType(
+		"DOS",
+		DataManager::FileType::SerializeableJSON
+	);
+	dataManager.setUseJournal(true);
+	Property::DOS dos(-1, 1, 10);
+	dataManager.complete(dos, "DOS", 0);
+	dataManager.complete(dos, "DOS", 1);
+	dataManager.flush();
+	for(int n = 0; n < 2; n++){
+		EXPECT_TRUE(
+			dataManagerTestFileExists(
+				directory.getPath()
+				+ dataManager.getFilename("DOS", n)
+			)
+		) << errorMessage;
+	}
+	EXPECT_EQ(dataManager.reserveDataPoint("DOS"), -1) << errorMessage;
+
+	//The journal has one line per completed data point.
+	std::ifstream fin(dataManager.getJournalFilename());
+	std::string line;
+	unsigned int numLines = 0;
+	while(std::getline(fin, line))
+		numLines++;
+	fin.close();
+	EXPECT_EQ(numLines, 2) << errorMessage;
+}
+
+TEST(DataManager, completeBinary){
+	std::string errorMessage = "complete() failed for binary files.";
+	std::string name = "TBTKTestDataManagerCompleteBinary";
+	DataManagerTestDirectory directory;
+	ASSERT_FALSE(directory.getPath().empty()) << errorMessage;
+
+	DataManager dataManager({0}, {1}, {1}, {"x"}, name);
+	dataManager.setPath(directory.getPath());
+	dataManager.addDataType(
+		"DOS",
+		DataManager::FileType::SerializeableBinary
+	);
+	double data[10];
+	for(unsigned int n = 0; n < 10; n++)
+		data[n] = n/3.;
+	Property::DOS dos(-1, 1, 10, data);
+	dataManager.complete(dos, "DOS", 0);
+	dataManager.flush();
+
+	std::ifstream fin(
+		directory.getPath() + dataManager.getFilename("DOS", 0),
+		std::ios::binary
+	);
+	std::string serialization(
+		(std::istreambuf_iterator<char>(fin)),
+		std::istreambuf_iterator<char>()
+	);
+	fin.close();
+	EXPECT_EQ(
+		serialization,
+		dos.serialize(Serializeable::Mode::Binary)
+	) << errorMessage;
+	Property::DOS storedDOS(serialization, Serializeable::Mode::Binary);
+	EXPECT_EQ(storedDOS.getResolution(), 10) << errorMessage;
+	for(unsigned int n = 0; n < 10; n++)
+		EXPECT_EQ(storedDOS(n), data[n]) << errorMessage;
+}
+
+TEST(DataManager, flush){
+	std::string name = "TBTKTestDataManagerFlush";
+
+	//Write errors on the writer thread are reported by flush().
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			DataManager dataManager({0}, {1}, {2}, {"x"}, name);
+			dataManager.addDataType(
+				"DOS",
+				DataManager::FileType::SerializeableJSON
+			);
+			dataManager.setPath("TBTKTestNonexistentDirectory");
+			Property::DOS dos(-1, 1, 10);
+			dataManager.complete(dos, "DOS", 0);
+			dataManager.flush();
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+}
+
+TEST(DataManager, destructor){
+	std::string errorMessage = "~DataManager() failed.";
+	std::string name = "TBTKTestDataManagerDestructor";
+
+	//Write errors that have not been reported by flush() are printed by
+	//the destructor.
+	std::stringstream ss;
+	std::streambuf *errBuffer = Streams::err.rdbuf(ss.rdbuf());
+	{
+		DataManager dataManager({0}, {1}, {2}, {"x"}, name);
+		dataManager.addDataType(
+			"DOS",
+			DataManager::FileType::SerializeableJSON
+		);
+		dataManager.setPath("TBTKTestNonexistentDirectory");
+		Property::DOS dos(-1, 1, 10);
+		dataManager.complete(dos, "DOS", 0);
+	}
+	Streams::err.rdbuf(errBuffer);
+	EXPECT_NE(ss.str().find("A write failed."), std::string::npos)
+		<< errorMessage;
+}
+
+};
@@ -0,0 +1,48 @@
+#include "TBTK/Model.h"
+#include "TBTK/Solver/Diagonalizer.h"
+
+#include "gtest/gtest.h"
+
+#include <complex>
+
+namespace TBTK{
+
+//Parameter read by the callback function below.
+inline double& getDiagonalizerTestParameter(){
+	static double parameter = 0;
+
+	return parameter;
+}
+
+inline std::complex<double> diagonalizerTestCallback(
+	const Index &toIndex,
+	const Index &fromIndex
+){
+	return getDiagonalizerTestParameter();
+}
+
+TEST(Diagonalizer, run){
+	std::string errorMessage = "run() failed.";
+
+	//The on-site energies are given by a callback function, which must be
+	//reevaluated each time the Diagonalizer is run.
+	Model model;
+	model << HoppingAmplitude(diagonalizerTestCallback, {0}, {0});
+	model << HoppingAmplitude(diagonalizerTestCallback, {1}, {1});
+	model << HoppingAmplitude(1, {0}, {1}) + HC;
+	model.construct();
+
+	Solver::Diagonalizer solver;
+	solver.setVerbose(false);
+	solver.setModel(model);
+	for(double parameter : {0., 0.5, -2.}){
+		getDiagonalizerTestParameter() = parameter;
+		solver.run();
+		EXPECT_NEAR(solver.getEigenValue(0), parameter - 1, 1e-12)
+			<< errorMessage;
+		EXPECT_NEAR(solver.getEigenValue(1), parameter + 1, 1e-12)
+			<< errorMessage;
+	}
+}
+
+};
@@ -0,0 +1,120 @@
+#ifdef TBTK_USE_HDF5
+
+#include "TBTK/FileReader.h"
+#include "TBTK/FileWriter.h"
+
+#include "gtest/gtest.h"
+
+#include <complex>
+#include <vector>
+
+namespace TBTK{
+
+//Sets the file name used by both the FileWriter and the FileReader and
+//removes any existing file with the same name.
+inline void initFileWriterTestFile(const std::string &filename){
+	FileWriter::setFileName(filename);
+	FileReader::setFileName(filename);
+	FileWriter::clear();
+}
+
+//Returns the values written to the test datasets.
+inline std::vector<double> getFileWriterTestValues(
+	unsigned int size,
+	double offset
+){
+	std::vector<double> values;
+	for(unsigned int n = 0; n < size; n++)
+		values.push_back(offset + 0.5*n);
+
+	return values;
+}
+
+TEST(FileWriter, write){
+	std::string errorMessage = "write() failed.";
+	initFileWriterTestFile("TBTKTestFileWriterWrite.h5");
+
+	//Datasets are read back unchanged with and without compression, and
+	//independently of whether the file is kept open between the writes.
+	const int dims[2] = {3, 40};
+	std::vector<double> values = getFileWriterTestValues(120, -1);
+	std::vector<std::complex<double>> complexValues;
+	for(unsigned int n = 0; n < values.size(); n++)
+		complexValues.push_back(std::complex<double>(values[n], n));
+	FileWriter::setChunkSize(256);
+	FileWriter::write(values.data(), 2, dims, "Contiguous");
+	FileWriter::setCompression(FileWriter::Compression::Deflate);
+	FileWriter::open();
+	FileWriter::write(values.data(), 2, dims, "Deflate");
+	FileWriter::write(complexValues.data(), 2, dims, "Complex");
+	FileWriter::close();
+	FileWriter::setCompression(FileWriter::Compression::None);
+	FileWriter::setChunkSize(1024*1024);
+
+	for(std::string name : {"Contiguous", "Deflate"}){
+		double *data;
+		int rank;
+		int *readDims;
+		FileReader::read(&data, &rank, &readDims, name);
+		ASSERT_EQ(rank, 2) << errorMessage;
+		EXPECT_EQ(readDims[0], dims[0]) << errorMessage;
+		EXPECT_EQ(readDims[1], dims[1]) << errorMessage;
+		for(unsigned int n = 0; n < values.size(); n++)
+			EXPECT_EQ(data[n], values[n]) << errorMessage;
+		delete [] data;
+		delete [] readDims;
+	}
+
+	std::complex<double> *data;
+	int rank;
+	int *readDims;
+	FileReader::read(&data, &rank, &readDims, "Complex");
+	ASSERT_EQ(rank, 2) << errorMessage;
+	for(unsigned int n = 0; n < complexValues.size(); n++)
+		EXPECT_EQ(data[n], complexValues[n]) << errorMessage;
+	delete [] data;
+	delete [] readDims;
+
+	FileWriter::clear();
+}
+
+TEST(FileWriter, writeSlice){
+	std::string errorMessage = "writeSlice() failed.";
+	initFileWriterTestFile("TBTKTestFileWriterWriteSlice.h5");
+
+	//The dataset is extended as slices are written, and slices can be
+	//overwritten and written out of order.
+	const int dims[2] = {2, 5};
+	FileWriter::setChunkSize(64);
+	FileWriter::open();
+	for(unsigned int slice : {0, 2, 1, 0}){
+		std::vector<double> values
+			= getFileWriterTestValues(10, 100*slice);
+		FileWriter::writeSlice(values.data(), 2, dims, slice, "Sweep");
+	}
+	FileWriter::close();
+	FileWriter::setChunkSize(1024*1024);
+
+	double *data;
+	int rank;
+	int *readDims;
+	FileReader::read(&data, &rank, &readDims, "Sweep");
+	ASSERT_EQ(rank, 3) << errorMessage;
+	EXPECT_EQ(readDims[0], 3) << errorMessage;
+	EXPECT_EQ(readDims[1], dims[0]) << errorMessage;
+	EXPECT_EQ(readDims[2], dims[1]) << errorMessage;
+	for(unsigned int slice = 0; slice < 3; slice++){
+		std::vector<double> values
+			= getFileWriterTestValues(10, 100*slice);
+		for(unsigned int n = 0; n < values.size(); n++)
+			EXPECT_EQ(data[10*slice + n], values[n]) << errorMessage;
+	}
+	delete [] data;
+	delete [] readDims;
+
+	FileWriter::clear();
+}
+
+};
+
+#endif
@@ -0,0 +1,218 @@
+#ifdef TBTK_USE_FFTW3
+
+#include "TBTK/FourierTransform.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace TBTK{
+
+//Reference implementation of the normalized multi-dimensional discrete
+//Fourier transform.
+inline std::vector<std::complex<double>> calculateFourierTransformTestDFT(
+	const std::vector<std::complex<double>> &in,
+	const std::vector<unsigned int> &ranges,
+	int sign
+){
+	std::vector<std::complex<double>> data = in;
+	unsigned int stride = data.size();
+	for(unsigned int d = 0; d < ranges.size(); d++){
+		stride /= ranges[d];
+		std::vector<std::complex<double>> result(data.size());
+		for(unsigned int n = 0; n < data.size(); n++){
+			unsigned int k = (n/stride)%ranges[d];
+			unsigned int base = n - k*stride;
+			for(unsigned int x = 0; x < ranges[d]; x++){
+				result[n] += data[base + x*stride]*std::polar(
+					1/sqrt(ranges[d]),
+					sign*2*M_PI*k*x/ranges[d]
+				);
+			}
+		}
+		data = result;
+	}
+
+	return data;
+}
+
+//Returns test data that is not symmetric under any permutation.
+inline std::vector<std::complex<double>> getFourierTransformTestData(
+	unsigned int size,
+	unsigned int offset
+){
+	std::vector<std::complex<double>> data;
+	for(unsigned int n = 0; n < size; n++){
+		data.push_back(
+			std::complex<double>(
+				cos(0.7*(n + offset)) + 0.1*n,
+				sin(1.3*(n + offset))
+			)
+		);
+	}
+
+	return data;
+}
+
+TEST(FourierTransform, realToComplex){
+	std::string errorMessage = "Real to complex transform failed.";
+
+	//The real to complex transform stores the first ranges.back()/2 + 1
+	//elements along the last dimension of the complex transform. The
+	//complex to real transform restores the original data.
+	for(
+		std::vector<unsigned int> ranges : {
+			std::vector<unsigned int>({7}),
+			std::vector<unsigned int>({4, 6}),
+			std::vector<unsigned int>({3, 2, 5})
+		}
+	){
+		unsigned int size = 1;
+		for(unsigned int n = 0; n < ranges.size(); n++)
+			size *= ranges[n];
+		unsigned int halfLast = ranges.back()/2 + 1;
+		unsigned int halfSize = size/ranges.back()*halfLast;
+
+		std::vector<double> real(size);
+		std::vector<std::complex<double>> complexData(halfSize);
+		FourierTransform::ForwardPlan<double, std::complex<double>>
+			forwardPlan(real.data(), complexData.data(), ranges);
+		FourierTransform::InversePlan<std::complex<double>, double>
+			inversePlan(complexData.data(), real.data(), ranges);
+
+		std::vector<std::complex<double>> data
+			= getFourierTransformTestData(size, 0);
+		for(unsigned int n = 0; n < size; n++){
+			real[n] = data[n].real();
+			data[n] = real[n];
+		}
+		std::vector<std::complex<double>> reference
+			= calculateFourierTransformTestDFT(data, ranges, -1);
+
+		FourierTransform::transform(forwardPlan);
+		for(unsigned int n = 0; n < halfSize; n++){
+			unsigned int outer = n/halfLast;
+			unsigned int last = n%halfLast;
+			EXPECT_NEAR(
+				abs(
+					complexData[n]
+					- reference[outer*ranges.back() + last]
+				),
+				0,
+				1e-10
+			) << errorMessage;
+		}
+
+		for(unsigned int n = 0; n < size; n++)
+			real[n] = 0;
+		FourierTransform::transform(inversePlan);
+		for(unsigned int n = 0; n < size; n++)
+			EXPECT_NEAR(real[n], data[n].real(), 1e-10) << errorMessage;
+	}
+}
+
+TEST(FourierTransform, batched){
+	std::string errorMessage = "Batched transform failed.";
+
+	//Each of the batched transforms agrees with the reference
+	//implementation, both when the transforms are stored one after
+	//another and when they are interleaved.
+	const std::vector<unsigned int> ranges = {2, 3};
+	const unsigned int SIZE = 6;
+	const unsigned int NUM_TRANSFORMS = 4;
+	for(
+		FourierTransform::Layout layout : {
+			FourierTransform::Layout::Consecutive,
+			FourierTransform::Layout::Interleaved
+		}
+	){
+		std::vector<std::complex<double>> in(SIZE*NUM_TRANSFORMS);
+		std::vector<std::complex<double>> out(SIZE*NUM_TRANSFORMS);
+		FourierTransform::ForwardPlan<std::complex<double>> plan(
+			in.data(),
+			out.data(),
+			ranges,
+			NUM_TRANSFORMS,
+			layout
+		);
+
+		std::vector<std::vector<std::complex<double>>> data;
+		for(unsigned int t = 0; t < NUM_TRANSFORMS; t++){
+			data.push_back(getFourierTransformTestData(SIZE, 10*t));
+			for(unsigned int n = 0; n < SIZE; n++){
+				if(layout == FourierTransform::Layout::Consecutive)
+					in[t*SIZE + n] = data[t][n];
+				else
+					in[n*NUM_TRANSFORMS + t] = data[t][n];
+			}
+		}
+
+		FourierTransform::transform(plan);
+		for(unsigned int t = 0; t < NUM_TRANSFORMS; t++){
+			std::vector<std::complex<double>> reference
+				= calculateFourierTransformTestDFT(
+					data[t],
+					ranges,
+					-1
+				);
+			for(unsigned int n = 0; n < SIZE; n++){
+				std::complex<double> value;
+				if(layout == FourierTransform::Layout::Consecutive)
+					value = out[t*SIZE + n];
+				else
+					value = out[n*NUM_TRANSFORMS + t];
+				EXPECT_NEAR(abs(value - reference[n]), 0, 1e-10)
+					<< errorMessage;
+			}
+		}
+	}
+}
+
+TEST(FourierTransform, wisdom){
+	std::string errorMessage = "Wisdom import/export failed.";
+	const char *temporaryDirectory = getenv("TMPDIR");
+	std::string filename = std::string(
+		temporaryDirectory == nullptr ? "/tmp" : temporaryDirectory
+	) + "/TBTKTestFourierTransformWisdom" + std::to_string(getpid());
+
+	//Wisdom that has been exported can be imported again, while a
+	//missing file is reported.
+	std::remove(filename.c_str());
+	EXPECT_FALSE(FourierTransform::importWisdom(filename)) << errorMessage;
+
+	FourierTransform::setPlanningRigor(
+		FourierTransform::PlanningRigor::Measure
+	);
+	std::vector<std::complex<double>> in(16);
+	std::vector<std::complex<double>> out(16);
+	{
+		FourierTransform::ForwardPlan<std::complex<double>> plan(
+			in.data(),
+			out.data(),
+			16
+		);
+	}
+	FourierTransform::setPlanningRigor(
+		FourierTransform::PlanningRigor::Estimate
+	);
+
+	FourierTransform::exportWisdom(filename);
+	std::ifstream fin(filename);
+	EXPECT_TRUE(fin.good()) << errorMessage;
+	fin.close();
+	EXPECT_TRUE(FourierTransform::importWisdom(filename)) << errorMessage;
+
+	std::remove(filename.c_str());
+}
+
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "TBTK/IndexTree.h"
+#include "TBTK/MemoryMappedFile.h"
+#include "TBTK/Property/GreensFunction.h"
+
+#include "gtest/gtest.h"
+
+#include <complex>
+#include <cstdio>
+#include <fstream>
+
+namespace TBTK{
+
+//Returns a retarded GreensFunction for two sites and three energies.
+inline Property::GreensFunction createGreensFunctionTestGreensFunction(){
+	IndexTree indexTree;
+	indexTree.add({Index({0}), Index({0})});
+	indexTree.add({Index({1}), Index({0})});
+	indexTree.generateLinearMap();
+	Property::GreensFunction greensFunction(
+		indexTree,
+		Property::GreensFunction::Type::Retarded,
+		-2,
+		3,
+		3
+	);
+	for(unsigned int n = 0; n < 3; n++){
+		greensFunction({Index({0}), Index({0})}, n)
+			= std::complex<double>(n, 1);
+		greensFunction({Index({1}), Index({0})}, n)
+			= std::complex<double>(-1, 10 + n);
+	}
+
+	return greensFunction;
+}
+
+//Expects the GreensFunction to agree with the one created by
+//createGreensFunctionTestGreensFunction().
+inline void expectGreensFunctionTestEqual(
+	const Property::GreensFunction &greensFunction,
+	const std::string &errorMessage
+){
+	EXPECT_TRUE(
+		greensFunction.getType()
+		== Property::GreensFunction::Type::Retarded
+	) << errorMessage;
+	EXPECT_EQ(greensFunction.getLowerBound(), -2) << errorMessage;
+	EXPECT_EQ(greensFunction.getUpperBound(), 3) << errorMessage;
+	EXPECT_EQ(greensFunction.getResolution(), 3) << errorMessage;
+	EXPECT_EQ(greensFunction.getSize(), 6) << errorMessage;
+	for(unsigned int n = 0; n < 3; n++){
+		EXPECT_EQ(
+			greensFunction({Index({0}), Index({0})}, n),
+			std::complex<double>(n, 1)
+		) << errorMessage;
+		EXPECT_EQ(
+			greensFunction({Index({1}), Index({0})}, n),
+			std::complex<double>(-1, 10 + n)
+		) << errorMessage;
+	}
+}
+
+TEST(GreensFunction, serialize){
+	std::string errorMessage = "serialize() failed.";
+	Property::GreensFunction greensFunction
+		= createGreensFunctionTestGreensFunction();
+
+	for(
+		Serializeable::Mode mode : {
+			Serializeable::Mode::JSON,
+			Serializeable::Mode::Binary
+		}
+	){
+		Property::GreensFunction copy(
+			greensFunction.serialize(mode),
+			mode
+		);
+		expectGreensFunctionTestEqual(copy, errorMessage);
+	}
+}
+
+TEST(GreensFunction, MemoryMappedFile){
+	std::string errorMessage = "Memory mapped GreensFunction failed.";
+	std::string filename = "TBTKTestGreensFunction.bin";
+	std::string serialization
+		= createGreensFunctionTestGreensFunction().serialize(
+			Serializeable::Mode::Binary
+		);
+	std::ofstream fout(filename, std::ios::binary);
+	fout.write(serialization.data(), serialization.size());
+	fout.close();
+
+	{
+		const Property::GreensFunction greensFunction(
+			(MemoryMappedFile(filename))
+		);
+		EXPECT_TRUE(greensFunction.isMemoryMapped()) << errorMessage;
+		expectGreensFunctionTestEqual(greensFunction, errorMessage);
+	}
+
+	std::remove(filename.c_str());
+}
+
+};
@@ -31,6 +31,45 @@ TEST(HoppingAmplitude, ConstructorAmplitudeCallback){
 	EXPECT_TRUE(hoppingAmplitude.getFromIndex().equals({3, 4, 5})) << errorMessage;
 }
 
+class ScaledAmplitudeCallback : public HoppingAmplitude::AmplitudeCallback{
+public:
+	ScaledAmplitudeCallback(double scale) : scale(scale){}
+
+	virtual std::complex<double> getHoppingAmplitude(
+		const Index &to,
+		const Index &from
+	) const{
+		return scale*amplitudeCallback(to, from);
+	}
+private:
+	double scale;
+};
+
+TEST(HoppingAmplitude, ConstructorAmplitudeCallbackObject){
+	std::string errorMessage = "AmplitudeCallback constructor failed.";
+
+	ScaledAmplitudeCallback callback0(1);
+	ScaledAmplitudeCallback callback1(2);
+	HoppingAmplitude hoppingAmplitude0(callback0, {1, 2}, {3, 4, 5});
+	HoppingAmplitude hoppingAmplitude1(callback1, {1, 2}, {3, 4, 5});
+	EXPECT_EQ(hoppingAmplitude0.getAmplitude(), std::complex<double>(3, 4)) << errorMessage;
+	EXPECT_EQ(hoppingAmplitude1.getAmplitude(), std::complex<double>(6, 8)) << errorMessage;
+	EXPECT_EQ(hoppingAmplitude0.getAmplitudeCallback(), &callback0) << errorMessage;
+	EXPECT_TRUE(hoppingAmplitude0.getToIndex().equals({1, 2})) << errorMessage;
+	EXPECT_TRUE(hoppingAmplitude0.getFromIndex().equals({3, 4, 5})) << errorMessage;
+
+	HoppingAmplitude hoppingAmplitude2 = hoppingAmplitude1.getHermitianConjugate();
+	EXPECT_EQ(hoppingAmplitude2.getAmplitude(), std::complex<double>(6, -8)) << errorMessage;
+
+	const Index *toIndices[2] = {&hoppingAmplitude1.getToIndex(), &hoppingAmplitude2.getToIndex()};
+	const Index *fromIndices[2] = {&hoppingAmplitude1.getFromIndex(), &hoppingAmplitude2.getFromIndex()};
+	int basisIndices[2] = {0, 1};
+	std::complex<double> amplitudes[2];
+	callback1.getHoppingAmplitudes(2, toIndices, fromIndices, basisIndices, basisIndices, amplitudes);
+	EXPECT_EQ(amplitudes[0], std::complex<double>(6, 8)) << errorMessage;
+	EXPECT_EQ(amplitudes[1], std::complex<double>(6, -8)) << errorMessage;
+}
+
 TEST(HoppingAmplitude, CopyConstructor){
 	std::string errorMessage = "Copy constructor failed.";
 
@@ -61,6 +100,19 @@ TEST(HoppingAmplitude, SerializeToJSON){
 	EXPECT_TRUE(hoppingAmplitude0.getFromIndex().equals(hoppingAmplitude1.getFromIndex())) << errorMessage;
 }
 
+TEST(HoppingAmplitude, SerializeToBinary){
+	std::string errorMessage = "Binary serialization failed.";
+
+	HoppingAmplitude hoppingAmplitude0(std::complex<double>(1, 2), {1, 2, 3}, {4, 5});
+	HoppingAmplitude hoppingAmplitude1(
+		hoppingAmplitude0.serialize(Serializeable::Mode::Binary),
+		Serializeable::Mode::Binary
+	);
+	EXPECT_EQ(hoppingAmplitude0.getAmplitude(), hoppingAmplitude1.getAmplitude()) << errorMessage;
+	EXPECT_TRUE(hoppingAmplitude0.getToIndex().equals(hoppingAmplitude1.getToIndex())) << errorMessage;
+	EXPECT_TRUE(hoppingAmplitude0.getFromIndex().equals(hoppingAmplitude1.getFromIndex())) << errorMessage;
+}
+
 TEST(HoppingAmplitude, getHermitianConjugate){
 	std::string errorMessage = "getHermitianConjugate() failed.";
 
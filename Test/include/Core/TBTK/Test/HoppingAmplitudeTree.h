@@ -44,6 +44,33 @@ TEST(HoppingAmplitudeTree, SerializeToJSON){
 	EXPECT_TRUE(indices[1].equals({1, 1, 1}));
 }
 
+TEST(HoppingAmplitudeTree, SerializeToBinary){
+	HoppingAmplitudeTree hoppingAmplitudeTree0;
+	hoppingAmplitudeTree0.add(HoppingAmplitude(1, {0, 0, 0}, {0, 0, 0}));
+	hoppingAmplitudeTree0.add(HoppingAmplitude(2, {0, 0, 1}, {0, 0, 1}));
+	hoppingAmplitudeTree0.add(HoppingAmplitude(3, {0, 0, 1}, {0, 0, 2}));
+	hoppingAmplitudeTree0.add(HoppingAmplitude(4, {0, 0, 2}, {0, 0, 1}));
+	hoppingAmplitudeTree0.add(HoppingAmplitude(5, {1, 1, 0}, {1, 1, 0}));
+	hoppingAmplitudeTree0.add(HoppingAmplitude(6, {1, 1, 0}, {1, 1, 1}));
+	hoppingAmplitudeTree0.add(HoppingAmplitude(7, {1, 1, 1}, {1, 1, 0}));
+	hoppingAmplitudeTree0.generateBasisIndices();
+
+	HoppingAmplitudeTree hoppingAmplitudeTree1(
+		hoppingAmplitudeTree0.serialize(Serializeable::Mode::Binary),
+		Serializeable::Mode::Binary
+	);
+
+	EXPECT_EQ(hoppingAmplitudeTree1.getBasisSize(), 5);
+	EXPECT_EQ(hoppingAmplitudeTree1.getBasisIndex({0, 0, 2}), 2);
+	EXPECT_EQ(hoppingAmplitudeTree1.getBasisIndex({1, 1, 1}), 4);
+
+	const std::vector<HoppingAmplitude> &hoppingAmplitudes
+		= *hoppingAmplitudeTree1.getHAs({1, 1, 0});
+	EXPECT_EQ(hoppingAmplitudes.size(), 2);
+	EXPECT_EQ(hoppingAmplitudes[0].getAmplitude(), std::complex<double>(5, 0));
+	EXPECT_TRUE(hoppingAmplitudes[1].getToIndex().equals({1, 1, 1}));
+}
+
 TEST(HoppingAmplitudeTree, add){
 	EXPECT_EXIT(
 		{
@@ -90,6 +117,114 @@ TEST(HoppingAmplitudeTree, add){
 	);
 }
 
+TEST(HoppingAmplitudeTree, addBulk){
+	std::string errorMessage = "add() with vector failed.";
+
+	//Sparse and unordered first subindices, duplicates, and Indices with
+	//different number of subindices in different subtrees.
+	std::vector<HoppingAmplitude> hoppingAmplitudes = {
+		HoppingAmplitude(1, {1000000, 1}, {1000000, 0}),
+		HoppingAmplitude(2, {3, 4, 5}, {3, 4, 5}),
+		HoppingAmplitude(3, {0, 0}, {1000000, 0}),
+		HoppingAmplitude(4, {1000000, 0}, {0, 0}),
+		HoppingAmplitude(5, {3, 4, 5}, {3, 4, 5}),
+		HoppingAmplitude(6, {0, 0}, {0, 0}),
+		HoppingAmplitude(7, {3, 4, 6}, {3, 4, 5})
+	};
+
+	HoppingAmplitudeTree hoppingAmplitudeTree0;
+	for(unsigned int n = 0; n < hoppingAmplitudes.size(); n++)
+		hoppingAmplitudeTree0.add(hoppingAmplitudes[n]);
+	hoppingAmplitudeTree0.generateBasisIndices();
+
+	HoppingAmplitudeTree hoppingAmplitudeTree1;
+	std::vector<HoppingAmplitude> bulk = hoppingAmplitudes;
+	hoppingAmplitudeTree1.add(bulk);
+	hoppingAmplitudeTree1.generateBasisIndices();
+	EXPECT_EQ(bulk.size(), 0) << errorMessage;
+
+	EXPECT_EQ(
+		hoppingAmplitudeTree1.getBasisSize(),
+		hoppingAmplitudeTree0.getBasisSize()
+	) << errorMessage;
+	for(unsigned int n = 0; n < hoppingAmplitudes.size(); n++){
+		const Index &fromIndex = hoppingAmplitudes[n].getFromIndex();
+		EXPECT_EQ(
+			hoppingAmplitudeTree1.getBasisIndex(fromIndex),
+			hoppingAmplitudeTree0.getBasisIndex(fromIndex)
+		) << errorMessage;
+
+		const std::vector<HoppingAmplitude> &has0
+			= *hoppingAmplitudeTree0.getHAs(fromIndex);
+		const std::vector<HoppingAmplitude> &has1
+			= *hoppingAmplitudeTree1.getHAs(fromIndex);
+		ASSERT_EQ(has1.size(), has0.size()) << errorMessage;
+		for(unsigned int c = 0; c < has0.size(); c++){
+			EXPECT_EQ(
+				has1[c].getAmplitude(),
+				has0[c].getAmplitude()
+			) << errorMessage;
+			EXPECT_TRUE(
+				has1[c].getToIndex().equals(
+					has0[c].getToIndex()
+				)
+			) << errorMessage;
+		}
+	}
+	EXPECT_EQ(hoppingAmplitudeTree1.getHAs({3, 4, 5})->size(), 3) << errorMessage;
+
+	//Bulk addition on top of previously added HoppingAmplitudes.
+	HoppingAmplitudeTree hoppingAmplitudeTree2;
+	hoppingAmplitudeTree2.add(HoppingAmplitude(1, {2, 0}, {2, 0}));
+	bulk = {
+		HoppingAmplitude(2, {2, 1}, {2, 0}),
+		HoppingAmplitude(3, {2, 0}, {2, 1})
+	};
+	hoppingAmplitudeTree2.add(bulk);
+	hoppingAmplitudeTree2.generateBasisIndices();
+	EXPECT_EQ(hoppingAmplitudeTree2.getBasisSize(), 2) << errorMessage;
+	EXPECT_EQ(hoppingAmplitudeTree2.getHAs({2, 0})->size(), 2) << errorMessage;
+
+	//Mixed number of subindices within the same subtree.
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			HoppingAmplitudeTree hoppingAmplitudeTree;
+			std::vector<HoppingAmplitude> incompatible;
+			incompatible.push_back(HoppingAmplitude(1, {1, 2}, {3, 4}));
+			incompatible.push_back(HoppingAmplitude(1, {1, 2}, {3, 4, 5}));
+			hoppingAmplitudeTree.add(incompatible);
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			HoppingAmplitudeTree hoppingAmplitudeTree;
+			hoppingAmplitudeTree.add(HoppingAmplitude(1, {1, 2}, {3, 4}));
+			std::vector<HoppingAmplitude> incompatible;
+			incompatible.push_back(HoppingAmplitude(1, {1, 2}, {3}));
+			hoppingAmplitudeTree.add(incompatible);
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			HoppingAmplitudeTree hoppingAmplitudeTree;
+			std::vector<HoppingAmplitude> negative;
+			negative.push_back(HoppingAmplitude(1, {1, 2}, {-1, 5}));
+			hoppingAmplitudeTree.add(negative);
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+}
+
 TEST(HoppingAmplitudeTree, getBasisSize){
 	std::string errorMessage = "getBasisSize() failed.";
 
@@ -35,6 +35,43 @@ TEST(Index, CopyConstructor){
 	EXPECT_EQ(indexCopy[2], 3) << "Copy constructor failed.";
 }
 
+TEST(Index, CopyConstructorLargeIndex){
+	std::string errorMessage = "Copy constructor failed for large Index.";
+
+	Index index({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+	Index indexCopy = index;
+	index[0] = 100;
+	EXPECT_EQ(indexCopy.getSize(), 12) << errorMessage;
+	for(int n = 0; n < 12; n++)
+		EXPECT_EQ(indexCopy[n], n) << errorMessage;
+}
+
+TEST(Index, MoveConstructor){
+	std::string errorMessage = "Move constructor failed.";
+
+	Index index0({1, 2, 3});
+	Index index1 = std::move(index0);
+	EXPECT_TRUE(index1.equals({1, 2, 3})) << errorMessage;
+
+	Index index2({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+	Index index3 = std::move(index2);
+	EXPECT_EQ(index3.getSize(), 12) << errorMessage;
+	for(int n = 0; n < 12; n++)
+		EXPECT_EQ(index3[n], n) << errorMessage;
+}
+
+TEST(Index, AssignmentOperator){
+	std::string errorMessage = "Assignment operator failed.";
+
+	Index index0({1, 2, 3});
+	Index index1({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+	index0 = index1;
+	EXPECT_EQ(index0.getSize(), 12) << errorMessage;
+	EXPECT_EQ(index0[11], 11) << errorMessage;
+	index1 = Index({4, 5});
+	EXPECT_TRUE(index1.equals({4, 5})) << errorMessage;
+}
+
 TEST(Index, ConstructorConcatenationInitializerList){
 	std::string errorMessage = "Index concatenation filed.";
 
@@ -156,6 +193,15 @@ TEST(Index, push_back){
 	EXPECT_TRUE(index.equals({1, 2, 3})) << "push_back failed.";
 }
 
+TEST(Index, push_backBeyondStackCapacity){
+	Index index;
+	for(int n = 0; n < 20; n++)
+		index.push_back(n);
+	EXPECT_EQ(index.getSize(), 20) << "push_back failed.";
+	for(int n = 0; n < 20; n++)
+		EXPECT_EQ(index[n], n) << "push_back failed.";
+}
+
 TEST(Index, popFront){
 	std::string errorMessage = "popFront() failed.";
 
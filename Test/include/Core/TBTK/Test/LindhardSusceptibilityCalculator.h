@@ -0,0 +1,110 @@
+#include "TBTK/BrillouinZone.h"
+#include "TBTK/Model.h"
+#include "TBTK/RPA/LindhardSusceptibilityCalculator.h"
+#include "TBTK/RPA/MomentumSpaceContext.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace TBTK{
+
+TEST(LindhardSusceptibilityCalculator, calculateSusceptibility){
+	std::string errorMessage = "calculateSusceptibility() failed.";
+
+	//Three orbitals with complex inter orbital hoppings, such that all
+	//orbital combinations contribute.
+	const std::vector<unsigned int> NUM_MESH_POINTS = {6, 5};
+	const int NUM_ORBITALS = 3;
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(NUM_MESH_POINTS);
+	Model model;
+	model.setTemperature(300);
+	for(unsigned int n = 0; n < mesh.size(); n++){
+		const std::vector<double> &k = mesh[n];
+		Index kIndex = brillouinZone.getMinorCellIndex(
+			k,
+			NUM_MESH_POINTS
+		);
+		for(int o0 = 0; o0 < NUM_ORBITALS; o0++){
+			model << HoppingAmplitude(
+				-2*cos(k[0] + o0) - 2*cos(k[1]) + 0.3*o0,
+				{kIndex[0], kIndex[1], o0},
+				{kIndex[0], kIndex[1], o0}
+			);
+			for(int o1 = o0 + 1; o1 < NUM_ORBITALS; o1++){
+				model << HoppingAmplitude(
+					std::complex<double>(
+						0.3*sin(k[0]),
+						0.2*cos(k[1]*o1)
+					),
+					{kIndex[0], kIndex[1], o0},
+					{kIndex[0], kIndex[1], o1}
+				) + HC;
+			}
+		}
+	}
+	model.construct();
+
+	MomentumSpaceContext momentumSpaceContext;
+	momentumSpaceContext.setModel(model);
+	momentumSpaceContext.setBrillouinZone(brillouinZone);
+	momentumSpaceContext.setNumMeshPoints(NUM_MESH_POINTS);
+	momentumSpaceContext.setNumOrbitals(NUM_ORBITALS);
+	momentumSpaceContext.init();
+
+	//Both real energies, which require pole handling, and complex
+	//energies.
+	std::vector<std::complex<double>> energies;
+	for(int n = 0; n < 6; n++)
+		energies.push_back(std::complex<double>(0.1*n, n%2 ? 0.05 : 0));
+
+	//The susceptibilities for all energies are calculated for all
+	//orbital combinations at once, and agree with the single energy
+	//expression.
+	LindhardSusceptibilityCalculator calculator(momentumSpaceContext);
+	calculator.setEnergies(energies);
+	for(unsigned int n = 0; n < mesh.size(); n += 7){
+		const std::vector<double> &q = mesh[n];
+		DualIndex qIndex(
+			brillouinZone.getMinorCellIndex(q, NUM_MESH_POINTS),
+			q
+		);
+		for(int orbitals = 0; orbitals < 81; orbitals++){
+			std::vector<int> orbitalIndices = {
+				(orbitals/27)%3,
+				(orbitals/9)%3,
+				(orbitals/3)%3,
+				orbitals%3
+			};
+			std::vector<std::complex<double>> result
+				= calculator.calculateSusceptibility(
+					qIndex,
+					orbitalIndices
+				);
+			ASSERT_EQ(result.size(), energies.size())
+				<< errorMessage;
+			for(unsigned int e = 0; e < energies.size(); e++){
+				std::complex<double> reference
+					= calculator.calculateSusceptibility(
+						q,
+						orbitalIndices,
+						energies[e]
+					);
+				EXPECT_NEAR(
+					abs(result[e] - reference),
+					0,
+					1e-12*std::max(abs(reference), 1.)
+				) << errorMessage;
+			}
+		}
+	}
+}
+
+};
@@ -0,0 +1,378 @@
+#include "TBTK/BrillouinZone.h"
+#include "TBTK/Model.h"
+#include "TBTK/RPA/LindhardSusceptibilityCalculator.h"
+#include "TBTK/RPA/MatsubaraSusceptibilityCalculator.h"
+#include "TBTK/RPA/MomentumSpaceContext.h"
+#include "TBTK/UnitHandler.h"
+
+#ifdef TBTK_USE_FFTW3
+#	include "TBTK/MatsubaraConvolver.h"
+#endif
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace TBTK{
+
+//Adds a two orbital model on the minor mesh of the Brillouin zone to the
+//Model and initializes the MomentumSpaceContext.
+inline void initMatsubaraSusceptibilityCalculatorTestContext(
+	Model &model,
+	const BrillouinZone &brillouinZone,
+	const std::vector<unsigned int> &numMeshPoints,
+	MomentumSpaceContext &momentumSpaceContext,
+	double temperature = 300
+){
+	model.setTemperature(temperature);
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(numMeshPoints);
+	for(unsigned int n = 0; n < mesh.size(); n++){
+		const std::vector<double> &k = mesh[n];
+		Index kIndex = brillouinZone.getMinorCellIndex(k, numMeshPoints);
+		double energy = -2*cos(k[0]) - 2*cos(k[1]);
+		model << HoppingAmplitude(
+			energy,
+			{kIndex[0], kIndex[1], 0},
+			{kIndex[0], kIndex[1], 0}
+		);
+		model << HoppingAmplitude(
+			energy + 0.5,
+			{kIndex[0], kIndex[1], 1},
+			{kIndex[0], kIndex[1], 1}
+		);
+		model << HoppingAmplitude(
+			0.3*sin(k[0]),
+			{kIndex[0], kIndex[1], 0},
+			{kIndex[0], kIndex[1], 1}
+		) + HC;
+	}
+	model.construct();
+
+	momentumSpaceContext.setModel(model);
+	momentumSpaceContext.setBrillouinZone(brillouinZone);
+	momentumSpaceContext.setNumMeshPoints(numMeshPoints);
+	momentumSpaceContext.setNumOrbitals(2);
+	momentumSpaceContext.init();
+}
+
+//Returns the bosonic Matsubara energies 2*pi*n*kT for -3 <= n <= 3.
+inline std::vector<std::complex<double>> getMatsubaraSusceptibilityCalculatorTestEnergies(
+	const Model &model
+){
+	double temperature = UnitHandler::convertTemperatureNtB(
+		model.getTemperature()
+	);
+	double kT = UnitHandler::getK_BB()*temperature;
+	std::vector<std::complex<double>> energies;
+	for(int n = -3; n <= 3; n++)
+		energies.push_back(std::complex<double>(0, 2*M_PI*n*kT));
+
+	return energies;
+}
+
+TEST(MatsubaraSusceptibilityCalculator, calculateSusceptibility){
+	std::string errorMessage = "calculateSusceptibility() failed.";
+
+	//The sum over the summation energies is normalized by 1/(NkT) and
+	//shifts the second Green's function by +iv_s, while the
+	//LindhardSusceptibilityCalculator evaluates the limit of kT/N times
+	//the sum with the shift -E. The results therefore agree up to a
+	//factor kT^2 and the sign of the energy. The truncation error decays
+	//as the inverse of the number of summation energies.
+	const std::vector<unsigned int> NUM_MESH_POINTS = {4, 3};
+	const unsigned int NUM_SUMMATION_ENERGIES = 1601;
+	const double TOLERANCE = 5e-4;
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	MomentumSpaceContext momentumSpaceContext;
+	initMatsubaraSusceptibilityCalculatorTestContext(
+		model,
+		brillouinZone,
+		NUM_MESH_POINTS,
+		momentumSpaceContext,
+		5000
+	);
+	std::vector<std::complex<double>> energies
+		= getMatsubaraSusceptibilityCalculatorTestEnergies(model);
+	double temperature = UnitHandler::convertTemperatureNtB(
+		model.getTemperature()
+	);
+	double kT = UnitHandler::getK_BB()*temperature;
+
+	MatsubaraSusceptibilityCalculator calculator(momentumSpaceContext);
+	calculator.setEnergies(energies);
+	calculator.setNumSummationEnergies(NUM_SUMMATION_ENERGIES);
+	LindhardSusceptibilityCalculator lindhardCalculator(
+		momentumSpaceContext
+	);
+	lindhardCalculator.setEnergies(energies);
+
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(NUM_MESH_POINTS);
+	for(unsigned int n = 0; n < mesh.size(); n++){
+		DualIndex q(
+			brillouinZone.getMinorCellIndex(mesh[n], NUM_MESH_POINTS),
+			mesh[n]
+		);
+		for(int orbitals = 0; orbitals < 16; orbitals++){
+			std::vector<int> orbitalIndices = {
+				(orbitals/8)%2,
+				(orbitals/4)%2,
+				(orbitals/2)%2,
+				orbitals%2
+			};
+			std::vector<std::complex<double>> result
+				= calculator.calculateSusceptibility(
+					q,
+					orbitalIndices
+				);
+			std::vector<std::complex<double>> reference
+				= lindhardCalculator.calculateSusceptibility(
+					q,
+					orbitalIndices
+				);
+			ASSERT_EQ(result.size(), energies.size())
+				<< errorMessage;
+			for(unsigned int e = 0; e < energies.size(); e++){
+				EXPECT_NEAR(
+					abs(
+						kT*kT*result[e]
+						- reference[
+							energies.size() - 1 - e
+						]
+					),
+					0,
+					TOLERANCE
+				) << errorMessage;
+			}
+		}
+	}
+}
+
+TEST(MatsubaraSusceptibilityCalculator, DiscreteLehmannRepresentation){
+	std::string errorMessage = "Discrete Lehmann representation failed.";
+
+	//The temperature is high enough for the sum over the summation
+	//energies to converge for a moderate number of summation energies.
+	//The truncation error decays as the inverse of the number of
+	//summation energies.
+	const std::vector<unsigned int> NUM_MESH_POINTS = {4, 3};
+	const unsigned int NUM_SUMMATION_ENERGIES = 1601;
+	const double TOLERANCE = 2e-3;
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	MomentumSpaceContext momentumSpaceContext;
+	initMatsubaraSusceptibilityCalculatorTestContext(
+		model,
+		brillouinZone,
+		NUM_MESH_POINTS,
+		momentumSpaceContext,
+		5000
+	);
+	std::vector<std::complex<double>> energies
+		= getMatsubaraSusceptibilityCalculatorTestEnergies(model);
+
+	MatsubaraSusceptibilityCalculator dense(momentumSpaceContext);
+	MatsubaraSusceptibilityCalculator dlr(momentumSpaceContext);
+	dense.setEnergies(energies);
+	dlr.setEnergies(energies);
+	dense.setNumSummationEnergies(NUM_SUMMATION_ENERGIES);
+	dlr.setUseDiscreteLehmannRepresentation(true);
+
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(NUM_MESH_POINTS);
+	for(unsigned int n = 0; n < mesh.size(); n++){
+		DualIndex q(
+			brillouinZone.getMinorCellIndex(mesh[n], NUM_MESH_POINTS),
+			mesh[n]
+		);
+		for(int orbitals = 0; orbitals < 16; orbitals++){
+			std::vector<int> orbitalIndices = {
+				(orbitals/8)%2,
+				(orbitals/4)%2,
+				(orbitals/2)%2,
+				orbitals%2
+			};
+			std::vector<std::complex<double>> denseResult
+				= dense.calculateSusceptibility(q, orbitalIndices);
+			std::vector<std::complex<double>> dlrResult
+				= dlr.calculateSusceptibility(q, orbitalIndices);
+			ASSERT_EQ(dlrResult.size(), denseResult.size())
+				<< errorMessage;
+			for(unsigned int e = 0; e < dlrResult.size(); e++){
+				EXPECT_NEAR(
+					abs(dlrResult[e] - denseResult[e]),
+					0,
+					TOLERANCE
+				) << errorMessage;
+			}
+		}
+	}
+}
+
+#ifdef TBTK_USE_FFTW3
+TEST(MatsubaraConvolver, correlate){
+	std::string errorMessage = "correlate() failed.";
+
+	//Compare with the direct sum over k and n for arbitrary functions. The
+	//sequence of pairs both reuses and replaces the transformed
+	//functions.
+	const std::vector<unsigned int> NUM_MESH_POINTS = {4, 3};
+	const unsigned int NUM_K = 12;
+	const unsigned int NUM_FUNCTIONS = 3;
+	const unsigned int NUM_INPUT_ENERGIES = 6;
+	const unsigned int NUM_OUTPUT_ENERGIES = 5;
+	std::vector<std::complex<double>> functions(
+		NUM_K*NUM_FUNCTIONS*NUM_INPUT_ENERGIES
+	);
+	for(unsigned int n = 0; n < functions.size(); n++)
+		functions[n] = std::complex<double>(cos(1.3*n), sin(0.7*n*n));
+
+	MatsubaraConvolver convolver(
+		NUM_MESH_POINTS,
+		NUM_FUNCTIONS,
+		NUM_INPUT_ENERGIES,
+		NUM_OUTPUT_ENERGIES
+	);
+	convolver.setFunctions(functions.data());
+	std::vector<std::pair<unsigned int, unsigned int>> pairs = {
+		{0, 1}, {1, 1}, {2, 1}, {1, 0}, {0, 2}, {2, 2}, {0, 1}
+	};
+	for(unsigned int p = 0; p < pairs.size(); p++){
+		unsigned int a = pairs[p].first;
+		unsigned int b = pairs[p].second;
+		std::vector<std::complex<double>> result(
+			NUM_K*NUM_OUTPUT_ENERGIES
+		);
+		convolver.correlate(a, b, result.data());
+
+		for(unsigned int q = 0; q < NUM_K; q++){
+			for(unsigned int e = 0; e < NUM_OUTPUT_ENERGIES; e++){
+				int s = (int)e - (int)NUM_OUTPUT_ENERGIES/2;
+				std::complex<double> reference = 0;
+				for(unsigned int k = 0; k < NUM_K; k++){
+					unsigned int kPlusQ
+						= (((k/3 + q/3)%4)*3)
+						+ (k%3 + q%3)%3;
+					for(
+						int n = 0;
+						n < (int)NUM_INPUT_ENERGIES;
+						n++
+					){
+						if(
+							n + s < 0
+							|| n + s >= (int)NUM_INPUT_ENERGIES
+						){
+							continue;
+						}
+
+						reference += functions[
+							NUM_INPUT_ENERGIES*(
+								NUM_FUNCTIONS*k + a
+							) + n
+						]*functions[
+							NUM_INPUT_ENERGIES*(
+								NUM_FUNCTIONS*kPlusQ
+								+ b
+							) + n + s
+						];
+					}
+				}
+				EXPECT_NEAR(
+					abs(
+						result[NUM_OUTPUT_ENERGIES*q + e]
+						- reference
+					),
+					0,
+					1e-10
+				) << errorMessage;
+			}
+		}
+	}
+}
+
+TEST(MatsubaraSusceptibilityCalculator, FFTConvolution){
+	std::string errorMessage = "FFT convolution failed.";
+
+	const std::vector<unsigned int> NUM_MESH_POINTS = {4, 3};
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	MomentumSpaceContext momentumSpaceContext;
+	initMatsubaraSusceptibilityCalculatorTestContext(
+		model,
+		brillouinZone,
+		NUM_MESH_POINTS,
+		momentumSpaceContext
+	);
+	std::vector<std::complex<double>> energies
+		= getMatsubaraSusceptibilityCalculatorTestEnergies(model);
+
+	MatsubaraSusceptibilityCalculator dense(momentumSpaceContext);
+	MatsubaraSusceptibilityCalculator fft(momentumSpaceContext);
+	dense.setEnergies(energies);
+	fft.setEnergies(energies);
+	dense.setNumSummationEnergies(15);
+	fft.setNumSummationEnergies(15);
+	fft.setUseFFTConvolution(true);
+
+	//The FFT mixes all momenta, so the rounding errors are relative to
+	//the largest value.
+	std::vector<std::complex<double>> reference;
+	std::vector<std::complex<double>> result;
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(NUM_MESH_POINTS);
+	for(unsigned int n = 0; n < mesh.size(); n++){
+		DualIndex q(
+			brillouinZone.getMinorCellIndex(mesh[n], NUM_MESH_POINTS),
+			mesh[n]
+		);
+		for(int orbitals = 0; orbitals < 16; orbitals++){
+			std::vector<int> orbitalIndices = {
+				(orbitals/8)%2,
+				(orbitals/4)%2,
+				(orbitals/2)%2,
+				orbitals%2
+			};
+			std::vector<std::complex<double>> denseResult
+				= dense.calculateSusceptibility(q, orbitalIndices);
+			std::vector<std::complex<double>> fftResult
+				= fft.calculateSusceptibility(q, orbitalIndices);
+			ASSERT_EQ(fftResult.size(), denseResult.size())
+				<< errorMessage;
+			reference.insert(
+				reference.end(),
+				denseResult.begin(),
+				denseResult.end()
+			);
+			result.insert(
+				result.end(),
+				fftResult.begin(),
+				fftResult.end()
+			);
+		}
+	}
+
+	double scale = 0;
+	for(unsigned int n = 0; n < reference.size(); n++)
+		scale = std::max(scale, abs(reference[n]));
+	EXPECT_TRUE(scale > 0) << errorMessage;
+	for(unsigned int n = 0; n < result.size(); n++){
+		EXPECT_NEAR(abs(result[n] - reference[n]), 0, 1e-12*scale)
+			<< errorMessage;
+	}
+}
+#endif
+
+};
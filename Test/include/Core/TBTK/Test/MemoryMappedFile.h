@@ -0,0 +1,142 @@
+#include "TBTK/IndexTree.h"
+#include "TBTK/MemoryMappedFile.h"
+#include "TBTK/Property/LDOS.h"
+#include "TBTK/Streams.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace TBTK{
+
+//Writes a serialization of an LDOS with two sites and four energies to the
+//given file and returns the LDOS.
+inline Property::LDOS writeMemoryMappedFileTestLDOS(const std::string &filename){
+	IndexTree indexTree;
+	indexTree.add({0});
+	indexTree.add({1});
+	indexTree.generateLinearMap();
+	Property::LDOS ldos(indexTree, -1, 1, 4);
+	for(unsigned int n = 0; n < 4; n++){
+		ldos({0}, n) = n;
+		ldos({1}, n) = 10 + n;
+	}
+
+	std::string serialization = ldos.serialize(Serializeable::Mode::Binary);
+	std::ofstream fout(filename, std::ios::binary);
+	fout.write(serialization.data(), serialization.size());
+	fout.close();
+
+	return ldos;
+}
+
+TEST(MemoryMappedFile, ReadOnly){
+	std::string errorMessage = "Read only mapping failed.";
+	std::string filename = "TBTKTestMemoryMappedFileReadOnly.bin";
+	Property::LDOS ldos = writeMemoryMappedFileTestLDOS(filename);
+	std::string serialization = ldos.serialize(Serializeable::Mode::Binary);
+
+	MemoryMappedFile file(filename);
+	EXPECT_TRUE(file.isMapped()) << errorMessage;
+	EXPECT_FALSE(file.isWritable()) << errorMessage;
+	EXPECT_EQ(file.getSize(), serialization.size()) << errorMessage;
+	EXPECT_EQ(
+		std::string(file.getData(), file.getSize()),
+		serialization
+	) << errorMessage;
+
+	//Write access requires a writable mapping.
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			file.getDataRW();
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+
+	//Properties can be read from read only mappings and are copied into
+	//memory when they are modified.
+	Property::LDOS mappedLDOS(file);
+	EXPECT_TRUE(mappedLDOS.isMemoryMapped()) << errorMessage;
+	const Property::LDOS &constMappedLDOS = mappedLDOS;
+	for(unsigned int n = 0; n < 4; n++){
+		EXPECT_EQ(constMappedLDOS({0}, n), ldos({0}, n)) << errorMessage;
+		EXPECT_EQ(constMappedLDOS({1}, n), ldos({1}, n)) << errorMessage;
+	}
+	EXPECT_TRUE(mappedLDOS.isMemoryMapped()) << errorMessage;
+	mappedLDOS({1}, 2) = 100;
+	EXPECT_FALSE(mappedLDOS.isMemoryMapped()) << errorMessage;
+	EXPECT_EQ(mappedLDOS({1}, 2), 100) << errorMessage;
+	EXPECT_EQ(mappedLDOS({1}, 3), 13) << errorMessage;
+	EXPECT_EQ(
+		std::string(file.getData(), file.getSize()),
+		serialization
+	) << errorMessage;
+
+	std::remove(filename.c_str());
+}
+
+TEST(MemoryMappedFile, CopyOnWrite){
+	std::string errorMessage = "Copy on write mapping failed.";
+	std::string filename = "TBTKTestMemoryMappedFileCopyOnWrite.bin";
+	Property::LDOS ldos = writeMemoryMappedFileTestLDOS(filename);
+
+	//The LDOS is accessed in place and agrees with the original.
+	{
+		Property::LDOS mappedLDOS(
+			MemoryMappedFile(
+				filename,
+				MemoryMappedFile::Mode::CopyOnWrite
+			)
+		);
+		EXPECT_TRUE(mappedLDOS.isMemoryMapped()) << errorMessage;
+		EXPECT_EQ(mappedLDOS.getLowerBound(), -1) << errorMessage;
+		EXPECT_EQ(mappedLDOS.getUpperBound(), 1) << errorMessage;
+		EXPECT_EQ(mappedLDOS.getResolution(), 4) << errorMessage;
+		EXPECT_EQ(mappedLDOS.getSize(), ldos.getSize()) << errorMessage;
+		for(unsigned int n = 0; n < 4; n++){
+			EXPECT_EQ(mappedLDOS({0}, n), ldos({0}, n)) << errorMessage;
+			EXPECT_EQ(mappedLDOS({1}, n), ldos({1}, n)) << errorMessage;
+		}
+
+		//Writes are private to the process.
+		mappedLDOS({1}, 2) = 100;
+		EXPECT_EQ(mappedLDOS({1}, 2), 100) << errorMessage;
+	}
+
+	Property::LDOS mappedLDOS(
+		MemoryMappedFile(filename, MemoryMappedFile::Mode::CopyOnWrite)
+	);
+	EXPECT_EQ(mappedLDOS({1}, 2), 12) << errorMessage;
+
+	std::remove(filename.c_str());
+}
+
+TEST(MemoryMappedFile, ReadWrite){
+	std::string errorMessage = "Read write mapping failed.";
+	std::string filename = "TBTKTestMemoryMappedFileReadWrite.bin";
+	writeMemoryMappedFileTestLDOS(filename);
+
+	//Writes are stored in the file.
+	{
+		Property::LDOS mappedLDOS(
+			MemoryMappedFile(
+				filename,
+				MemoryMappedFile::Mode::ReadWrite
+			)
+		);
+		mappedLDOS({1}, 2) = 100;
+	}
+
+	Property::LDOS mappedLDOS(
+		MemoryMappedFile(filename, MemoryMappedFile::Mode::CopyOnWrite)
+	);
+	EXPECT_EQ(mappedLDOS({1}, 2), 100) << errorMessage;
+	EXPECT_EQ(mappedLDOS({1}, 3), 13) << errorMessage;
+
+	std::remove(filename.c_str());
+}
+
+};
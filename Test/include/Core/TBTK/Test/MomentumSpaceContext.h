@@ -0,0 +1,258 @@
+#include "TBTK/BrillouinZone.h"
+#include "TBTK/Model.h"
+#include "TBTK/RPA/LindhardSusceptibilityCalculator.h"
+#include "TBTK/RPA/MomentumSpaceContext.h"
+#include "TBTK/Streams.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace TBTK{
+
+//Adds a two orbital model with the symmetries of the square lattice to the
+//Model. If pOrbitals is false, both orbitals are invariant under the point
+//group. Otherwise the orbitals transform as p_x and p_y orbitals.
+inline void addMomentumSpaceContextTestModel(
+	Model &model,
+	const BrillouinZone &brillouinZone,
+	const std::vector<unsigned int> &numMeshPoints,
+	bool pOrbitals
+){
+	model.setTemperature(300);
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(numMeshPoints);
+	for(unsigned int n = 0; n < mesh.size(); n++){
+		const std::vector<double> &k = mesh[n];
+		Index kIndex = brillouinZone.getMinorCellIndex(k, numMeshPoints);
+		if(pOrbitals){
+			model << HoppingAmplitude(
+				-2*cos(k[0]) - cos(k[1]),
+				{kIndex[0], kIndex[1], 0},
+				{kIndex[0], kIndex[1], 0}
+			);
+			model << HoppingAmplitude(
+				-2*cos(k[1]) - cos(k[0]),
+				{kIndex[0], kIndex[1], 1},
+				{kIndex[0], kIndex[1], 1}
+			);
+			model << HoppingAmplitude(
+				0.7*sin(k[0])*sin(k[1]),
+				{kIndex[0], kIndex[1], 0},
+				{kIndex[0], kIndex[1], 1}
+			) + HC;
+		}
+		else{
+			double energy = -2*cos(k[0]) - 2*cos(k[1]);
+			model << HoppingAmplitude(
+				energy,
+				{kIndex[0], kIndex[1], 0},
+				{kIndex[0], kIndex[1], 0}
+			);
+			model << HoppingAmplitude(
+				energy + 0.5,
+				{kIndex[0], kIndex[1], 1},
+				{kIndex[0], kIndex[1], 1}
+			);
+			model << HoppingAmplitude(
+				std::complex<double>(0.3, 0.2)*(cos(k[0]) + cos(k[1])),
+				{kIndex[0], kIndex[1], 0},
+				{kIndex[0], kIndex[1], 1}
+			) + HC;
+		}
+	}
+	model.construct();
+}
+
+//Compares the energies and the precomputed bare susceptibilities of two
+//MomentumSpaceContexts for the same Model.
+inline void compareMomentumSpaceContexts(
+	const MomentumSpaceContext &reference,
+	const MomentumSpaceContext &momentumSpaceContext,
+	const std::string &errorMessage
+){
+	const std::vector<std::vector<double>> &mesh = reference.getMesh();
+	for(unsigned int n = 0; n < mesh.size(); n++){
+		for(unsigned int state = 0; state < 2; state++){
+			EXPECT_NEAR(
+				momentumSpaceContext.getEnergy(n, state),
+				reference.getEnergy(n, state),
+				1e-12
+			) << errorMessage;
+		}
+	}
+
+	std::vector<std::complex<double>> energies;
+	for(int n = 0; n < 5; n++)
+		energies.push_back(std::complex<double>(0.1*n, 0.05));
+	LindhardSusceptibilityCalculator referenceCalculator(reference);
+	LindhardSusceptibilityCalculator calculator(momentumSpaceContext);
+	referenceCalculator.setEnergies(energies);
+	calculator.setEnergies(energies);
+	referenceCalculator.precompute();
+	calculator.precompute();
+	const BrillouinZone &brillouinZone = reference.getBrillouinZone();
+	const std::vector<unsigned int> &numMeshPoints
+		= reference.getNumMeshPoints();
+	for(unsigned int n = 0; n < mesh.size(); n++){
+		DualIndex q(
+			brillouinZone.getMinorCellIndex(mesh[n], numMeshPoints),
+			mesh[n]
+		);
+		for(int orbitals = 0; orbitals < 16; orbitals++){
+			std::vector<int> orbitalIndices = {
+				(orbitals/8)%2,
+				(orbitals/4)%2,
+				(orbitals/2)%2,
+				orbitals%2
+			};
+			const std::complex<double> *referenceResult
+				= referenceCalculator.getSusceptibilityData(
+					q,
+					orbitalIndices
+				);
+			const std::complex<double> *result
+				= calculator.getSusceptibilityData(
+					q,
+					orbitalIndices
+				);
+			for(unsigned int e = 0; e < energies.size(); e++){
+				EXPECT_NEAR(
+					abs(result[e] - referenceResult[e]),
+					0,
+					1e-12
+				) << errorMessage;
+			}
+		}
+	}
+}
+
+TEST(MomentumSpaceContext, setDetectSymmetryOperations){
+	std::string errorMessage = "Symmetry detection failed.";
+
+	const std::vector<unsigned int> NUM_MESH_POINTS = {6, 6};
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	addMomentumSpaceContextTestModel(
+		model,
+		brillouinZone,
+		NUM_MESH_POINTS,
+		false
+	);
+
+	MomentumSpaceContext reference;
+	reference.setModel(model);
+	reference.setBrillouinZone(brillouinZone);
+	reference.setNumMeshPoints(NUM_MESH_POINTS);
+	reference.setNumOrbitals(2);
+	reference.init();
+
+	//The full point group of the square lattice is found, which leaves
+	//ten irreducible points on the 6x6 mesh.
+	MomentumSpaceContext momentumSpaceContext;
+	momentumSpaceContext.setModel(model);
+	momentumSpaceContext.setBrillouinZone(brillouinZone);
+	momentumSpaceContext.setNumMeshPoints(NUM_MESH_POINTS);
+	momentumSpaceContext.setNumOrbitals(2);
+	momentumSpaceContext.setDetectSymmetryOperations(true);
+	momentumSpaceContext.init();
+	EXPECT_EQ(momentumSpaceContext.getNumSymmetryOperations(), 8)
+		<< errorMessage;
+	const std::vector<unsigned int> &irreducibleMeshPoints
+		= momentumSpaceContext.getIrreducibleMeshPoints();
+	EXPECT_EQ(irreducibleMeshPoints.size(), 10) << errorMessage;
+	for(unsigned int n = 0; n < 36; n++){
+		EXPECT_TRUE(
+			std::find(
+				irreducibleMeshPoints.begin(),
+				irreducibleMeshPoints.end(),
+				momentumSpaceContext.getRepresentativeMeshPoint(n)
+			) != irreducibleMeshPoints.end()
+		) << errorMessage;
+	}
+
+	compareMomentumSpaceContexts(
+		reference,
+		momentumSpaceContext,
+		errorMessage
+	);
+}
+
+TEST(MomentumSpaceContext, addSymmetryOperation){
+	std::string errorMessage = "addSymmetryOperation() failed.";
+
+	const std::vector<unsigned int> NUM_MESH_POINTS = {6, 6};
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	addMomentumSpaceContextTestModel(
+		model,
+		brillouinZone,
+		NUM_MESH_POINTS,
+		true
+	);
+
+	MomentumSpaceContext reference;
+	reference.setModel(model);
+	reference.setBrillouinZone(brillouinZone);
+	reference.setNumMeshPoints(NUM_MESH_POINTS);
+	reference.setNumOrbitals(2);
+	reference.init();
+
+	//The four fold rotation and the mirror generate the full point group
+	//when the p-orbitals are transformed along with the momenta.
+	MomentumSpaceContext momentumSpaceContext;
+	momentumSpaceContext.setModel(model);
+	momentumSpaceContext.setBrillouinZone(brillouinZone);
+	momentumSpaceContext.setNumMeshPoints(NUM_MESH_POINTS);
+	momentumSpaceContext.setNumOrbitals(2);
+	momentumSpaceContext.addSymmetryOperation(
+		{{0, -1}, {1, 0}},
+		{{0, -1}, {1, 0}}
+	);
+	momentumSpaceContext.addSymmetryOperation(
+		{{-1, 0}, {0, 1}},
+		{{1, 0}, {0, -1}}
+	);
+	momentumSpaceContext.init();
+	EXPECT_EQ(momentumSpaceContext.getNumSymmetryOperations(), 8)
+		<< errorMessage;
+	EXPECT_EQ(momentumSpaceContext.getIrreducibleMeshPoints().size(), 10)
+		<< errorMessage;
+
+	compareMomentumSpaceContexts(
+		reference,
+		momentumSpaceContext,
+		errorMessage
+	);
+
+	//The rotation is not a symmetry if the orbitals are left unchanged.
+	//OpenMP threads have been started at this point, which requires the
+	//death test to run in a new process rather than in a fork.
+	std::string deathTestStyle = ::testing::GTEST_FLAG(death_test_style);
+	::testing::GTEST_FLAG(death_test_style) = "threadsafe";
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			MomentumSpaceContext invalidContext;
+			invalidContext.setModel(model);
+			invalidContext.setBrillouinZone(brillouinZone);
+			invalidContext.setNumMeshPoints(NUM_MESH_POINTS);
+			invalidContext.setNumOrbitals(2);
+			invalidContext.addSymmetryOperation({{0, -1}, {1, 0}});
+			invalidContext.init();
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+	::testing::GTEST_FLAG(death_test_style) = deathTestStyle;
+}
+
+};
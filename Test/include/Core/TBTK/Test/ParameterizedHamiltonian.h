@@ -0,0 +1,113 @@
+#include "TBTK/Model.h"
+#include "TBTK/ParameterizedHamiltonian.h"
+#include "TBTK/Streams.h"
+
+#include "gtest/gtest.h"
+
+namespace TBTK{
+
+TEST(ParameterizedHamiltonian, setParameter){
+	std::string errorMessage = "setParameter() failed.";
+
+	ParameterizedHamiltonian parameterizedHamiltonian;
+	parameterizedHamiltonian.addParameter("mu", 1);
+	parameterizedHamiltonian.addParameter("t", 0);
+	for(int x = 0; x < 2; x++){
+		parameterizedHamiltonian.add(HoppingAmplitude(x, {x}, {x}));
+		parameterizedHamiltonian.add("mu", HoppingAmplitude(-1, {x}, {x}));
+	}
+	parameterizedHamiltonian.add("t", HoppingAmplitude(-1, {1}, {0}) + HC);
+	EXPECT_EQ(parameterizedHamiltonian.getNumMatrixElements(), 4) << errorMessage;
+
+	Model model;
+	model.setVerbose(false);
+	model << parameterizedHamiltonian;
+	model.construct();
+
+	std::vector<std::complex<double>> amplitudes
+		= model.getHoppingAmplitudeSet()->getAmplitudes();
+	std::complex<double> sum = 0;
+	for(unsigned int n = 0; n < amplitudes.size(); n++)
+		sum += amplitudes[n];
+	EXPECT_EQ(amplitudes.size(), 4) << errorMessage;
+	EXPECT_EQ(sum, std::complex<double>(-1, 0)) << errorMessage;
+
+	parameterizedHamiltonian.setParameter("mu", 2);
+	parameterizedHamiltonian.setParameter("t", std::complex<double>(0, 1));
+	EXPECT_EQ(parameterizedHamiltonian.getParameter("mu"), std::complex<double>(2, 0)) << errorMessage;
+	EXPECT_EQ(parameterizedHamiltonian.getHoppingAmplitude({0}, {0}), std::complex<double>(-2, 0)) << errorMessage;
+	EXPECT_EQ(parameterizedHamiltonian.getHoppingAmplitude({1}, {1}), std::complex<double>(-1, 0)) << errorMessage;
+	EXPECT_EQ(parameterizedHamiltonian.getHoppingAmplitude({1}, {0}), std::complex<double>(0, -1)) << errorMessage;
+	EXPECT_EQ(parameterizedHamiltonian.getHoppingAmplitude({0}, {1}), std::complex<double>(0, 1)) << errorMessage;
+
+	amplitudes = model.getHoppingAmplitudeSet()->getAmplitudes();
+	sum = 0;
+	for(unsigned int n = 0; n < amplitudes.size(); n++)
+		sum += amplitudes[n];
+	EXPECT_EQ(sum, std::complex<double>(-3, 0)) << errorMessage;
+
+	//The Hamiltonian remains Hermitian for complex parameter values.
+	const std::vector<int> &toBasisIndices
+		= model.getHoppingAmplitudeSet()->getToBasisIndices();
+	const std::vector<int> &fromBasisIndices
+		= model.getHoppingAmplitudeSet()->getFromBasisIndices();
+	for(unsigned int n = 0; n < amplitudes.size(); n++){
+		for(unsigned int m = 0; m < amplitudes.size(); m++){
+			if(
+				toBasisIndices[n] == fromBasisIndices[m]
+				&& fromBasisIndices[n] == toBasisIndices[m]
+			){
+				EXPECT_EQ(amplitudes[n], conj(amplitudes[m])) << errorMessage;
+			}
+		}
+	}
+
+	parameterizedHamiltonian.setParameters({0, 0});
+	amplitudes = model.getHoppingAmplitudeSet()->getAmplitudes();
+	sum = 0;
+	for(unsigned int n = 0; n < amplitudes.size(); n++)
+		sum += amplitudes[n];
+	EXPECT_EQ(sum, std::complex<double>(1, 0)) << errorMessage;
+}
+
+TEST(ParameterizedHamiltonian, copyModel){
+	ParameterizedHamiltonian parameterizedHamiltonian;
+	parameterizedHamiltonian.addParameter("mu", 1);
+	parameterizedHamiltonian.add("mu", HoppingAmplitude(-1, {0}, {0}));
+
+	Model model;
+	model.setVerbose(false);
+	model << parameterizedHamiltonian;
+	model.construct();
+
+	//The lookup table of the ParameterizedHamiltonian belongs to a single
+	//Model, which therefore can not be copied.
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			Model copy(model);
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			Model copy;
+			copy = model;
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+
+	//A Model without ParameterizedHamiltonians can be assigned to it.
+	Model other;
+	other.setVerbose(false);
+	other << HoppingAmplitude(1, {0}, {0});
+	other.construct();
+	model = other;
+	Model copy(model);
+	EXPECT_EQ(copy.getBasisSize(), 1);
+}
+
+};
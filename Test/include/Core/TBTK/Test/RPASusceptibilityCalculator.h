@@ -0,0 +1,295 @@
+#include "TBTK/BrillouinZone.h"
+#include "TBTK/Exception.h"
+#include "TBTK/InteractionAmplitude.h"
+#include "TBTK/Model.h"
+#include "TBTK/RPA/LindhardSusceptibilityCalculator.h"
+#include "TBTK/RPA/MomentumSpaceContext.h"
+#include "TBTK/RPA/RPASusceptibilityCalculator.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+extern "C" {
+	void zgetrf_(
+		int *M,
+		int *N,
+		std::complex<double> *A,
+		int *lda,
+		int *ipiv,
+		int *info
+	);
+	void zgetri_(
+		int *N,
+		std::complex<double> *A,
+		int *lda,
+		int *ipiv,
+		std::complex<double> *work,
+		int *lwork,
+		int *info
+	);
+}
+
+namespace TBTK{
+
+//Adds the Model on the given mesh and initializes the
+//MomentumSpaceContext. The on-site energies are the sum of the dispersion,
+//scaled by bandWidth, and the orbital energies. The inter orbital
+//hoppings are scaled by interOrbitalHopping.
+inline void initRPASusceptibilityCalculatorTestContext(
+	Model &model,
+	const BrillouinZone &brillouinZone,
+	const std::vector<unsigned int> &numMeshPoints,
+	const std::vector<double> &orbitalEnergies,
+	double bandWidth,
+	double interOrbitalHopping,
+	MomentumSpaceContext &momentumSpaceContext
+){
+	int numOrbitals = orbitalEnergies.size();
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(numMeshPoints);
+	for(unsigned int n = 0; n < mesh.size(); n++){
+		const std::vector<double> &k = mesh[n];
+		Index kIndex = brillouinZone.getMinorCellIndex(k, numMeshPoints);
+		for(int o0 = 0; o0 < numOrbitals; o0++){
+			model << HoppingAmplitude(
+				-bandWidth*(cos(k[0] + o0) + cos(k[1]))
+				+ orbitalEnergies[o0],
+				{kIndex[0], kIndex[1], o0},
+				{kIndex[0], kIndex[1], o0}
+			);
+			//Added also when zero to keep all orbitals in the same
+			//block.
+			for(int o1 = o0 + 1; o1 < numOrbitals; o1++){
+				model << HoppingAmplitude(
+					interOrbitalHopping*std::complex<double>(
+						sin(k[0]),
+						cos(k[1]*o1)
+					),
+					{kIndex[0], kIndex[1], o0},
+					{kIndex[0], kIndex[1], o1}
+				) + HC;
+			}
+		}
+	}
+	model.construct();
+
+	momentumSpaceContext.setModel(model);
+	momentumSpaceContext.setBrillouinZone(brillouinZone);
+	momentumSpaceContext.setNumMeshPoints(numMeshPoints);
+	momentumSpaceContext.setNumOrbitals(numOrbitals);
+	momentumSpaceContext.init();
+}
+
+TEST(RPASusceptibilityCalculator, calculateRPASusceptibility){
+	std::string errorMessage = "calculateRPASusceptibility() failed.";
+
+	const std::vector<unsigned int> NUM_MESH_POINTS = {4, 3};
+	const int NUM_ORBITALS = 3;
+	const int MATRIX_DIMENSION = NUM_ORBITALS*NUM_ORBITALS;
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	model.setTemperature(300);
+	MomentumSpaceContext momentumSpaceContext;
+	initRPASusceptibilityCalculatorTestContext(
+		model,
+		brillouinZone,
+		NUM_MESH_POINTS,
+		{-0.5, 0, 0.5},
+		1,
+		0.2,
+		momentumSpaceContext
+	);
+
+	std::vector<std::complex<double>> energies;
+	for(int n = 0; n < 4; n++)
+		energies.push_back(std::complex<double>(0.1*n, 0.05));
+
+	std::vector<InteractionAmplitude> interactionAmplitudes;
+	for(int n = 0; n < MATRIX_DIMENSION*MATRIX_DIMENSION; n++){
+		interactionAmplitudes.push_back(
+			InteractionAmplitude(
+				std::complex<double>(
+					0.3*cos(n),
+					0.1*sin(2*n)
+				),
+				{{(n/27)%3}, {(n/9)%3}},
+				{{(n/3)%3}, {n%3}}
+			)
+		);
+	}
+
+	RPASusceptibilityCalculator calculator(momentumSpaceContext);
+	calculator.setEnergies(energies);
+	calculator.setInteractionAmplitudes(interactionAmplitudes);
+	LindhardSusceptibilityCalculator bareCalculator(momentumSpaceContext);
+	bareCalculator.setEnergies(energies);
+
+	//Compare with \chi_0(1 + U\chi_0)^{-1}, where the denominator is
+	//explicitly inverted.
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(NUM_MESH_POINTS);
+	for(unsigned int m = 0; m < mesh.size(); m += 5){
+		DualIndex q(
+			brillouinZone.getMinorCellIndex(mesh[m], NUM_MESH_POINTS),
+			mesh[m]
+		);
+		std::vector<std::vector<std::complex<double>>> denominators(
+			energies.size(),
+			std::vector<std::complex<double>>(
+				MATRIX_DIMENSION*MATRIX_DIMENSION,
+				0.
+			)
+		);
+		for(unsigned int e = 0; e < energies.size(); e++){
+			for(int n = 0; n < MATRIX_DIMENSION; n++){
+				denominators[e][MATRIX_DIMENSION*n + n] = 1.;
+			}
+		}
+		for(unsigned int n = 0; n < interactionAmplitudes.size(); n++){
+			const InteractionAmplitude &interactionAmplitude
+				= interactionAmplitudes[n];
+			int c0 = interactionAmplitude.getCreationOperatorIndex(
+				0
+			)[0];
+			int c1 = interactionAmplitude.getCreationOperatorIndex(
+				1
+			)[0];
+			int a0 = interactionAmplitude.getAnnihilationOperatorIndex(
+				0
+			)[0];
+			int a1 = interactionAmplitude.getAnnihilationOperatorIndex(
+				1
+			)[0];
+			int row = NUM_ORBITALS*c0 + a1;
+			for(int c = 0; c < NUM_ORBITALS; c++){
+				for(int d = 0; d < NUM_ORBITALS; d++){
+					int col = NUM_ORBITALS*c + d;
+					std::vector<std::complex<double>> bare
+						= bareCalculator.calculateSusceptibility(
+							q,
+							{c1, a0, d, c}
+						);
+					for(unsigned int e = 0; e < energies.size(); e++){
+						denominators[e][
+							MATRIX_DIMENSION*col + row
+						] += interactionAmplitude.getAmplitude()
+							*bare[e];
+					}
+				}
+			}
+		}
+		for(unsigned int e = 0; e < energies.size(); e++){
+			int N = MATRIX_DIMENSION;
+			int info;
+			std::vector<int> ipiv(MATRIX_DIMENSION);
+			zgetrf_(
+				&N,
+				&N,
+				denominators[e].data(),
+				&N,
+				ipiv.data(),
+				&info
+			);
+			ASSERT_EQ(info, 0) << errorMessage;
+			int lwork = MATRIX_DIMENSION*MATRIX_DIMENSION;
+			std::vector<std::complex<double>> work(lwork);
+			zgetri_(
+				&N,
+				denominators[e].data(),
+				&N,
+				ipiv.data(),
+				work.data(),
+				&lwork,
+				&info
+			);
+			ASSERT_EQ(info, 0) << errorMessage;
+		}
+
+		for(int orbitals = 0; orbitals < 81; orbitals++){
+			std::vector<int> orbitalIndices = {
+				(orbitals/27)%3,
+				(orbitals/9)%3,
+				(orbitals/3)%3,
+				orbitals%3
+			};
+			std::vector<std::complex<double>> result
+				= calculator.calculateRPASusceptibility(
+					q,
+					orbitalIndices
+				);
+			ASSERT_EQ(result.size(), energies.size())
+				<< errorMessage;
+			for(unsigned int e = 0; e < energies.size(); e++){
+				std::complex<double> reference = 0;
+				for(int c = 0; c < NUM_ORBITALS; c++){
+					for(int d = 0; d < NUM_ORBITALS; d++){
+						std::vector<std::complex<double>> bare
+							= bareCalculator.calculateSusceptibility(
+								q,
+								{
+									orbitalIndices[0],
+									orbitalIndices[1],
+									d,
+									c
+								}
+							);
+						reference += denominators[e][
+							MATRIX_DIMENSION*(
+								NUM_ORBITALS*orbitalIndices[2]
+								+ orbitalIndices[3]
+							) + NUM_ORBITALS*c + d
+						]*bare[e];
+					}
+				}
+				EXPECT_NEAR(
+					abs(result[e] - reference),
+					0,
+					1e-12*std::max(abs(reference), 1.)
+				) << errorMessage;
+			}
+		}
+	}
+}
+
+TEST(RPASusceptibilityCalculator, singularDenominator){
+	//For a single mesh point and uncoupled orbitals with energies -1 and
+	//1 at low temperature, \chi_0(0, 1, 1, 0) = 1/2 at zero energy. The
+	//interaction amplitude -2 for this channel therefore makes the
+	//denominator exactly singular.
+	const std::vector<unsigned int> NUM_MESH_POINTS = {1, 1};
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	model.setTemperature(1);
+	MomentumSpaceContext momentumSpaceContext;
+	initRPASusceptibilityCalculatorTestContext(
+		model,
+		brillouinZone,
+		NUM_MESH_POINTS,
+		{-1, 1},
+		0,
+		0,
+		momentumSpaceContext
+	);
+
+	RPASusceptibilityCalculator calculator(momentumSpaceContext);
+	calculator.setEnergies({0., std::complex<double>(0, 1)});
+	calculator.setInteractionAmplitudes({
+		InteractionAmplitude(-2., {{0}, {0}}, {{1}, {1}})
+	});
+	std::vector<double> q = brillouinZone.getMinorMesh(NUM_MESH_POINTS)[0];
+	EXPECT_THROW(
+		calculator.calculateRPASusceptibility(q, {0, 1, 0, 1}),
+		Exception
+	);
+}
+
+};
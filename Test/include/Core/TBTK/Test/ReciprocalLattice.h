@@ -0,0 +1,326 @@
+#include "TBTK/BandDiagramGenerator.h"
+#include "TBTK/BasicState.h"
+#include "TBTK/Model.h"
+#include "TBTK/ReciprocalLattice.h"
+#include "TBTK/UnitCell.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace TBTK{
+
+//Creates a UnitCell with two states on an oblique two-dimensional lattice.
+//The matrix elements are complex and connect the states to themselves and
+//each other in the same and the neighboring cells.
+inline UnitCell* createReciprocalLatticeTestUnitCell(){
+	UnitCell *unitCell = new UnitCell({{1, 0}, {0.5, 1}});
+
+	BasicState *state0 = new BasicState({0}, {0, 0});
+	BasicState *state1 = new BasicState({1}, {0, 0});
+	state0->setCoordinates({0, 0});
+	state1->setCoordinates({0.3, 0.4});
+	state0->setExtent(1.5);
+	state1->setExtent(1.5);
+
+	state0->addMatrixElement(-1, {0}, {0, 0});
+	state0->addMatrixElement(std::complex<double>(0.5, 0.2), {0}, {1, 0});
+	state0->addMatrixElement(std::complex<double>(0.5, -0.2), {0}, {-1, 0});
+	state0->addMatrixElement(std::complex<double>(0.3, 0.1), {1}, {0, 0});
+	state0->addMatrixElement(std::complex<double>(0.1, 0.4), {1}, {0, -1});
+	state1->addMatrixElement(2, {1}, {0, 0});
+	state1->addMatrixElement(std::complex<double>(0.2, 0.3), {1}, {0, 1});
+	state1->addMatrixElement(std::complex<double>(0.2, -0.3), {1}, {0, -1});
+	state1->addMatrixElement(std::complex<double>(0.3, -0.1), {0}, {0, 0});
+	state1->addMatrixElement(std::complex<double>(0.1, -0.4), {0}, {1, 1});
+
+	unitCell->addState(state0);
+	unitCell->addState(state1);
+
+	return unitCell;
+}
+
+//Calculates the Bloch Hamiltonian on the layout [to][from] the way
+//ReciprocalLattice::generateModel() did before H(R) was tabulated. That is,
+//by creating a Model for the given momentum where every amplitude is summed
+//over the translated copies of the bra.
+inline std::vector<std::complex<double>> calculateReciprocalLatticeTestHamiltonian(
+	const UnitCell &unitCell,
+	const std::vector<double> &momentum
+){
+	//Offset that keeps the container indices positive.
+	const int OFFSET = 3;
+	const std::vector<std::vector<double>> &latticeVectors
+		= unitCell.getLatticeVectors();
+	const std::vector<AbstractState*> &states = unitCell.getStates();
+	unsigned int numDimensions = latticeVectors.size();
+	unsigned int numCells = 1;
+	for(unsigned int c = 0; c < numDimensions; c++)
+		numCells *= 2*OFFSET + 1;
+
+	Model model;
+	model.setVerbose(false);
+	for(unsigned int from = 0; from < states.size(); from++){
+		AbstractState *ket = states[from]->clone();
+		ket->setContainer(std::vector<int>(numDimensions, OFFSET));
+		for(unsigned int to = 0; to < states.size(); to++){
+			std::complex<double> amplitude = 0;
+			for(unsigned int cell = 0; cell < numCells; cell++){
+				AbstractState *bra = states[to]->clone();
+				std::vector<int> container;
+				std::vector<double> coordinates
+					= bra->getCoordinates();
+				unsigned int remainder = cell;
+				for(unsigned int c = 0; c < numDimensions; c++){
+					int n = remainder%(2*OFFSET + 1);
+					remainder /= 2*OFFSET + 1;
+					container.push_back(n);
+					for(
+						unsigned int i = 0;
+						i < numDimensions;
+						i++
+					){
+						coordinates[i] += (n - OFFSET)
+							*latticeVectors[c][i];
+					}
+				}
+				bra->setContainer(container);
+
+				double exponent = 0;
+				for(unsigned int c = 0; c < numDimensions; c++){
+					exponent += momentum[c]*(
+						coordinates[c]
+						- bra->getCoordinates()[c]
+					);
+				}
+				bra->setCoordinates(coordinates);
+				amplitude += bra->getMatrixElement(*ket)*std::polar(
+					1.,
+					exponent
+				);
+
+				delete bra;
+			}
+			model << HoppingAmplitude(
+				amplitude,
+				states[to]->getIndex(),
+				states[from]->getIndex()
+			);
+		}
+
+		delete ket;
+	}
+	model.construct();
+
+	std::vector<std::complex<double>> hamiltonian(
+		states.size()*states.size(),
+		0.
+	);
+	std::vector<std::complex<double>> amplitudes
+		= model.getHoppingAmplitudeSet()->getAmplitudes();
+	const std::vector<int> &toBasisIndices
+		= model.getHoppingAmplitudeSet()->getToBasisIndices();
+	const std::vector<int> &fromBasisIndices
+		= model.getHoppingAmplitudeSet()->getFromBasisIndices();
+	for(unsigned int n = 0; n < amplitudes.size(); n++){
+		hamiltonian[
+			states.size()*toBasisIndices[n] + fromBasisIndices[n]
+		] += amplitudes[n];
+	}
+
+	return hamiltonian;
+}
+
+TEST(ReciprocalLattice, calculateHamiltonians){
+	std::string errorMessage = "calculateHamiltonians() failed.";
+
+	UnitCell *unitCell = createReciprocalLatticeTestUnitCell();
+	ReciprocalLattice reciprocalLattice(unitCell);
+	const unsigned int NUM_STATES = 2;
+
+	std::vector<std::vector<double>> momentums = {
+		{0, 0},
+		{0.3, -1.2},
+		{M_PI, 0.5},
+		{-2.1, 2.7},
+		{5.3, 4.1}
+	};
+	std::vector<std::complex<double>> hamiltonians
+		= reciprocalLattice.calculateHamiltonians(momentums);
+	ASSERT_EQ(hamiltonians.size(), momentums.size()*NUM_STATES*NUM_STATES)
+		<< errorMessage;
+	for(unsigned int k = 0; k < momentums.size(); k++){
+		std::vector<std::complex<double>> reference
+			= calculateReciprocalLatticeTestHamiltonian(
+				*unitCell,
+				momentums[k]
+			);
+		for(unsigned int n = 0; n < NUM_STATES*NUM_STATES; n++){
+			EXPECT_NEAR(
+				abs(
+					hamiltonians[NUM_STATES*NUM_STATES*k + n]
+					- reference[n]
+				),
+				0,
+				1e-12
+			) << errorMessage;
+		}
+	}
+
+	//No momentums.
+	EXPECT_EQ(
+		reciprocalLattice.calculateHamiltonians(
+			std::vector<std::vector<double>>()
+		).size(),
+		0
+	) << errorMessage;
+
+	delete unitCell;
+}
+
+TEST(ReciprocalLattice, calculateHamiltoniansOnMesh){
+	std::string errorMessage = "calculateHamiltonians() failed.";
+
+	UnitCell *unitCell = createReciprocalLatticeTestUnitCell();
+	ReciprocalLattice reciprocalLattice(unitCell);
+	const unsigned int NUM_STATES = 2;
+	const std::vector<unsigned int> NUM_MESH_POINTS = {5, 3};
+	const std::vector<std::vector<double>> &reciprocalLatticeVectors
+		= reciprocalLattice.getReciprocalLatticeVectors();
+
+	//Mesh points k = (m_0/N_0)b_0 + (m_1/N_1)b_1 with the last index
+	//varying fastest.
+	std::vector<std::vector<double>> momentums;
+	for(unsigned int m0 = 0; m0 < NUM_MESH_POINTS[0]; m0++){
+		for(unsigned int m1 = 0; m1 < NUM_MESH_POINTS[1]; m1++){
+			std::vector<double> k(2);
+			for(unsigned int c = 0; c < 2; c++){
+				k[c] = m0*reciprocalLatticeVectors[0][c]
+					/NUM_MESH_POINTS[0]
+					+ m1*reciprocalLatticeVectors[1][c]
+					/NUM_MESH_POINTS[1];
+			}
+			momentums.push_back(k);
+		}
+	}
+
+	std::vector<std::complex<double>> hamiltonians
+		= reciprocalLattice.calculateHamiltonians(NUM_MESH_POINTS);
+	ASSERT_EQ(hamiltonians.size(), momentums.size()*NUM_STATES*NUM_STATES)
+		<< errorMessage;
+	for(unsigned int k = 0; k < momentums.size(); k++){
+		std::vector<std::complex<double>> reference
+			= calculateReciprocalLatticeTestHamiltonian(
+				*unitCell,
+				momentums[k]
+			);
+		for(unsigned int n = 0; n < NUM_STATES*NUM_STATES; n++){
+			EXPECT_NEAR(
+				abs(
+					hamiltonians[NUM_STATES*NUM_STATES*k + n]
+					- reference[n]
+				),
+				0,
+				1e-12
+			) << errorMessage;
+		}
+	}
+
+	delete unitCell;
+}
+
+TEST(BandDiagramGenerator, generateBandDiagram){
+	std::string errorMessage = "generateBandDiagram() failed.";
+
+	//Chain with a single state per unit cell, on-site energy MU and
+	//nearest neighbor hopping T. The dispersion is E(k) = MU + 2T cos(k).
+	const double MU = 0.5;
+	const double T = -1;
+	const unsigned int RESOLUTION = 10;
+	UnitCell *unitCell = new UnitCell({{1}});
+	BasicState *state = new BasicState({0}, {0});
+	state->setCoordinates({0});
+	state->setExtent(1);
+	state->addMatrixElement(MU, {0}, {0});
+	state->addMatrixElement(T, {0}, {1});
+	state->addMatrixElement(T, {0}, {-1});
+	unitCell->addState(state);
+	ReciprocalLattice reciprocalLattice(unitCell);
+
+	BandDiagramGenerator bandDiagramGenerator;
+	bandDiagramGenerator.setReciprocalLattice(reciprocalLattice);
+	std::vector<std::vector<double>> bandDiagram
+		= bandDiagramGenerator.generateBandDiagram(
+			{{0}, {M_PI}, {2*M_PI}},
+			RESOLUTION,
+			{{M_PI}}
+		);
+
+	//One band per nesting vector, including the zero nesting vector, and
+	//RESOLUTION points per segment of the path.
+	ASSERT_EQ(bandDiagram.size(), 2) << errorMessage;
+	for(unsigned int n = 0; n < bandDiagram.size(); n++){
+		ASSERT_EQ(bandDiagram[n].size(), 2*RESOLUTION)
+			<< errorMessage;
+		for(unsigned int p = 0; p < 2*RESOLUTION; p++){
+			double k = M_PI*p/RESOLUTION + n*M_PI;
+			EXPECT_NEAR(
+				bandDiagram[n][p],
+				MU + 2*T*cos(k),
+				1e-12
+			) << errorMessage;
+		}
+	}
+
+	delete unitCell;
+}
+
+TEST(BandDiagramGenerator, generateBandDiagramMultipleBands){
+	std::string errorMessage = "generateBandDiagram() failed.";
+
+	//Chain with two states per unit cell, intra cell hopping V and inter
+	//cell hopping W. The bands are E(k) = -+|V + We^{ik}|.
+	const double V = 1;
+	const double W = 0.4;
+	const unsigned int RESOLUTION = 16;
+	UnitCell *unitCell = new UnitCell({{1}});
+	BasicState *state0 = new BasicState({0}, {0});
+	BasicState *state1 = new BasicState({1}, {0});
+	state0->setCoordinates({0});
+	state1->setCoordinates({0.5});
+	state0->setExtent(1);
+	state1->setExtent(1);
+	state0->addMatrixElement(V, {1}, {0});
+	state0->addMatrixElement(W, {1}, {-1});
+	state1->addMatrixElement(V, {0}, {0});
+	state1->addMatrixElement(W, {0}, {1});
+	unitCell->addState(state0);
+	unitCell->addState(state1);
+	ReciprocalLattice reciprocalLattice(unitCell);
+
+	BandDiagramGenerator bandDiagramGenerator;
+	bandDiagramGenerator.setReciprocalLattice(reciprocalLattice);
+	std::vector<std::vector<double>> bandDiagram
+		= bandDiagramGenerator.generateBandDiagram(
+			{{-M_PI}, {M_PI}},
+			RESOLUTION
+		);
+
+	ASSERT_EQ(bandDiagram.size(), 2) << errorMessage;
+	for(unsigned int n = 0; n < bandDiagram.size(); n++){
+		ASSERT_EQ(bandDiagram[n].size(), RESOLUTION) << errorMessage;
+		for(unsigned int p = 0; p < RESOLUTION; p++){
+			double k = -M_PI + 2*M_PI*p/RESOLUTION;
+			double energy = abs(V + std::polar(W, k));
+			EXPECT_NEAR(
+				bandDiagram[n][p],
+				(n == 0 ? -energy : energy),
+				1e-12
+			) << errorMessage;
+		}
+	}
+
+	delete unitCell;
+}
+
+};
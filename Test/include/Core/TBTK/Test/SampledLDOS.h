@@ -0,0 +1,151 @@
+#include "TBTK/Model.h"
+#include "TBTK/PropertyExtractor/ChebyshevExpander.h"
+#include "TBTK/PropertyExtractor/Diagonalizer.h"
+#include "TBTK/Solver/ChebyshevExpander.h"
+#include "TBTK/Solver/Diagonalizer.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace TBTK{
+
+//Energy window used for the LDOS that the SampledLDOS is compared to.
+const double SAMPLED_LDOS_TEST_LOWER_BOUND = -3;
+const double SAMPLED_LDOS_TEST_UPPER_BOUND = 3;
+const int SAMPLED_LDOS_TEST_RESOLUTION = 60;
+
+//Energy intervals of the LDOS at which the SampledLDOS is compared to the
+//LDOS. The eigenvalues of the chain lie in the intervals 11, 17, 25, 34, 42,
+//and 48, while the intervals 3 and 30 contain no eigenvalue.
+inline std::vector<int> getSampledLDOSTestIntervals(){
+	return {3, 11, 17, 25, 30, 34, 42, 48};
+}
+
+//Adds an open chain with six sites to the model. The eigenvalues are
+//-2cos(n*pi/7), n = 1, ..., 6, which lie strictly inside the energy
+//intervals of the LDOS.
+inline void initSampledLDOSTestModel(Model &model){
+	for(int x = 0; x < 6; x++)
+		if(x + 1 < 6)
+			model << HoppingAmplitude(-1, {x + 1}, {x}) + HC;
+	model.construct();
+}
+
+TEST(SampledLDOS, Diagonalizer){
+	std::string errorMessage = "Diagonalizer::calculateSampledLDOS() failed.";
+
+	Model model;
+	initSampledLDOSTestModel(model);
+	Solver::Diagonalizer solver;
+	solver.setVerbose(false);
+	solver.setModel(model);
+	solver.run();
+
+	PropertyExtractor::Diagonalizer propertyExtractor(solver);
+	propertyExtractor.setEnergyWindow(
+		SAMPLED_LDOS_TEST_LOWER_BOUND,
+		SAMPLED_LDOS_TEST_UPPER_BOUND,
+		SAMPLED_LDOS_TEST_RESOLUTION
+	);
+	Property::LDOS ldos = propertyExtractor.calculateLDOS({{IDX_ALL}});
+
+	//With the default bin width, a sample at the center of an interval
+	//of the LDOS is equal to the LDOS in that interval.
+	const double dE = (SAMPLED_LDOS_TEST_UPPER_BOUND
+		- SAMPLED_LDOS_TEST_LOWER_BOUND)/SAMPLED_LDOS_TEST_RESOLUTION;
+	std::vector<int> intervals = getSampledLDOSTestIntervals();
+	std::vector<double> energies;
+	for(unsigned int n = 0; n < intervals.size(); n++){
+		energies.push_back(
+			SAMPLED_LDOS_TEST_LOWER_BOUND + (intervals[n] + 0.5)*dE
+		);
+	}
+	Property::SampledLDOS sampledLDOS
+		= propertyExtractor.calculateSampledLDOS({{IDX_ALL}}, energies);
+	ASSERT_EQ(sampledLDOS.getNumEnergies(), energies.size())
+		<< errorMessage;
+	double totalWeight = 0;
+	for(int x = 0; x < 6; x++){
+		for(unsigned int n = 0; n < intervals.size(); n++){
+			EXPECT_NEAR(
+				sampledLDOS({x}, n),
+				ldos({x}, intervals[n]),
+				1e-10
+			) << errorMessage;
+			totalWeight += sampledLDOS({x}, n)*dE;
+		}
+	}
+	EXPECT_NEAR(totalWeight, 6, 1e-10) << errorMessage;
+
+	//A bin width that covers the whole spectrum collects all the weight
+	//in a single sample.
+	Property::SampledLDOS wideSampledLDOS
+		= propertyExtractor.calculateSampledLDOS({{IDX_ALL}}, {0.}, 10);
+	for(int x = 0; x < 6; x++)
+		EXPECT_NEAR(wideSampledLDOS({x}, 0), 0.1, 1e-10) << errorMessage;
+}
+
+TEST(SampledLDOS, ChebyshevExpander){
+	std::string errorMessage
+		= "ChebyshevExpander::calculateSampledLDOS() failed.";
+
+	Model model;
+	initSampledLDOSTestModel(model);
+	Solver::ChebyshevExpander solver;
+	solver.setVerbose(false);
+	solver.setModel(model);
+	solver.setScaleFactor(5);
+
+	//The LDOS of the ChebyshevExpander is the density of states times
+	//the width of the energy intervals, evaluated at the lower edge of
+	//each interval. The SampledLDOS is the density of states at the
+	//given energies, which is evaluated without the lookup table.
+	const double dE = (SAMPLED_LDOS_TEST_UPPER_BOUND
+		- SAMPLED_LDOS_TEST_LOWER_BOUND)/SAMPLED_LDOS_TEST_RESOLUTION;
+	std::vector<int> intervals = getSampledLDOSTestIntervals();
+	std::vector<double> energies;
+	for(unsigned int n = 0; n < intervals.size(); n++){
+		energies.push_back(
+			SAMPLED_LDOS_TEST_LOWER_BOUND
+			+ (SAMPLED_LDOS_TEST_UPPER_BOUND
+				- SAMPLED_LDOS_TEST_LOWER_BOUND)
+			*intervals[n]/(double)SAMPLED_LDOS_TEST_RESOLUTION
+		);
+	}
+	for(bool useLookupTable : {false, true}){
+		PropertyExtractor::ChebyshevExpander propertyExtractor(
+			solver,
+			200,
+			false,
+			false,
+			useLookupTable
+		);
+		propertyExtractor.setEnergyWindow(
+			SAMPLED_LDOS_TEST_LOWER_BOUND,
+			SAMPLED_LDOS_TEST_UPPER_BOUND,
+			SAMPLED_LDOS_TEST_RESOLUTION
+		);
+		Property::LDOS ldos = propertyExtractor.calculateLDOS(
+			{{IDX_ALL}}
+		);
+		Property::SampledLDOS sampledLDOS
+			= propertyExtractor.calculateSampledLDOS(
+				{{IDX_ALL}},
+				energies
+			);
+		ASSERT_EQ(sampledLDOS.getNumEnergies(), energies.size())
+			<< errorMessage;
+		for(int x = 0; x < 6; x++){
+			for(unsigned int n = 0; n < intervals.size(); n++){
+				EXPECT_NEAR(
+					sampledLDOS({x}, n)*dE,
+					ldos({x}, intervals[n]),
+					1e-10
+				) << errorMessage;
+			}
+		}
+	}
+}
+
+};
@@ -0,0 +1,96 @@
+#include "TBTK/BrillouinZone.h"
+#include "TBTK/Model.h"
+#include "TBTK/RPA/MomentumSpaceContext.h"
+#include "TBTK/RPA/SelfEnergyCalculator.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace TBTK{
+
+TEST(SelfEnergyCalculator, calculateSelfEnergy){
+	std::string errorMessage = "calculateSelfEnergy() failed.";
+
+	//The self-energy calculated by several workers, which are handed the
+	//mesh points dynamically, agrees with the self-energy calculated by a
+	//single worker. The context is set up by the helper in the
+	//RPASusceptibilityCalculator tests.
+	const std::vector<unsigned int> NUM_MESH_POINTS = {3, 2};
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	model.setTemperature(300);
+	MomentumSpaceContext momentumSpaceContext;
+	initRPASusceptibilityCalculatorTestContext(
+		model,
+		brillouinZone,
+		NUM_MESH_POINTS,
+		{-0.5, 0.5},
+		1,
+		0.2,
+		momentumSpaceContext
+	);
+
+	std::vector<std::complex<double>> selfEnergyEnergies;
+	for(int n = 0; n < 3; n++){
+		selfEnergyEnergies.push_back(
+			std::complex<double>(0.2*n - 0.2, 0.05)
+		);
+	}
+
+	std::vector<SelfEnergyCalculator*> calculators;
+	for(unsigned int numWorkers : {1, 4}){
+		SelfEnergyCalculator *calculator = new SelfEnergyCalculator(
+			momentumSpaceContext,
+			numWorkers
+		);
+		calculator->setNumSummationEnergies(3);
+		calculator->init();
+		calculator->setSelfEnergyEnergies(selfEnergyEnergies);
+		calculator->setU(0.3);
+		calculator->setUp(0.2);
+		calculator->setJ(0.05);
+		calculator->setJp(0.05);
+		calculators.push_back(calculator);
+	}
+
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(NUM_MESH_POINTS);
+	for(unsigned int m = 0; m < mesh.size(); m++){
+		for(int orbitals = 0; orbitals < 4; orbitals++){
+			std::vector<int> orbitalIndices
+				= {orbitals/2, orbitals%2};
+			std::vector<std::complex<double>> reference
+				= calculators[0]->calculateSelfEnergy(
+					mesh[m],
+					orbitalIndices
+				);
+			std::vector<std::complex<double>> result
+				= calculators[1]->calculateSelfEnergy(
+					mesh[m],
+					orbitalIndices
+				);
+			ASSERT_EQ(result.size(), selfEnergyEnergies.size())
+				<< errorMessage;
+			ASSERT_EQ(reference.size(), selfEnergyEnergies.size())
+				<< errorMessage;
+			for(unsigned int e = 0; e < result.size(); e++){
+				EXPECT_NEAR(
+					abs(result[e] - reference[e]),
+					0,
+					1e-10*std::max(abs(reference[e]), 1.)
+				) << errorMessage;
+			}
+		}
+	}
+
+	for(unsigned int n = 0; n < calculators.size(); n++)
+		delete calculators[n];
+}
+
+};
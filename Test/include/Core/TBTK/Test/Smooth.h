@@ -0,0 +1,106 @@
+#include "TBTK/IndexTree.h"
+#include "TBTK/Property/LDOS.h"
+#include "TBTK/Smooth.h"
+#include "TBTK/Streams.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace TBTK{
+
+TEST(Smooth, gaussianWindow){
+	std::string errorMessage = "Gaussian smoothing with window failed.";
+
+	//A delta function is smoothed into the normalized Gaussian.
+	std::vector<double> data(101, 0.);
+	data[50] = 1;
+	const double SIGMA = 2;
+	std::vector<double> result = Smooth::gaussian(data, SIGMA, 41);
+	double sum = 0;
+	for(unsigned int n = 0; n < result.size(); n++)
+		sum += result[n];
+	EXPECT_NEAR(sum, 1, 1e-12) << errorMessage;
+	for(int n = 40; n <= 60; n++){
+		EXPECT_NEAR(
+			result[n]/result[50],
+			std::exp(-(n - 50)*(n - 50)/(2*SIGMA*SIGMA)),
+			1e-12
+		) << errorMessage;
+	}
+}
+
+TEST(Smooth, gaussianRecursive){
+	std::string errorMessage = "Recursive Gaussian smoothing failed.";
+
+	//The recursive filter agrees with the truncated convolution.
+	std::vector<double> data(201, 0.);
+	data[100] = 1;
+	data[40] = 2;
+	for(unsigned int n = 150; n < 170; n++)
+		data[n] = 0.5;
+	const double SIGMA = 4;
+	std::vector<double> reference = Smooth::gaussian(data, SIGMA, 49);
+	std::vector<double> result = Smooth::gaussian(data, SIGMA);
+	ASSERT_EQ(result.size(), data.size()) << errorMessage;
+	double referenceSum = 0;
+	double sum = 0;
+	for(unsigned int n = 0; n < data.size(); n++){
+		EXPECT_NEAR(result[n], reference[n], 0.01) << errorMessage;
+		referenceSum += reference[n];
+		sum += result[n];
+	}
+	EXPECT_NEAR(sum, referenceSum, 1e-3*referenceSum) << errorMessage;
+
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			Smooth::gaussian(data, 0.);
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+}
+
+TEST(Smooth, gaussianLDOS){
+	std::string errorMessage = "Gaussian smoothing of LDOS failed.";
+
+	//Every block is smoothed as an independent series, with sigma given
+	//in units of energy.
+	IndexTree indexTree;
+	for(int x = 0; x < 10; x++)
+		indexTree.add({x});
+	indexTree.generateLinearMap();
+	const int RESOLUTION = 200;
+	Property::LDOS ldos(indexTree, -1, 1, RESOLUTION);
+	for(int x = 0; x < 10; x++)
+		ldos({x}, 10*x + 50) = x + 1;
+
+	const double SIGMA = 0.05;
+	const double SCALED_SIGMA = SIGMA/2*RESOLUTION;
+	Property::LDOS result = Smooth::gaussian(ldos, SIGMA);
+	Property::LDOS resultWindow = Smooth::gaussian(ldos, SIGMA, 61);
+	for(int x = 0; x < 10; x++){
+		std::vector<double> block(RESOLUTION, 0.);
+		block[10*x + 50] = x + 1;
+		std::vector<double> reference = Smooth::gaussian(
+			block,
+			SCALED_SIGMA
+		);
+		std::vector<double> referenceWindow = Smooth::gaussian(
+			block,
+			SCALED_SIGMA,
+			61
+		);
+		for(int n = 0; n < RESOLUTION; n++){
+			EXPECT_DOUBLE_EQ(result({x}, n), reference[n])
+				<< errorMessage;
+			EXPECT_DOUBLE_EQ(
+				resultWindow({x}, n),
+				referenceWindow[n]
+			) << errorMessage;
+		}
+	}
+}
+
+};
@@ -0,0 +1,214 @@
+#include "TBTK/BrillouinZone.h"
+#include "TBTK/Model.h"
+#include "TBTK/RPA/LindhardSusceptibilityCalculator.h"
+#include "TBTK/RPA/MomentumSpaceContext.h"
+#include "TBTK/Streams.h"
+#include "TBTK/UnitHandler.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <sstream>
+
+#ifdef TBTK_USE_OPEN_MP
+#	include <omp.h>
+#endif
+
+namespace TBTK{
+
+TEST(SusceptibilityCalculator, precompute){
+	std::string errorMessage = "precompute() failed.";
+
+	//The susceptibilities precomputed by several threads agree with those
+	//precomputed by a single thread, and the progress is reported when
+	//the calculator is verbose. The context is set up by the helper in
+	//the RPASusceptibilityCalculator tests.
+	const std::vector<unsigned int> NUM_MESH_POINTS = {4, 3};
+	const int NUM_ORBITALS = 3;
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	model.setTemperature(300);
+	MomentumSpaceContext momentumSpaceContext;
+	initRPASusceptibilityCalculatorTestContext(
+		model,
+		brillouinZone,
+		NUM_MESH_POINTS,
+		{-0.5, 0, 0.5},
+		1,
+		0.2,
+		momentumSpaceContext
+	);
+
+	std::vector<std::complex<double>> energies;
+	for(int n = 0; n < 4; n++)
+		energies.push_back(std::complex<double>(0.1*n, 0.05));
+
+	LindhardSusceptibilityCalculator serialCalculator(
+		momentumSpaceContext
+	);
+	serialCalculator.setEnergies(energies);
+#ifdef TBTK_USE_OPEN_MP
+	int maxThreads = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+	serialCalculator.precompute();
+#ifdef TBTK_USE_OPEN_MP
+	omp_set_num_threads(4);
+#endif
+
+	LindhardSusceptibilityCalculator calculator(momentumSpaceContext);
+	calculator.setEnergies(energies);
+	calculator.setVerbose(true);
+	std::stringstream ss;
+	std::streambuf *outBuffer = Streams::out.rdbuf(ss.rdbuf());
+	calculator.precompute();
+	Streams::out.rdbuf(outBuffer);
+#ifdef TBTK_USE_OPEN_MP
+	omp_set_num_threads(maxThreads);
+#endif
+
+	unsigned int numTasks
+		= NUM_ORBITALS*NUM_ORBITALS*NUM_ORBITALS*NUM_ORBITALS*12;
+	std::string output = ss.str();
+	EXPECT_NE(
+		output.find("Tasks: " + std::to_string(numTasks)),
+		std::string::npos
+	) << errorMessage;
+	std::string progressLabel = "Progress (2% per dot): ";
+	size_t progressBegin = output.find(progressLabel);
+	ASSERT_NE(progressBegin, std::string::npos) << errorMessage;
+	progressBegin += progressLabel.size();
+	size_t progressEnd = output.find('\n', progressBegin);
+	EXPECT_EQ(
+		output.substr(progressBegin, progressEnd - progressBegin),
+		std::string(50, '.')
+	) << errorMessage;
+	EXPECT_NE(output.find("Calculated"), std::string::npos)
+		<< errorMessage;
+
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(NUM_MESH_POINTS);
+	for(unsigned int m = 0; m < mesh.size(); m++){
+		DualIndex q(
+			brillouinZone.getMinorCellIndex(mesh[m], NUM_MESH_POINTS),
+			mesh[m]
+		);
+		for(int orbitals = 0; orbitals < 81; orbitals++){
+			std::vector<int> orbitalIndices = {
+				(orbitals/27)%3,
+				(orbitals/9)%3,
+				(orbitals/3)%3,
+				orbitals%3
+			};
+			std::vector<std::complex<double>> result
+				= calculator.calculateSusceptibility(
+					q,
+					orbitalIndices
+				);
+			std::vector<std::complex<double>> reference
+				= serialCalculator.calculateSusceptibility(
+					q,
+					orbitalIndices
+				);
+			ASSERT_EQ(result.size(), reference.size())
+				<< errorMessage;
+			for(unsigned int e = 0; e < result.size(); e++){
+				EXPECT_NEAR(
+					abs(result[e] - reference[e]),
+					0,
+					1e-12*std::max(abs(reference[e]), 1.)
+				) << errorMessage;
+			}
+		}
+	}
+}
+
+TEST(SusceptibilityCalculator, energiesAreInversionSymmetric){
+	std::string errorMessage = "Symmetry extension of the cache failed.";
+
+	//For inversion symmetric Matsubara energies, every calculated entry is
+	//also used to fill in related entries. The entries obtained in this
+	//way agree with those calculated explicitly.
+	const std::vector<unsigned int> NUM_MESH_POINTS = {4, 3};
+	BrillouinZone brillouinZone(
+		{{2*M_PI, 0}, {0, 2*M_PI}},
+		SpacePartition::MeshType::Nodal
+	);
+	Model model;
+	model.setTemperature(300);
+	MomentumSpaceContext momentumSpaceContext;
+	initRPASusceptibilityCalculatorTestContext(
+		model,
+		brillouinZone,
+		NUM_MESH_POINTS,
+		{-0.5, 0.5},
+		1,
+		0.2,
+		momentumSpaceContext
+	);
+
+	double temperature = UnitHandler::convertTemperatureNtB(
+		model.getTemperature()
+	);
+	double kT = UnitHandler::getK_BB()*temperature;
+	std::vector<std::complex<double>> energies;
+	for(int n = -2; n <= 2; n++)
+		energies.push_back(std::complex<double>(0, 2*M_PI*n*kT));
+
+	LindhardSusceptibilityCalculator referenceCalculator(
+		momentumSpaceContext
+	);
+	referenceCalculator.setEnergies(energies);
+	referenceCalculator.setEnergyType(
+		SusceptibilityCalculator::EnergyType::Imaginary
+	);
+	LindhardSusceptibilityCalculator calculator(momentumSpaceContext);
+	calculator.setEnergies(energies);
+	calculator.setEnergyType(
+		SusceptibilityCalculator::EnergyType::Imaginary
+	);
+	calculator.setEnergiesAreInversionSymmetric(true);
+
+	std::vector<std::vector<double>> mesh
+		= brillouinZone.getMinorMesh(NUM_MESH_POINTS);
+	for(unsigned int m = 0; m < mesh.size(); m++){
+		DualIndex q(
+			brillouinZone.getMinorCellIndex(mesh[m], NUM_MESH_POINTS),
+			mesh[m]
+		);
+		for(int orbitals = 0; orbitals < 16; orbitals++){
+			std::vector<int> orbitalIndices = {
+				(orbitals/8)%2,
+				(orbitals/4)%2,
+				(orbitals/2)%2,
+				orbitals%2
+			};
+			std::vector<std::complex<double>> result
+				= calculator.calculateSusceptibility(
+					q,
+					orbitalIndices
+				);
+			std::vector<std::complex<double>> reference
+				= referenceCalculator.calculateSusceptibility(
+					q,
+					orbitalIndices
+				);
+			ASSERT_EQ(result.size(), reference.size())
+				<< errorMessage;
+			for(unsigned int e = 0; e < result.size(); e++){
+				EXPECT_NEAR(
+					abs(result[e] - reference[e]),
+					0,
+					1e-12*std::max(abs(reference[e]), 1.)
+				) << errorMessage;
+			}
+		}
+	}
+}
+
+};
@@ -0,0 +1,180 @@
+#include "TBTK/MemoryMappedFile.h"
+#include "TBTK/RPA/SusceptibilityTensor.h"
+#include "TBTK/Streams.h"
+
+#include "gtest/gtest.h"
+
+#include <complex>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace TBTK{
+
+//Gives access to the binary format to locate the status flags in a
+//serialization.
+class SusceptibilityTensorTestFormat : public Serializeable{
+public:
+	static std::uint64_t getStatusOffset(const std::string &serialization){
+		BinaryReader reader(serialization, "SusceptibilityTensor");
+		return (const char*)reader.getArrayData<unsigned char>("status")
+			- serialization.data();
+	}
+};
+
+inline std::vector<std::complex<double>> getSusceptibilityTensorTestValues(
+	double offset
+){
+	std::vector<std::complex<double>> values;
+	for(unsigned int n = 0; n < 4; n++)
+		values.push_back(std::complex<double>(offset + n, -offset*n));
+
+	return values;
+}
+
+inline std::string readSusceptibilityTensorTestFile(
+	const std::string &filename
+){
+	std::ifstream fin(filename, std::ios::binary);
+	return std::string(
+		(std::istreambuf_iterator<char>(fin)),
+		std::istreambuf_iterator<char>()
+	);
+}
+
+TEST(SusceptibilityTensor, add){
+	std::string errorMessage = "add() failed.";
+
+	SusceptibilityTensor tensor(3, 2, 4);
+	EXPECT_EQ(tensor.get(1, {0, 1, 1, 0}), nullptr) << errorMessage;
+	std::vector<std::complex<double>> values
+		= getSusceptibilityTensorTestValues(1);
+	EXPECT_TRUE(tensor.add(values.data(), 1, {0, 1, 1, 0}))
+		<< errorMessage;
+
+	//Entries can only be added once.
+	std::vector<std::complex<double>> otherValues
+		= getSusceptibilityTensorTestValues(2);
+	EXPECT_FALSE(tensor.add(otherValues.data(), 1, {0, 1, 1, 0}))
+		<< errorMessage;
+	const std::complex<double> *entry = tensor.get(1, {0, 1, 1, 0});
+	ASSERT_NE(entry, nullptr) << errorMessage;
+	for(unsigned int n = 0; n < 4; n++)
+		EXPECT_EQ(entry[n], values[n]) << errorMessage;
+	EXPECT_EQ(tensor.get(1, {0, 1, 1, 1}), nullptr) << errorMessage;
+	EXPECT_EQ(tensor.getNumAddedEntries(), 1) << errorMessage;
+}
+
+TEST(SusceptibilityTensor, serialize){
+	std::string errorMessage = "serialize() failed.";
+
+	//Large enough for the data to be written in several chunks.
+	const unsigned int NUM_ENERGIES = 128;
+	SusceptibilityTensor tensor(100, 2, NUM_ENERGIES);
+	std::vector<std::complex<double>> values;
+	for(unsigned int n = 0; n < NUM_ENERGIES; n++)
+		values.push_back(std::complex<double>(n, 1));
+	tensor.add(values.data(), 2, {1, 0, 1, 1});
+	tensor.add(values.data(), 99, {1, 1, 1, 1});
+
+	//Serialization to a stream agrees with the serialization string.
+	std::ostringstream stream;
+	tensor.serialize(Serializeable::Mode::Binary, stream);
+	EXPECT_EQ(
+		stream.str(),
+		tensor.serialize(Serializeable::Mode::Binary)
+	) << errorMessage;
+}
+
+TEST(SusceptibilityTensor, MemoryMappedFile){
+	std::string errorMessage = "Memory mapped SusceptibilityTensor failed.";
+	std::string filename = "TBTKTestSusceptibilityTensor.bin";
+
+	//Store one complete entry and one entry that was being written.
+	SusceptibilityTensor tensor(3, 2, 4);
+	std::vector<std::complex<double>> values0
+		= getSusceptibilityTensorTestValues(1);
+	tensor.add(values0.data(), 0, {0, 0, 0, 0});
+	std::string serialization = tensor.serialize(
+		Serializeable::Mode::Binary
+	);
+	std::uint64_t writingEntry = 1;
+	serialization[
+		SusceptibilityTensorTestFormat::getStatusOffset(serialization)
+		+ writingEntry
+	] = 1;
+	std::ofstream fout(filename, std::ios::binary);
+	fout.write(serialization.data(), serialization.size());
+	fout.close();
+
+	//The incomplete entry is treated as empty.
+	std::vector<std::complex<double>> values1
+		= getSusceptibilityTensorTestValues(2);
+	{
+		SusceptibilityTensor mappedTensor(
+			MemoryMappedFile(
+				filename,
+				MemoryMappedFile::Mode::CopyOnWrite
+			)
+		);
+		EXPECT_EQ(mappedTensor.getMeshSize(), 3) << errorMessage;
+		EXPECT_EQ(mappedTensor.getNumOrbitals(), 2) << errorMessage;
+		EXPECT_EQ(mappedTensor.getNumEnergies(), 4) << errorMessage;
+		EXPECT_EQ(mappedTensor.getNumAddedEntries(), 1) << errorMessage;
+		const std::complex<double> *entry
+			= mappedTensor.get(0, {0, 0, 0, 0});
+		ASSERT_NE(entry, nullptr) << errorMessage;
+		for(unsigned int n = 0; n < 4; n++)
+			EXPECT_EQ(entry[n], values0[n]) << errorMessage;
+		EXPECT_EQ(mappedTensor.get(0, {0, 0, 0, 1}), nullptr)
+			<< errorMessage;
+		EXPECT_TRUE(
+			mappedTensor.add(values1.data(), 0, {0, 0, 0, 1})
+		) << errorMessage;
+	}
+
+	//Loading does not write to a shared mapping, while added entries are
+	//stored in the file.
+	{
+		SusceptibilityTensor mappedTensor(
+			MemoryMappedFile(
+				filename,
+				MemoryMappedFile::Mode::ReadWrite
+			)
+		);
+		EXPECT_EQ(
+			readSusceptibilityTensorTestFile(filename),
+			serialization
+		) << errorMessage;
+		mappedTensor.add(values1.data(), 2, {1, 1, 0, 1});
+	}
+	SusceptibilityTensor mappedTensor(
+		MemoryMappedFile(filename, MemoryMappedFile::Mode::CopyOnWrite)
+	);
+	EXPECT_EQ(mappedTensor.getNumAddedEntries(), 2) << errorMessage;
+	const std::complex<double> *entry = mappedTensor.get(2, {1, 1, 0, 1});
+	ASSERT_NE(entry, nullptr) << errorMessage;
+	for(unsigned int n = 0; n < 4; n++)
+		EXPECT_EQ(entry[n], values1[n]) << errorMessage;
+
+	//Read only mappings can be read from, but not added to.
+	SusceptibilityTensor readOnlyTensor((MemoryMappedFile(filename)));
+	EXPECT_EQ(readOnlyTensor.getNumAddedEntries(), 2) << errorMessage;
+	entry = readOnlyTensor.get(0, {0, 0, 0, 0});
+	ASSERT_NE(entry, nullptr) << errorMessage;
+	for(unsigned int n = 0; n < 4; n++)
+		EXPECT_EQ(entry[n], values0[n]) << errorMessage;
+	EXPECT_EXIT(
+		{
+			Streams::setStdMuteErr();
+			readOnlyTensor.add(values1.data(), 1, {0, 0, 0, 0});
+		},
+		::testing::ExitedWithCode(1),
+		""
+	);
+
+	std::remove(filename.c_str());
+}
+
+};
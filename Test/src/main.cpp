@@ -1,8 +1,29 @@
 #include "gtest/gtest.h"
 
 #include "TBTK/Test/Index.h"
+#include "TBTK/Test/Array.h"
 #include "TBTK/Test/HoppingAmplitude.h"
 #include "TBTK/Test/HoppingAmplitudeTree.h"
+#include "TBTK/Test/BasisIndexLookupTable.h"
+#include "TBTK/Test/ParameterizedHamiltonian.h"
+#include "TBTK/Test/MemoryMappedFile.h"
+#include "TBTK/Test/DataManager.h"
+#include "TBTK/Test/FileWriter.h"
+#include "TBTK/Test/AbstractProperty.h"
+#include "TBTK/Test/GreensFunction.h"
+#include "TBTK/Test/Smooth.h"
+#include "TBTK/Test/FourierTransform.h"
+#include "TBTK/Test/MatsubaraSusceptibilityCalculator.h"
+#include "TBTK/Test/SusceptibilityTensor.h"
+#include "TBTK/Test/LindhardSusceptibilityCalculator.h"
+#include "TBTK/Test/RPASusceptibilityCalculator.h"
+#include "TBTK/Test/SusceptibilityCalculator.h"
+#include "TBTK/Test/SelfEnergyCalculator.h"
+#include "TBTK/Test/MomentumSpaceContext.h"
+#include "TBTK/Test/BrillouinZoneIntegrator.h"
+#include "TBTK/Test/Diagonalizer.h"
+#include "TBTK/Test/SampledLDOS.h"
+#include "TBTK/Test/ReciprocalLattice.h"
 
 int main(int argc, char **argv){
 	::testing::InitGoogleTest(&argc, argv);